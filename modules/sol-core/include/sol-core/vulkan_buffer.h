@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <vector>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -44,6 +50,11 @@ namespace sol
              */
             VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+            /**
+             * \brief Queue families that will access the buffer. Only used if sharingMode is concurrent.
+             */
+            std::vector<uint32_t> queueFamilyIndices;
+
             /**
              * \brief Optional allocator. If set, also fill in the properties of the vma member.
              */
@@ -193,6 +204,27 @@ namespace sol
 
         [[nodiscard]] bool isMapped() const noexcept;
 
+        /**
+         * \brief Get the property flags of the memory type this buffer was allocated from. Only known for buffers
+         * created using an allocator. Returns 0 otherwise.
+         * \return Memory property flags.
+         */
+        [[nodiscard]] VkMemoryPropertyFlags getMemoryPropertyFlags() const;
+
+        /**
+         * \brief Returns whether this buffer was allocated from HOST_VISIBLE memory, i.e. whether it is mapped or can
+         * be mapped. Only known for buffers created using an allocator.
+         * \return True if host visible.
+         */
+        [[nodiscard]] bool isHostVisible() const;
+
+        /**
+         * \brief Returns whether this buffer was allocated from HOST_COHERENT memory. If not, host writes need to be
+         * flushed and device writes need to be invalidated before the host reads them.
+         * \return True if host coherent.
+         */
+        [[nodiscard]] bool isHostCoherent() const;
+
         template<typename T>
         [[nodiscard]] T* getMappedData() const noexcept
         {
@@ -267,6 +299,22 @@ namespace sol
 
         void flush() const;
 
+        /**
+         * \brief Flush host writes in the range [offset, offset + size) so that they become visible to the device.
+         * Does nothing for host coherent memory.
+         * \param offset Offset in bytes.
+         * \param size Size in bytes. Can be VK_WHOLE_SIZE.
+         */
+        void flush(size_t offset, size_t size) const;
+
+        /**
+         * \brief Invalidate the range [offset, offset + size) so that device writes become visible to the host.
+         * Does nothing for host coherent memory.
+         * \param offset Offset in bytes.
+         * \param size Size in bytes. Can be VK_WHOLE_SIZE.
+         */
+        void invalidate(size_t offset, size_t size) const;
+
     private:
         [[nodiscard]] static std::tuple<VkBuffer, VmaAllocation, void*> createImpl(const Settings& settings,
                                                                                    bool            throwOnOutOfMemory);
@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <vector>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -53,6 +59,11 @@ namespace sol
 
             VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
+            /**
+             * \brief Queue families that will access the image. Only used if sharingMode is concurrent.
+             */
+            std::vector<uint32_t> queueFamilyIndices;
+
             VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
             /**
@@ -83,6 +83,11 @@ namespace sol
         bufferInfo.size        = settings.size;
         bufferInfo.usage       = settings.bufferUsage;
         bufferInfo.sharingMode = settings.sharingMode;
+        if (settings.sharingMode == VK_SHARING_MODE_CONCURRENT)
+        {
+            bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(settings.queueFamilyIndices.size());
+            bufferInfo.pQueueFamilyIndices   = settings.queueFamilyIndices.data();
+        }
 
         VkBuffer      vkBuffer      = VK_NULL_HANDLE;
         VmaAllocation vmaAllocation = VK_NULL_HANDLE;
@@ -206,6 +211,25 @@ namespace sol
 
     bool VulkanBuffer::isMapped() const noexcept { return mappedData != nullptr; }
 
+    VkMemoryPropertyFlags VulkanBuffer::getMemoryPropertyFlags() const
+    {
+        if (!allocation) return 0;
+
+        VkMemoryPropertyFlags flags = 0;
+        vmaGetAllocationMemoryProperties(getAllocator().get(), allocation, &flags);
+        return flags;
+    }
+
+    bool VulkanBuffer::isHostVisible() const
+    {
+        return (getMemoryPropertyFlags() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+    }
+
+    bool VulkanBuffer::isHostCoherent() const
+    {
+        return (getMemoryPropertyFlags() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+    }
+
     ////////////////////////////////////////////////////////////////
     // ...
     ////////////////////////////////////////////////////////////////
@@ -357,4 +381,16 @@ namespace sol
         else
             throw SolError("");
     }
+
+    void VulkanBuffer::flush(const size_t offset, const size_t size) const
+    {
+        if (!allocation) throw SolError("Cannot flush buffer. Buffer was not created using an allocator.");
+        handleVulkanError(vmaFlushAllocation(getAllocator().get(), allocation, offset, size));
+    }
+
+    void VulkanBuffer::invalidate(const size_t offset, const size_t size) const
+    {
+        if (!allocation) throw SolError("Cannot invalidate buffer. Buffer was not created using an allocator.");
+        handleVulkanError(vmaInvalidateAllocation(getAllocator().get(), allocation, offset, size));
+    }
 }  // namespace sol
@@ -86,8 +86,11 @@ namespace sol
         createInfo.tiling                = settings.tiling;
         createInfo.usage                 = settings.imageUsage;
         createInfo.sharingMode           = settings.sharingMode;
-        createInfo.queueFamilyIndexCount = 0;
-        createInfo.pQueueFamilyIndices   = nullptr;
+        createInfo.queueFamilyIndexCount = settings.sharingMode == VK_SHARING_MODE_CONCURRENT ?
+                                             static_cast<uint32_t>(settings.queueFamilyIndices.size()) :
+                                             0;
+        createInfo.pQueueFamilyIndices =
+          settings.sharingMode == VK_SHARING_MODE_CONCURRENT ? settings.queueFamilyIndices.data() : nullptr;
         createInfo.initialLayout         = settings.initialLayout;
 
         VkImage       vkImage       = VK_NULL_HANDLE;
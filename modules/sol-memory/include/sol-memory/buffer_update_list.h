@@ -0,0 +1,181 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// External includes.
+////////////////////////////////////////////////////////////////
+
+#include <vulkan/vulkan.hpp>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/fwd.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief List of small buffer updates that are recorded with vkCmdUpdateBuffer directly into a command buffer on
+     * the queue that consumes the buffers, e.g. at the start of the command buffer of a render task. Unlike a
+     * Transaction, this needs no staging buffer, copy on the transfer queue, queue family ownership transfer or
+     * semaphore wait, which makes it a good fit for per-frame parameter changes.
+     * -
+     *
+     * Data is copied into the list when an update is added, so it can be released right away. All updates are
+     * recorded in the order they were added, surrounded by a single pair of memory barriers.
+     */
+    class BufferUpdateList
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Maximum size of a single update, as imposed by vkCmdUpdateBuffer.
+         */
+        static constexpr size_t maxUpdateSize = 65536;
+
+        /**
+         * \brief Synchronization of the updates with the commands around them.
+         */
+        struct Barrier
+        {
+            /**
+             * \brief Stages of preceding commands that access the buffers, e.g. reads of the previous frame.
+             */
+            VkPipelineStageFlags2 srcStage = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+            /**
+             * \brief Stages of following commands that read the updated data.
+             */
+            VkPipelineStageFlags2 dstStage = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+            /**
+             * \brief Accesses of preceding commands that must be made available before the update.
+             */
+            VkAccessFlags2 srcAccess = VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+            /**
+             * \brief Accesses of following commands that read the updated data.
+             */
+            VkAccessFlags2 dstAccess = VK_ACCESS_2_MEMORY_READ_BIT;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        BufferUpdateList();
+
+        BufferUpdateList(const BufferUpdateList&) = delete;
+
+        BufferUpdateList(BufferUpdateList&&) noexcept;
+
+        ~BufferUpdateList() noexcept;
+
+        BufferUpdateList& operator=(const BufferUpdateList&) = delete;
+
+        BufferUpdateList& operator=(BufferUpdateList&&) noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        [[nodiscard]] size_t getUpdateCount() const noexcept;
+
+        /**
+         * \brief Get the total number of bytes over all pending updates.
+         * \return Size in bytes.
+         */
+        [[nodiscard]] size_t getDataSize() const noexcept;
+
+        [[nodiscard]] const Barrier& getBarrier() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set the synchronization used when flushing.
+         * \param value Barrier.
+         */
+        void setBarrier(const Barrier& value) noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Updates.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Add an update. The buffer must stay alive and keep its queue family until the list is flushed or
+         * cleared.
+         * \param buffer Destination buffer. Must have been created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+         * \param src Pointer to data. Copied into the list.
+         * \param size Size of the update in bytes. Must be a multiple of 4 and at most maxUpdateSize.
+         * \param offset Offset into the buffer. Is added to buffer.getBufferOffset(). The sum must be a multiple of 4.
+         * \throws SolError Thrown if the size or offset are invalid.
+         */
+        void add(IBuffer& buffer, const void* src, size_t size, size_t offset = 0);
+
+        /**
+         * \brief Record all updates into a command buffer and clear the list. Does nothing if the list is empty.
+         * Must be called outside of a render pass.
+         * \param commandBuffer Command buffer in the recording state. Must have been allocated from a pool of the
+         * queue family that owns the buffers.
+         * \throws SolError Thrown if a buffer is owned by a different queue family.
+         */
+        void flush(const VulkanCommandBuffer& commandBuffer);
+
+        /**
+         * \brief Discard all pending updates.
+         */
+        void clear() noexcept;
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Update
+        {
+            IBuffer* buffer = nullptr;
+
+            /**
+             * \brief Offset into the buffer, including the suballocation offset.
+             */
+            size_t offset = 0;
+
+            /**
+             * \brief Offset into the data array.
+             */
+            size_t dataOffset = 0;
+
+            size_t size = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        Barrier barrier;
+
+        std::vector<Update> updates;
+
+        std::vector<std::byte> data;
+    };
+}  // namespace sol
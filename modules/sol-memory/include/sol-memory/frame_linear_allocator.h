@@ -0,0 +1,208 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <optional>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/fwd.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief Allocator for transient per-frame data, such as uniforms and instance data. Keeps a persistently mapped
+     * buffer for each of N frames, allocated from a StackMemoryPool. Allocating only bumps an offset into the buffer
+     * of the current frame. When the allocator cycles back to a frame, it waits until the timeline semaphore value
+     * recorded for that frame is reached and then reuses the whole buffer at once.
+     * -
+     *
+     * Allocating is lock-free and may be done from multiple threads. Beginning and ending frames must not overlap
+     * with allocations.
+     */
+    class FrameLinearAllocator
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Range in the buffer of the current frame.
+         */
+        struct Allocation
+        {
+            /**
+             * \brief Buffer of the frame the range was allocated from.
+             */
+            VulkanBuffer* buffer = nullptr;
+
+            /**
+             * \brief Offset of the range in the buffer.
+             */
+            size_t offset = 0;
+
+            /**
+             * \brief Size of the range in bytes.
+             */
+            size_t size = 0;
+
+            /**
+             * \brief Pointer to the mapped memory of the range.
+             */
+            void* data = nullptr;
+
+            template<typename T>
+            [[nodiscard]] T* getData() const noexcept
+            {
+                return static_cast<T*>(data);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        FrameLinearAllocator() = delete;
+
+        /**
+         * \brief Construct a new FrameLinearAllocator.
+         * \param memoryPool Memory pool from which the buffers of all frames are allocated. Must have been created with
+         * VMA_ALLOCATION_CREATE_MAPPED_BIT.
+         * \param size Size of the buffer of each frame in bytes.
+         * \param count Number of frames. Typically the number of frames in flight.
+         * \param alignment Minimum alignment of all allocations. Is raised to the required alignment of the memory
+         * pool. The default satisfies the uniform, storage and texel buffer offset alignment of all devices.
+         * \throws SolError Thrown if the memory pool is not persistently mapped or count is 0.
+         */
+        FrameLinearAllocator(StackMemoryPool& memoryPool, size_t size, size_t count, size_t alignment = 256);
+
+        FrameLinearAllocator(const FrameLinearAllocator&) = delete;
+
+        FrameLinearAllocator(FrameLinearAllocator&&) noexcept = delete;
+
+        ~FrameLinearAllocator() noexcept;
+
+        FrameLinearAllocator& operator=(const FrameLinearAllocator&) = delete;
+
+        FrameLinearAllocator& operator=(FrameLinearAllocator&&) noexcept = delete;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] StackMemoryPool& getMemoryPool() noexcept;
+
+        [[nodiscard]] const StackMemoryPool& getMemoryPool() const noexcept;
+
+        [[nodiscard]] size_t getFrameSize() const noexcept;
+
+        [[nodiscard]] size_t getFrameCount() const noexcept;
+
+        /**
+         * \brief Get the index of the current frame.
+         * \return Frame index.
+         */
+        [[nodiscard]] size_t getFrameIndex() const noexcept;
+
+        /**
+         * \brief Get the number of bytes allocated in the current frame, including alignment padding.
+         * \return Number of bytes.
+         */
+        [[nodiscard]] size_t getUsedBytes() const noexcept;
+
+        /**
+         * \brief Get the buffer of a frame.
+         * \param frame Frame index.
+         * \return Buffer.
+         */
+        [[nodiscard]] VulkanBuffer& getBuffer(size_t frame) const;
+
+        ////////////////////////////////////////////////////////////////
+        // Frames.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Advance to the next frame. If a timeline semaphore value was recorded for that frame, does a CPU-side
+         * wait until it is reached. All previous allocations of the frame are released.
+         */
+        void beginFrame();
+
+        /**
+         * \brief End the current frame. Flushes the allocated range if the memory is not host coherent and records the
+         * timeline semaphore value that is signalled once the device no longer uses the allocations of this frame.
+         * \param semaphore Timeline semaphore.
+         * \param value Value that is signalled after the last submit that uses this frame.
+         */
+        void endFrame(const VulkanTimelineSemaphore& semaphore, uint64_t value);
+
+        ////////////////////////////////////////////////////////////////
+        // Allocations.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Allocate a range from the current frame.
+         * \param size Size in bytes.
+         * \param alignment Alignment in bytes. Is raised to the minimum alignment. Must be a power of 2.
+         * \throws SolError Thrown if the current frame is out of memory.
+         * \return Allocation.
+         */
+        [[nodiscard]] Allocation allocate(size_t size, size_t alignment = 0);
+
+        /**
+         * \brief Allocate a range from the current frame.
+         * \param size Size in bytes.
+         * \param alignment Alignment in bytes. Is raised to the minimum alignment. Must be a power of 2.
+         * \return Allocation, or std::nullopt if the current frame is out of memory.
+         */
+        [[nodiscard]] std::optional<Allocation> tryAllocate(size_t size, size_t alignment = 0);
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Frame
+        {
+            MemoryPoolBufferPtr buffer;
+
+            /**
+             * \brief Semaphore that is signalled when the device no longer uses this frame. Null if never submitted.
+             */
+            const VulkanTimelineSemaphore* semaphore = nullptr;
+
+            uint64_t value = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        StackMemoryPool* pool = nullptr;
+
+        size_t frameSize = 0;
+
+        size_t minAlignment = 0;
+
+        std::vector<Frame> frames;
+
+        size_t frameIndex = 0;
+
+        /**
+         * \brief Offset at which the next allocation in the current frame is placed.
+         */
+        std::atomic_size_t head = 0;
+    };
+}  // namespace sol
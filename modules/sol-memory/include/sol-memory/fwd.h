@@ -9,8 +9,10 @@
 namespace sol
 {
     class Buffer;
+    class BufferUpdateList;
     class Transaction;
     class DoubleStackMemoryPool;
+    class FrameLinearAllocator;
     class FreeAtOnceMemoryPool;
     class IBuffer;
     class IBufferAllocator;
@@ -19,16 +21,24 @@ namespace sol
     class MemoryManager;
     class MemoryPoolBuffer;
     class NonLinearMemoryPool;
+    class ResidencyManager;
     class RingBufferMemoryPool;
     class StackMemoryPool;
+    class TransactionHandle;
     class TransactionManager;
+    class TransientAllocator;
+    class UploadScheduler;
 
     using BufferPtr                      = std::unique_ptr<Buffer>;
     using BufferSharedPtr                = std::shared_ptr<Buffer>;
+    using BufferUpdateListPtr            = std::unique_ptr<BufferUpdateList>;
+    using BufferUpdateListSharedPtr      = std::shared_ptr<BufferUpdateList>;
     using BufferTransactionPtr           = std::unique_ptr<Transaction>;
     using BufferTransactionSharedPtr     = std::shared_ptr<Transaction>;
     using DoubleStackMemoryPoolPtr       = std::unique_ptr<DoubleStackMemoryPool>;
     using DoubleStackMemoryPoolSharedPtr = std::shared_ptr<DoubleStackMemoryPool>;
+    using FrameLinearAllocatorPtr        = std::unique_ptr<FrameLinearAllocator>;
+    using FrameLinearAllocatorSharedPtr  = std::shared_ptr<FrameLinearAllocator>;
     using FreeAtOnceMemoryPoolPtr        = std::unique_ptr<FreeAtOnceMemoryPool>;
     using FreeAtOnceMemoryPoolSharedPtr  = std::shared_ptr<FreeAtOnceMemoryPool>;
     using IBufferPtr                     = std::unique_ptr<IBuffer>;
@@ -45,10 +55,16 @@ namespace sol
     using MemoryPoolBufferSharedPtr      = std::shared_ptr<MemoryPoolBuffer>;
     using NonLinearMemoryPoolPtr         = std::unique_ptr<NonLinearMemoryPool>;
     using NonLinearMemoryPoolSharedPtr   = std::shared_ptr<NonLinearMemoryPool>;
+    using ResidencyManagerPtr            = std::unique_ptr<ResidencyManager>;
+    using ResidencyManagerSharedPtr      = std::shared_ptr<ResidencyManager>;
     using RingBufferMemoryPoolPtr        = std::unique_ptr<RingBufferMemoryPool>;
     using RingBufferMemoryPoolSharedPtr  = std::shared_ptr<RingBufferMemoryPool>;
     using StackMemoryPoolPtr             = std::unique_ptr<StackMemoryPool>;
     using StackMemoryPoolSharedPtr       = std::shared_ptr<StackMemoryPool>;
     using TransactionManagerPtr          = std::unique_ptr<TransactionManager>;
     using TransactionManagerSharedPtr    = std::shared_ptr<TransactionManager>;
+    using TransientAllocatorPtr          = std::unique_ptr<TransientAllocator>;
+    using TransientAllocatorSharedPtr    = std::shared_ptr<TransientAllocator>;
+    using UploadSchedulerPtr             = std::unique_ptr<UploadScheduler>;
+    using UploadSchedulerSharedPtr       = std::shared_ptr<UploadScheduler>;
 }  // namespace sol
@@ -92,6 +92,13 @@ namespace sol
          */
         [[nodiscard]] const VulkanQueueFamily& getQueueFamily() const noexcept;
 
+        /**
+         * \brief Get whether this buffer was created with VK_SHARING_MODE_CONCURRENT. A concurrent buffer can be
+         * accessed by all queue families without ownership transfers. Its queue family is never changed by barriers.
+         * \return True if concurrent.
+         */
+        [[nodiscard]] bool isConcurrent() const;
+
         [[nodiscard]] virtual VulkanBuffer& getBuffer() = 0;
 
         [[nodiscard]] virtual const VulkanBuffer& getBuffer() const = 0;
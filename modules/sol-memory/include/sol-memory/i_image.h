@@ -74,6 +74,13 @@ namespace sol
          */
         [[nodiscard]] virtual const VulkanQueueFamily& getQueueFamily(uint32_t level, uint32_t layer) const = 0;
 
+        /**
+         * \brief Get whether this image was created with VK_SHARING_MODE_CONCURRENT. A concurrent image can be
+         * accessed by all queue families without ownership transfers. Its queue family is never changed by barriers.
+         * \return True if concurrent.
+         */
+        [[nodiscard]] bool isConcurrent() const;
+
         /**
          * \brief Get the underlying vulkan image object.
          * \return VulkanImage.
@@ -130,6 +137,19 @@ namespace sol
 
         [[nodiscard]] virtual VkFormat getFormat() const noexcept = 0;
 
+        /**
+         * \brief Get the size of a texel block of the image format. For block-compressed formats, this is the size of
+         * a compressed block.
+         * \return Size in bytes, or 0 if the format is not known.
+         */
+        [[nodiscard]] size_t getTexelBlockSize() const noexcept;
+
+        /**
+         * \brief Returns whether the image format is block-compressed (BC, ETC2, EAC or ASTC).
+         * \return True if block-compressed.
+         */
+        [[nodiscard]] bool isBlockCompressed() const noexcept;
+
         [[nodiscard]] virtual VkImageUsageFlags getImageUsageFlags() const noexcept = 0;
 
         [[nodiscard]] virtual VkImageAspectFlags getImageAspectFlags() const noexcept = 0;
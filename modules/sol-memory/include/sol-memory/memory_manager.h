@@ -29,6 +29,48 @@ namespace sol
     class MemoryManager : public IBufferAllocator
     {
     public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Usage and budget of a single memory heap.
+         */
+        struct HeapBudget
+        {
+            /**
+             * \brief Heap flags.
+             */
+            VkMemoryHeapFlags flags = 0;
+
+            /**
+             * \brief Total size of the heap in bytes.
+             */
+            size_t size = 0;
+
+            /**
+             * \brief Bytes allocated in device memory blocks by this allocator.
+             */
+            size_t blockBytes = 0;
+
+            /**
+             * \brief Bytes occupied by allocations made by this allocator.
+             */
+            size_t allocationBytes = 0;
+
+            /**
+             * \brief Estimated bytes used by the whole process, including other allocators and processes if
+             * VK_EXT_memory_budget is enabled.
+             */
+            size_t usage = 0;
+
+            /**
+             * \brief Estimated bytes available to the process. Allocating more than this may fail or degrade
+             * performance.
+             */
+            size_t budget = 0;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -83,6 +125,12 @@ namespace sol
 
         [[nodiscard]] VulkanQueue& getTransferQueue() const;
 
+        /**
+         * \brief Get the indices of the distinct queue families of the compute, graphics and transfer queues.
+         * \return Sorted list of queue family indices.
+         */
+        [[nodiscard]] std::vector<uint32_t> getQueueFamilyIndices() const;
+
         [[nodiscard]] Capabilities getCapabilities() const noexcept override;
 
         [[nodiscard]] IMemoryPool& getMemoryPool(const std::string& name);
@@ -97,6 +145,27 @@ namespace sol
 
         void setTransferQueue(VulkanQueue& queue);
 
+        /**
+         * \brief Set the sharing mode of VulkanBuffer or VulkanImage settings. A concurrent resource is shared by the
+         * queue families returned by getQueueFamilyIndices. If there is only one such family, there is nothing to
+         * share and the resource is made exclusive instead.
+         * \tparam S VulkanBuffer::Settings or VulkanImage::Settings.
+         * \param settings Settings.
+         * \param sharingMode Requested sharing mode.
+         */
+        template<typename S>
+        void setSharingMode(S& settings, const VkSharingMode sharingMode) const
+        {
+            settings.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+            settings.queueFamilyIndices.clear();
+            if (sharingMode != VK_SHARING_MODE_CONCURRENT) return;
+
+            auto indices = getQueueFamilyIndices();
+            if (indices.size() < 2) return;
+            settings.sharingMode        = VK_SHARING_MODE_CONCURRENT;
+            settings.queueFamilyIndices = std::move(indices);
+        }
+
         ////////////////////////////////////////////////////////////////
         // Allocations.
         ////////////////////////////////////////////////////////////////
@@ -173,6 +242,13 @@ namespace sol
 
         void writeAllocatorStatsToFile(const std::filesystem::path& path) const;
 
+        /**
+         * \brief Get the current usage and budget of each memory heap. Cheap enough to call every frame. Numbers come
+         * from VK_EXT_memory_budget if the device was created with that extension and are estimated otherwise.
+         * \return List of budgets, indexed by heap index.
+         */
+        [[nodiscard]] std::vector<HeapBudget> getHeapBudgets() const;
+
     private:
         ////////////////////////////////////////////////////////////////
         // Initialization.
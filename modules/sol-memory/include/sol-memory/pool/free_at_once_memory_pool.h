@@ -28,6 +28,10 @@
 
 namespace sol
 {
+    /**
+     * \brief Memory pool that linearly suballocates buffers from up to maxBlocks VkBuffers of blockSize bytes.
+     * Memory is only reclaimed once all buffers have been released, after which the pool can be reused.
+     */
     class FreeAtOnceMemoryPool : public IMemoryPool
     {
     public:
@@ -58,6 +62,13 @@ namespace sol
 
         [[nodiscard]] Capabilities getCapabilities() const noexcept override;
 
+        /**
+         * \brief Calculate a histogram of the free ranges in this pool. Since allocations are only ever appended,
+         * each block has a single free range at its end.
+         * \return Histogram.
+         */
+        [[nodiscard]] FreeBlockHistogram getFreeBlockHistogram() override;
+
         ////////////////////////////////////////////////////////////////
         // Allocations.
         ////////////////////////////////////////////////////////////////
@@ -69,14 +80,39 @@ namespace sol
     private:
         void releaseBuffer(const MemoryPoolBuffer& buffer) override;
 
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Block
+        {
+            VulkanBufferPtr buffer;
+
+            VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        };
+
+        /**
+         * \brief Create a new block. Must be called while holding the lock.
+         * \param throwOnOutOfMemory If true, throws when the device is out of memory. Otherwise, returns false.
+         * \return True on success.
+         */
+        [[nodiscard]] bool createBlock(bool throwOnOutOfMemory);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
 
-        std::vector<VulkanBufferPtr> buffers;
+        std::vector<Block> blocks;
+
+        /**
+         * \brief Index of the block that is currently being allocated from.
+         */
+        size_t currentBlock = 0;
 
         std::mutex mutex;
 
+        size_t allocCount = 0;
+
         size_t deallocCount = 0;
     };
 }  // namespace sol
@@ -4,6 +4,8 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <array>
+#include <atomic>
 #include <expected>
 #include <latch>
 #include <string>
@@ -52,6 +54,13 @@ namespace sol
              */
             VkBufferUsageFlags bufferUsage = 0;
 
+            /**
+             * \brief Sharing mode of all buffers allocated from the pool. Concurrent buffers can be accessed by the
+             * compute, graphics and transfer queues without queue family ownership transfers, which is a good fit for
+             * read-mostly data that is uploaded once. See MemoryManager::setSharingMode.
+             */
+            VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
             /**
              * \brief Memory usage flags.
              */
@@ -83,11 +92,90 @@ namespace sol
             size_t minBlocks = 0;
 
             /**
-             * \brief Maximum number of memory blocks.
+             * \brief Maximum number of memory blocks. 0 means unlimited.
              */
             size_t maxBlocks = 0;
         };
 
+        /**
+         * \brief Statistics of a memory pool. Gathered from counters that are updated on allocation and release, so
+         * retrieving them is cheap enough to do every frame.
+         */
+        struct Statistics
+        {
+            /**
+             * \brief Total size in bytes of all buffers that are currently allocated from this pool.
+             */
+            size_t liveBytes = 0;
+
+            /**
+             * \brief Number of buffers that are currently allocated from this pool.
+             */
+            size_t liveAllocations = 0;
+
+            /**
+             * \brief Highest value liveBytes has reached since creation or the last call to resetHighWatermark.
+             */
+            size_t highWatermark = 0;
+
+            /**
+             * \brief Total number of successful allocations since creation.
+             */
+            size_t totalAllocations = 0;
+
+            /**
+             * \brief Number of allocations that failed because the pool was out of memory, either returning an empty
+             * buffer or throwing.
+             */
+            size_t failedAllocations = 0;
+
+            /**
+             * \brief Number of times an allocation had to wait on a latch for memory to be released.
+             */
+            size_t waits = 0;
+
+            /**
+             * \brief Number of device memory blocks allocated by the underlying VmaPool.
+             */
+            size_t blockCount = 0;
+
+            /**
+             * \brief Total size in bytes of the device memory blocks allocated by the underlying VmaPool.
+             */
+            size_t blockBytes = 0;
+        };
+
+        /**
+         * \brief Histogram of the free ranges in a memory pool. Bucket i counts free ranges with a size in
+         * [2^i, 2^(i+1)) bytes.
+         */
+        struct FreeBlockHistogram
+        {
+            std::array<size_t, 64> buckets{};
+
+            /**
+             * \brief Total number of free ranges.
+             */
+            size_t count = 0;
+
+            /**
+             * \brief Total size in bytes of all free ranges.
+             */
+            size_t freeBytes = 0;
+
+            /**
+             * \brief Size in bytes of the largest free range, i.e. the largest allocation that can still succeed
+             * without growing the pool.
+             */
+            size_t largest = 0;
+
+            /**
+             * \brief Add a free range to the histogram.
+             * \param size Size in bytes. Empty ranges are ignored.
+             */
+            void add(size_t size) noexcept;
+        };
+
         struct AllocationInfo
         {
             /**
@@ -137,6 +225,8 @@ namespace sol
 
         [[nodiscard]] VkBufferUsageFlags getBufferUsage() const noexcept;
 
+        [[nodiscard]] VkSharingMode getSharingMode() const noexcept;
+
         [[nodiscard]] VmaMemoryUsage getMemoryUsage() const noexcept;
 
         [[nodiscard]] VkMemoryPropertyFlags getRequiredMemoryFlags() const noexcept;
@@ -151,6 +241,38 @@ namespace sol
 
         [[nodiscard]] size_t getMaxBlocks() const noexcept;
 
+        /**
+         * \brief Get the minimum alignment of suballocations. This is the largest of the memory alignment of a buffer
+         * with the usage flags of this pool and the device offset alignment limits of those usages. Transfer
+         * destinations are aligned to at least 4 bytes, as required by vkCmdFillBuffer and vkCmdUpdateBuffer.
+         * \return Alignment in bytes.
+         */
+        [[nodiscard]] size_t getRequiredAlignment() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Statistics.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Get the statistics of this pool. Does not walk over allocations.
+         * \return Statistics.
+         */
+        [[nodiscard]] Statistics getStatistics() const;
+
+        /**
+         * \brief Calculate a histogram of the free ranges in this pool, to judge fragmentation. Depending on the pool
+         * type, this may have to visit all allocations and should not be done as often as getStatistics. The default
+         * implementation is based on the statistics of the underlying VmaPool, which only report the number of free
+         * ranges, their total size and the largest range. The histogram itself is not available, so all buckets are 0.
+         * \return Histogram.
+         */
+        [[nodiscard]] virtual FreeBlockHistogram getFreeBlockHistogram();
+
+        /**
+         * \brief Reset the high watermark to the current number of live bytes.
+         */
+        void resetHighWatermark() noexcept;
+
         ////////////////////////////////////////////////////////////////
         // Allocations.
         ////////////////////////////////////////////////////////////////
@@ -194,6 +316,18 @@ namespace sol
         [[nodiscard]] MemoryPoolBufferPtr allocateMemoryPoolBuffer(const AllocationInfo& alloc,
                                                                    OnAllocationFailure   onFailure);
 
+        /**
+         * \brief Update statistics for a new buffer. Called by MemoryPoolBuffer on construction.
+         * \param size Buffer size in bytes.
+         */
+        void recordAllocation(size_t size) noexcept;
+
+        /**
+         * \brief Update statistics for a destroyed buffer. Called by MemoryPoolBuffer on destruction.
+         * \param size Buffer size in bytes.
+         */
+        void recordRelease(size_t size) noexcept;
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -202,6 +336,20 @@ namespace sol
 
         CreateInfo info;
 
+        size_t requiredAlignment = 1;
+
+        std::atomic_size_t liveBytes = 0;
+
+        std::atomic_size_t liveAllocations = 0;
+
+        std::atomic_size_t highWatermark = 0;
+
+        std::atomic_size_t totalAllocations = 0;
+
+        std::atomic_size_t failedAllocations = 0;
+
+        std::atomic_size_t waits = 0;
+
     protected:
         VulkanMemoryPoolPtr pool;
     };
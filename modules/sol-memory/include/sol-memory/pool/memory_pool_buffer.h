@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+
 ////////////////////////////////////////////////////////////////
 // Module includes.
 ////////////////////////////////////////////////////////////////
@@ -18,18 +24,38 @@ namespace sol
     class MemoryPoolBuffer : public IBuffer
     {
     public:
+        friend class NonLinearMemoryPool;
+
+        /**
+         * \brief Callback invoked after the buffer was moved to a different VkBuffer and/or offset, e.g. by
+         * defragmentation. Can be used to patch descriptors and vertex bindings that reference the old location.
+         */
+        using RelocationCallback = std::function<void(MemoryPoolBuffer&)>;
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
 
         MemoryPoolBuffer() = delete;
 
+        /**
+         * \brief Construct a buffer. Called by the memory pool.
+         * \param memoryPool Memory pool.
+         * \param queueFamily Queue family.
+         * \param id Identifier.
+         * \param buffer Buffer.
+         * \param bufferSize Buffer size in bytes.
+         * \param bufferOffset Offset in the buffer in bytes.
+         * \param recordStatistics If false, the buffer is not counted in the statistics of the memory pool. Used for
+         * temporary buffers of internal operations such as defragmentation.
+         */
         MemoryPoolBuffer(IMemoryPool&       memoryPool,
                          VulkanQueueFamily& queueFamily,
                          size_t             id,
                          VulkanBuffer&      buffer,
                          size_t             bufferSize,
-                         size_t             bufferOffset);
+                         size_t             bufferOffset,
+                         bool               recordStatistics = true);
 
         MemoryPoolBuffer(const MemoryPoolBuffer&) = delete;
 
@@ -61,7 +87,24 @@ namespace sol
 
         [[nodiscard]] bool isSubAllocation() const noexcept override;
 
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set the callback that is invoked when this buffer is relocated.
+         * \param callback Callback.
+         */
+        void setRelocationCallback(RelocationCallback callback);
+
     private:
+        /**
+         * \brief Move this buffer to a new location and invoke the relocation callback.
+         * \param newBuffer New buffer.
+         * \param newOffset New offset.
+         */
+        void relocate(VulkanBuffer& newBuffer, size_t newOffset);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -75,5 +118,9 @@ namespace sol
         size_t size = 0;
 
         size_t offset = 0;
+
+        bool recorded = true;
+
+        RelocationCallback onRelocate;
     };
 }  // namespace sol
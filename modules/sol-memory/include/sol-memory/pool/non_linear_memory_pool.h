@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -28,9 +29,33 @@
 
 namespace sol
 {
+    /**
+     * \brief Memory pool that suballocates buffers in arbitrary order from up to maxBlocks VkBuffers of blockSize
+     * bytes. Space inside each block is managed by a VmaVirtualBlock.
+     * -
+     *
+     * Optionally, small allocations are served from per-thread caches, see setThreadCache.
+     */
     class NonLinearMemoryPool : public IMemoryPool
     {
     public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct DefragmentationStats
+        {
+            /**
+             * \brief Number of bytes copied in the pass.
+             */
+            size_t bytesMoved = 0;
+
+            /**
+             * \brief Number of buffers moved in the pass.
+             */
+            size_t allocationsMoved = 0;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -58,6 +83,81 @@ namespace sol
 
         [[nodiscard]] Capabilities getCapabilities() const noexcept override;
 
+        /**
+         * \brief Get the number of blocks that are currently allocated.
+         * \return Number of blocks.
+         */
+        [[nodiscard]] size_t getBlockCount();
+
+        /**
+         * \brief Returns whether a defragmentation pass was begun and not yet ended.
+         * \return True if defragmenting.
+         */
+        [[nodiscard]] bool isDefragmenting();
+
+        /**
+         * \brief Get the largest allocation size that is served from the thread caches. 0 if disabled.
+         * \return Size in bytes.
+         */
+        [[nodiscard]] size_t getThreadCacheMaxSize() const noexcept;
+
+        /**
+         * \brief Get the number of slots a thread cache takes from or returns to the shared pool at once.
+         * \return Number of slots.
+         */
+        [[nodiscard]] size_t getThreadCacheBatchSize() const noexcept;
+
+        /**
+         * \brief Calculate a histogram of the free ranges in this pool. Visits all allocations, so this is more
+         * expensive than getStatistics.
+         * \return Histogram.
+         */
+        [[nodiscard]] FreeBlockHistogram getFreeBlockHistogram() override;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Enable per-thread caches for small allocations. Sizes are rounded up to a power of 2 (the size
+         * class), with a minimum of 256 bytes. Each thread keeps a list of free slots per size class, so that
+         * allocating and releasing do not take the lock of the pool. When a list is empty, batchSize slots are taken
+         * from a shared list at once or carved out of a new range of the pool. When a thread holds twice batchSize
+         * free slots, batchSize slots are returned to the shared list.
+         * -
+         *
+         * Ranges used for slots are not moved by defragmentation, and slots cached by a thread that exits are not
+         * reused. Calling this again releases all ranges used for slots. Threads discard their cached slots the next
+         * time they use the pool. Must not be called while there are live allocations.
+         * \param maxSize Largest allocation size that is cached. Rounded up to a power of 2. If 0, caching is
+         * disabled.
+         * \param batchSize Number of slots that are moved between a thread cache and the shared pool at once.
+         * \throws SolError Thrown if maxSize is larger than the block size, batchSize is 0 or there are live
+         * allocations.
+         */
+        void setThreadCache(size_t maxSize, size_t batchSize = 32);
+
+        ////////////////////////////////////////////////////////////////
+        // Defragmentation.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Begin an incremental defragmentation pass. Plans a number of moves of buffers towards the start of
+         * the pool and stages a copy for each move in the transaction. Buffers keep referencing their old location
+         * until endDefragmentation is called. Buffers that are moved must not be destroyed before the pass ends.
+         * \param transaction Transaction in which to stage copies.
+         * \param maxBytes Maximum number of bytes to move in this pass. If 0, there is no limit.
+         * \return Stats.
+         */
+        DefragmentationStats beginDefragmentation(Transaction& transaction, size_t maxBytes = 0);
+
+        /**
+         * \brief End the current defragmentation pass. Should only be called after the transaction passed to
+         * beginDefragmentation has completed. Moves all buffers to their new location, invokes their relocation
+         * callbacks, releases the old memory and destroys trailing empty blocks.
+         */
+        void endDefragmentation();
+
         ////////////////////////////////////////////////////////////////
         // Allocations.
         ////////////////////////////////////////////////////////////////
@@ -69,12 +169,189 @@ namespace sol
     private:
         void releaseBuffer(const MemoryPoolBuffer& buffer) override;
 
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Block
+        {
+            VulkanBufferPtr buffer;
+
+            VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        };
+
+        struct Allocation
+        {
+            size_t block = 0;
+
+            VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+
+            size_t offset = 0;
+
+            size_t size = 0;
+
+            size_t alignment = 1;
+
+            MemoryPoolBuffer* owner = nullptr;
+
+            /**
+             * \brief True while this allocation is being moved by a defragmentation pass.
+             */
+            bool moving = false;
+        };
+
+        /**
+         * \brief Range of a block that was allocated as a whole and carved into slots for the thread caches.
+         */
+        struct Slab
+        {
+            size_t block = 0;
+
+            VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+
+            size_t offset = 0;
+
+            size_t size = 0;
+        };
+
+        /**
+         * \brief Free slot of a size class.
+         */
+        struct Slot
+        {
+            VulkanBuffer* buffer = nullptr;
+
+            size_t offset = 0;
+        };
+
+        /**
+         * \brief Free slots per size class.
+         */
+        using SlotLists = std::vector<std::vector<Slot>>;
+
+        /**
+         * \brief Free slots of a thread.
+         */
+        struct ThreadSlots
+        {
+            /**
+             * \brief Value of cacheGeneration when the slots were taken. Outdated slots are discarded.
+             */
+            size_t generation = 0;
+
+            SlotLists slots;
+        };
+
+        struct Move
+        {
+            /**
+             * \brief Identifier of the buffer that is moved.
+             */
+            size_t id = 0;
+
+            /**
+             * \brief Temporary buffer at the destination location.
+             */
+            MemoryPoolBufferPtr dst;
+        };
+
+        /**
+         * \brief Create a new block. Must be called while holding the lock.
+         * \param throwOnOutOfMemory If true, throws when the device is out of memory. Otherwise, returns false.
+         * \return True on success.
+         */
+        [[nodiscard]] bool createBlock(bool throwOnOutOfMemory);
+
+        /**
+         * \brief Get an unused identifier and resize the list of allocations if needed. Must be called while holding
+         * the lock.
+         * \return Identifier.
+         */
+        [[nodiscard]] size_t getFreeId();
+
+        /**
+         * \brief Allocate a range from the first block that has room, creating a new block if needed. Must be called
+         * while holding the lock.
+         * \param info Virtual allocation info.
+         * \param throwOnOutOfMemory If true, throws when the device is out of memory. Otherwise, returns false.
+         * \param blockIndex Index of the block the range was allocated from.
+         * \param virtualAllocation Virtual allocation.
+         * \param offset Offset of the range in the block.
+         * \return True on success.
+         */
+        [[nodiscard]] bool allocateRange(const VmaVirtualAllocationCreateInfo& info,
+                                         bool                                  throwOnOutOfMemory,
+                                         size_t&                               blockIndex,
+                                         VmaVirtualAllocation&                 virtualAllocation,
+                                         VkDeviceSize&                         offset);
+
+        /**
+         * \brief Get the free slots of the calling thread. Slots from before the last call to setThreadCache are
+         * discarded.
+         * \return Free slots per size class.
+         */
+        [[nodiscard]] SlotLists& getThreadCache() const;
+
+        /**
+         * \brief Refill the free slots of a size class of the calling thread, first from the shared list and
+         * otherwise from a new slab.
+         * \param sizeClass Size class.
+         * \param slots Free slots of the calling thread.
+         * \param throwOnOutOfMemory If true, throws when the device is out of memory. Otherwise, returns false.
+         * \return True on success.
+         */
+        [[nodiscard]] bool refillThreadCache(size_t sizeClass, std::vector<Slot>& slots, bool throwOnOutOfMemory);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
 
-        std::vector<VulkanBufferPtr> buffers;
+        std::vector<Block> blocks;
+
+        /**
+         * \brief Allocations, indexed by buffer identifier. Unused entries have a null allocation.
+         */
+        std::vector<Allocation> allocations;
+
+        /**
+         * \brief Unused identifiers in the allocations list.
+         */
+        std::vector<size_t> freeIds;
+
+        /**
+         * \brief Moves of the current defragmentation pass.
+         */
+        std::vector<Move> moves;
+
+        bool defragmenting = false;
 
         std::mutex mutex;
+
+        /**
+         * \brief Unique identifier of this pool, used to look up the thread caches. Unlike the address of the pool, it
+         * is never reused.
+         */
+        size_t uid = 0;
+
+        size_t threadCacheMaxSize = 0;
+
+        size_t threadCacheBatchSize = 0;
+
+        /**
+         * \brief Incremented by each call to setThreadCache, so that threads can detect that their slots are outdated.
+         */
+        std::atomic_size_t cacheGeneration = 0;
+
+        /**
+         * \brief Slabs carved into slots for the thread caches. Protected by mutex.
+         */
+        std::vector<Slab> slabs;
+
+        /**
+         * \brief Free slots that were returned by thread caches. Protected by sharedSlotsMutex.
+         */
+        SlotLists sharedSlots;
+
+        std::mutex sharedSlotsMutex;
     };
 }  // namespace sol
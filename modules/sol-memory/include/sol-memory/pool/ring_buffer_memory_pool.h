@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <deque>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -29,6 +30,15 @@
 
 namespace sol
 {
+    /**
+     * \brief Memory pool that suballocates from a single VkBuffer of blockSize bytes in FIFO order. Allocating
+     * only bumps a head offset. Memory is reclaimed by advancing a tail offset once the oldest allocations have been
+     * released. Buffers that are released out of order only free up space after all older buffers are released.
+     * -
+     *
+     * Allocations are aligned to the least common multiple of the requested alignment and getRequiredAlignment, so
+     * that alignments that are not a power of 2, such as the texel block size of 3-component formats, are supported.
+     */
     class RingBufferMemoryPool : public IMemoryPool
     {
     public:
@@ -59,6 +69,26 @@ namespace sol
 
         [[nodiscard]] Capabilities getCapabilities() const noexcept override;
 
+        /**
+         * \brief Get the buffer all allocations are made from.
+         * \return VulkanBuffer.
+         */
+        [[nodiscard]] VulkanBuffer& getBuffer() noexcept;
+
+        /**
+         * \brief Get the buffer all allocations are made from.
+         * \return VulkanBuffer.
+         */
+        [[nodiscard]] const VulkanBuffer& getBuffer() const noexcept;
+
+        /**
+         * \brief Calculate a histogram of the free ranges in this pool. There are at most two free ranges, one after
+         * the head and one before the tail. Space held by released buffers that are not yet reclaimed does not count
+         * as free.
+         * \return Histogram.
+         */
+        [[nodiscard]] FreeBlockHistogram getFreeBlockHistogram() override;
+
         ////////////////////////////////////////////////////////////////
         // Allocations.
         ////////////////////////////////////////////////////////////////
@@ -70,11 +100,45 @@ namespace sol
     private:
         void releaseBuffer(const MemoryPoolBuffer& buffer) override;
 
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Allocation
+        {
+            size_t offset = 0;
+
+            size_t size = 0;
+
+            bool released = false;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
 
-        std::vector<VulkanBufferPtr> buffers;
+        VulkanBufferPtr ringBuffer;
+
+        /**
+         * \brief Live allocations, in allocation order. Released allocations are kept until all older allocations are
+         * released as well.
+         */
+        std::deque<Allocation> allocations;
+
+        /**
+         * \brief Identifier of the allocation at the front of the deque.
+         */
+        size_t firstId = 0;
+
+        /**
+         * \brief Offset at which the next allocation is placed.
+         */
+        size_t head = 0;
+
+        /**
+         * \brief Offset of the oldest live allocation.
+         */
+        size_t tail = 0;
 
         std::vector<std::latch*> latches;
 
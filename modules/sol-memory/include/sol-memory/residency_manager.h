@@ -0,0 +1,285 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/fwd.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+#include "sol-memory/i_buffer_allocator.h"
+
+namespace sol
+{
+    /**
+     * \brief Keeps the device memory used by registered resources within a budget. Each resource has a priority and
+     * the index of the frame in which it was last used. When the budget is exceeded, resources with the lowest
+     * priority that were least recently used are evicted: their contents are downloaded into a host-side backing
+     * copy and their device memory is released. When an evicted resource is touched again, it is reallocated and its
+     * contents are uploaded through a Transaction.
+     * -
+     *
+     * By default, the budget is a fraction of the budget of all device local heaps reported by MemoryManager,
+     * which is accurate if the device was created with VK_EXT_memory_budget. Alternatively, an explicit budget for
+     * the registered resources can be set.
+     */
+    class ResidencyManager
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        using Handle = size_t;
+
+        /**
+         * \brief Description of a resource and the functions to move it out of and back into device memory.
+         */
+        struct Resource
+        {
+            /**
+             * \brief Size of the resource contents in bytes. This is also the size of the backing copy.
+             */
+            size_t size = 0;
+
+            /**
+             * \brief Resources with a lower priority are evicted first.
+             */
+            uint32_t priority = 0;
+
+            /**
+             * \brief Stage a copy of the contents of the resource to the range [0, size) of the destination buffer.
+             * The destination is host visible and read on the host once the transaction completes.
+             */
+            std::function<void(Transaction& transaction, IBuffer& dstBuffer)> download;
+
+            /**
+             * \brief Release the device memory of the resource.
+             */
+            std::function<void()> release;
+
+            /**
+             * \brief Allocate device memory for the resource again and stage an upload of size bytes of data. Returns
+             * false if allocating device or staging memory failed.
+             */
+            std::function<bool(Transaction& transaction, const void* data)> restore;
+        };
+
+        struct Statistics
+        {
+            /**
+             * \brief Number of registered resources that are resident.
+             */
+            size_t residentCount = 0;
+
+            /**
+             * \brief Bytes of registered resources that are resident.
+             */
+            size_t residentBytes = 0;
+
+            /**
+             * \brief Number of registered resources that are evicted.
+             */
+            size_t evictedCount = 0;
+
+            /**
+             * \brief Bytes of registered resources that are evicted and held in host memory.
+             */
+            size_t evictedBytes = 0;
+
+            /**
+             * \brief Total number of evictions.
+             */
+            size_t evictions = 0;
+
+            /**
+             * \brief Total number of restores.
+             */
+            size_t restores = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        ResidencyManager() = delete;
+
+        /**
+         * \brief Construct a new ResidencyManager.
+         * \param memoryManager MemoryManager.
+         * \param transactionManager TransactionManager used to download the contents of evicted resources.
+         */
+        ResidencyManager(MemoryManager& memoryManager, TransactionManager& transactionManager);
+
+        ResidencyManager(const ResidencyManager&) = delete;
+
+        ResidencyManager(ResidencyManager&&) noexcept = delete;
+
+        ~ResidencyManager() noexcept;
+
+        ResidencyManager& operator=(const ResidencyManager&) = delete;
+
+        ResidencyManager& operator=(ResidencyManager&&) noexcept = delete;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] MemoryManager& getMemoryManager() noexcept;
+
+        [[nodiscard]] const MemoryManager& getMemoryManager() const noexcept;
+
+        [[nodiscard]] TransactionManager& getTransactionManager() noexcept;
+
+        [[nodiscard]] const TransactionManager& getTransactionManager() const noexcept;
+
+        /**
+         * \brief Get the budget in bytes. Either the explicit budget, or the budget fraction of the budget of all
+         * device local heaps.
+         * \return Budget in bytes.
+         */
+        [[nodiscard]] size_t getBudget() const;
+
+        /**
+         * \brief Get the usage that is compared against the budget. Either the bytes of resident registered
+         * resources if an explicit budget was set, or the usage of all device local heaps.
+         * \return Usage in bytes.
+         */
+        [[nodiscard]] size_t getUsage() const;
+
+        [[nodiscard]] float getBudgetFraction() const noexcept;
+
+        [[nodiscard]] bool isResident(Handle handle) const;
+
+        [[nodiscard]] uint64_t getLastUsedFrame(Handle handle) const;
+
+        [[nodiscard]] Statistics getStatistics() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set an explicit budget for the registered resources.
+         * \param bytes Budget in bytes. If 0, the budget is derived from the heap budgets again.
+         */
+        void setBudget(size_t bytes) noexcept;
+
+        /**
+         * \brief Set the fraction of the device local heap budgets that can be used before resources are evicted.
+         * Leaves headroom for allocations that are not registered, such as staging buffers.
+         * \param fraction Fraction in (0, 1].
+         * \throws SolError Thrown if fraction is not in (0, 1].
+         */
+        void setBudgetFraction(float fraction);
+
+        void setPriority(Handle handle, uint32_t priority);
+
+        ////////////////////////////////////////////////////////////////
+        // Resources.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Register a resource. The resource is assumed to be resident.
+         * \param resource Resource.
+         * \throws SolError Thrown if any of the functions is empty.
+         * \return Handle.
+         */
+        [[nodiscard]] Handle add(Resource resource);
+
+        /**
+         * \brief Register a buffer. On eviction, the buffer is destroyed. On restore, a new buffer is allocated with
+         * the same allocation info. The pointer must stay valid as long as the buffer is registered, and users must
+         * access the buffer through it to see the restored buffer.
+         * \param buffer Buffer. Must have been allocated with info.
+         * \param allocator Allocator the buffer was allocated from.
+         * \param info Allocation info.
+         * \param priority Priority.
+         * \return Handle.
+         */
+        [[nodiscard]] Handle addBuffer(IBufferPtr&                             buffer,
+                                       IBufferAllocator&                       allocator,
+                                       const IBufferAllocator::AllocationInfo& info,
+                                       uint32_t                                priority = 0);
+
+        /**
+         * \brief Unregister a resource. An evicted resource is not restored and its backing copy is discarded.
+         * \param handle Handle.
+         */
+        void remove(Handle handle);
+
+        /**
+         * \brief Mark a resource as used in a frame. If it was evicted, its contents are restored through the
+         * transaction. Should be called before recording commands that use the resource.
+         * \param transaction Transaction to stage the upload to.
+         * \param handle Handle.
+         * \param frame Frame index.
+         * \return True if the resource is resident or could be restored. On failure, the resource remains evicted
+         * and the transaction should be committed before trying again.
+         */
+        [[nodiscard]] bool touch(Transaction& transaction, Handle handle, uint64_t frame);
+
+        /**
+         * \brief Evict resources until the usage is within the budget. Resources used in the given frame are never
+         * evicted. Downloads are done in a single transaction that is committed and waited on.
+         * \param frame Current frame index.
+         * \return Number of bytes evicted.
+         */
+        size_t enforceBudget(uint64_t frame);
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Entry
+        {
+            Resource resource;
+
+            uint64_t lastUsed = 0;
+
+            bool registered = false;
+
+            bool resident = true;
+
+            /**
+             * \brief Contents of an evicted resource.
+             */
+            std::vector<std::byte> backing;
+        };
+
+        [[nodiscard]] Entry& getEntry(Handle handle);
+
+        [[nodiscard]] const Entry& getEntry(Handle handle) const;
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        MemoryManager* memoryManager = nullptr;
+
+        TransactionManager* transactionManager = nullptr;
+
+        size_t budget = 0;
+
+        float budgetFraction = 0.9f;
+
+        std::vector<Entry> entries;
+
+        std::vector<Handle> freeHandles;
+
+        Statistics statistics;
+    };
+}  // namespace sol
@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <cstddef>
 #include <optional>
 #include <vector>
 
@@ -24,6 +25,7 @@
 ////////////////////////////////////////////////////////////////
 
 #include "sol-memory/fwd.h"
+#include "sol-memory/transaction_handle.h"
 
 namespace sol
 {
@@ -37,7 +39,13 @@ namespace sol
         /**
          * \brief Place barrier after copies.
          */
-        AfterCopy = 1
+        AfterCopy = 1,
+
+        /**
+         * \brief Place barrier directly after inline updates and image clears, in the same command buffer on the
+         * queue family that owns the resource.
+         */
+        AfterUpdate = 2
     };
 
     /**
@@ -79,6 +87,17 @@ namespace sol
          * \brief Destination access.
          */
         VkAccessFlags2 dstAccess = VK_ACCESS_2_NONE;
+
+        /**
+         * \brief Start of the range covered by the barrier, relative to the start of the buffer.
+         */
+        size_t offset = 0;
+
+        /**
+         * \brief Size of the range covered by the barrier. If VK_WHOLE_SIZE, the barrier covers the remainder of the
+         * buffer. Barriers that transfer queue family ownership always cover the whole buffer.
+         */
+        size_t size = VK_WHOLE_SIZE;
     };
 
     /**
@@ -310,14 +329,155 @@ namespace sol
         bool dstOnDedicatedTransfer = false;
     };
 
+    /**
+     * \brief Describes a region that is copied between two images.
+     */
+    struct ImageCopyRegion
+    {
+        /**
+         * \brief Image aspect flags.
+         */
+        VkImageAspectFlags aspectMask = 0;
+
+        /**
+         * \brief Mip level of the source image.
+         */
+        uint32_t srcMipLevel = 0;
+
+        /**
+         * \brief First array layer of the source image.
+         */
+        uint32_t srcBaseArrayLayer = 0;
+
+        /**
+         * \brief Mip level of the destination image.
+         */
+        uint32_t dstMipLevel = 0;
+
+        /**
+         * \brief First array layer of the destination image.
+         */
+        uint32_t dstBaseArrayLayer = 0;
+
+        /**
+         * \brief Number of layers.
+         */
+        uint32_t layerCount = 0;
+
+        /**
+         * \brief Offset of the region in the source image.
+         */
+        std::array<int32_t, 3> srcOffset{};
+
+        /**
+         * \brief Offset of the region in the destination image.
+         */
+        std::array<int32_t, 3> dstOffset{};
+
+        /**
+         * \brief Extent of the region.
+         */
+        std::array<uint32_t, 3> extent{};
+    };
+
+    /**
+     * \brief Describes a copy from a source image to a destination image.
+     */
     struct ImageToImageCopy
     {
-        // Note: Not yet implemented.
+        /**
+         * \brief Source image.
+         */
+        IImage& srcImage;
+
+        /**
+         * \brief Destination image.
+         */
+        IImage& dstImage;
+
+        /**
+         * \brief List of regions describing the parts of the images that are copied. Regions should not overlap with one another.
+         */
+        std::vector<ImageCopyRegion> regions;
+
+        /**
+         * \brief If there is an explicit image barrier, transfer ownership of the source image to the transfer
+         * queue before doing the copy.
+         * -
+         *
+         * If no explicit destination queue is specified in the barrier, ownership will go from the current owner
+         * to the transfer queue before the copy, and back to the current owner after the copy.
+         * -
+         *
+         * With an explicit destination queue, ownership will go from the current owner to the transfer queue
+         * before the copy, and to the destination queue after the copy.
+         */
+        bool srcOnDedicatedTransfer = false;
+
+        /**
+         * \brief If there is an explicit image barrier, transfer ownership of the destination image to the
+         * transfer queue before doing the copy.
+         * -
+         *
+         * If no explicit barrier with a destination queue is specified, ownership will go from the current owner
+         * to the transfer queue before the copy, and back to the current owner after the copy.
+         * -
+         *
+         * With an explicit destination queue, ownership will go from the current owner to the transfer queue
+         * before the copy, and to the destination queue after the copy.
+         */
+        bool dstOnDedicatedTransfer = false;
     };
 
+    /**
+     * \brief Describes a copy from a source buffer to a destination image.
+     */
     struct BufferToImageCopy
     {
-        // Note: Not yet implemented.
+        /**
+         * \brief Source buffer.
+         */
+        IBuffer& srcBuffer;
+
+        /**
+         * \brief Destination image.
+         */
+        IImage& dstImage;
+
+        /**
+         * \brief List of regions describing the parts of the image that are copied. The dataOffset of each region is
+         * an offset into the source buffer, which is added to srcBuffer.getBufferOffset() if it is a suballocation.
+         * Regions should not overlap with one another.
+         */
+        std::vector<ImageRegion> regions;
+
+        /**
+         * \brief If there is an explicit memory barrier, transfer ownership of the source buffer to the transfer
+         * queue before doing the copy.
+         * -
+         *
+         * If no explicit destination queue is specified in the barrier, ownership will go from the current owner
+         * to the transfer queue before the copy, and back to the current owner after the copy.
+         * -
+         *
+         * With an explicit destination queue, ownership will go from the current owner to the transfer queue
+         * before the copy, and to the destination queue after the copy.
+         */
+        bool srcOnDedicatedTransfer = false;
+
+        /**
+         * \brief If there is an explicit image barrier, transfer ownership of the destination image to the
+         * transfer queue before doing the copy.
+         * -
+         *
+         * If no explicit barrier with a destination queue is specified, ownership will go from the current owner
+         * to the transfer queue before the copy, and back to the current owner after the copy.
+         * -
+         *
+         * With an explicit destination queue, ownership will go from the current owner to the transfer queue
+         * before the copy, and to the destination queue after the copy.
+         */
+        bool dstOnDedicatedTransfer = false;
     };
 
     struct ImageToBufferCopy
@@ -352,9 +512,143 @@ namespace sol
         bool dstOnDedicatedTransfer = false;
     };
 
+    /**
+     * \brief Describes a fill of a range of a buffer with a repeated 4 byte value.
+     */
+    struct BufferFill
+    {
+        /**
+         * \brief Destination buffer.
+         */
+        IBuffer& dstBuffer;
+
+        /**
+         * \brief Value that is repeated over the range.
+         */
+        uint32_t data = 0;
+
+        /**
+         * \brief Size of the fill in bytes. Must be a multiple of 4. If set to VK_WHOLE_SIZE, the remainder of
+         * the buffer starting at offset is filled, rounded down to a multiple of 4.
+         */
+        size_t size = VK_WHOLE_SIZE;
+
+        /**
+         * \brief Offset into destination buffer. Is added to dstBuffer.getBufferOffset() if it is a suballocation.
+         * The sum must be a multiple of 4.
+         */
+        size_t offset = 0;
+
+        /**
+         * \brief If there is an explicit memory barrier, transfer ownership of the destination buffer to the
+         * transfer queue before doing the fill. See StagingBufferCopy::dstOnDedicatedTransfer.
+         */
+        bool dstOnDedicatedTransfer = false;
+    };
+
+    /**
+     * \brief Describes a clear of subresource ranges of an image to a constant value.
+     */
+    struct ImageClear
+    {
+        /**
+         * \brief Destination image.
+         */
+        IImage& dstImage;
+
+        /**
+         * \brief Value used for ranges with the color aspect.
+         */
+        VkClearColorValue color{};
+
+        /**
+         * \brief Value used for ranges with the depth and/or stencil aspect.
+         */
+        VkClearDepthStencilValue depthStencil{};
+
+        /**
+         * \brief List of subresource ranges that are cleared. Each range must either have only the color aspect, or
+         * only depth and/or stencil aspects.
+         */
+        std::vector<VkImageSubresourceRange> ranges;
+    };
+
     class Transaction
     {
     public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Maximum size of a staging copy that is recorded inline, as imposed by vkCmdUpdateBuffer.
+         */
+        static constexpr size_t inlineUpdateSize = 65536;
+
+        /**
+         * \brief Statistics about the commands that were recorded on commit.
+         */
+        struct Stats
+        {
+            /**
+             * \brief Number of copies that were staged.
+             */
+            size_t stagedCopies = 0;
+
+            /**
+             * \brief Number of staging copies that were written directly into a host visible destination buffer,
+             * instead of going through a staging buffer and copy command. Not included in stagedCopies.
+             */
+            size_t directWrites = 0;
+
+            /**
+             * \brief Number of staging copies that were recorded inline with vkCmdUpdateBuffer on the queue family
+             * that owns the destination buffer. Not included in stagedCopies.
+             */
+            size_t inlineUpdates = 0;
+
+            /**
+             * \brief Number of buffer fills that were recorded.
+             */
+            size_t fills = 0;
+
+            /**
+             * \brief Number of image clear commands that were recorded.
+             */
+            size_t clears = 0;
+
+            /**
+             * \brief Number of copy commands that were recorded. Copies between the same source and destination are
+             * grouped into a single command.
+             */
+            size_t copyCommands = 0;
+
+            /**
+             * \brief Total number of regions over all copy commands.
+             */
+            size_t copyRegions = 0;
+
+            /**
+             * \brief Number of buffer memory barriers that were recorded, after merging.
+             */
+            size_t bufferBarriers = 0;
+
+            /**
+             * \brief Number of image memory barriers that were recorded, after merging.
+             */
+            size_t imageBarriers = 0;
+
+            /**
+             * \brief Number of pipeline barrier commands that were recorded.
+             */
+            size_t barrierCommands = 0;
+
+            /**
+             * \brief Number of queue submits.
+             */
+            size_t submits = 0;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -396,21 +690,99 @@ namespace sol
          */
         [[nodiscard]] const std::vector<uint64_t>& getSemaphoreValues() const;
 
+        /**
+         * \brief Returns whether barriers placed around buffer copies are narrowed to the copied range.
+         * \return True if narrowing.
+         */
+        [[nodiscard]] bool getNarrowBarriers() const noexcept;
+
+        /**
+         * \brief Returns whether staging copies to host visible destination buffers are written directly.
+         * \return True if direct writes are enabled.
+         */
+        [[nodiscard]] bool getDirectWrite() const noexcept;
+
+        /**
+         * \brief Returns whether small staging copies are recorded inline.
+         * \return True if inline updates are enabled.
+         */
+        [[nodiscard]] bool getInlineUpdates() const noexcept;
+
+        /**
+         * \brief Returns whether no barriers, copies, fills, inline updates or clears were staged. Direct writes
+         * are not recorded and do not count.
+         * \return True if there is nothing to commit.
+         */
+        [[nodiscard]] bool isEmpty() const noexcept;
+
+        /**
+         * \brief Get statistics about the commands that were recorded. Can only be called after committing.
+         * \return Stats.
+         */
+        [[nodiscard]] const Stats& getStats() const;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief If enabled, the barriers that are placed around buffer copies only cover the range that is copied,
+         * instead of the whole buffer. Barriers that transfer queue family ownership are never narrowed. Only applies
+         * to copies that are staged after calling this method.
+         * \param value Enable narrowing.
+         */
+        void setNarrowBarriers(bool value);
+
+        /**
+         * \brief If enabled, staging copies to a destination buffer that was allocated from host visible memory (e.g.
+         * on integrated GPUs or with resizable BAR) skip the staging buffer and copy command. Instead, the data is
+         * written into the destination during the call to stage and flushed if the memory is not host coherent.
+         * Since the write happens immediately, the destination range must not be in use by the device at that
+         * point. Copies whose barrier transfers ownership to another queue family always go through a staging buffer,
+         * since a host write cannot be released by a queue. Defaults to the value of
+         * TransactionManager::getDirectWrite. Only applies to copies that are staged after calling this method.
+         * \param value Enable direct writes.
+         */
+        void setDirectWrite(bool value);
+
+        /**
+         * \brief If enabled, staging copies of at most inlineUpdateSize bytes whose size and offset are a multiple of
+         * 4 skip the staging buffer and the dedicated transfer queue. Instead, the data is copied into the
+         * transaction and recorded with vkCmdUpdateBuffer in a command buffer on the queue family that owns the
+         * destination buffer, together with the barriers around it. This avoids the ownership transfers to and from
+         * the transfer queue and the semaphore waits between them. dstOnDedicatedTransfer is ignored for these
+         * copies. Direct writes take precedence. Defaults to the value of TransactionManager::getInlineUpdates. Only
+         * applies to copies that are staged after calling this method.
+         * \param value Enable inline updates.
+         */
+        void setInlineUpdates(bool value);
+
         ////////////////////////////////////////////////////////////////
         // Staging.
         ////////////////////////////////////////////////////////////////
 
         /**
          * \brief Stage a buffer barrier.
+         * -
+         *
+         * A concurrent buffer (see IBuffer::isConcurrent) is never transferred between queue families. Instead, the
+         * barrier is recorded only on the queue family that performs the operation: dstFamily for BeforeCopy and
+         * srcFamily otherwise. Stages that family does not support are replaced by ALL_COMMANDS. Around copies on
+         * the transfer queue, this means the barriers are recorded into the copy command buffer and a single submit
+         * remains. Work on other queues that uses the buffer is not ordered by these barriers, so it must not overlap
+         * the transaction and must wait on its semaphore values afterwards.
          * \param barrier Barrier.
-         * \param location Where to place the barrier, if a separate copy on the same buffer is being staged.
+         * \param location Where to place the barrier, if a separate copy on the same buffer is being staged. With
+         * AfterUpdate, the barrier is recorded on srcFamily (or the current owner).
          */
         void stage(BufferBarrier barrier, BarrierLocation location);
 
         /**
-         * \brief Stage an image barrier.
+         * \brief Stage an image barrier. Barriers on concurrent images are handled in the same way as in
+         * stage(BufferBarrier, BarrierLocation), but layout transitions still take place.
          * \param barrier Barrier.
-         * \param location Where to place the barrier, if a separate copy on the same image is being staged.
+         * \param location Where to place the barrier, if a separate copy on the same image is being staged. With
+         * AfterUpdate, the barrier is recorded on srcFamily (or the current owner).
          */
         void stage(ImageBarrier barrier, BarrierLocation location);
 
@@ -425,6 +797,17 @@ namespace sol
          * require any staging buffer allocations.
          * -
          *
+         * If direct writes are enabled and the destination buffer is host visible, the data is instead written into
+         * the destination buffer immediately and no staging buffer is allocated. With an explicit barrier, only an
+         * after barrier is placed, which takes the host stage as the first scope and the barrier.dst values for the
+         * second scope.
+         * -
+         *
+         * If inline updates are enabled and the copy is small enough, no staging buffer is allocated either. The copy
+         * is recorded with vkCmdUpdateBuffer on the queue family that owns the destination buffer, see
+         * setInlineUpdates.
+         * -
+         *
          * If there is no explicit barrier, it is assumed that manually placed barriers before and/or after the copy
          * will take care of any required synchronization. No automatic barriers are placed.
          * -
@@ -504,6 +887,52 @@ namespace sol
                    const std::optional<BufferBarrier>& srcBarrier = {},
                    const std::optional<BufferBarrier>& dstBarrier = {});
 
+        /**
+         * \brief Stage a copy from a source image to a destination image. Optionally places barriers around the
+         * copy.
+         * -
+         *
+         * If there are no explicit barriers, it is assumed that manually placed barriers before and/or after the copy
+         * will take care of any required synchronization. No automatic barriers are placed.
+         * -
+         *
+         * With explicit barriers, the supplied parameters are used to place two barriers around the copy command for
+         * the source and/or destination image. The before barrier takes the barrier.src values for the first scope
+         * and the transfer stage as the second scope, and transitions the image to the transfer layout. The after
+         * barrier takes the transfer stage as the first scope and the barrier.dst values for the second scope, and
+         * transitions the image to barrier.dstLayout. Note that if the copy is only for part of the image, both
+         * barriers still apply to the levels and layers described by the barrier.
+         * \param copy Copy.
+         * \param srcBarrier Optional explicit image barrier for the source image.
+         * \param dstBarrier Optional explicit image barrier for the destination image.
+         */
+        void stage(const ImageToImageCopy&            copy,
+                   const std::optional<ImageBarrier>& srcBarrier = {},
+                   const std::optional<ImageBarrier>& dstBarrier = {});
+
+        /**
+         * \brief Stage a copy from a source buffer to a destination image. Optionally places barriers around the
+         * copy.
+         * -
+         *
+         * If there are no explicit barriers, it is assumed that manually placed barriers before and/or after the copy
+         * will take care of any required synchronization. No automatic barriers are placed.
+         * -
+         *
+         * With explicit barriers, the supplied parameters are used to place two barriers around the copy command for
+         * the source buffer and/or destination image. The before barrier takes the barrier.src values for the first
+         * scope and the transfer stage as the second scope. The after barrier takes the transfer stage as the first
+         * scope and the barrier.dst values for the second scope. Note that if the copy is only for part of the
+         * buffer/image, both barriers still apply to the whole buffer and the levels and layers described by the
+         * image barrier.
+         * \param copy Copy.
+         * \param srcBarrier Optional explicit memory barrier for the source buffer.
+         * \param dstBarrier Optional explicit image barrier for the destination image.
+         */
+        void stage(const BufferToImageCopy&            copy,
+                   const std::optional<BufferBarrier>& srcBarrier = {},
+                   const std::optional<ImageBarrier>&  dstBarrier = {});
+
         /**
          * \brief Stage a copy from a source image to a destination buffer. Optionally places barriers around the
          * copy.
@@ -526,18 +955,62 @@ namespace sol
                    const std::optional<ImageBarrier>&  srcBarrier = {},
                    const std::optional<BufferBarrier>& dstBarrier = {});
 
+        /**
+         * \brief Stage a fill of a buffer range with a constant value. Optionally places a memory barrier around the
+         * fill. Needs no staging memory.
+         * -
+         *
+         * The fill is recorded with vkCmdFillBuffer on the transfer queue, before all copies. If there are both fills
+         * and copies, a memory barrier is placed between them, so that a copy can overwrite part of a filled range.
+         * Barriers and ownership transfers are handled as for a StagingBufferCopy.
+         * \param fill Fill.
+         * \param barrier Optional explicit barrier placed around the fill command.
+         * \throws SolError Thrown if the size or offset is not a multiple of 4.
+         */
+        void stage(const BufferFill& fill, const std::optional<BufferBarrier>& barrier = {});
+
+        /**
+         * \brief Stage a clear of an image. Optionally places an image barrier around the clear. Needs no staging
+         * memory.
+         * -
+         *
+         * vkCmdClearColorImage and vkCmdClearDepthStencilImage are not supported on dedicated transfer queues.
+         * Instead, the clear is recorded on the queue family that owns the image (barrier.srcFamily, if set), in the
+         * same command buffer as the barriers around it. The image must be in the transfer destination layout at
+         * that point, which the before barrier takes care of. The after barrier takes the transfer stage as the first
+         * scope and the barrier.dst values for the second scope, and can transfer ownership to barrier.dstFamily.
+         * \param clear Clear.
+         * \param barrier Optional explicit image barrier placed around the clear command.
+         * \throws SolError Thrown if the queue family does not support clearing the aspects of a range.
+         */
+        void stage(const ImageClear& clear, const std::optional<ImageBarrier>& barrier = {});
+
         ////////////////////////////////////////////////////////////////
         // Commit.
         ////////////////////////////////////////////////////////////////
 
         /**
-         * \brief Commit this transaction. Will wait for previously committed transactions to complete
-         * and then record and submit command buffers.
+         * \brief Commit this transaction. Acquires a free slot from the manager, only waiting for a previously
+         * committed transaction to complete if all slots are in use, and then records and submits command buffers.
+         * Copies between the same source and destination are recorded as a single multi-region command, and barriers
+         * on the same resource are merged. Barriers that would be submitted on the transfer queue directly before or
+         * after the copies are recorded into the copy command buffer instead of being submitted separately.
          */
         void commit();
 
         /**
-         * \brief Do a CPU-side wait on the semaphores. Can only be called after committing.
+         * \brief Commit this transaction and hand its staging buffers over to the manager, which releases them as
+         * soon as it observes the transaction has completed. Recording and submitting happens on the calling thread
+         * and only waits on the GPU if all slots of the manager are in use. The returned handle can be used to poll
+         * for completion or to register callbacks. Afterwards, calling wait() on this transaction is still allowed and
+         * invalidates host visible destinations. Waiting on the handle does not.
+         * \return Completion handle.
+         */
+        [[nodiscard]] TransactionHandle commitAsync();
+
+        /**
+         * \brief Do a CPU-side wait on the semaphores. Can only be called after committing. Afterwards, the results
+         * of copies to host visible destination buffers are invalidated, so that they can be read on the host.
          * For GPU-side waiting, you can directly retrieve the final state of the semaphores using getSemaphoreValues().
          */
         void wait();
@@ -547,12 +1020,87 @@ namespace sol
         void requireNotCommitted() const;
 
     private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Staging copy that is recorded with vkCmdUpdateBuffer in the pre-copy acquire command buffer of the
+         * queue family that owns the destination buffer.
+         */
+        struct InlineUpdate
+        {
+            IBuffer* buffer = nullptr;
+
+            const VulkanQueueFamily* family = nullptr;
+
+            /**
+             * \brief Offset into the destination buffer, including the suballocation offset.
+             */
+            size_t offset = 0;
+
+            /**
+             * \brief Offset into inlineData.
+             */
+            size_t dataOffset = 0;
+
+            size_t size = 0;
+        };
+
+        /**
+         * \brief Move all staging buffers out of the staged copies. The copies themselves are kept.
+         * \return Staging buffers.
+         */
+        [[nodiscard]] std::vector<IBufferPtr> takeStagingBuffers();
+
+        /**
+         * \brief Write the data of a staging copy directly into the host visible destination buffer.
+         * \param copy Copy.
+         */
+        void writeDirect(const StagingBufferCopy& copy) const;
+
+        /**
+         * \brief Returns whether a staging copy can be written directly into the destination buffer.
+         * \param copy Copy.
+         * \param barrier Optional barrier around the copy.
+         * \return True if direct writes are enabled, the destination is host visible and the barrier does not transfer
+         * ownership.
+         */
+        [[nodiscard]] bool canWriteDirect(const StagingBufferCopy&            copy,
+                                          const std::optional<BufferBarrier>& barrier) const;
+
+        /**
+         * \brief Returns whether a staging copy can be recorded inline.
+         * \param copy Copy.
+         * \return True if inline updates are enabled and the size and offset of the copy are valid for
+         * vkCmdUpdateBuffer.
+         */
+        [[nodiscard]] bool canUpdateInline(const StagingBufferCopy& copy) const;
+
+        /**
+         * \brief Copy the data of a staging copy into the transaction and stage the barriers around it on the queue
+         * family that owns the destination buffer.
+         * \param copy Copy.
+         * \param barrier Optional explicit barrier.
+         */
+        void stageInline(const StagingBufferCopy& copy, const std::optional<BufferBarrier>& barrier);
+
+        /**
+         * \brief Invalidate the host visible destination buffers of all fills, inline updates and copies to buffers.
+         */
+        void invalidateDestinations() const;
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
 
         TransactionManager* manager = nullptr;
 
+        /**
+         * \brief Index of the TransactionManager slot this transaction was submitted through.
+         */
+        size_t slot = 0;
+
         size_t index = 0;
 
         std::vector<BufferBarrier>                            preBufferBarriers;
@@ -565,11 +1113,29 @@ namespace sol
         std::vector<ImageToImageCopy>                         i2iCopies;
         std::vector<BufferToImageCopy>                        b2iCopies;
         std::vector<ImageToBufferCopy>                        i2bCopies;
+        std::vector<BufferFill>                               bufferFills;
+
+        /**
+         * \brief Commands recorded on the queue family that owns the resource, and the barriers directly after them.
+         */
+        std::vector<InlineUpdate>                                    inlineCopies;
+        std::vector<std::byte>                                       inlineData;
+        std::vector<std::pair<ImageClear, const VulkanQueueFamily*>> imageClears;
+        std::vector<BufferBarrier>                                   updateBufferBarriers;
+        std::vector<ImageBarrier>                                    updateImageBarriers;
+
+        bool narrowBarriers = false;
+
+        bool directWrite = false;
+
+        bool inlineUpdates = false;
 
         bool committed = false;
 
         bool done = false;
 
+        Stats stats;
+
         std::vector<uint64_t> semaphoreValues;
     };
 }  // namespace sol
@@ -0,0 +1,125 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief Handle to a transaction that was committed without waiting on it. Can be used to poll for completion or
+     * to register callbacks. Copies of a handle refer to the same transaction. Staging buffers of the transaction are
+     * released by the TransactionManager as soon as it observes that the GPU has finished, independent of the
+     * lifetime of the handle.
+     */
+    class TransactionHandle
+    {
+    public:
+        friend class Transaction;
+        friend class TransactionManager;
+
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        using Callback = std::function<void()>;
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        TransactionHandle() = delete;
+
+        TransactionHandle(const TransactionHandle&) = default;
+
+        TransactionHandle(TransactionHandle&&) noexcept = default;
+
+        ~TransactionHandle() noexcept;
+
+        TransactionHandle& operator=(const TransactionHandle&) = default;
+
+        TransactionHandle& operator=(TransactionHandle&&) noexcept = default;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] TransactionManager& getTransferManager() noexcept;
+
+        [[nodiscard]] const TransactionManager& getTransferManager() const noexcept;
+
+        /**
+         * \brief Get the final semaphore value for each queue family that is set when the transaction completes.
+         * Can be supplied to other submits that need to wait on this transaction to complete.
+         * \return List of semaphore values. Can be indexed using queue family index.
+         */
+        [[nodiscard]] const std::vector<uint64_t>& getSemaphoreValues() const noexcept;
+
+        /**
+         * \brief Check whether the transaction has completed, without waiting. Polls the manager, which releases the
+         * staging buffers and invokes the callbacks of all transactions that have completed.
+         * \return True if completed.
+         */
+        [[nodiscard]] bool isComplete();
+
+        ////////////////////////////////////////////////////////////////
+        // Completion.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Register a callback that is invoked once the transaction has completed. Callbacks are invoked from
+         * TransactionManager::poll, on whichever thread calls it. If the transaction has already completed, the
+         * callback is invoked immediately.
+         * \param callback Callback.
+         */
+        void onComplete(Callback callback);
+
+        /**
+         * \brief Do a CPU-side wait until the transaction has completed.
+         */
+        void wait();
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief State shared between the handles and the manager.
+         */
+        struct State
+        {
+            std::vector<uint64_t> semaphoreValues;
+
+            /**
+             * \brief Staging buffers that are released once the transaction completes.
+             */
+            std::vector<IBufferPtr> stagingBuffers;
+
+            std::vector<Callback> callbacks;
+
+            std::atomic_bool complete = false;
+        };
+
+        TransactionHandle(TransactionManager& transactionManager, std::shared_ptr<State> handleState);
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        TransactionManager* manager = nullptr;
+
+        std::shared_ptr<State> state;
+    };
+}  // namespace sol
@@ -4,8 +4,11 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 ////////////////////////////////////////////////////////////////
 // Module includes.
@@ -19,6 +22,8 @@
 
 #include "sol-memory/fwd.h"
 #include "sol-memory/pool/ring_buffer_memory_pool.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_handle.h"
 
 namespace sol
 {
@@ -26,6 +31,17 @@ namespace sol
     {
     public:
         friend class Transaction;
+        friend class TransactionHandle;
+
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Function that invokes task(i) for all i in [0, count), possibly in parallel on a worker pool, and
+         * returns once all tasks have finished. Tasks do not throw.
+         */
+        using CopyExecutor = std::function<void(size_t count, const std::function<void(size_t)>& task)>;
 
         ////////////////////////////////////////////////////////////////
         // Constructors.
@@ -33,7 +49,15 @@ namespace sol
 
         TransactionManager() = delete;
 
-        TransactionManager(MemoryManager& memoryManager, RingBufferMemoryPool& memoryPool);
+        /**
+         * \brief Construct a new TransactionManager.
+         * \param memoryManager MemoryManager.
+         * \param memoryPool Memory pool from which staging buffers are allocated.
+         * \param slotCount Number of transactions that can be in flight at the same time. Each slot has its own
+         * command buffers, staging buffers and timeline semaphore values. A commit only has to wait on the GPU
+         * when all slots are still in use by previously committed transactions.
+         */
+        TransactionManager(MemoryManager& memoryManager, RingBufferMemoryPool& memoryPool, size_t slotCount = 2);
 
         TransactionManager(const TransactionManager&) = delete;
 
@@ -49,7 +73,8 @@ namespace sol
         // Create.
         ////////////////////////////////////////////////////////////////
 
-        [[nodiscard]] static TransactionManagerPtr create(MemoryManager& memoryManager, size_t memoryPoolSize);
+        [[nodiscard]] static TransactionManagerPtr
+          create(MemoryManager& memoryManager, size_t memoryPoolSize, size_t slotCount = 2);
 
         ////////////////////////////////////////////////////////////////
         // Getters.
@@ -67,24 +92,202 @@ namespace sol
 
         [[nodiscard]] const std::vector<VulkanTimelineSemaphorePtr>& getSemaphores() const noexcept;
 
+        /**
+         * \brief Get the number of transactions that can be in flight at the same time.
+         * \return Number of slots.
+         */
+        [[nodiscard]] size_t getSlotCount() const noexcept;
+
+        /**
+         * \brief Returns whether new transactions write directly into host visible destination buffers by default.
+         * \return True if direct writes are enabled.
+         */
+        [[nodiscard]] bool getDirectWrite() const noexcept;
+
+        /**
+         * \brief Returns whether new transactions record small staging copies inline by default.
+         * \return True if inline updates are enabled.
+         */
+        [[nodiscard]] bool getInlineUpdates() const noexcept;
+
+        /**
+         * \brief Get the executor used to split large memcpys into staging memory. Can be empty.
+         * \return Executor.
+         */
+        [[nodiscard]] const CopyExecutor& getCopyExecutor() const noexcept;
+
+        /**
+         * \brief Get the size of the pieces into which large memcpys are split.
+         * \return Size in bytes.
+         */
+        [[nodiscard]] size_t getParallelCopyChunkSize() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set whether new transactions write directly into host visible destination buffers by default. See
+         * Transaction::setDirectWrite. Disabled by default.
+         * \param value Enable direct writes.
+         */
+        void setDirectWrite(bool value) noexcept;
+
+        /**
+         * \brief Set whether new transactions record small staging copies inline by default. See
+         * Transaction::setInlineUpdates.
+         * \param value Enable inline updates.
+         */
+        void setInlineUpdates(bool value) noexcept;
+
+        /**
+         * \brief Set an executor that is used to split memcpys from user data into staging (or directly written
+         * destination) memory over multiple threads. Copies smaller than twice the chunk size are always done inline
+         * on the calling thread, to avoid the dispatch overhead.
+         * \param executor Executor. If empty, all copies are done inline.
+         * \param chunkSize Size of the pieces into which large copies are split.
+         * \throws SolError Thrown if chunkSize is 0.
+         */
+        void setCopyExecutor(CopyExecutor executor, size_t chunkSize = 4ull * 1024ull * 1024ull);
+
         ////////////////////////////////////////////////////////////////
         // Transactions.
         ////////////////////////////////////////////////////////////////
 
+        /**
+         * \brief Begin a new transaction. Polls for completed transactions first.
+         * \return Transaction.
+         */
         [[nodiscard]] BufferTransactionPtr beginTransaction();
 
+        /**
+         * \brief Check for committed transactions that have completed, without waiting. Releases their staging
+         * buffers and invokes the callbacks registered on their handles on the calling thread.
+         * \return Number of transactions that completed since the last poll.
+         */
+        size_t poll();
+
+        ////////////////////////////////////////////////////////////////
+        // Streaming.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Upload data to a buffer in chunks through the staging pool, which allows uploading more data than
+         * fits in the pool. Each chunk is committed as a separate transaction without waiting, so that copying chunk
+         * k + 1 into the staging pool overlaps with the GPU copy of chunk k. Only when the pool is full, the calling
+         * thread waits for the oldest chunk to complete. The barrier is placed before the first and after the last
+         * chunk.
+         * \param copy Copy.
+         * \param barrier Optional explicit memory barrier.
+         * \param chunkSize Size of each chunk in bytes. If 0, half the block size of the staging pool is used, so that
+         * two chunks fit in the pool at the same time. Cannot be larger than the block size.
+         * \throws SolError Thrown if chunkSize is larger than the block size of the staging pool.
+         * \return Handle of the transaction of the last chunk. Completes once all chunks have completed.
+         */
+        [[nodiscard]] TransactionHandle upload(const StagingBufferCopy&            copy,
+                                               const std::optional<BufferBarrier>& barrier   = {},
+                                               size_t                              chunkSize = 0);
+
+        /**
+         * \brief Upload data to an image in chunks through the staging pool, which allows uploading more data than
+         * fits in the pool. Regions are split over array layers, depth slices and rows as needed to fit in a chunk.
+         * This assumes the data of each region is tightly packed and that regions are stored in order of dataOffset.
+         * Regions of block-compressed images are never split by rows. See the buffer overload for details on chunking
+         * and barriers.
+         * \param copy Copy.
+         * \param barrier Optional explicit image barrier.
+         * \param chunkSize Size of each chunk in bytes. If 0, half the block size of the staging pool is used.
+         * \throws SolError Thrown if chunkSize is larger than the block size of the staging pool, or if a region cannot
+         * be split into chunks of chunkSize bytes (which includes a single slice of a block-compressed image that does
+         * not fit).
+         * \return Handle of the transaction of the last chunk. Completes once all chunks have completed.
+         */
+        [[nodiscard]] TransactionHandle upload(const StagingImageCopy&            copy,
+                                               const std::optional<ImageBarrier>& barrier   = {},
+                                               size_t                             chunkSize = 0);
+
+        /**
+         * \brief Copy data into a mapped buffer. If a copy executor was set and the copy is large enough, the copy
+         * is split into pieces that are copied in parallel. Otherwise, this is equivalent to buffer.setData.
+         * \param buffer Mapped buffer.
+         * \param data Pointer to data.
+         * \param size Size in bytes.
+         * \param offset Offset into buffer in bytes.
+         * \throws SolError Thrown if the buffer is not mapped or size + offset exceeds the buffer size.
+         */
+        void setData(const VulkanBuffer& buffer, const void* data, size_t size, size_t offset) const;
+
     private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
         /**
-         * \brief Wait for currently active transaction to complete and then return a lock.
-         * While holding the lock, the command buffers and semaphores can be used.
+         * \brief Resources used by a single in-flight transaction.
+         */
+        struct Slot
+        {
+            std::vector<VulkanCommandBufferPtr> preCopyReleaseCmdBuffers;
+            std::vector<VulkanCommandBufferPtr> preCopyAcquireCmdBuffers;
+            std::vector<VulkanCommandBufferPtr> postCopyReleaseCmdBuffers;
+            std::vector<VulkanCommandBufferPtr> postCopyAcquireCmdBuffers;
+            VulkanCommandBufferPtr              copyCmdBuffer;
+
+            /**
+             * \brief Semaphore values that are reached when the last transaction submitted through this slot completes.
+             */
+            std::vector<uint64_t> semaphoreValues;
+
+            /**
+             * \brief Index of the last transaction submitted through this slot. 0 if the slot was never used.
+             */
+            size_t transactionIndex = 0;
+        };
+
+        /**
+         * \brief Wait for all in-flight transactions to complete and then return a lock.
          * \return Lock.
          */
         [[nodiscard]] std::unique_ptr<std::scoped_lock<std::mutex>> lockAndWait();
 
         [[nodiscard]] std::unique_ptr<std::scoped_lock<std::mutex>> lock();
 
+        /**
+         * \brief Wait for all in-flight transactions to complete and release all pending staging buffers. Callbacks
+         * are not invoked until the next poll. Must be called while holding the lock.
+         */
         void wait();
 
+        /**
+         * \brief Do a CPU-side wait until all semaphores have reached the specified values.
+         * \param values Semaphore values. Can be indexed using queue family index.
+         */
+        void wait(const std::vector<uint64_t>& values) const;
+
+        /**
+         * \brief Check whether all semaphores have reached the specified values, without waiting.
+         * \param values Semaphore values. Can be indexed using queue family index.
+         * \return True if all values were reached.
+         */
+        [[nodiscard]] bool isComplete(const std::vector<uint64_t>& values) const;
+
+        /**
+         * \brief Get a slot that is not in use by the GPU anymore. If all slots are busy, waits for the oldest one
+         * to complete. Must be called while holding the lock.
+         * \return Slot index.
+         */
+        [[nodiscard]] size_t acquireSlot();
+
+        /**
+         * \brief Register a committed transaction whose staging buffers must be kept alive until it completes.
+         * Must be called while holding the lock.
+         * \param values Semaphore values that are reached when the transaction completes.
+         * \param stagingBuffers Staging buffers.
+         * \return Shared state for a TransactionHandle.
+         */
+        [[nodiscard]] std::shared_ptr<TransactionHandle::State> addCompletion(std::vector<uint64_t>   values,
+                                                                              std::vector<IBufferPtr> stagingBuffers);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -95,14 +298,22 @@ namespace sol
 
         std::mutex mutex;
 
-        std::vector<VulkanCommandBufferPtr>     preCopyReleaseCmdBuffers;
-        std::vector<VulkanCommandBufferPtr>     preCopyAcquireCmdBuffers;
-        std::vector<VulkanCommandBufferPtr>     postCopyReleaseCmdBuffers;
-        std::vector<VulkanCommandBufferPtr>     postCopyAcquireCmdBuffers;
-        VulkanCommandBufferPtr                  copyCmdBuffer;
+        std::vector<Slot>                       slots;
         std::vector<VulkanTimelineSemaphorePtr> semaphores;
         std::vector<uint64_t>                   semaphoreValues;
         size_t                                  transactionIndex = 0;
-        std::vector<IBufferPtr>                 pendingStagingBuffers;
+
+        bool directWrite = false;
+
+        bool inlineUpdates = false;
+
+        CopyExecutor copyExecutor;
+
+        size_t parallelCopyChunkSize = 4ull * 1024ull * 1024ull;
+
+        /**
+         * \brief Committed transactions that were not yet observed to be complete.
+         */
+        std::vector<std::shared_ptr<TransactionHandle::State>> completions;
     };
 }  // namespace sol
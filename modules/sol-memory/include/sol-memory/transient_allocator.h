@@ -0,0 +1,248 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/fwd.h"
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_image.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief Allocator for transient resources, such as intermediate render targets, that are only used during part
+     * of a frame. Each resource is declared together with the index of its first and last use, for example the
+     * indices of the tasks in a graph that write and read it. When allocating, resources whose lifetimes do not
+     * overlap are placed at overlapping ranges of the same device memory.
+     * -
+     *
+     * Images with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT are placed in lazily allocated memory if the device has
+     * such a memory type. Since resources alias, the contents of a resource are undefined at its first use. Images
+     * must be transitioned from VK_IMAGE_LAYOUT_UNDEFINED.
+     */
+    class TransientAllocator
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Statistics
+        {
+            /**
+             * \brief Number of bytes that would be needed if each resource had its own allocation.
+             */
+            size_t dedicatedBytes = 0;
+
+            /**
+             * \brief Number of bytes of device memory that were actually allocated.
+             */
+            size_t heapBytes = 0;
+
+            /**
+             * \brief Number of bytes saved by aliasing, i.e. dedicatedBytes - heapBytes.
+             */
+            size_t savedBytes = 0;
+
+            /**
+             * \brief Number of device memory allocations.
+             */
+            size_t heapCount = 0;
+
+            /**
+             * \brief Number of device memory allocations that are lazily allocated.
+             */
+            size_t lazyHeapCount = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        TransientAllocator() = delete;
+
+        explicit TransientAllocator(MemoryManager& memoryManager);
+
+        TransientAllocator(const TransientAllocator&) = delete;
+
+        TransientAllocator(TransientAllocator&&) noexcept = delete;
+
+        ~TransientAllocator() noexcept;
+
+        TransientAllocator& operator=(const TransientAllocator&) = delete;
+
+        TransientAllocator& operator=(TransientAllocator&&) noexcept = delete;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] MemoryManager& getMemoryManager() noexcept;
+
+        [[nodiscard]] const MemoryManager& getMemoryManager() const noexcept;
+
+        [[nodiscard]] size_t getResourceCount() const noexcept;
+
+        /**
+         * \brief Returns whether allocate was called since construction or the last reset.
+         * \return True if allocated.
+         */
+        [[nodiscard]] bool isAllocated() const noexcept;
+
+        /**
+         * \brief Get an image. Memory is only bound after allocate was called.
+         * \param index Resource index returned by addImage.
+         * \throws SolError Thrown if the resource is not an image.
+         * \return Image.
+         */
+        [[nodiscard]] VulkanImage& getImage(size_t index) const;
+
+        /**
+         * \brief Get a buffer. Memory is only bound after allocate was called.
+         * \param index Resource index returned by addBuffer.
+         * \throws SolError Thrown if the resource is not a buffer.
+         * \return Buffer.
+         */
+        [[nodiscard]] VulkanBuffer& getBuffer(size_t index) const;
+
+        /**
+         * \brief Get the offset of a resource in its device memory.
+         * \param index Resource index.
+         * \throws SolError Thrown if not allocated yet.
+         * \return Offset in bytes.
+         */
+        [[nodiscard]] size_t getOffset(size_t index) const;
+
+        /**
+         * \brief Get the index of the device memory a resource was placed in. Resources in different device memories
+         * never alias.
+         * \param index Resource index.
+         * \throws SolError Thrown if not allocated yet.
+         * \return Device memory index.
+         */
+        [[nodiscard]] size_t getHeapIndex(size_t index) const;
+
+        /**
+         * \brief Get the statistics of the last call to allocate.
+         * \return Statistics.
+         */
+        [[nodiscard]] const Statistics& getStatistics() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Resources.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Declare an image. The image is created right away, but memory is only bound by allocate.
+         * \param settings Image settings. The device is taken from the memory manager. Must not have an allocator.
+         * \param firstUse Index of the first use of the image.
+         * \param lastUse Index of the last use of the image (inclusive).
+         * \throws SolError Thrown if already allocated, lastUse < firstUse or an allocator is set.
+         * \return Resource index.
+         */
+        size_t addImage(const VulkanImage::Settings& settings, uint32_t firstUse, uint32_t lastUse);
+
+        /**
+         * \brief Declare a buffer. The buffer is created right away, but memory is only bound by allocate.
+         * \param settings Buffer settings. The device is taken from the memory manager. Must not have an allocator.
+         * \param firstUse Index of the first use of the buffer.
+         * \param lastUse Index of the last use of the buffer (inclusive).
+         * \throws SolError Thrown if already allocated, lastUse < firstUse or an allocator is set.
+         * \return Resource index.
+         */
+        size_t addBuffer(const VulkanBuffer::Settings& settings, uint32_t firstUse, uint32_t lastUse);
+
+        /**
+         * \brief Place all declared resources, allocate device memory and bind it. Resources are placed from large
+         * to small, each at the lowest offset that does not overlap with an already placed resource whose lifetime
+         * overlaps.
+         * \throws SolError Thrown if already allocated.
+         */
+        void allocate();
+
+        /**
+         * \brief Destroy all resources and device memory, so that a new set of resources can be declared.
+         */
+        void reset();
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Resource
+        {
+            VulkanImagePtr image;
+
+            VulkanBufferPtr buffer;
+
+            uint32_t firstUse = 0;
+
+            uint32_t lastUse = 0;
+
+            VkMemoryRequirements requirements{};
+
+            /**
+             * \brief Whether the resource can be placed in lazily allocated memory.
+             */
+            bool lazy = false;
+
+            size_t heap = 0;
+
+            size_t offset = 0;
+        };
+
+        struct Heap
+        {
+            VulkanDeviceMemoryPtr memory;
+
+            size_t size = 0;
+
+            uint32_t memoryTypeBits = 0;
+
+            bool lazy = false;
+        };
+
+        void validateResource(uint32_t firstUse, uint32_t lastUse, bool hasAllocator) const;
+
+        [[nodiscard]] const Resource& getResource(size_t index) const;
+
+        /**
+         * \brief Find the memory type index for a set of allowed memory types and required property flags.
+         * \param memoryTypeBits Allowed memory types.
+         * \param flags Required property flags.
+         * \return Memory type index, or -1 if not found.
+         */
+        [[nodiscard]] int32_t findMemoryType(uint32_t memoryTypeBits, VkMemoryPropertyFlags flags) const;
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        MemoryManager* manager = nullptr;
+
+        /**
+         * \brief Device memory. Declared before the resources, so that resources are destroyed first.
+         */
+        std::vector<Heap> heaps;
+
+        std::vector<Resource> resources;
+
+        bool allocated = false;
+
+        Statistics statistics;
+    };
+}  // namespace sol
@@ -0,0 +1,295 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <variant>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/fwd.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_handle.h"
+
+namespace sol
+{
+    /**
+     * \brief Queues uploads from any number of producers and commits them through a TransactionManager in priority
+     * order, limited to a byte budget per frame. This keeps bulk uploads, e.g. while a level is loading, from
+     * saturating the transfer queue and delaying uploads that are needed to render the current frame.
+     * -
+     *
+     * Requests are committed highest priority first and in order of submission within a priority. Committing stops
+     * at the first request that does not fit in the remaining budget, so lower priority requests never overtake higher
+     * priority ones. A request that is larger than the whole budget is committed on its own once it reaches the front.
+     * -
+     *
+     * Enqueueing, cancelling and changing priorities is thread safe. commitFrame should be called from a single
+     * thread, typically once per frame.
+     */
+    class UploadScheduler
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        enum class Priority : uint32_t
+        {
+            /**
+             * \brief Needed to render the current frame.
+             */
+            VisibleNow = 0,
+
+            /**
+             * \brief Likely needed soon, e.g. objects just outside of the view.
+             */
+            Prefetch = 1,
+
+            /**
+             * \brief Everything else, e.g. bulk data of a level that is loading.
+             */
+            Background = 2
+        };
+
+        static constexpr size_t priorityCount = 3;
+
+        using RequestId = uint64_t;
+
+        using Callback = std::function<void()>;
+
+        struct Metrics
+        {
+            /**
+             * \brief Number of requests waiting to be committed, per priority.
+             */
+            std::array<size_t, priorityCount> queuedRequests{};
+
+            /**
+             * \brief Bytes waiting to be committed, per priority.
+             */
+            std::array<size_t, priorityCount> queuedBytes{};
+
+            /**
+             * \brief Total number of requests committed since creation, per priority.
+             */
+            std::array<size_t, priorityCount> committedRequests{};
+
+            /**
+             * \brief Total bytes committed since creation, per priority.
+             */
+            std::array<size_t, priorityCount> committedBytes{};
+
+            /**
+             * \brief Bytes committed by the last call to commitFrame.
+             */
+            size_t lastFrameBytes = 0;
+
+            /**
+             * \brief Number of requests committed by the last call to commitFrame.
+             */
+            size_t lastFrameRequests = 0;
+
+            /**
+             * \brief Number of calls to commitFrame.
+             */
+            size_t frames = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        UploadScheduler() = delete;
+
+        /**
+         * \brief Construct a new UploadScheduler.
+         * \param transactionManager TransactionManager.
+         * \param budget Maximum number of bytes committed per frame.
+         * \throws SolError Thrown if budget is 0.
+         */
+        UploadScheduler(TransactionManager& transactionManager, size_t budget);
+
+        UploadScheduler(const UploadScheduler&) = delete;
+
+        UploadScheduler(UploadScheduler&&) noexcept = delete;
+
+        ~UploadScheduler() noexcept;
+
+        UploadScheduler& operator=(const UploadScheduler&) = delete;
+
+        UploadScheduler& operator=(UploadScheduler&&) noexcept = delete;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] TransactionManager& getTransactionManager() noexcept;
+
+        [[nodiscard]] const TransactionManager& getTransactionManager() const noexcept;
+
+        [[nodiscard]] size_t getFrameBudget() const noexcept;
+
+        /**
+         * \brief Get the number of requests waiting to be committed.
+         * \param priority Priority.
+         * \return Number of requests.
+         */
+        [[nodiscard]] size_t getQueueDepth(Priority priority) const;
+
+        /**
+         * \brief Get the number of bytes waiting to be committed.
+         * \param priority Priority.
+         * \return Bytes.
+         */
+        [[nodiscard]] size_t getQueuedBytes(Priority priority) const;
+
+        [[nodiscard]] Metrics getMetrics() const;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set the maximum number of bytes committed per frame.
+         * \param budget Budget in bytes.
+         * \throws SolError Thrown if budget is 0.
+         */
+        void setFrameBudget(size_t budget);
+
+        /**
+         * \brief Change the priority of a request that has not been committed yet. It is moved to the back of the
+         * queue of its new priority.
+         * \param id Request.
+         * \param priority New priority.
+         * \return True if the request was still queued.
+         */
+        bool setPriority(RequestId id, Priority priority);
+
+        ////////////////////////////////////////////////////////////////
+        // Requests.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Queue an upload to a buffer. The data is not copied. It must stay valid until the request has been
+         * cancelled or its completion callback has been invoked.
+         * \param copy Copy info. See Transaction::stage.
+         * \param barrier Optional explicit barrier. See Transaction::stage.
+         * \param priority Priority.
+         * \param onComplete Optional callback, invoked through TransactionHandle::onComplete once the upload has
+         * completed on the GPU.
+         * \throws SolError Thrown if the upload is larger than the block size of the staging pool.
+         * \return Request identifier.
+         */
+        RequestId enqueue(const StagingBufferCopy&     copy,
+                          std::optional<BufferBarrier> barrier,
+                          Priority                     priority,
+                          Callback                     onComplete = {});
+
+        /**
+         * \brief Queue an upload to an image. The data is not copied. It must stay valid until the request has been
+         * cancelled or its completion callback has been invoked.
+         * \param copy Copy info. See Transaction::stage.
+         * \param barrier Optional explicit barrier. See Transaction::stage.
+         * \param priority Priority.
+         * \param onComplete Optional callback, invoked through TransactionHandle::onComplete once the upload has
+         * completed on the GPU.
+         * \throws SolError Thrown if the upload is larger than the block size of the staging pool.
+         * \return Request identifier.
+         */
+        RequestId enqueue(const StagingImageCopy&     copy,
+                          std::optional<ImageBarrier> barrier,
+                          Priority                    priority,
+                          Callback                    onComplete = {});
+
+        /**
+         * \brief Remove a request that has not been committed yet.
+         * \param id Request.
+         * \return True if the request was still queued.
+         */
+        bool cancel(RequestId id);
+
+        /**
+         * \brief Stage queued requests in a single transaction, highest priority first, until the frame budget is
+         * reached or the staging pool is full, and commit the transaction without waiting.
+         * \return Handle of the transaction, or nothing if no requests were committed.
+         */
+        [[nodiscard]] std::optional<TransactionHandle> commitFrame();
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct BufferUpload
+        {
+            StagingBufferCopy copy;
+
+            std::optional<BufferBarrier> barrier;
+        };
+
+        struct ImageUpload
+        {
+            StagingImageCopy copy;
+
+            std::optional<ImageBarrier> barrier;
+        };
+
+        struct Request
+        {
+            std::variant<BufferUpload, ImageUpload> upload;
+
+            Priority priority = Priority::Background;
+
+            size_t size = 0;
+
+            Callback onComplete;
+        };
+
+        RequestId enqueue(std::variant<BufferUpload, ImageUpload> upload,
+                          size_t                                  size,
+                          Priority                                priority,
+                          Callback                                onComplete);
+
+        /**
+         * \brief Remove a request from the queue of its priority. Mutex must be locked.
+         * \param id Request.
+         * \return Iterator to the request, or requests.end() if it is not queued.
+         */
+        std::unordered_map<RequestId, Request>::iterator dequeue(RequestId id);
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        TransactionManager* manager = nullptr;
+
+        size_t frameBudget = 0;
+
+        mutable std::mutex mutex;
+
+        RequestId nextId = 0;
+
+        /**
+         * \brief All queued requests.
+         */
+        std::unordered_map<RequestId, Request> requests;
+
+        /**
+         * \brief Order of the queued requests, per priority.
+         */
+        std::array<std::deque<RequestId>, priorityCount> queues;
+
+        Metrics metrics;
+    };
+}  // namespace sol
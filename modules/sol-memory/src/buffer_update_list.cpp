@@ -0,0 +1,152 @@
+#include "sol-memory/buffer_update_list.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <format>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_command_buffer.h"
+#include "sol-core/vulkan_command_pool.h"
+#include "sol-core/vulkan_queue_family.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/i_buffer.h"
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    BufferUpdateList::BufferUpdateList() = default;
+
+    BufferUpdateList::BufferUpdateList(BufferUpdateList&&) noexcept = default;
+
+    BufferUpdateList::~BufferUpdateList() noexcept = default;
+
+    BufferUpdateList& BufferUpdateList::operator=(BufferUpdateList&&) noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    bool BufferUpdateList::empty() const noexcept { return updates.empty(); }
+
+    size_t BufferUpdateList::getUpdateCount() const noexcept { return updates.size(); }
+
+    size_t BufferUpdateList::getDataSize() const noexcept { return data.size(); }
+
+    const BufferUpdateList::Barrier& BufferUpdateList::getBarrier() const noexcept { return barrier; }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void BufferUpdateList::setBarrier(const Barrier& value) noexcept { barrier = value; }
+
+    ////////////////////////////////////////////////////////////////
+    // Updates.
+    ////////////////////////////////////////////////////////////////
+
+    void BufferUpdateList::add(IBuffer& buffer, const void* src, const size_t size, const size_t offset)
+    {
+        const size_t bufferOffset = buffer.getBufferOffset() + offset;
+
+        if (size == 0 || size > maxUpdateSize || size % 4 != 0)
+            throw SolError(std::format(
+              "Cannot add buffer update of {} bytes. Size must be a non-zero multiple of 4 of at most {} bytes.",
+              size,
+              maxUpdateSize));
+        if (bufferOffset % 4 != 0)
+            throw SolError(
+              std::format("Cannot add buffer update at offset {}. Offset must be a multiple of 4.", bufferOffset));
+        if (offset + size > buffer.getBufferSize())
+            throw SolError(std::format("Cannot add buffer update of {} bytes at offset {}. Buffer is only {} bytes.",
+                                       size,
+                                       offset,
+                                       buffer.getBufferSize()));
+
+        const size_t dataOffset = data.size();
+        data.resize(dataOffset + size);
+        std::memcpy(data.data() + dataOffset, src, size);
+
+        updates.emplace_back(Update{.buffer = &buffer, .offset = bufferOffset, .dataOffset = dataOffset, .size = size});
+    }
+
+    void BufferUpdateList::flush(const VulkanCommandBuffer& commandBuffer)
+    {
+        if (updates.empty()) return;
+
+        const uint32_t familyIndex = commandBuffer.getCommandPool().getSettings().queueFamilyIndex;
+        for (const auto& update : updates)
+        {
+            if (update.buffer->getQueueFamily().getIndex() != familyIndex)
+                throw SolError(std::format("Cannot flush buffer updates. Buffer is owned by queue family {}, but "
+                                           "command buffer is for queue family {}.",
+                                           update.buffer->getQueueFamily().getIndex(),
+                                           familyIndex));
+        }
+
+        // A single global barrier on each side of the updates is cheaper than a buffer barrier per update and
+        // covers the same dependencies, since no ownership is transferred.
+        const VkMemoryBarrier2 preBarrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                          .pNext         = nullptr,
+                                          .srcStageMask  = barrier.srcStage,
+                                          .srcAccessMask = barrier.srcAccess,
+                                          .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                          .dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT};
+        const VkMemoryBarrier2 postBarrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                           .pNext         = nullptr,
+                                           .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                           .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                           .dstStageMask  = barrier.dstStage,
+                                           .dstAccessMask = barrier.dstAccess};
+
+        const VkDependencyInfo preDependency{.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                                             .pNext                    = VK_NULL_HANDLE,
+                                             .dependencyFlags          = 0,
+                                             .memoryBarrierCount       = 1,
+                                             .pMemoryBarriers          = &preBarrier,
+                                             .bufferMemoryBarrierCount = 0,
+                                             .pBufferMemoryBarriers    = VK_NULL_HANDLE,
+                                             .imageMemoryBarrierCount  = 0,
+                                             .pImageMemoryBarriers     = VK_NULL_HANDLE};
+        const VkDependencyInfo postDependency{.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                                              .pNext                    = VK_NULL_HANDLE,
+                                              .dependencyFlags          = 0,
+                                              .memoryBarrierCount       = 1,
+                                              .pMemoryBarriers          = &postBarrier,
+                                              .bufferMemoryBarrierCount = 0,
+                                              .pBufferMemoryBarriers    = VK_NULL_HANDLE,
+                                              .imageMemoryBarrierCount  = 0,
+                                              .pImageMemoryBarriers     = VK_NULL_HANDLE};
+
+        vkCmdPipelineBarrier2(commandBuffer.get(), &preDependency);
+        for (const auto& update : updates)
+            vkCmdUpdateBuffer(commandBuffer.get(),
+                              update.buffer->getBuffer().get(),
+                              update.offset,
+                              update.size,
+                              data.data() + update.dataOffset);
+        vkCmdPipelineBarrier2(commandBuffer.get(), &postDependency);
+
+        clear();
+    }
+
+    void BufferUpdateList::clear() noexcept
+    {
+        updates.clear();
+        data.clear();
+    }
+}  // namespace sol
@@ -0,0 +1,156 @@
+#include "sol-memory/frame_linear_allocator.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+
+////////////////////////////////////////////////////////////////
+// External includes.
+////////////////////////////////////////////////////////////////
+
+#include <vulkan/vulkan.hpp>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_device.h"
+#include "sol-core/vulkan_timeline_semaphore.h"
+#include "sol-error/sol_error.h"
+#include "sol-error/vulkan_error_handler.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/stack_memory_pool.h"
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    FrameLinearAllocator::FrameLinearAllocator(StackMemoryPool& memoryPool,
+                                               const size_t     size,
+                                               const size_t     count,
+                                               const size_t     alignment) :
+        pool(&memoryPool),
+        frameSize(size),
+        minAlignment(std::max({alignment, memoryPool.getRequiredAlignment(), size_t{1}}))
+    {
+        if (count == 0) throw SolError("Cannot create FrameLinearAllocator with 0 frames.");
+        if (!(pool->getAllocationFlags() & VMA_ALLOCATION_CREATE_MAPPED_BIT))
+            throw SolError("Cannot create FrameLinearAllocator. Memory pool is not persistently mapped.");
+
+        frames.resize(count);
+        for (auto& frame : frames)
+            frame.buffer = pool->allocateBuffer(frameSize, IBufferAllocator::OnAllocationFailure::Throw);
+
+        // Start at the last frame, so that the first call to beginFrame moves to frame 0.
+        frameIndex = count - 1;
+    }
+
+    FrameLinearAllocator::~FrameLinearAllocator() noexcept
+    {
+        // StackMemoryPool requires buffers to be released in reverse order.
+        while (!frames.empty()) frames.pop_back();
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    StackMemoryPool& FrameLinearAllocator::getMemoryPool() noexcept { return *pool; }
+
+    const StackMemoryPool& FrameLinearAllocator::getMemoryPool() const noexcept { return *pool; }
+
+    size_t FrameLinearAllocator::getFrameSize() const noexcept { return frameSize; }
+
+    size_t FrameLinearAllocator::getFrameCount() const noexcept { return frames.size(); }
+
+    size_t FrameLinearAllocator::getFrameIndex() const noexcept { return frameIndex; }
+
+    size_t FrameLinearAllocator::getUsedBytes() const noexcept { return std::min(head.load(), frameSize); }
+
+    VulkanBuffer& FrameLinearAllocator::getBuffer(const size_t frame) const
+    {
+        if (frame >= frames.size())
+            throw SolError(std::format("Cannot get buffer of frame {}. There are only {} frames.", frame, frames.size()));
+        return frames[frame].buffer->getBuffer();
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Frames.
+    ////////////////////////////////////////////////////////////////
+
+    void FrameLinearAllocator::beginFrame()
+    {
+        frameIndex  = (frameIndex + 1) % frames.size();
+        auto& frame = frames[frameIndex];
+
+        // Wait for the device to finish using the previous contents of this frame.
+        if (frame.semaphore)
+        {
+            const VkSemaphoreWaitInfo info{.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                                           .pNext          = nullptr,
+                                           .flags          = 0,
+                                           .semaphoreCount = 1,
+                                           .pSemaphores    = &frame.semaphore->get(),
+                                           .pValues        = &frame.value};
+            handleVulkanError(vkWaitSemaphores(frame.semaphore->getDevice().get(), &info, UINT64_MAX));
+            frame.semaphore = nullptr;
+        }
+
+        head = 0;
+    }
+
+    void FrameLinearAllocator::endFrame(const VulkanTimelineSemaphore& semaphore, const uint64_t value)
+    {
+        auto& frame = frames[frameIndex];
+
+        if (const size_t used = getUsedBytes(); used > 0) frame.buffer->getBuffer().flush(0, used);
+
+        frame.semaphore = &semaphore;
+        frame.value     = value;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Allocations.
+    ////////////////////////////////////////////////////////////////
+
+    FrameLinearAllocator::Allocation FrameLinearAllocator::allocate(const size_t size, const size_t alignment)
+    {
+        auto alloc = tryAllocate(size, alignment);
+        if (!alloc)
+            throw SolError(std::format("Cannot allocate {} bytes from FrameLinearAllocator. Frame is out of memory "
+                                       "({} of {} bytes used).",
+                                       size,
+                                       getUsedBytes(),
+                                       frameSize));
+        return *alloc;
+    }
+
+    std::optional<FrameLinearAllocator::Allocation> FrameLinearAllocator::tryAllocate(const size_t size,
+                                                                                      const size_t alignment)
+    {
+        const size_t align = std::max(alignment, minAlignment);
+
+        // Bump the head. Retry if another thread allocated in the meantime.
+        size_t current = head.load(std::memory_order_relaxed);
+        size_t offset  = 0;
+        do {
+            offset = (current + align - 1) / align * align;
+            if (offset + size > frameSize) return std::nullopt;
+        } while (!head.compare_exchange_weak(current, offset + size, std::memory_order_relaxed));
+
+        auto& buffer = frames[frameIndex].buffer->getBuffer();
+        return Allocation{
+          .buffer = &buffer, .offset = offset, .size = size, .data = buffer.getMappedData<std::byte>() + offset};
+    }
+}  // namespace sol
@@ -1,5 +1,11 @@
 #include "sol-memory/i_buffer.h"
 
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+
 ////////////////////////////////////////////////////////////////
 // Current target includes.
 ////////////////////////////////////////////////////////////////
@@ -33,6 +39,8 @@ namespace sol
 
     const VulkanQueueFamily& IBuffer::getQueueFamily() const noexcept { return *queueFamily; }
 
+    bool IBuffer::isConcurrent() const { return getBuffer().getSettings().sharingMode == VK_SHARING_MODE_CONCURRENT; }
+
     ////////////////////////////////////////////////////////////////
     // Setters.
     ////////////////////////////////////////////////////////////////
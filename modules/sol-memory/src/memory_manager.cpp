@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <format>
 #include <fstream>
 
@@ -23,6 +24,7 @@
 #include "sol-core/vulkan_memory_allocator.h"
 #include "sol-core/vulkan_physical_device.h"
 #include "sol-core/vulkan_queue.h"
+#include "sol-core/vulkan_queue_family.h"
 #include "sol-error/sol_error.h"
 
 ////////////////////////////////////////////////////////////////
@@ -113,6 +115,17 @@ namespace sol
         return *transferQueue;
     }
 
+    std::vector<uint32_t> MemoryManager::getQueueFamilyIndices() const
+    {
+        std::vector<uint32_t> indices;
+        for (const auto* queue : {computeQueue, graphicsQueue, transferQueue})
+            if (queue) indices.emplace_back(queue->getFamily().getIndex());
+        std::ranges::sort(indices);
+        const auto [first, last] = std::ranges::unique(indices);
+        indices.erase(first, last);
+        return indices;
+    }
+
     IBufferAllocator::Capabilities MemoryManager::getCapabilities() const noexcept { return Capabilities::Alignment; }
 
     IMemoryPool& MemoryManager::getMemoryPool(const std::string& name)
@@ -131,7 +144,11 @@ namespace sol
     {
         VulkanMemoryAllocator::Settings settings;
         settings.device = getDevice();
-        allocator       = VulkanMemoryAllocator::create(settings);
+        // Let VMA query actual heap usage and budget when the extension is available.
+        if (const auto& extensions = getDevice().getSettings().extensions;
+            std::ranges::contains(extensions, std::string(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)))
+            settings.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        allocator = VulkanMemoryAllocator::create(settings);
     }
 
     void MemoryManager::initializeCommandPools()
@@ -193,13 +210,13 @@ namespace sol
         settings.device             = getDevice();
         settings.size               = alloc.size;
         settings.bufferUsage        = alloc.bufferUsage;
-        settings.sharingMode        = alloc.sharingMode;
         settings.allocator          = getAllocator();
         settings.vma.memoryUsage    = alloc.memoryUsage;
         settings.vma.requiredFlags  = alloc.requiredMemoryFlags;
         settings.vma.preferredFlags = alloc.preferredMemoryFlags;
         settings.vma.flags          = alloc.allocationFlags;
         settings.vma.alignment      = alloc.alignment;
+        setSharingMode(settings, alloc.sharingMode);
 
         auto buffer = VulkanBuffer::create(settings, onFailure != OnAllocationFailure::Empty);
         if (!buffer) return nullptr;
@@ -213,8 +230,7 @@ namespace sol
     FreeAtOnceMemoryPool& MemoryManager::createFreeAtOnceMemoryPool(const std::string&      name,
                                                                     IMemoryPool::CreateInfo createInfo)
     {
-        assert(createInfo.minBlocks <= createInfo.maxBlocks);
-        assert(createInfo.maxBlocks > 0);
+        assert(createInfo.maxBlocks == 0 || createInfo.minBlocks <= createInfo.maxBlocks);
         createInfo.createFlags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
         return createMemoryPool<FreeAtOnceMemoryPool>(name, createInfo);
     }
@@ -222,8 +238,7 @@ namespace sol
     NonLinearMemoryPool& MemoryManager::createNonLinearMemoryPool(const std::string&      name,
                                                                   IMemoryPool::CreateInfo createInfo)
     {
-        assert(createInfo.minBlocks <= createInfo.maxBlocks);
-        assert(createInfo.maxBlocks > 0);
+        assert(createInfo.maxBlocks == 0 || createInfo.minBlocks <= createInfo.maxBlocks);
         return createMemoryPool<NonLinearMemoryPool>(name, createInfo);
     }
 
@@ -257,4 +272,27 @@ namespace sol
         vmaFreeStatsString(allocator->get(), str);
     }
 
+    std::vector<MemoryManager::HeapBudget> MemoryManager::getHeapBudgets() const
+    {
+        const VkPhysicalDeviceMemoryProperties* properties = nullptr;
+        vmaGetMemoryProperties(allocator->get(), &properties);
+
+        std::vector<VmaBudget> budgets(properties->memoryHeapCount);
+        vmaGetHeapBudgets(allocator->get(), budgets.data());
+
+        std::vector<HeapBudget> heapBudgets;
+        heapBudgets.reserve(budgets.size());
+        for (uint32_t i = 0; i < properties->memoryHeapCount; i++)
+        {
+            heapBudgets.emplace_back(HeapBudget{.flags           = properties->memoryHeaps[i].flags,
+                                                .size            = properties->memoryHeaps[i].size,
+                                                .blockBytes      = budgets[i].statistics.blockBytes,
+                                                .allocationBytes = budgets[i].statistics.allocationBytes,
+                                                .usage           = budgets[i].usage,
+                                                .budget          = budgets[i].budget});
+        }
+
+        return heapBudgets;
+    }
+
 }  // namespace sol
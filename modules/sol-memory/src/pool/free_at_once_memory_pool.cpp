@@ -1,5 +1,12 @@
 #include "sol-memory/pool/free_at_once_memory_pool.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -13,6 +20,7 @@
 #include "sol-core/vulkan_buffer.h"
 #include "sol-core/vulkan_memory_pool.h"
 #include "sol-error/sol_error.h"
+#include "sol-error/vulkan_error_handler.h"
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -33,9 +41,17 @@ namespace sol
                                                VulkanMemoryPoolPtr memoryPool) :
         IMemoryPool(memoryManager, std::move(poolName), createInfo, std::move(memoryPool))
     {
+        for (size_t i = 0; i < getMinBlocks(); i++) static_cast<void>(createBlock(true));
     }
 
-    FreeAtOnceMemoryPool::~FreeAtOnceMemoryPool() noexcept = default;
+    FreeAtOnceMemoryPool::~FreeAtOnceMemoryPool() noexcept
+    {
+        for (const auto& block : blocks)
+        {
+            vmaClearVirtualBlock(block.virtualBlock);
+            vmaDestroyVirtualBlock(block.virtualBlock);
+        }
+    }
 
     ////////////////////////////////////////////////////////////////
     // Getters.
@@ -43,28 +59,67 @@ namespace sol
 
     IMemoryPool::Capabilities FreeAtOnceMemoryPool::getCapabilities() const noexcept { return Capabilities::None; }
 
+    IMemoryPool::FreeBlockHistogram FreeAtOnceMemoryPool::getFreeBlockHistogram()
+    {
+        std::scoped_lock lock(mutex);
+
+        FreeBlockHistogram histogram;
+        for (const auto& block : blocks)
+        {
+            VmaStatistics blockStats;
+            vmaGetVirtualBlockStatistics(block.virtualBlock, &blockStats);
+            histogram.add(blockStats.blockBytes - blockStats.allocationBytes);
+        }
+
+        return histogram;
+    }
+
     ////////////////////////////////////////////////////////////////
     // Allocations.
     ////////////////////////////////////////////////////////////////
 
+    bool FreeAtOnceMemoryPool::createBlock(const bool throwOnOutOfMemory)
+    {
+        VulkanBuffer::Settings settings;
+        settings.device      = getDevice();
+        settings.size        = getBlockSize();
+        settings.bufferUsage = getBufferUsage();
+        settings.allocator   = getMemoryManager().getAllocator();
+        settings.vma.pool    = pool;
+        settings.vma.flags   = getAllocationFlags();
+        getMemoryManager().setSharingMode(settings, getSharingMode());
+
+        auto buffer = VulkanBuffer::create(settings, throwOnOutOfMemory);
+        if (!buffer) return false;
+
+        const VmaVirtualBlockCreateInfo blockCreateInfo{
+          .size                 = getBlockSize(),
+          .flags                = VMA_VIRTUAL_BLOCK_CREATE_LINEAR_ALGORITHM_BIT,
+          .pAllocationCallbacks = nullptr};
+        VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        handleVulkanError(vmaCreateVirtualBlock(&blockCreateInfo, &virtualBlock));
+
+        blocks.emplace_back(Block{.buffer = std::move(buffer), .virtualBlock = virtualBlock});
+        return true;
+    }
+
     void FreeAtOnceMemoryPool::releaseBuffer(const MemoryPoolBuffer& buffer)
     {
         std::scoped_lock lock(mutex);
 
         assert(&buffer.getMemoryPool() == this);
-        assert(buffer.getId() < buffers.size());
-        assert(buffers[buffer.getId()]);
-
-        buffers[buffer.getId()].reset();
+        assert(buffer.getId() < allocCount);
 
         // Keep track of the number of deallocated buffers.
         deallocCount++;
 
-        // If all buffers have been deallocated, reset.
-        if (deallocCount == buffers.size())
+        // If all buffers have been deallocated, reset. Blocks are kept around to be reused.
+        if (deallocCount == allocCount)
         {
+            allocCount   = 0;
             deallocCount = 0;
-            buffers.clear();
+            currentBlock = 0;
+            for (const auto& block : blocks) vmaClearVirtualBlock(block.virtualBlock);
         }
     }
 
@@ -78,18 +133,52 @@ namespace sol
             throw SolError("Cannot allocate new buffer from FreeAtOnceMemoryPool before all previous buffers have been "
                            "deallocated.");
 
-        VulkanBuffer::Settings settings;
-        settings.device        = getDevice();
-        settings.size          = alloc.size;
-        settings.bufferUsage   = alloc.bufferUsage;
-        settings.allocator     = getMemoryManager().getAllocator();
-        settings.vma.pool      = pool;
-        settings.vma.flags     = getAllocationFlags();
-        settings.vma.alignment = alloc.alignment;
-
-        auto buffer = VulkanBuffer::create(settings, onFailure != OnAllocationFailure::Empty);
-        if (!buffer) return nullptr;
-        auto& b = *buffers.emplace_back(std::move(buffer));
-        return std::make_unique<MemoryPoolBuffer>(*this, getDefaultQueueFamily(), buffers.size() - 1, b, alloc.size, 0);
+        if ((alloc.bufferUsage & getBufferUsage()) != alloc.bufferUsage)
+            throw SolError(std::format("Cannot allocate buffer with usage flags {} from memory pool. Blocks only "
+                                       "support usage flags {}.",
+                                       alloc.bufferUsage,
+                                       getBufferUsage()));
+
+        if (alloc.size > getBlockSize())
+        {
+            if (onFailure == OnAllocationFailure::Empty) return nullptr;
+            throw SolError(
+              std::format("Cannot allocate buffer of {} bytes from memory pool with a block size of {} bytes.",
+                          alloc.size,
+                          getBlockSize()));
+        }
+
+        const VmaVirtualAllocationCreateInfo info{.size      = alloc.size,
+                                                  .alignment = std::max(alloc.alignment, getRequiredAlignment()),
+                                                  .flags     = 0,
+                                                  .pUserData = nullptr};
+        VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+        VkDeviceSize         offset            = 0;
+
+        // Allocations are only ever appended, so only the current block and the blocks after it need to be checked.
+        for (; currentBlock < blocks.size(); currentBlock++)
+        {
+            if (vmaVirtualAllocate(blocks[currentBlock].virtualBlock, &info, &virtualAllocation, &offset) ==
+                VK_SUCCESS)
+                break;
+        }
+
+        // All blocks are full, try to create a new block.
+        if (currentBlock == blocks.size())
+        {
+            if ((getMaxBlocks() > 0 && blocks.size() == getMaxBlocks()) ||
+                !createBlock(onFailure != OnAllocationFailure::Empty))
+            {
+                currentBlock = blocks.empty() ? 0 : blocks.size() - 1;
+                if (onFailure == OnAllocationFailure::Empty) return nullptr;
+                throw SolError("Failed to allocate buffer from memory pool. Pool is out of memory.");
+            }
+
+            handleVulkanError(
+              vmaVirtualAllocate(blocks[currentBlock].virtualBlock, &info, &virtualAllocation, &offset));
+        }
+
+        return std::make_unique<MemoryPoolBuffer>(
+          *this, getDefaultQueueFamily(), allocCount++, *blocks[currentBlock].buffer, alloc.size, offset);
     }
 }  // namespace sol
@@ -4,6 +4,8 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <bit>
 #include <format>
 
 ////////////////////////////////////////////////////////////////
@@ -17,7 +19,10 @@
 ////////////////////////////////////////////////////////////////
 
 #include "common/enum_classes.h"
+#include "sol-core/vulkan_device.h"
+#include "sol-core/vulkan_memory_allocator.h"
 #include "sol-core/vulkan_memory_pool.h"
+#include "sol-core/vulkan_physical_device.h"
 #include "sol-error/sol_error.h"
 
 ////////////////////////////////////////////////////////////////
@@ -43,6 +48,33 @@ namespace sol
         info(std::move(createInfo)),
         pool(std::move(memoryPool))
     {
+        const auto usage = info.bufferUsage;
+        if (usage == 0) return;
+
+        const VkBufferCreateInfo bufferInfo{.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                                            .pNext                 = nullptr,
+                                            .flags                 = 0,
+                                            .size                  = std::max<VkDeviceSize>(info.blockSize, 1),
+                                            .usage                 = usage,
+                                            .sharingMode           = VK_SHARING_MODE_EXCLUSIVE,
+                                            .queueFamilyIndexCount = 0,
+                                            .pQueueFamilyIndices   = nullptr};
+        const VkDeviceBufferMemoryRequirements requirementsInfo{
+          .sType = VK_STRUCTURE_TYPE_DEVICE_BUFFER_MEMORY_REQUIREMENTS, .pNext = nullptr, .pCreateInfo = &bufferInfo};
+        VkMemoryRequirements2 requirements{.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = nullptr};
+        vkGetDeviceBufferMemoryRequirements(getDevice().get(), &requirementsInfo, &requirements);
+        requiredAlignment = std::max<size_t>(requirements.memoryRequirements.alignment, 1);
+
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(getDevice().getPhysicalDevice().get(), &properties);
+        const auto& limits = properties.limits;
+        if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+            requiredAlignment = std::max<size_t>(requiredAlignment, limits.minUniformBufferOffsetAlignment);
+        if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+            requiredAlignment = std::max<size_t>(requiredAlignment, limits.minStorageBufferOffsetAlignment);
+        if (usage & (VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT))
+            requiredAlignment = std::max<size_t>(requiredAlignment, limits.minTexelBufferOffsetAlignment);
+        if (usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) requiredAlignment = std::max<size_t>(requiredAlignment, 4);
     }
 
     IMemoryPool::~IMemoryPool() noexcept = default;
@@ -71,6 +103,8 @@ namespace sol
 
     VkBufferUsageFlags IMemoryPool::getBufferUsage() const noexcept { return info.bufferUsage; }
 
+    VkSharingMode IMemoryPool::getSharingMode() const noexcept { return info.sharingMode; }
+
     VmaMemoryUsage IMemoryPool::getMemoryUsage() const noexcept { return info.memoryUsage; }
 
     VkMemoryPropertyFlags IMemoryPool::getRequiredMemoryFlags() const noexcept { return info.requiredMemoryFlags; }
@@ -85,6 +119,53 @@ namespace sol
 
     size_t IMemoryPool::getMaxBlocks() const noexcept { return info.maxBlocks; }
 
+    size_t IMemoryPool::getRequiredAlignment() const noexcept { return requiredAlignment; }
+
+    ////////////////////////////////////////////////////////////////
+    // Statistics.
+    ////////////////////////////////////////////////////////////////
+
+    void IMemoryPool::FreeBlockHistogram::add(const size_t size) noexcept
+    {
+        if (size == 0) return;
+        buckets[std::bit_width(size) - 1]++;
+        count++;
+        freeBytes += size;
+        largest = std::max(largest, size);
+    }
+
+    IMemoryPool::Statistics IMemoryPool::getStatistics() const
+    {
+        VmaStatistics vmaStats{};
+        vmaGetPoolStatistics(getMemoryManager().getAllocator().get(), pool->get(), &vmaStats);
+
+        return Statistics{.liveBytes         = liveBytes.load(),
+                          .liveAllocations   = liveAllocations.load(),
+                          .highWatermark     = highWatermark.load(),
+                          .totalAllocations  = totalAllocations.load(),
+                          .failedAllocations = failedAllocations.load(),
+                          .waits             = waits.load(),
+                          .blockCount        = vmaStats.blockCount,
+                          .blockBytes        = vmaStats.blockBytes};
+    }
+
+    IMemoryPool::FreeBlockHistogram IMemoryPool::getFreeBlockHistogram()
+    {
+        VmaDetailedStatistics vmaStats{};
+        vmaCalculatePoolStatistics(getMemoryManager().getAllocator().get(), pool->get(), &vmaStats);
+
+        // The sizes of the individual ranges are not known, so the buckets are left empty.
+        FreeBlockHistogram histogram;
+        if (vmaStats.unusedRangeCount == 0) return histogram;
+        histogram.count     = vmaStats.unusedRangeCount;
+        histogram.freeBytes = vmaStats.statistics.blockBytes - vmaStats.statistics.allocationBytes;
+        histogram.largest   = vmaStats.unusedRangeSizeMax;
+
+        return histogram;
+    }
+
+    void IMemoryPool::resetHighWatermark() noexcept { highWatermark = liveBytes.load(); }
+
     ////////////////////////////////////////////////////////////////
     // Allocations.
     ////////////////////////////////////////////////////////////////
@@ -118,6 +199,8 @@ namespace sol
                           "supported flags {}.",
                           alloc.bufferUsage,
                           getBufferUsage()));
+        if (alloc.sharingMode == VK_SHARING_MODE_CONCURRENT && getSharingMode() != VK_SHARING_MODE_CONCURRENT)
+            throw SolError("Cannot allocate concurrent buffer from memory pool. Pool only supports exclusive buffers.");
         if ((alloc.memoryUsage & getMemoryUsage()) != alloc.memoryUsage)
             throw SolError(
               std::format("Cannot allocate buffer from memory pool. Requested memory usage flags {} do not match "
@@ -150,15 +233,32 @@ namespace sol
             throw SolError("This memory pool does not support waiting.");
 
         do {
-            auto buffer = allocateMemoryPoolBufferImpl(alloc, onFailure);
-            if (buffer.has_value()) return std::move(*buffer);
+            std::expected<MemoryPoolBufferPtr, std::unique_ptr<std::latch>> buffer;
+            try
+            {
+                buffer = allocateMemoryPoolBufferImpl(alloc, onFailure);
+            }
+            catch (...)
+            {
+                ++failedAllocations;
+                throw;
+            }
+
+            if (buffer.has_value())
+            {
+                if (!*buffer) ++failedAllocations;
+                return std::move(*buffer);
+            }
 
             // Pool will count down at latch as well, signaling we can try allocating again.
             if (onFailure == OnAllocationFailure::Wait)
             {
+                ++waits;
                 buffer.error()->arrive_and_wait();
                 continue;
             }
+
+            ++failedAllocations;
             if (onFailure == OnAllocationFailure::Empty)
             {
                 return nullptr;
@@ -167,4 +267,20 @@ namespace sol
             throw SolError("Failed to allocate buffer from memory pool.");
         } while (true);
     }
+
+    void IMemoryPool::recordAllocation(const size_t size) noexcept
+    {
+        ++liveAllocations;
+        ++totalAllocations;
+        const size_t bytes = liveBytes += size;
+
+        size_t peak = highWatermark.load();
+        while (bytes > peak && !highWatermark.compare_exchange_weak(peak, bytes)) {}
+    }
+
+    void IMemoryPool::recordRelease(const size_t size) noexcept
+    {
+        --liveAllocations;
+        liveBytes -= size;
+    }
 }  // namespace sol
@@ -4,6 +4,12 @@
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
+#include "sol-core/vulkan_buffer.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
 #include "sol-memory/pool/i_memory_pool.h"
 
 namespace sol
@@ -17,19 +23,26 @@ namespace sol
                                        const size_t       id,
                                        VulkanBuffer&      buffer,
                                        const size_t       bufferSize,
-                                       const size_t       bufferOffset) :
+                                       const size_t       bufferOffset,
+                                       const bool         recordStatistics) :
         IBuffer(memoryPool.getMemoryManager(), queueFamily),
         pool(&memoryPool),
         identifier(id),
         buffer(&buffer),
         size(bufferSize),
-        offset(bufferOffset)
+        offset(bufferOffset),
+        recorded(recordStatistics)
     {
+        if (recorded) pool->recordAllocation(size);
     }
 
     MemoryPoolBuffer::MemoryPoolBuffer(MemoryPoolBuffer&&) noexcept = default;
 
-    MemoryPoolBuffer::~MemoryPoolBuffer() noexcept { pool->releaseBuffer(*this); }
+    MemoryPoolBuffer::~MemoryPoolBuffer() noexcept
+    {
+        pool->releaseBuffer(*this);
+        if (recorded) pool->recordRelease(size);
+    }
 
     MemoryPoolBuffer& MemoryPoolBuffer::operator=(MemoryPoolBuffer&&) noexcept = default;
 
@@ -51,6 +64,19 @@ namespace sol
 
     size_t MemoryPoolBuffer::getBufferOffset() const noexcept { return offset; }
 
-    bool MemoryPoolBuffer::isSubAllocation() const noexcept { return offset > 0; }
+    bool MemoryPoolBuffer::isSubAllocation() const noexcept { return offset > 0 || size < buffer->getSize(); }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void MemoryPoolBuffer::setRelocationCallback(RelocationCallback callback) { onRelocate = std::move(callback); }
+
+    void MemoryPoolBuffer::relocate(VulkanBuffer& newBuffer, const size_t newOffset)
+    {
+        buffer = &newBuffer;
+        offset = newOffset;
+        if (onRelocate) onRelocate(*this);
+    }
 
 }  // namespace sol
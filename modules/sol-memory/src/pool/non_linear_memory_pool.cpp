@@ -1,5 +1,16 @@
 #include "sol-memory/pool/non_linear_memory_pool.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <format>
+#include <tuple>
+#include <unordered_map>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -12,6 +23,8 @@
 
 #include "sol-core/vulkan_buffer.h"
 #include "sol-core/vulkan_memory_pool.h"
+#include "sol-error/sol_error.h"
+#include "sol-error/vulkan_error_handler.h"
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -19,6 +32,30 @@
 
 #include "sol-memory/memory_manager.h"
 #include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/transaction.h"
+
+namespace
+{
+    /**
+     * \brief Size of the smallest size class of the thread caches.
+     */
+    constexpr size_t minSizeClass = 256;
+
+    /**
+     * \brief Buffer identifiers with this bit set were allocated from a thread cache. The other bits hold the size
+     * class.
+     */
+    constexpr size_t cachedIdBit = size_t{1} << (sizeof(size_t) * 8 - 1);
+
+    std::atomic_size_t nextUid = 1;
+
+    [[nodiscard]] size_t getSizeClass(const size_t size) noexcept
+    {
+        return std::bit_width(std::max(size, minSizeClass) - 1) - std::bit_width(minSizeClass - 1);
+    }
+
+    [[nodiscard]] size_t getSizeClassSize(const size_t sizeClass) noexcept { return minSizeClass << sizeClass; }
+}  // namespace
 
 namespace sol
 {
@@ -30,11 +67,22 @@ namespace sol
                                              std::string         poolName,
                                              const CreateInfo&   createInfo,
                                              VulkanMemoryPoolPtr memoryPool) :
-        IMemoryPool(memoryManager, std::move(poolName), createInfo, std::move(memoryPool))
+        IMemoryPool(memoryManager, std::move(poolName), createInfo, std::move(memoryPool)), uid(nextUid++)
     {
+        for (size_t i = 0; i < getMinBlocks(); i++) static_cast<void>(createBlock(true));
     }
 
-    NonLinearMemoryPool::~NonLinearMemoryPool() noexcept = default;
+    NonLinearMemoryPool::~NonLinearMemoryPool() noexcept
+    {
+        // Release temporary buffers of an unfinished defragmentation pass.
+        moves.clear();
+
+        for (const auto& block : blocks)
+        {
+            vmaClearVirtualBlock(block.virtualBlock);
+            vmaDestroyVirtualBlock(block.virtualBlock);
+        }
+    }
 
     ////////////////////////////////////////////////////////////////
     // Getters.
@@ -42,59 +90,436 @@ namespace sol
 
     IMemoryPool::Capabilities NonLinearMemoryPool::getCapabilities() const noexcept
     {
-        // TODO: This pool should also support defragging.
-        return Capabilities::None;
+        return Capabilities::Defragmentation;
+    }
+
+    size_t NonLinearMemoryPool::getBlockCount()
+    {
+        std::scoped_lock lock(mutex);
+        return blocks.size();
+    }
+
+    bool NonLinearMemoryPool::isDefragmenting()
+    {
+        std::scoped_lock lock(mutex);
+        return defragmenting;
+    }
+
+    size_t NonLinearMemoryPool::getThreadCacheMaxSize() const noexcept { return threadCacheMaxSize; }
+
+    size_t NonLinearMemoryPool::getThreadCacheBatchSize() const noexcept { return threadCacheBatchSize; }
+
+    IMemoryPool::FreeBlockHistogram NonLinearMemoryPool::getFreeBlockHistogram()
+    {
+        std::scoped_lock lock(mutex);
+
+        // Sort live ranges by block and offset, so that the gaps between them can be collected in a single pass.
+        std::vector<std::tuple<size_t, size_t, size_t>> ranges;
+        for (const auto& alloc : allocations)
+            if (alloc.allocation != VK_NULL_HANDLE) ranges.emplace_back(alloc.block, alloc.offset, alloc.size);
+        for (const auto& slab : slabs) ranges.emplace_back(slab.block, slab.offset, slab.size);
+        std::ranges::sort(ranges);
+
+        FreeBlockHistogram histogram;
+        auto               it = ranges.begin();
+        for (size_t block = 0; block < blocks.size(); block++)
+        {
+            size_t end = 0;
+            for (; it != ranges.end() && std::get<0>(*it) == block; ++it)
+            {
+                const auto [_, offset, size] = *it;
+                histogram.add(offset - end);
+                end = offset + size;
+            }
+            histogram.add(blocks[block].buffer->getSize() - end);
+        }
+
+        return histogram;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void NonLinearMemoryPool::setThreadCache(const size_t maxSize, const size_t batchSize)
+    {
+        if (maxSize > getBlockSize())
+            throw SolError(std::format("Cannot enable thread caches for allocations of up to {} bytes in a memory pool "
+                                       "with a block size of {} bytes.",
+                                       maxSize,
+                                       getBlockSize()));
+        if (batchSize == 0) throw SolError("Cannot enable thread caches with a batch size of 0.");
+        if (const size_t bytes = getStatistics().liveBytes; bytes != 0)
+            throw SolError(std::format("Cannot change thread caches of a memory pool with {} live bytes.", bytes));
+
+        std::scoped_lock lock(mutex, sharedSlotsMutex);
+
+        // Without live allocations, all slots are free. Release the slabs they were carved from and let the threads
+        // discard their slots.
+        for (const auto& slab : slabs) vmaVirtualFree(blocks[slab.block].virtualBlock, slab.allocation);
+        slabs.clear();
+        sharedSlots.clear();
+        ++cacheGeneration;
+
+        threadCacheMaxSize   = maxSize == 0 ? 0 : std::max(std::bit_ceil(maxSize), minSizeClass);
+        threadCacheBatchSize = batchSize;
+        if (threadCacheMaxSize > 0) sharedSlots.resize(getSizeClass(threadCacheMaxSize) + 1);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Defragmentation.
+    ////////////////////////////////////////////////////////////////
+
+    NonLinearMemoryPool::DefragmentationStats NonLinearMemoryPool::beginDefragmentation(Transaction& transaction,
+                                                                                        const size_t maxBytes)
+    {
+        DefragmentationStats stats;
+        std::scoped_lock     lock(mutex);
+
+        if (defragmenting) throw SolError("Cannot begin a defragmentation pass before the previous one has ended.");
+        defragmenting = true;
+
+        // Try to move allocations from the back of the pool first, so that trailing blocks are emptied.
+        std::vector<size_t> candidates;
+        for (size_t id = 0; id < allocations.size(); id++)
+            if (allocations[id].allocation != VK_NULL_HANDLE) candidates.push_back(id);
+        std::ranges::sort(candidates, [this](const size_t lhs, const size_t rhs) {
+            const auto& l = allocations[lhs];
+            const auto& r = allocations[rhs];
+            return l.block != r.block ? l.block > r.block : l.offset > r.offset;
+        });
+
+        for (const auto id : candidates)
+        {
+            // Copy, since the list of allocations can be resized below.
+            const auto src = allocations[id];
+            if (maxBytes > 0 && stats.bytesMoved + src.size > maxBytes) continue;
+
+            // Look for the lowest available range in the blocks up to and including the current block.
+            const VmaVirtualAllocationCreateInfo info{.size      = src.size,
+                                                      .alignment = src.alignment,
+                                                      .flags = VMA_VIRTUAL_ALLOCATION_CREATE_STRATEGY_MIN_OFFSET_BIT,
+                                                      .pUserData = nullptr};
+
+            VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+            VkDeviceSize         offset            = 0;
+            size_t               blockIndex        = 0;
+            for (; blockIndex <= src.block; blockIndex++)
+            {
+                if (vmaVirtualAllocate(blocks[blockIndex].virtualBlock, &info, &virtualAllocation, &offset) !=
+                    VK_SUCCESS)
+                    continue;
+
+                // Only keep the new range if it is before the current one.
+                if (blockIndex == src.block && offset > src.offset)
+                {
+                    vmaVirtualFree(blocks[blockIndex].virtualBlock, virtualAllocation);
+                    blockIndex = src.block + 1;
+                }
+                break;
+            }
+            if (blockIndex > src.block) continue;
+
+            // Create a temporary buffer for the destination range. It is not counted in the statistics, since it only
+            // exists until the move has finished.
+            const auto dstId = getFreeId();
+            auto       dst   = std::make_unique<MemoryPoolBuffer>(
+              *this, getDefaultQueueFamily(), dstId, *blocks[blockIndex].buffer, src.size, offset, false);
+            allocations[dstId] = Allocation{.block      = blockIndex,
+                                            .allocation = virtualAllocation,
+                                            .offset     = offset,
+                                            .size       = src.size,
+                                            .alignment  = src.alignment,
+                                            .owner      = dst.get(),
+                                            .moving     = false};
+            allocations[id].moving = true;
+
+            // Copy data. Ownership of the source buffer is temporarily moved to the transfer queue and returned
+            // afterwards. The destination ends up with the same owner as the source.
+            auto& srcBuffer = *src.owner;
+            auto& family    = srcBuffer.getQueueFamily();
+            transaction.stage(
+              BufferToBufferCopy{.srcBuffer              = srcBuffer,
+                                 .dstBuffer              = *dst,
+                                 .size                   = src.size,
+                                 .srcOffset              = 0,
+                                 .dstOffset              = 0,
+                                 .srcOnDedicatedTransfer = true,
+                                 .dstOnDedicatedTransfer = true},
+              BufferBarrier{.buffer    = srcBuffer,
+                            .srcFamily = &family,
+                            .dstFamily = &family,
+                            .srcStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                            .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                            .srcAccess = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                            .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT},
+              BufferBarrier{.buffer    = *dst,
+                            .srcFamily = &dst->getQueueFamily(),
+                            .dstFamily = &family,
+                            .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                            .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                            .srcAccess = VK_ACCESS_2_NONE,
+                            .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT});
+
+            moves.emplace_back(Move{.id = id, .dst = std::move(dst)});
+            stats.bytesMoved += src.size;
+            stats.allocationsMoved++;
+        }
+
+        return stats;
+    }
+
+    void NonLinearMemoryPool::endDefragmentation()
+    {
+        std::vector<Move>                                                  finishedMoves;
+        std::vector<std::tuple<MemoryPoolBuffer*, VulkanBuffer*, size_t>> relocations;
+
+        {
+            std::scoped_lock lock(mutex);
+
+            if (!defragmenting) throw SolError("Cannot end a defragmentation pass that was not begun.");
+
+            // Swap the source and destination ranges. The temporary buffers now own the old ranges.
+            for (const auto& [id, dst] : moves)
+            {
+                auto& srcAlloc = allocations[id];
+                auto& dstAlloc = allocations[dst->getId()];
+                std::swap(srcAlloc.block, dstAlloc.block);
+                std::swap(srcAlloc.allocation, dstAlloc.allocation);
+                std::swap(srcAlloc.offset, dstAlloc.offset);
+                srcAlloc.moving = false;
+
+                relocations.emplace_back(srcAlloc.owner, blocks[srcAlloc.block].buffer.get(), srcAlloc.offset);
+                relocations.emplace_back(dstAlloc.owner, blocks[dstAlloc.block].buffer.get(), dstAlloc.offset);
+            }
+
+            finishedMoves = std::move(moves);
+            moves.clear();
+            defragmenting = false;
+        }
+
+        // Invoke callbacks without holding the lock, so that they can safely use this pool.
+        for (const auto& [owner, buffer, offset] : relocations) owner->relocate(*buffer, offset);
+
+        // Release the old ranges.
+        finishedMoves.clear();
+
+        // Destroy trailing empty blocks.
+        std::scoped_lock lock(mutex);
+        while (blocks.size() > getMinBlocks())
+        {
+            VmaStatistics blockStats;
+            vmaGetVirtualBlockStatistics(blocks.back().virtualBlock, &blockStats);
+            if (blockStats.allocationCount > 0) break;
+
+            vmaDestroyVirtualBlock(blocks.back().virtualBlock);
+            blocks.pop_back();
+        }
     }
 
     ////////////////////////////////////////////////////////////////
     // Allocations.
     ////////////////////////////////////////////////////////////////
 
+    bool NonLinearMemoryPool::createBlock(const bool throwOnOutOfMemory)
+    {
+        VulkanBuffer::Settings settings;
+        settings.device      = getDevice();
+        settings.size        = getBlockSize();
+        settings.bufferUsage = getBufferUsage();
+        settings.allocator   = getMemoryManager().getAllocator();
+        settings.vma.pool    = pool;
+        settings.vma.flags   = getAllocationFlags();
+        getMemoryManager().setSharingMode(settings, getSharingMode());
+
+        auto buffer = VulkanBuffer::create(settings, throwOnOutOfMemory);
+        if (!buffer) return false;
+
+        const VmaVirtualBlockCreateInfo blockCreateInfo{
+          .size = getBlockSize(), .flags = 0, .pAllocationCallbacks = nullptr};
+        VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+        handleVulkanError(vmaCreateVirtualBlock(&blockCreateInfo, &virtualBlock));
+
+        blocks.emplace_back(Block{.buffer = std::move(buffer), .virtualBlock = virtualBlock});
+        return true;
+    }
+
+    bool NonLinearMemoryPool::allocateRange(const VmaVirtualAllocationCreateInfo& info,
+                                            const bool                            throwOnOutOfMemory,
+                                            size_t&                               blockIndex,
+                                            VmaVirtualAllocation&                 virtualAllocation,
+                                            VkDeviceSize&                         offset)
+    {
+        // Try to allocate from existing blocks.
+        for (blockIndex = 0; blockIndex < blocks.size(); blockIndex++)
+        {
+            if (vmaVirtualAllocate(blocks[blockIndex].virtualBlock, &info, &virtualAllocation, &offset) == VK_SUCCESS)
+                return true;
+        }
+
+        // All blocks are full, try to create a new block.
+        if ((getMaxBlocks() > 0 && blocks.size() == getMaxBlocks()) || !createBlock(throwOnOutOfMemory)) return false;
+
+        handleVulkanError(vmaVirtualAllocate(blocks[blockIndex].virtualBlock, &info, &virtualAllocation, &offset));
+        return true;
+    }
+
+    NonLinearMemoryPool::SlotLists& NonLinearMemoryPool::getThreadCache() const
+    {
+        thread_local std::unordered_map<size_t, ThreadSlots> caches;
+
+        auto& cache = caches[uid];
+        if (const size_t generation = cacheGeneration.load(); cache.generation != generation)
+        {
+            // The slabs of outdated slots were released by setThreadCache.
+            cache.generation = generation;
+            cache.slots.clear();
+            cache.slots.resize(getSizeClass(threadCacheMaxSize) + 1);
+        }
+        return cache.slots;
+    }
+
+    bool NonLinearMemoryPool::refillThreadCache(const size_t       sizeClass,
+                                                std::vector<Slot>& slots,
+                                                const bool         throwOnOutOfMemory)
+    {
+        // Take slots that were returned by other threads.
+        {
+            std::scoped_lock lock(sharedSlotsMutex);
+            auto&            shared = sharedSlots[sizeClass];
+            const size_t     count  = std::min(shared.size(), threadCacheBatchSize);
+            slots.insert(slots.end(), shared.end() - static_cast<ptrdiff_t>(count), shared.end());
+            shared.resize(shared.size() - count);
+            if (count > 0) return true;
+        }
+
+        // Carve a new slab into slots. The slab is aligned to the size class, so that each slot is as well.
+        const size_t                         slotSize = getSizeClassSize(sizeClass);
+        const size_t                         count    = std::min(threadCacheBatchSize, getBlockSize() / slotSize);
+        const VmaVirtualAllocationCreateInfo info{
+          .size = slotSize * count, .alignment = slotSize, .flags = 0, .pUserData = nullptr};
+
+        std::scoped_lock     lock(mutex);
+        size_t               blockIndex        = 0;
+        VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+        VkDeviceSize         offset            = 0;
+        if (!allocateRange(info, throwOnOutOfMemory, blockIndex, virtualAllocation, offset)) return false;
+
+        slabs.emplace_back(
+          Slab{.block = blockIndex, .allocation = virtualAllocation, .offset = offset, .size = info.size});
+        for (size_t i = 0; i < count; i++)
+            slots.emplace_back(Slot{.buffer = blocks[blockIndex].buffer.get(), .offset = offset + i * slotSize});
+
+        return true;
+    }
+
+    size_t NonLinearMemoryPool::getFreeId()
+    {
+        if (freeIds.empty())
+        {
+            allocations.emplace_back();
+            return allocations.size() - 1;
+        }
+
+        const auto id = freeIds.back();
+        freeIds.pop_back();
+        return id;
+    }
+
     void NonLinearMemoryPool::releaseBuffer(const MemoryPoolBuffer& buffer)
     {
+        assert(&buffer.getMemoryPool() == this);
+
+        // Return slot to the thread cache without taking the lock of the pool.
+        if (buffer.getId() & cachedIdBit)
+        {
+            const size_t sizeClass = buffer.getId() & ~cachedIdBit;
+            auto&        slots     = getThreadCache()[sizeClass];
+            // Block buffers are owned by this pool, the buffer is only const in the view of the MemoryPoolBuffer.
+            slots.emplace_back(
+              Slot{.buffer = const_cast<VulkanBuffer*>(&buffer.getBuffer()), .offset = buffer.getBufferOffset()});
+
+            // Hand a batch over to the shared list, so that memory released on this thread can be reused by others.
+            if (slots.size() >= 2 * threadCacheBatchSize)
+            {
+                std::scoped_lock lock(sharedSlotsMutex);
+                auto&            shared = sharedSlots[sizeClass];
+                shared.insert(shared.end(), slots.end() - static_cast<ptrdiff_t>(threadCacheBatchSize), slots.end());
+                slots.resize(slots.size() - threadCacheBatchSize);
+            }
+            return;
+        }
+
         std::scoped_lock lock(mutex);
 
-        assert(&buffer.getMemoryPool() == this);
-        assert(buffer.getId() < buffers.size());
-        assert(buffers[buffer.getId()]);
-        buffers[buffer.getId()].reset();
+        assert(buffer.getId() < allocations.size());
+        assert(allocations[buffer.getId()].allocation != VK_NULL_HANDLE);
+
+        auto& allocation = allocations[buffer.getId()];
+        assert(!allocation.moving);
+        vmaVirtualFree(blocks[allocation.block].virtualBlock, allocation.allocation);
+        allocation = {};
+        freeIds.push_back(buffer.getId());
     }
 
     std::expected<MemoryPoolBufferPtr, std::unique_ptr<std::latch>>
       NonLinearMemoryPool::allocateMemoryPoolBufferImpl(const AllocationInfo&     alloc,
                                                         const OnAllocationFailure onFailure)
     {
+        // Small allocations are served from the thread cache without taking the lock of the pool. Slots are aligned to
+        // their size class, so the size class must be at least the alignment.
+        const size_t alignment = std::max(alloc.alignment, getRequiredAlignment());
+        if (const size_t size = std::max(alloc.size, alignment); threadCacheMaxSize > 0 && size <= threadCacheMaxSize)
+        {
+            const size_t sizeClass = getSizeClass(size);
+            auto&        slots     = getThreadCache()[sizeClass];
+            if (slots.empty() && !refillThreadCache(sizeClass, slots, onFailure != OnAllocationFailure::Empty))
+            {
+                if (onFailure == OnAllocationFailure::Empty) return nullptr;
+                throw SolError("Failed to allocate buffer from memory pool. Pool is out of memory.");
+            }
+
+            const auto slot = slots.back();
+            slots.pop_back();
+            return std::make_unique<MemoryPoolBuffer>(
+              *this, getDefaultQueueFamily(), cachedIdBit | sizeClass, *slot.buffer, alloc.size, slot.offset);
+        }
+
         std::scoped_lock lock(mutex);
 
-        VulkanBuffer::Settings settings;
-        settings.device        = getDevice();
-        settings.size          = alloc.size;
-        settings.bufferUsage   = alloc.bufferUsage;
-        settings.allocator     = getMemoryManager().getAllocator();
-        settings.vma.pool      = pool;
-        settings.vma.flags     = getAllocationFlags();
-        settings.vma.alignment = alloc.alignment;
-
-        // Look for empty spot.
-        size_t id = 0;
-        for (; id < buffers.size(); id++)
+        if (alloc.size > getBlockSize())
         {
-            if (!buffers[id]) break;
+            if (onFailure == OnAllocationFailure::Empty) return nullptr;
+            throw SolError(
+              std::format("Cannot allocate buffer of {} bytes from memory pool with a block size of {} bytes.",
+                          alloc.size,
+                          getBlockSize()));
         }
 
-        // No empty spot found, construct at end.
-        if (id == buffers.size())
+        const VmaVirtualAllocationCreateInfo info{.size      = alloc.size,
+                                                  .alignment = alignment,
+                                                  .flags     = 0,
+                                                  .pUserData = nullptr};
+        VmaVirtualAllocation virtualAllocation = VK_NULL_HANDLE;
+        VkDeviceSize         offset            = 0;
+        size_t               blockIndex        = 0;
+        if (!allocateRange(info, onFailure != OnAllocationFailure::Empty, blockIndex, virtualAllocation, offset))
         {
-            auto buffer = VulkanBuffer::create(settings, onFailure != OnAllocationFailure::Empty);
-            if (!buffer) return nullptr;
-            auto& b = *buffers.emplace_back(std::move(buffer));
-            return std::make_unique<MemoryPoolBuffer>(*this, getDefaultQueueFamily(), id, b, alloc.size, 0);
+            if (onFailure == OnAllocationFailure::Empty) return nullptr;
+            throw SolError("Failed to allocate buffer from memory pool. Pool is out of memory.");
         }
 
-        // Fill in empty spot.
-        auto buffer = VulkanBuffer::create(settings, onFailure != OnAllocationFailure::Empty);
-        if (!buffer) return nullptr;
-        buffers[id] = std::move(buffer);
-        return std::make_unique<MemoryPoolBuffer>(*this, getDefaultQueueFamily(), id, *buffers[id], alloc.size, 0);
+        const auto id     = getFreeId();
+        auto       buffer = std::make_unique<MemoryPoolBuffer>(
+          *this, getDefaultQueueFamily(), id, *blocks[blockIndex].buffer, alloc.size, offset);
+        allocations[id] = Allocation{.block      = blockIndex,
+                                     .allocation = virtualAllocation,
+                                     .offset     = offset,
+                                     .size       = alloc.size,
+                                     .alignment  = info.alignment,
+                                     .owner      = buffer.get(),
+                                     .moving     = false};
+
+        return buffer;
     }
 }  // namespace sol
@@ -1,5 +1,14 @@
 #include "sol-memory/pool/ring_buffer_memory_pool.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+#include <optional>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -12,6 +21,7 @@
 
 #include "sol-core/vulkan_buffer.h"
 #include "sol-core/vulkan_memory_pool.h"
+#include "sol-error/sol_error.h"
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -32,6 +42,15 @@ namespace sol
                                                VulkanMemoryPoolPtr memoryPool) :
         IMemoryPool(memoryManager, std::move(poolName), createInfo, std::move(memoryPool))
     {
+        VulkanBuffer::Settings settings;
+        settings.device      = getDevice();
+        settings.size        = getBlockSize();
+        settings.bufferUsage = getBufferUsage();
+        settings.allocator   = getMemoryManager().getAllocator();
+        settings.vma.pool    = pool;
+        settings.vma.flags   = getAllocationFlags();
+        getMemoryManager().setSharingMode(settings, getSharingMode());
+        ringBuffer = VulkanBuffer::create(settings);
     }
 
     RingBufferMemoryPool::~RingBufferMemoryPool() noexcept = default;
@@ -42,6 +61,28 @@ namespace sol
 
     IMemoryPool::Capabilities RingBufferMemoryPool::getCapabilities() const noexcept { return Capabilities::Wait; }
 
+    VulkanBuffer& RingBufferMemoryPool::getBuffer() noexcept { return *ringBuffer; }
+
+    const VulkanBuffer& RingBufferMemoryPool::getBuffer() const noexcept { return *ringBuffer; }
+
+    IMemoryPool::FreeBlockHistogram RingBufferMemoryPool::getFreeBlockHistogram()
+    {
+        std::scoped_lock lock(mutex);
+
+        FreeBlockHistogram histogram;
+        if (allocations.empty())
+            histogram.add(ringBuffer->getSize());
+        else if (head < tail)
+            histogram.add(tail - head);
+        else if (head > tail)
+        {
+            histogram.add(ringBuffer->getSize() - head);
+            histogram.add(tail);
+        }
+
+        return histogram;
+    }
+
     ////////////////////////////////////////////////////////////////
     // Allocations.
     ////////////////////////////////////////////////////////////////
@@ -51,10 +92,27 @@ namespace sol
         std::scoped_lock lock(mutex);
 
         assert(&buffer.getMemoryPool() == this);
-        assert(buffer.getId() < buffers.size());
-        assert(buffers[buffer.getId()]);
+        assert(buffer.getId() >= firstId);
+        assert(buffer.getId() - firstId < allocations.size());
+        assert(!allocations[buffer.getId() - firstId].released);
 
-        buffers[buffer.getId()].reset();
+        allocations[buffer.getId() - firstId].released = true;
+
+        // Advance tail past all released allocations at the front.
+        while (!allocations.empty() && allocations.front().released)
+        {
+            allocations.pop_front();
+            firstId++;
+        }
+
+        // Reset to the start of the buffer when empty, so that the next allocation has the full block available.
+        if (allocations.empty())
+        {
+            head = 0;
+            tail = 0;
+        }
+        else
+            tail = allocations.front().offset;
 
         // Signal all threads that are waiting they can try again.
         for (const auto& latch : latches) latch->count_down();
@@ -67,39 +125,53 @@ namespace sol
     {
         std::scoped_lock lock(mutex);
 
-        VulkanBuffer::Settings settings;
-        settings.device        = getDevice();
-        settings.size          = alloc.size;
-        settings.bufferUsage   = alloc.bufferUsage;
-        settings.allocator     = getMemoryManager().getAllocator();
-        settings.vma.pool      = pool;
-        settings.vma.flags     = getAllocationFlags();
-        settings.vma.alignment = alloc.alignment;
-
-        // Look for empty spot.
-        size_t id = 0;
-        for (; id < buffers.size(); id++)
+        const size_t blockSize = ringBuffer->getSize();
+
+        // Allocation can never fit. Waiting would block forever.
+        if (alloc.size > blockSize)
         {
-            if (!buffers[id]) break;
+            if (onFailure == OnAllocationFailure::Empty) return nullptr;
+            throw SolError(std::format(
+              "Cannot allocate buffer of {} bytes from ring buffer memory pool with {} bytes.", alloc.size, blockSize));
         }
 
-        // No empty spot found, construct at end.
-        if (id == buffers.size()) buffers.resize(id + 1);
+        const size_t alignment = std::lcm(std::max<size_t>(alloc.alignment, 1), getRequiredAlignment());
+        const size_t aligned   = (head + alignment - 1) / alignment * alignment;
 
-        // Try to allocate buffer. If allocation fails and waitOnOutOfMemory is false, this will automatically throw.
-        auto buffer = VulkanBuffer::create(settings, onFailure == OnAllocationFailure::Throw);
+        // Look for a contiguous range after the head. If the head is behind the tail, the only free range is
+        // [head, tail). Otherwise, there is [head, blockSize) and, after wrapping around, [0, tail).
+        std::optional<size_t> offset;
+        if (allocations.empty())
+            offset = 0;
+        else if (head < tail)
+        {
+            if (aligned + alloc.size <= tail) offset = aligned;
+        }
+        else if (head > tail)
+        {
+            if (aligned + alloc.size <= blockSize)
+                offset = aligned;
+            else if (alloc.size <= tail)
+                offset = 0;
+        }
 
         // Allocation failed because pool is out of memory. Return nullptr or a std::latch that is signalled when a buffer is released.
-        if (!buffer)
+        if (!offset)
         {
             if (onFailure == OnAllocationFailure::Empty) return nullptr;
+            if (onFailure == OnAllocationFailure::Throw)
+                throw SolError("Failed to allocate buffer from ring buffer memory pool. Pool is out of memory.");
 
             auto latch = std::make_unique<std::latch>(2);
             latches.emplace_back(latch.get());
             return std::unexpected(std::move(latch));
         }
 
-        buffers[id] = std::move(buffer);
-        return std::make_unique<MemoryPoolBuffer>(*this, getDefaultQueueFamily(), id, *buffers[id], alloc.size, 0);
+        const size_t id = firstId + allocations.size();
+        allocations.emplace_back(Allocation{.offset = *offset, .size = alloc.size, .released = false});
+        head = *offset + alloc.size;
+        if (allocations.size() == 1) tail = *offset;
+
+        return std::make_unique<MemoryPoolBuffer>(*this, getDefaultQueueFamily(), id, *ringBuffer, alloc.size, *offset);
     }
 }  // namespace sol
@@ -100,6 +100,7 @@ namespace sol
         settings.vma.pool      = pool;
         settings.vma.flags     = getAllocationFlags();
         settings.vma.alignment = alloc.alignment;
+        getMemoryManager().setSharingMode(settings, getSharingMode());
 
         // Look for empty spot.
         if (currentIndex < buffers.size())
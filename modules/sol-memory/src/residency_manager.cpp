@@ -0,0 +1,298 @@
+#include "sol-memory/residency_manager.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    ResidencyManager::ResidencyManager(MemoryManager& memoryManager, TransactionManager& transactionManager) :
+        memoryManager(&memoryManager), transactionManager(&transactionManager)
+    {
+    }
+
+    ResidencyManager::~ResidencyManager() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    MemoryManager& ResidencyManager::getMemoryManager() noexcept { return *memoryManager; }
+
+    const MemoryManager& ResidencyManager::getMemoryManager() const noexcept { return *memoryManager; }
+
+    TransactionManager& ResidencyManager::getTransactionManager() noexcept { return *transactionManager; }
+
+    const TransactionManager& ResidencyManager::getTransactionManager() const noexcept { return *transactionManager; }
+
+    size_t ResidencyManager::getBudget() const
+    {
+        if (budget > 0) return budget;
+
+        size_t total = 0;
+        for (const auto& heap : memoryManager->getHeapBudgets())
+            if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) total += heap.budget;
+        return static_cast<size_t>(static_cast<double>(total) * budgetFraction);
+    }
+
+    size_t ResidencyManager::getUsage() const
+    {
+        if (budget > 0) return statistics.residentBytes;
+
+        size_t total = 0;
+        for (const auto& heap : memoryManager->getHeapBudgets())
+            if (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) total += heap.usage;
+        return total;
+    }
+
+    float ResidencyManager::getBudgetFraction() const noexcept { return budgetFraction; }
+
+    bool ResidencyManager::isResident(const Handle handle) const { return getEntry(handle).resident; }
+
+    uint64_t ResidencyManager::getLastUsedFrame(const Handle handle) const { return getEntry(handle).lastUsed; }
+
+    ResidencyManager::Statistics ResidencyManager::getStatistics() const noexcept { return statistics; }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void ResidencyManager::setBudget(const size_t bytes) noexcept { budget = bytes; }
+
+    void ResidencyManager::setBudgetFraction(const float fraction)
+    {
+        if (fraction <= 0.0f || fraction > 1.0f)
+            throw SolError(std::format("Cannot set budget fraction to {}. Must be in (0, 1].", fraction));
+        budgetFraction = fraction;
+    }
+
+    void ResidencyManager::setPriority(const Handle handle, const uint32_t priority)
+    {
+        getEntry(handle).resource.priority = priority;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Resources.
+    ////////////////////////////////////////////////////////////////
+
+    ResidencyManager::Handle ResidencyManager::add(Resource resource)
+    {
+        if (!resource.download || !resource.release || !resource.restore)
+            throw SolError("Cannot register resource with ResidencyManager. Not all functions were set.");
+
+        Handle handle = entries.size();
+        if (!freeHandles.empty())
+        {
+            handle = freeHandles.back();
+            freeHandles.pop_back();
+        }
+        else
+            entries.emplace_back();
+
+        statistics.residentCount++;
+        statistics.residentBytes += resource.size;
+        entries[handle] = Entry{.resource = std::move(resource), .lastUsed = 0, .registered = true, .resident = true};
+
+        return handle;
+    }
+
+    ResidencyManager::Handle ResidencyManager::addBuffer(IBufferPtr&                             buffer,
+                                                         IBufferAllocator&                       allocator,
+                                                         const IBufferAllocator::AllocationInfo& info,
+                                                         const uint32_t                          priority)
+    {
+        Resource resource;
+        resource.size     = info.size;
+        resource.priority = priority;
+        resource.download = [&buffer, size = info.size](Transaction& transaction, IBuffer& dstBuffer) {
+            buffer->getData(transaction,
+                            dstBuffer,
+                            IBuffer::Barrier{.dstFamily = nullptr,
+                                             .srcStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_NONE,
+                                             .srcAccess = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                                             .dstAccess = VK_ACCESS_2_NONE},
+                            IBuffer::Barrier{.dstFamily = nullptr,
+                                             .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                             .srcAccess = VK_ACCESS_2_NONE,
+                                             .dstAccess = VK_ACCESS_2_HOST_READ_BIT},
+                            size,
+                            0,
+                            0);
+        };
+        resource.release = [&buffer] { buffer.reset(); };
+        resource.restore = [&buffer, &allocator, info](Transaction& transaction, const void* data) {
+            buffer = allocator.allocateBuffer(info, IBufferAllocator::OnAllocationFailure::Empty);
+            if (!buffer) return false;
+            return buffer->setData(transaction,
+                                   data,
+                                   info.size,
+                                   0,
+                                   IBuffer::Barrier{.dstFamily = nullptr,
+                                                    .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                                    .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                                    .srcAccess = VK_ACCESS_2_NONE,
+                                                    .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT},
+                                   false);
+        };
+
+        return add(std::move(resource));
+    }
+
+    void ResidencyManager::remove(const Handle handle)
+    {
+        auto& entry = getEntry(handle);
+        if (entry.resident)
+        {
+            statistics.residentCount--;
+            statistics.residentBytes -= entry.resource.size;
+        }
+        else
+        {
+            statistics.evictedCount--;
+            statistics.evictedBytes -= entry.resource.size;
+        }
+
+        entry = Entry{};
+        freeHandles.push_back(handle);
+    }
+
+    bool ResidencyManager::touch(Transaction& transaction, const Handle handle, const uint64_t frame)
+    {
+        auto& entry    = getEntry(handle);
+        entry.lastUsed = std::max(entry.lastUsed, frame);
+        if (entry.resident) return true;
+
+        if (!entry.resource.restore(transaction, entry.backing.data()))
+        {
+            // Allocation of device memory may have succeeded. Release it again, so that the state is consistent.
+            entry.resource.release();
+            return false;
+        }
+
+        // Data was copied into staging memory, so the backing copy is no longer needed.
+        entry.backing  = {};
+        entry.resident = true;
+        statistics.evictedCount--;
+        statistics.evictedBytes -= entry.resource.size;
+        statistics.residentCount++;
+        statistics.residentBytes += entry.resource.size;
+        statistics.restores++;
+
+        return true;
+    }
+
+    size_t ResidencyManager::enforceBudget(const uint64_t frame)
+    {
+        const size_t limit = getBudget();
+        const size_t usage = getUsage();
+        if (usage <= limit) return 0;
+
+        // Order candidates by priority and then by the frame in which they were last used.
+        std::vector<Handle> candidates;
+        for (Handle handle = 0; handle < entries.size(); handle++)
+        {
+            const auto& entry = entries[handle];
+            if (entry.registered && entry.resident && entry.lastUsed < frame) candidates.push_back(handle);
+        }
+        std::ranges::sort(candidates, [this](const Handle lhs, const Handle rhs) {
+            const auto& l = entries[lhs];
+            const auto& r = entries[rhs];
+            return l.resource.priority != r.resource.priority ? l.resource.priority < r.resource.priority :
+                                                                l.lastUsed < r.lastUsed;
+        });
+
+        // Allocate host visible buffers to download the contents of all victims into.
+        IBufferAllocator::AllocationInfo info{
+          .size                 = 0,
+          .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment       = 0};
+        std::vector<std::pair<Handle, IBufferPtr>> victims;
+        size_t                                     selected = 0;
+        for (const auto handle : candidates)
+        {
+            if (selected >= usage - limit) break;
+
+            const auto& entry = entries[handle];
+            info.size         = std::max<size_t>(entry.resource.size, 1);
+            auto dst          = memoryManager->allocateBuffer(info, IBufferAllocator::OnAllocationFailure::Empty);
+            if (!dst) break;
+
+            selected += entry.resource.size;
+            victims.emplace_back(handle, std::move(dst));
+        }
+        if (victims.empty()) return 0;
+
+        auto transaction = transactionManager->beginTransaction();
+        for (const auto& [handle, dst] : victims) entries[handle].resource.download(*transaction, *dst);
+        transaction->commit();
+        transaction->wait();
+
+        // Move contents into host memory and release device memory.
+        size_t evicted = 0;
+        for (const auto& [handle, dst] : victims)
+        {
+            auto&       entry    = entries[handle];
+            const auto& vkBuffer = dst->getBuffer();
+            entry.backing.resize(entry.resource.size);
+            std::memcpy(entry.backing.data(),
+                        vkBuffer.getMappedData<std::byte>() + dst->getBufferOffset(),
+                        entry.resource.size);
+            entry.resource.release();
+            entry.resident = false;
+
+            statistics.residentCount--;
+            statistics.residentBytes -= entry.resource.size;
+            statistics.evictedCount++;
+            statistics.evictedBytes += entry.resource.size;
+            statistics.evictions++;
+            evicted += entry.resource.size;
+        }
+
+        return evicted;
+    }
+
+    ResidencyManager::Entry& ResidencyManager::getEntry(const Handle handle)
+    {
+        if (handle >= entries.size() || !entries[handle].registered)
+            throw SolError(std::format("Resource {} is not registered with the ResidencyManager.", handle));
+        return entries[handle];
+    }
+
+    const ResidencyManager::Entry& ResidencyManager::getEntry(const Handle handle) const
+    {
+        if (handle >= entries.size() || !entries[handle].registered)
+            throw SolError(std::format("Resource {} is not registered with the ResidencyManager.", handle));
+        return entries[handle];
+    }
+}  // namespace sol
@@ -4,7 +4,13 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <map>
+#include <numeric>
 #include <ranges>
+#include <tuple>
 
 ////////////////////////////////////////////////////////////////
 // Module includes.
@@ -16,6 +22,7 @@
 #include "sol-core/vulkan_image.h"
 #include "sol-core/vulkan_physical_device.h"
 #include "sol-core/vulkan_queue.h"
+#include "sol-core/vulkan_queue_family.h"
 #include "sol-core/vulkan_timeline_semaphore.h"
 #include "sol-error/sol_error.h"
 #include "sol-error/vulkan_error_handler.h"
@@ -27,6 +34,7 @@
 #include "sol-memory/i_buffer.h"
 #include "sol-memory/i_image.h"
 #include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction_handle.h"
 #include "sol-memory/transaction_manager.h"
 
 namespace
@@ -48,12 +56,17 @@ namespace
 
         if (!stagingBuffer) return nullptr;
 
-        stagingBuffer->getBuffer().setData(copy.data, stagingBuffer->getBufferSize());
+        manager.setData(
+          stagingBuffer->getBuffer(), copy.data, stagingBuffer->getBufferSize(), stagingBuffer->getBufferOffset());
         return stagingBuffer;
     }
 
     [[nodiscard]] sol::IBufferPtr tryAllocate(const sol::TransactionManager& manager, const sol::StagingImageCopy& copy)
     {
+        // The buffer offset of a copy to an image must be a multiple of both the texel block size and 4. Fall back to
+        // 16 bytes, which covers all power of 2 block sizes, if the format is not known.
+        const size_t blockSize = copy.dstImage.getTexelBlockSize();
+
         const sol::IBufferAllocator::AllocationInfo alloc{
           .size                 = copy.dataSize,
           .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
@@ -62,15 +75,197 @@ namespace
           .requiredMemoryFlags  = 0,
           .preferredMemoryFlags = 0,
           .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
-          .alignment       = 0};
+          .alignment       = std::lcm(blockSize == 0 ? size_t{16} : blockSize, size_t{4})};
         auto stagingBuffer =
           manager.getMemoryPool().allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Empty);
 
         if (!stagingBuffer) return nullptr;
 
-        stagingBuffer->getBuffer().setData(copy.data, stagingBuffer->getBufferSize());
+        manager.setData(
+          stagingBuffer->getBuffer(), copy.data, stagingBuffer->getBufferSize(), stagingBuffer->getBufferOffset());
         return stagingBuffer;
     }
+
+    /**
+     * \brief Copy regions grouped by (source, destination) pair, in order of first appearance.
+     */
+    template<typename K, typename R>
+    struct CopyGroups
+    {
+        std::vector<std::pair<K, std::vector<R>>> groups;
+
+        std::map<K, size_t> index;
+
+        [[nodiscard]] std::vector<R>& get(const K& key)
+        {
+            const auto [it, inserted] = index.try_emplace(key, groups.size());
+            if (inserted) groups.emplace_back(key, std::vector<R>{});
+            return groups[it->second].second;
+        }
+
+        /**
+         * \brief Start a new group for key on the next call to get.
+         */
+        void split(const K& key) { index.erase(key); }
+
+        [[nodiscard]] size_t regionCount() const noexcept
+        {
+            size_t count = 0;
+            for (const auto& regions : groups | std::views::values) count += regions.size();
+            return count;
+        }
+    };
+
+    [[nodiscard]] bool overlaps(const VkDeviceSize offset0,
+                                const VkDeviceSize size0,
+                                const VkDeviceSize offset1,
+                                const VkDeviceSize size1) noexcept
+    {
+        return offset0 < offset1 + size1 && offset1 < offset0 + size0;
+    }
+
+    void addBufferCopy(CopyGroups<std::pair<VkBuffer, VkBuffer>, VkBufferCopy2>& groups,
+                       const VkBuffer                                            src,
+                       const VkBuffer                                            dst,
+                       const VkBufferCopy2&                                      region)
+    {
+        const auto key = std::make_pair(src, dst);
+
+        // When copying within the same buffer, the union of source regions must not overlap the union of destination
+        // regions inside a single command. Start a new command if that would happen.
+        if (src == dst)
+        {
+            const auto& regions  = groups.get(key);
+            const bool  conflict = std::ranges::any_of(regions, [&](const VkBufferCopy2& r) {
+                return overlaps(r.srcOffset, r.size, region.dstOffset, region.size) ||
+                       overlaps(r.dstOffset, r.size, region.srcOffset, region.size);
+            });
+            if (conflict) groups.split(key);
+        }
+
+        groups.get(key).emplace_back(region);
+    }
+
+    /**
+     * \brief Replace a stage mask with ALL_COMMANDS if it contains stages that a queue family does not support. Used
+     * for barriers on concurrent resources, which are recorded on the queue family that performs the transfer
+     * instead of the queue family that uses the resource.
+     */
+    [[nodiscard]] VkPipelineStageFlags2 restrictStages(const VkPipelineStageFlags2    stages,
+                                                       const sol::VulkanQueueFamily& family) noexcept
+    {
+        if (family.supportsGraphics()) return stages;
+
+        VkPipelineStageFlags2 supported = VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT |
+                                          VK_PIPELINE_STAGE_2_HOST_BIT | VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT |
+                                          VK_PIPELINE_STAGE_2_ALL_TRANSFER_BIT | VK_PIPELINE_STAGE_2_COPY_BIT |
+                                          VK_PIPELINE_STAGE_2_RESOLVE_BIT | VK_PIPELINE_STAGE_2_BLIT_BIT |
+                                          VK_PIPELINE_STAGE_2_CLEAR_BIT;
+        if (family.supportsCompute())
+            supported |= VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+        return (stages & ~supported) != 0 ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : stages;
+    }
+
+    /**
+     * \brief Get the absolute range of the buffer covered by a barrier. Barriers that transfer queue family ownership
+     * always cover the whole buffer, since ownership is tracked per buffer.
+     */
+    [[nodiscard]] std::pair<VkDeviceSize, VkDeviceSize> getBarrierRange(const sol::BufferBarrier& barrier)
+    {
+        const auto bufferOffset = barrier.buffer.getBufferOffset();
+        const auto bufferSize   = barrier.buffer.getBufferSize();
+        if (barrier.srcFamily != barrier.dstFamily) return {bufferOffset, bufferSize};
+
+        const auto offset = std::min<VkDeviceSize>(barrier.offset, bufferSize);
+        const auto size =
+          barrier.size == VK_WHOLE_SIZE ? bufferSize - offset : std::min<VkDeviceSize>(barrier.size, bufferSize - offset);
+        return {bufferOffset + offset, size};
+    }
+
+    /**
+     * \brief Merge barriers on the same buffer with the same queue families. Barriers without ownership transfer are
+     * merged into a single barrier covering the union of their ranges. Ownership transfers are only merged if their
+     * ranges touch or overlap.
+     */
+    void mergeBarriers(std::vector<VkBufferMemoryBarrier2>& barriers)
+    {
+        if (barriers.size() < 2) return;
+
+        std::ranges::sort(barriers, [](const VkBufferMemoryBarrier2& lhs, const VkBufferMemoryBarrier2& rhs) {
+            return std::tie(lhs.buffer, lhs.srcQueueFamilyIndex, lhs.dstQueueFamilyIndex, lhs.offset) <
+                   std::tie(rhs.buffer, rhs.srcQueueFamilyIndex, rhs.dstQueueFamilyIndex, rhs.offset);
+        });
+
+        std::vector<VkBufferMemoryBarrier2> merged;
+        merged.reserve(barriers.size());
+        for (const auto& barrier : barriers)
+        {
+            if (!merged.empty())
+            {
+                auto&      last     = merged.back();
+                const bool sameKey  = last.buffer == barrier.buffer &&
+                                     last.srcQueueFamilyIndex == barrier.srcQueueFamilyIndex &&
+                                     last.dstQueueFamilyIndex == barrier.dstQueueFamilyIndex;
+                const bool transfer = barrier.srcQueueFamilyIndex != barrier.dstQueueFamilyIndex;
+                if (sameKey && (!transfer || barrier.offset <= last.offset + last.size))
+                {
+                    last.size = std::max(last.offset + last.size, barrier.offset + barrier.size) - last.offset;
+                    last.srcStageMask |= barrier.srcStageMask;
+                    last.srcAccessMask |= barrier.srcAccessMask;
+                    last.dstStageMask |= barrier.dstStageMask;
+                    last.dstAccessMask |= barrier.dstAccessMask;
+                    continue;
+                }
+            }
+
+            merged.emplace_back(barrier);
+        }
+
+        barriers = std::move(merged);
+    }
+
+    /**
+     * \brief Merge barriers on the same image that are identical except for their stage and access masks.
+     */
+    void mergeBarriers(std::vector<VkImageMemoryBarrier2>& barriers)
+    {
+        if (barriers.size() < 2) return;
+
+        const auto key = [](const VkImageMemoryBarrier2& b) {
+            return std::tie(b.image,
+                            b.srcQueueFamilyIndex,
+                            b.dstQueueFamilyIndex,
+                            b.oldLayout,
+                            b.newLayout,
+                            b.subresourceRange.aspectMask,
+                            b.subresourceRange.baseMipLevel,
+                            b.subresourceRange.levelCount,
+                            b.subresourceRange.baseArrayLayer,
+                            b.subresourceRange.layerCount);
+        };
+
+        std::ranges::stable_sort(barriers, [&](const auto& lhs, const auto& rhs) { return key(lhs) < key(rhs); });
+
+        std::vector<VkImageMemoryBarrier2> merged;
+        merged.reserve(barriers.size());
+        for (const auto& barrier : barriers)
+        {
+            if (!merged.empty() && key(merged.back()) == key(barrier))
+            {
+                auto& last = merged.back();
+                last.srcStageMask |= barrier.srcStageMask;
+                last.srcAccessMask |= barrier.srcAccessMask;
+                last.dstStageMask |= barrier.dstStageMask;
+                last.dstAccessMask |= barrier.dstAccessMask;
+                continue;
+            }
+
+            merged.emplace_back(barrier);
+        }
+
+        barriers = std::move(merged);
+    }
 }  // namespace
 
 namespace sol
@@ -79,23 +274,27 @@ namespace sol
     // Constructors.
     ////////////////////////////////////////////////////////////////
 
-    Transaction::Transaction(TransactionManager& transactionManager) : manager(&transactionManager) {}
+    Transaction::Transaction(TransactionManager& transactionManager) :
+        manager(&transactionManager),
+        directWrite(transactionManager.getDirectWrite()),
+        inlineUpdates(transactionManager.getInlineUpdates())
+    {
+    }
 
     Transaction::~Transaction() noexcept
     {
         /*
-         * If necessary, collect pending staging buffers. They will be destroyed in the next wait of the manager.
+         * If necessary, hand pending staging buffers over to the manager. They will be destroyed once the manager
+         * observes this transaction has completed.
          */
 
-        if (!committed || (s2bCopies.empty() && s2iCopies.empty())) return;
+        if (!committed) return;
 
-        std::vector<IBufferPtr> stagingBuffers;
-        for (auto& buffer : s2bCopies | std::views::values) stagingBuffers.push_back(std::move(buffer));
-        for (auto& buffer : s2iCopies | std::views::values) stagingBuffers.push_back(std::move(buffer));
+        auto stagingBuffers = takeStagingBuffers();
+        if (stagingBuffers.empty()) return;
 
         auto lock = manager->lock();
-        manager->pendingStagingBuffers.reserve(manager->pendingStagingBuffers.size() + stagingBuffers.size());
-        for (auto& b : stagingBuffers) manager->pendingStagingBuffers.push_back(std::move(b));
+        static_cast<void>(manager->addCompletion(semaphoreValues, std::move(stagingBuffers)));
     }
 
     ////////////////////////////////////////////////////////////////
@@ -120,6 +319,49 @@ namespace sol
         return semaphoreValues;
     }
 
+    bool Transaction::getNarrowBarriers() const noexcept { return narrowBarriers; }
+
+    bool Transaction::getDirectWrite() const noexcept { return directWrite; }
+
+    bool Transaction::getInlineUpdates() const noexcept { return inlineUpdates; }
+
+    bool Transaction::isEmpty() const noexcept
+    {
+        return preBufferBarriers.empty() && postBufferBarriers.empty() && preImageBarriers.empty() &&
+               postImageBarriers.empty() && s2bCopies.empty() && s2iCopies.empty() && b2bCopies.empty() &&
+               i2iCopies.empty() && b2iCopies.empty() && i2bCopies.empty() && bufferFills.empty() &&
+               inlineCopies.empty() && imageClears.empty() && updateBufferBarriers.empty() &&
+               updateImageBarriers.empty();
+    }
+
+    const Transaction::Stats& Transaction::getStats() const
+    {
+        requireCommitted();
+        return stats;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void Transaction::setNarrowBarriers(const bool value)
+    {
+        requireNotCommitted();
+        narrowBarriers = value;
+    }
+
+    void Transaction::setDirectWrite(const bool value)
+    {
+        requireNotCommitted();
+        directWrite = value;
+    }
+
+    void Transaction::setInlineUpdates(const bool value)
+    {
+        requireNotCommitted();
+        inlineUpdates = value;
+    }
+
     ////////////////////////////////////////////////////////////////
     // Staging.
     ////////////////////////////////////////////////////////////////
@@ -131,12 +373,26 @@ namespace sol
         if (!barrier.srcFamily) barrier.srcFamily = &barrier.buffer.getQueueFamily();
         if (!barrier.dstFamily) barrier.dstFamily = barrier.srcFamily;
 
-        if (barrier.srcFamily != barrier.dstFamily) barrier.buffer.setQueueFamily(*barrier.dstFamily);
+        // A concurrent buffer needs no ownership transfer. Record the barrier only on the queue family that performs
+        // the transfer operation: the destination before it, the source after it.
+        if (barrier.buffer.isConcurrent())
+        {
+            if (location == BarrierLocation::BeforeCopy)
+                barrier.srcFamily = barrier.dstFamily;
+            else
+                barrier.dstFamily = barrier.srcFamily;
+            barrier.srcStage = restrictStages(barrier.srcStage, *barrier.srcFamily);
+            barrier.dstStage = restrictStages(barrier.dstStage, *barrier.srcFamily);
+        }
+        else if (barrier.srcFamily != barrier.dstFamily)
+            barrier.buffer.setQueueFamily(*barrier.dstFamily);
 
         if (location == BarrierLocation::BeforeCopy)
             preBufferBarriers.emplace_back(barrier);
-        else
+        else if (location == BarrierLocation::AfterCopy)
             postBufferBarriers.emplace_back(barrier);
+        else
+            updateBufferBarriers.emplace_back(barrier);
     }
 
     void Transaction::stage(ImageBarrier barrier, const BarrierLocation location)
@@ -147,6 +403,17 @@ namespace sol
             barrier.srcFamily = &barrier.image.getQueueFamily(barrier.baseMipLevel, barrier.baseArrayLayer);
         if (!barrier.dstFamily) barrier.dstFamily = barrier.srcFamily;
 
+        // See stage(BufferBarrier, BarrierLocation).
+        if (barrier.image.isConcurrent())
+        {
+            if (location == BarrierLocation::BeforeCopy)
+                barrier.srcFamily = barrier.dstFamily;
+            else
+                barrier.dstFamily = barrier.srcFamily;
+            barrier.srcStage = restrictStages(barrier.srcStage, *barrier.srcFamily);
+            barrier.dstStage = restrictStages(barrier.dstStage, *barrier.srcFamily);
+        }
+
         for (uint32_t level = 0; level < barrier.levelCount; level++)
         {
             for (uint32_t layer = 0; layer < barrier.layerCount; layer++)
@@ -162,8 +429,10 @@ namespace sol
 
         if (location == BarrierLocation::BeforeCopy)
             preImageBarriers.emplace_back(barrier);
-        else
+        else if (location == BarrierLocation::AfterCopy)
             postImageBarriers.emplace_back(barrier);
+        else
+            updateImageBarriers.emplace_back(barrier);
     }
 
     bool Transaction::stage(const StagingBufferCopy&            copy,
@@ -174,7 +443,43 @@ namespace sol
 
         // TODO: Here and in the other stage method we could test for image/bufferUsage being transfer_dst/src.
 
+        // Write straight into host visible memory. No staging buffer, copy command or ownership transfer to the
+        // transfer queue is needed.
+        if (canWriteDirect(copy, barrier))
+        {
+            writeDirect(copy);
+            stats.directWrites++;
+
+            // Memory barrier that will get the destination buffer from the host write to its final state.
+            if (barrier)
+            {
+                stage(BufferBarrier{.buffer    = copy.dstBuffer,
+                                    .srcFamily = barrier->srcFamily,
+                                    .dstFamily = barrier->dstFamily,
+                                    .srcStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                    .dstStage  = barrier->dstStage,
+                                    .srcAccess = VK_ACCESS_2_HOST_WRITE_BIT,
+                                    .dstAccess = barrier->dstAccess,
+                                    .offset    = narrowBarriers ? copy.offset : 0,
+                                    .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
+                      BarrierLocation::AfterCopy);
+            }
+
+            return true;
+        }
+
+        // Record small copies with vkCmdUpdateBuffer on the queue family that owns the destination. No staging buffer
+        // or ownership transfer to the transfer queue is needed.
+        if (canUpdateInline(copy))
+        {
+            stageInline(copy, barrier);
+            stats.inlineUpdates++;
+            return true;
+        }
+
         auto stagingBuffer = tryAllocate(*manager, copy);
+        // Release staging buffers of transactions that have completed in the meantime and retry.
+        if (!stagingBuffer && manager->poll() > 0) stagingBuffer = tryAllocate(*manager, copy);
         if (!stagingBuffer)
         {
             if (waitOnAllocFailure)
@@ -198,7 +503,9 @@ namespace sol
                                 .srcStage  = barrier->srcStage,
                                 .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .srcAccess = barrier->srcAccess,
-                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT},
+                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .offset    = narrowBarriers ? copy.offset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
                   BarrierLocation::BeforeCopy);
         }
 
@@ -216,7 +523,9 @@ namespace sol
                                 .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .dstStage  = barrier->dstStage,
                                 .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                                .dstAccess = barrier->dstStage},
+                                .dstAccess = barrier->dstAccess,
+                                .offset    = narrowBarriers ? copy.offset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
                   BarrierLocation::AfterCopy);
         }
 
@@ -232,6 +541,8 @@ namespace sol
         // TODO: If there is a barrier, it is currently assumed that the levels and layers it describes match the regions in the copy.
 
         auto stagingBuffer = tryAllocate(*manager, copy);
+        // Release staging buffers of transactions that have completed in the meantime and retry.
+        if (!stagingBuffer && manager->poll() > 0) stagingBuffer = tryAllocate(*manager, copy);
         if (!stagingBuffer)
         {
             if (waitOnAllocFailure)
@@ -276,7 +587,7 @@ namespace sol
                                .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                .dstStage       = barrier->dstStage,
                                .srcAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                               .dstAccess      = barrier->dstStage,
+                               .dstAccess      = barrier->dstAccess,
                                .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                                .dstLayout      = barrier->dstLayout,
                                .aspectMask     = barrier->aspectMask,
@@ -307,7 +618,9 @@ namespace sol
                                 .srcStage  = srcBarrier->srcStage,
                                 .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .srcAccess = srcBarrier->srcAccess,
-                                .dstAccess = VK_ACCESS_2_TRANSFER_READ_BIT},
+                                .dstAccess = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                .offset    = narrowBarriers ? copy.srcOffset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
                   BarrierLocation::BeforeCopy);
         }
 
@@ -322,7 +635,9 @@ namespace sol
                                 .srcStage  = dstBarrier->srcStage,
                                 .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .srcAccess = dstBarrier->srcAccess,
-                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT},
+                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .offset    = narrowBarriers ? copy.dstOffset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
                   BarrierLocation::BeforeCopy);
         }
 
@@ -340,7 +655,9 @@ namespace sol
                                 .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .dstStage  = srcBarrier->dstStage,
                                 .srcAccess = VK_ACCESS_2_TRANSFER_READ_BIT,
-                                .dstAccess = srcBarrier->dstStage},
+                                .dstAccess = srcBarrier->dstAccess,
+                                .offset    = narrowBarriers ? copy.srcOffset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
                   BarrierLocation::AfterCopy);
         }
 
@@ -355,7 +672,193 @@ namespace sol
                                 .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .dstStage  = dstBarrier->dstStage,
                                 .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                                .dstAccess = dstBarrier->dstStage},
+                                .dstAccess = dstBarrier->dstAccess,
+                                .offset    = narrowBarriers ? copy.dstOffset : 0,
+                                .size      = narrowBarriers ? copy.size : VK_WHOLE_SIZE},
+                  BarrierLocation::AfterCopy);
+        }
+    }
+
+    void Transaction::stage(const ImageToImageCopy&            copy,
+                            const std::optional<ImageBarrier>& srcBarrier,
+                            const std::optional<ImageBarrier>& dstBarrier)
+    {
+        requireNotCommitted();
+
+        // TODO: If there is a barrier, it is currently assumed that the levels and layers it describes match the regions in the copy.
+        // Image barrier that will get the source image from its current state to the transfer read state.
+        if (srcBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.srcImage,
+                               .srcFamily      = srcBarrier->srcFamily,
+                               .dstFamily      = copy.srcOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   srcBarrier->srcFamily,
+                               .srcStage       = srcBarrier->srcStage,
+                               .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccess      = srcBarrier->srcAccess,
+                               .dstAccess      = VK_ACCESS_2_TRANSFER_READ_BIT,
+                               .srcLayout      = srcBarrier->srcLayout,
+                               .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               .aspectMask     = srcBarrier->aspectMask,
+                               .baseMipLevel   = srcBarrier->baseMipLevel,
+                               .levelCount     = srcBarrier->levelCount,
+                               .baseArrayLayer = srcBarrier->baseArrayLayer,
+                               .layerCount     = srcBarrier->layerCount},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // Image barrier that will get the destination image from its current state to the transfer write state.
+        if (dstBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.dstImage,
+                               .srcFamily      = dstBarrier->srcFamily,
+                               .dstFamily      = copy.dstOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   dstBarrier->srcFamily,
+                               .srcStage       = dstBarrier->srcStage,
+                               .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccess      = dstBarrier->srcAccess,
+                               .dstAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .srcLayout      = dstBarrier->srcLayout,
+                               .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .aspectMask     = dstBarrier->aspectMask,
+                               .baseMipLevel   = dstBarrier->baseMipLevel,
+                               .levelCount     = dstBarrier->levelCount,
+                               .baseArrayLayer = dstBarrier->baseArrayLayer,
+                               .layerCount     = dstBarrier->layerCount},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // The actual copy.
+        i2iCopies.emplace_back(copy);
+
+        // Image barrier that will get the source image from the transfer read state to its final state.
+        if (srcBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.srcImage,
+                               .srcFamily      = copy.srcOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   srcBarrier->srcFamily,
+                               .dstFamily      = srcBarrier->dstFamily,
+                               .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstStage       = srcBarrier->dstStage,
+                               .srcAccess      = VK_ACCESS_2_TRANSFER_READ_BIT,
+                               .dstAccess      = srcBarrier->dstAccess,
+                               .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               .dstLayout      = srcBarrier->dstLayout,
+                               .aspectMask     = srcBarrier->aspectMask,
+                               .baseMipLevel   = srcBarrier->baseMipLevel,
+                               .levelCount     = srcBarrier->levelCount,
+                               .baseArrayLayer = srcBarrier->baseArrayLayer,
+                               .layerCount     = srcBarrier->layerCount},
+                  BarrierLocation::AfterCopy);
+        }
+
+        // Image barrier that will get the destination image from the transfer write state to its final state.
+        if (dstBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.dstImage,
+                               .srcFamily      = copy.dstOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   dstBarrier->srcFamily,
+                               .dstFamily      = dstBarrier->dstFamily,
+                               .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstStage       = dstBarrier->dstStage,
+                               .srcAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .dstAccess      = dstBarrier->dstAccess,
+                               .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .dstLayout      = dstBarrier->dstLayout,
+                               .aspectMask     = dstBarrier->aspectMask,
+                               .baseMipLevel   = dstBarrier->baseMipLevel,
+                               .levelCount     = dstBarrier->levelCount,
+                               .baseArrayLayer = dstBarrier->baseArrayLayer,
+                               .layerCount     = dstBarrier->layerCount},
+                  BarrierLocation::AfterCopy);
+        }
+    }
+
+    void Transaction::stage(const BufferToImageCopy&            copy,
+                            const std::optional<BufferBarrier>& srcBarrier,
+                            const std::optional<ImageBarrier>&  dstBarrier)
+    {
+        requireNotCommitted();
+
+        // Memory barrier that will get the source buffer from its current state to the transfer read state.
+        if (srcBarrier)
+        {
+            stage(BufferBarrier{.buffer    = copy.srcBuffer,
+                                .srcFamily = srcBarrier->srcFamily,
+                                .dstFamily = copy.srcOnDedicatedTransfer ?
+                                               &getMemoryManager().getTransferQueue().getFamily() :
+                                               srcBarrier->srcFamily,
+                                .srcStage  = srcBarrier->srcStage,
+                                .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .srcAccess = srcBarrier->srcAccess,
+                                .dstAccess = VK_ACCESS_2_TRANSFER_READ_BIT},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // TODO: If there is a barrier, it is currently assumed that the levels and layers it describes match the regions in the copy.
+        // Image barrier that will get the destination image from its current state to the transfer write state.
+        if (dstBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.dstImage,
+                               .srcFamily      = dstBarrier->srcFamily,
+                               .dstFamily      = copy.dstOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   dstBarrier->srcFamily,
+                               .srcStage       = dstBarrier->srcStage,
+                               .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccess      = dstBarrier->srcAccess,
+                               .dstAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .srcLayout      = dstBarrier->srcLayout,
+                               .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .aspectMask     = dstBarrier->aspectMask,
+                               .baseMipLevel   = dstBarrier->baseMipLevel,
+                               .levelCount     = dstBarrier->levelCount,
+                               .baseArrayLayer = dstBarrier->baseArrayLayer,
+                               .layerCount     = dstBarrier->layerCount},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // The actual copy.
+        b2iCopies.emplace_back(copy);
+
+        // Memory barrier that will get the source buffer from the transfer read state to its final state.
+        if (srcBarrier)
+        {
+            stage(BufferBarrier{.buffer    = copy.srcBuffer,
+                                .srcFamily = copy.srcOnDedicatedTransfer ?
+                                               &getMemoryManager().getTransferQueue().getFamily() :
+                                               srcBarrier->srcFamily,
+                                .dstFamily = srcBarrier->dstFamily,
+                                .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstStage  = srcBarrier->dstStage,
+                                .srcAccess = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                .dstAccess = srcBarrier->dstAccess},
+                  BarrierLocation::AfterCopy);
+        }
+
+        // Image barrier that will get the destination image from the transfer write state to its final state.
+        if (dstBarrier)
+        {
+            stage(ImageBarrier{.image          = copy.dstImage,
+                               .srcFamily      = copy.dstOnDedicatedTransfer ?
+                                                   &getMemoryManager().getTransferQueue().getFamily() :
+                                                   dstBarrier->srcFamily,
+                               .dstFamily      = dstBarrier->dstFamily,
+                               .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstStage       = dstBarrier->dstStage,
+                               .srcAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .dstAccess      = dstBarrier->dstAccess,
+                               .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .dstLayout      = dstBarrier->dstLayout,
+                               .aspectMask     = dstBarrier->aspectMask,
+                               .baseMipLevel   = dstBarrier->baseMipLevel,
+                               .levelCount     = dstBarrier->levelCount,
+                               .baseArrayLayer = dstBarrier->baseArrayLayer,
+                               .layerCount     = dstBarrier->layerCount},
                   BarrierLocation::AfterCopy);
         }
     }
@@ -436,11 +939,140 @@ namespace sol
                                 .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
                                 .dstStage  = dstBarrier->dstStage,
                                 .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
-                                .dstAccess = dstBarrier->dstStage},
+                                .dstAccess = dstBarrier->dstAccess},
                   BarrierLocation::AfterCopy);
         }
     }
 
+    void Transaction::stage(const BufferFill& fill, const std::optional<BufferBarrier>& barrier)
+    {
+        requireNotCommitted();
+
+        BufferFill f = fill;
+        if (f.size == VK_WHOLE_SIZE) f.size = (f.dstBuffer.getBufferSize() - f.offset) & ~static_cast<size_t>(3);
+        if (f.size % 4 != 0 || (f.dstBuffer.getBufferOffset() + f.offset) % 4 != 0)
+            throw SolError(std::format(
+              "Cannot stage buffer fill of {} bytes at offset {}. Size and offset must be a multiple of 4.",
+              f.size,
+              f.dstBuffer.getBufferOffset() + f.offset));
+
+        // Memory barrier that will get the destination buffer from its current state to the transfer state.
+        if (barrier)
+        {
+            stage(BufferBarrier{.buffer    = f.dstBuffer,
+                                .srcFamily = barrier->srcFamily,
+                                .dstFamily = f.dstOnDedicatedTransfer ?
+                                               &getMemoryManager().getTransferQueue().getFamily() :
+                                               barrier->srcFamily,
+                                .srcStage  = barrier->srcStage,
+                                .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .srcAccess = barrier->srcAccess,
+                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .offset    = narrowBarriers ? f.offset : 0,
+                                .size      = narrowBarriers ? f.size : VK_WHOLE_SIZE},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // The actual fill.
+        bufferFills.emplace_back(f);
+
+        // Memory barrier that will get the destination buffer from the transfer state to its final state.
+        if (barrier)
+        {
+            stage(BufferBarrier{.buffer    = f.dstBuffer,
+                                .srcFamily = f.dstOnDedicatedTransfer ?
+                                               &getMemoryManager().getTransferQueue().getFamily() :
+                                               barrier->srcFamily,
+                                .dstFamily = barrier->dstFamily,
+                                .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstStage  = barrier->dstStage,
+                                .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .dstAccess = barrier->dstAccess,
+                                .offset    = narrowBarriers ? f.offset : 0,
+                                .size      = narrowBarriers ? f.size : VK_WHOLE_SIZE},
+                  BarrierLocation::AfterCopy);
+        }
+    }
+
+    void Transaction::stage(const ImageClear& clear, const std::optional<ImageBarrier>& barrier)
+    {
+        requireNotCommitted();
+
+        if (clear.ranges.empty()) throw SolError("Cannot stage image clear without any ranges.");
+
+        const auto& first  = clear.ranges.front();
+        const auto* family = barrier && barrier->srcFamily ?
+                               barrier->srcFamily :
+                               &clear.dstImage.getQueueFamily(first.baseMipLevel, first.baseArrayLayer);
+
+        // Clear commands are not supported on dedicated transfer queues.
+        for (const auto& range : clear.ranges)
+        {
+            if (range.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+            {
+                if (!family->supportsGraphics() && !family->supportsCompute())
+                    throw SolError(std::format(
+                      "Cannot stage color image clear. Queue family {} does not support graphics or compute.",
+                      family->getIndex()));
+            }
+            else if (range.aspectMask & (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) &&
+                     !(range.aspectMask & ~(VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT)))
+            {
+                if (!family->supportsGraphics())
+                    throw SolError(std::format(
+                      "Cannot stage depth/stencil image clear. Queue family {} does not support graphics.",
+                      family->getIndex()));
+            }
+            else
+                throw SolError(std::format("Cannot stage image clear with aspect mask {}.", range.aspectMask));
+        }
+
+        // Image barrier that will get the destination image from its current state to the transfer state, without
+        // changing ownership.
+        if (barrier)
+        {
+            stage(ImageBarrier{.image          = clear.dstImage,
+                               .srcFamily      = family,
+                               .dstFamily      = family,
+                               .srcStage       = barrier->srcStage,
+                               .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .srcAccess      = barrier->srcAccess,
+                               .dstAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .srcLayout      = barrier->srcLayout,
+                               .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .aspectMask     = barrier->aspectMask,
+                               .baseMipLevel   = barrier->baseMipLevel,
+                               .levelCount     = barrier->levelCount,
+                               .baseArrayLayer = barrier->baseArrayLayer,
+                               .layerCount     = barrier->layerCount},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        // The actual clear.
+        imageClears.emplace_back(clear, family);
+
+        // Image barrier that will get the destination image from the transfer state to its final state. It is
+        // recorded directly after the clear.
+        if (barrier)
+        {
+            stage(ImageBarrier{.image          = clear.dstImage,
+                               .srcFamily      = family,
+                               .dstFamily      = barrier->dstFamily,
+                               .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                               .dstStage       = barrier->dstStage,
+                               .srcAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                               .dstAccess      = barrier->dstAccess,
+                               .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               .dstLayout      = barrier->dstLayout,
+                               .aspectMask     = barrier->aspectMask,
+                               .baseMipLevel   = barrier->baseMipLevel,
+                               .levelCount     = barrier->levelCount,
+                               .baseArrayLayer = barrier->baseArrayLayer,
+                               .layerCount     = barrier->layerCount},
+                  BarrierLocation::AfterUpdate);
+        }
+    }
+
     ////////////////////////////////////////////////////////////////
     // Commit.
     ////////////////////////////////////////////////////////////////
@@ -453,6 +1085,7 @@ namespace sol
         auto&      device         = memoryManager.getDevice();
         auto&      physicalDevice = device.getPhysicalDevice();
         const auto familyCount    = static_cast<uint32_t>(physicalDevice.getQueueFamilies().size());
+        const auto transferIndex  = memoryManager.getTransferQueue().getFamily().getIndex();
 
         // Barriers releasing ownership from current queue, submitted before copies.
         std::vector<std::vector<VkBufferMemoryBarrier2>> preCopyReleaseBufferBarriers(familyCount);
@@ -469,20 +1102,29 @@ namespace sol
         // Barriers acquiring ownership on destination queue, submitted after copies.
         std::vector<std::vector<VkBufferMemoryBarrier2>> postCopyAcquireBufferBarriers(familyCount);
         std::vector<std::vector<VkImageMemoryBarrier2>>  postCopyAcquireImageBarriers(familyCount);
-
-        std::vector<VkBufferCopy2>            bufferCopies;  // [s2b[0], ..., s2b[n], b2b[0], ..., b2b[n]]
-        std::vector<VkImageCopy2>             imageCopies;
-        std::vector<VkBufferImageCopy2>       bufferImageCopies;  // [s2i[0], ..., s2i[n], b2i[0], ..., b2i[n]]
-        std::vector<VkBufferImageCopy2>       imageBufferCopies;
-        std::vector<VkCopyBufferInfo2>        bufferInfos;
+        // Barriers placed directly after inline updates and image clears, in the same command buffer. Barriers that
+        // transfer ownership release here and acquire together with the post-copy acquire barriers.
+        std::vector<std::vector<VkBufferMemoryBarrier2>> postUpdateBufferBarriers(familyCount);
+        std::vector<std::vector<VkImageMemoryBarrier2>>  postUpdateImageBarriers(familyCount);
+        // Inline updates and image clears grouped by the queue family they are recorded on.
+        std::vector<std::vector<const InlineUpdate*>> updates(familyCount);
+        std::vector<std::vector<const ImageClear*>>   clears(familyCount);
+
+        // Copy regions grouped by (source, destination) pair, so that each group is recorded as a single command.
+        CopyGroups<std::pair<VkBuffer, VkBuffer>, VkBufferCopy2>     bufferCopies;
+        CopyGroups<std::pair<VkImage, VkImage>, VkImageCopy2>        imageCopies;
+        CopyGroups<std::pair<VkBuffer, VkImage>, VkBufferImageCopy2> bufferImageCopies;
+        CopyGroups<std::pair<VkImage, VkBuffer>, VkBufferImageCopy2> imageBufferCopies;
+        std::vector<VkCopyBufferInfo2>                               bufferInfos;
         std::vector<VkCopyImageInfo2>         imageInfos;
         std::vector<VkCopyBufferToImageInfo2> bufferImageInfos;
         std::vector<VkCopyImageToBufferInfo2> imageBufferInfos;
 
         for (const auto& barrier : preBufferBarriers)
         {
-            const auto* srcFamily = barrier.srcFamily;
-            const auto* dstFamily = barrier.dstFamily;
+            const auto* srcFamily     = barrier.srcFamily;
+            const auto* dstFamily     = barrier.dstFamily;
+            const auto [offset, size] = getBarrierRange(barrier);
 
             // Source and destination family are the same. Only an acquire on the destination queue is needed.
             if (srcFamily == dstFamily)
@@ -497,8 +1139,8 @@ namespace sol
                                          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                                          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
             }
             // Source and destination family are different. Release and acquire are needed.
             else
@@ -513,8 +1155,8 @@ namespace sol
                                          .srcQueueFamilyIndex = srcFamily->getIndex(),
                                          .dstQueueFamilyIndex = dstFamily->getIndex(),
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
 
                 preCopyAcquireBufferBarriers[dstFamily->getIndex()].emplace_back(
                   VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
@@ -526,20 +1168,24 @@ namespace sol
                                          .srcQueueFamilyIndex = srcFamily->getIndex(),
                                          .dstQueueFamilyIndex = dstFamily->getIndex(),
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
             }
         }
 
         for (const auto& barrier : postBufferBarriers)
         {
-            const auto* srcFamily = barrier.srcFamily;
-            const auto* dstFamily = barrier.dstFamily;
+            const auto* srcFamily     = barrier.srcFamily;
+            const auto* dstFamily     = barrier.dstFamily;
+            const auto [offset, size] = getBarrierRange(barrier);
 
-            // Source and destination family are the same. Only an acquire on the destination queue is needed.
+            // Source and destination family are the same. Only an acquire on the destination queue is needed. On the
+            // transfer queue, it is recorded together with the releases, directly after the copies.
             if (srcFamily == dstFamily)
             {
-                postCopyAcquireBufferBarriers[dstFamily->getIndex()].emplace_back(
+                auto& barriers = dstFamily->getIndex() == transferIndex ? postCopyReleaseBufferBarriers :
+                                                                          postCopyAcquireBufferBarriers;
+                barriers[dstFamily->getIndex()].emplace_back(
                   VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
                                          .pNext               = nullptr,
                                          .srcStageMask        = barrier.srcStage,
@@ -549,8 +1195,8 @@ namespace sol
                                          .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                                          .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
             }
             // Source and destination family are different. Release and acquire are needed.
             else
@@ -565,8 +1211,61 @@ namespace sol
                                          .srcQueueFamilyIndex = srcFamily->getIndex(),
                                          .dstQueueFamilyIndex = dstFamily->getIndex(),
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
+
+                postCopyAcquireBufferBarriers[dstFamily->getIndex()].emplace_back(
+                  VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                                         .pNext               = nullptr,
+                                         .srcStageMask        = VK_PIPELINE_STAGE_2_NONE,
+                                         .srcAccessMask       = VK_ACCESS_2_NONE,
+                                         .dstStageMask        = barrier.dstStage,
+                                         .dstAccessMask       = barrier.dstAccess,
+                                         .srcQueueFamilyIndex = srcFamily->getIndex(),
+                                         .dstQueueFamilyIndex = dstFamily->getIndex(),
+                                         .buffer              = barrier.buffer.getBuffer().get(),
+                                         .offset              = offset,
+                                         .size                = size});
+            }
+        }
+
+        for (const auto& barrier : updateBufferBarriers)
+        {
+            const auto* srcFamily     = barrier.srcFamily;
+            const auto* dstFamily     = barrier.dstFamily;
+            const auto [offset, size] = getBarrierRange(barrier);
+
+            // Source and destination family are the same. Only a barrier directly after the update is needed.
+            if (srcFamily == dstFamily)
+            {
+                postUpdateBufferBarriers[srcFamily->getIndex()].emplace_back(
+                  VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                                         .pNext               = nullptr,
+                                         .srcStageMask        = barrier.srcStage,
+                                         .srcAccessMask       = barrier.srcAccess,
+                                         .dstStageMask        = barrier.dstStage,
+                                         .dstAccessMask       = barrier.dstAccess,
+                                         .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                         .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                                         .buffer              = barrier.buffer.getBuffer().get(),
+                                         .offset              = offset,
+                                         .size                = size});
+            }
+            // Source and destination family are different. Release after the update, acquire after the copies.
+            else
+            {
+                postUpdateBufferBarriers[srcFamily->getIndex()].emplace_back(
+                  VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+                                         .pNext               = nullptr,
+                                         .srcStageMask        = barrier.srcStage,
+                                         .srcAccessMask       = barrier.srcAccess,
+                                         .dstStageMask        = VK_PIPELINE_STAGE_2_NONE,
+                                         .dstAccessMask       = VK_ACCESS_2_NONE,
+                                         .srcQueueFamilyIndex = srcFamily->getIndex(),
+                                         .dstQueueFamilyIndex = dstFamily->getIndex(),
+                                         .buffer              = barrier.buffer.getBuffer().get(),
+                                         .offset              = offset,
+                                         .size                = size});
 
                 postCopyAcquireBufferBarriers[dstFamily->getIndex()].emplace_back(
                   VkBufferMemoryBarrier2{.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
@@ -578,11 +1277,81 @@ namespace sol
                                          .srcQueueFamilyIndex = srcFamily->getIndex(),
                                          .dstQueueFamilyIndex = dstFamily->getIndex(),
                                          .buffer              = barrier.buffer.getBuffer().get(),
-                                         .offset              = barrier.buffer.getBufferOffset(),
-                                         .size                = barrier.buffer.getBufferSize()});
+                                         .offset              = offset,
+                                         .size                = size});
+            }
+        }
+
+        for (const auto& barrier : updateImageBarriers)
+        {
+            const auto* srcFamily = barrier.srcFamily;
+            const auto* dstFamily = barrier.dstFamily ? barrier.dstFamily : srcFamily;
+
+            // Source and destination family are the same. Only a barrier directly after the clear is needed.
+            if (srcFamily == dstFamily)
+            {
+                postUpdateImageBarriers[srcFamily->getIndex()].emplace_back(VkImageMemoryBarrier2{
+                  .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                  .pNext               = nullptr,
+                  .srcStageMask        = barrier.srcStage,
+                  .srcAccessMask       = barrier.srcAccess,
+                  .dstStageMask        = barrier.dstStage,
+                  .dstAccessMask       = barrier.dstAccess,
+                  .oldLayout           = barrier.srcLayout,
+                  .newLayout           = barrier.dstLayout,
+                  .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                  .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+                  .image               = barrier.image.getImage().get(),
+                  .subresourceRange    = VkImageSubresourceRange{.aspectMask     = barrier.aspectMask,
+                                                                 .baseMipLevel   = barrier.baseMipLevel,
+                                                                 .levelCount     = barrier.levelCount,
+                                                                 .baseArrayLayer = barrier.baseArrayLayer,
+                                                                 .layerCount     = barrier.layerCount}});
+            }
+            // Source and destination family are different. Release after the clear, acquire after the copies.
+            else
+            {
+                postUpdateImageBarriers[srcFamily->getIndex()].emplace_back(VkImageMemoryBarrier2{
+                  .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                  .pNext               = nullptr,
+                  .srcStageMask        = barrier.srcStage,
+                  .srcAccessMask       = barrier.srcAccess,
+                  .dstStageMask        = VK_PIPELINE_STAGE_2_NONE,
+                  .dstAccessMask       = VK_ACCESS_2_NONE,
+                  .oldLayout           = barrier.srcLayout,
+                  .newLayout           = barrier.dstLayout,
+                  .srcQueueFamilyIndex = srcFamily->getIndex(),
+                  .dstQueueFamilyIndex = dstFamily->getIndex(),
+                  .image               = barrier.image.getImage().get(),
+                  .subresourceRange    = VkImageSubresourceRange{.aspectMask     = barrier.aspectMask,
+                                                                 .baseMipLevel   = barrier.baseMipLevel,
+                                                                 .levelCount     = barrier.levelCount,
+                                                                 .baseArrayLayer = barrier.baseArrayLayer,
+                                                                 .layerCount     = barrier.layerCount}});
+
+                postCopyAcquireImageBarriers[dstFamily->getIndex()].emplace_back(VkImageMemoryBarrier2{
+                  .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+                  .pNext               = nullptr,
+                  .srcStageMask        = VK_PIPELINE_STAGE_2_NONE,
+                  .srcAccessMask       = VK_ACCESS_2_NONE,
+                  .dstStageMask        = barrier.dstStage,
+                  .dstAccessMask       = barrier.dstAccess,
+                  .oldLayout           = barrier.srcLayout,
+                  .newLayout           = barrier.dstLayout,
+                  .srcQueueFamilyIndex = srcFamily->getIndex(),
+                  .dstQueueFamilyIndex = dstFamily->getIndex(),
+                  .image               = barrier.image.getImage().get(),
+                  .subresourceRange    = VkImageSubresourceRange{.aspectMask     = barrier.aspectMask,
+                                                                 .baseMipLevel   = barrier.baseMipLevel,
+                                                                 .levelCount     = barrier.levelCount,
+                                                                 .baseArrayLayer = barrier.baseArrayLayer,
+                                                                 .layerCount     = barrier.layerCount}});
             }
         }
 
+        for (const auto& update : inlineCopies) updates[update.family->getIndex()].emplace_back(&update);
+        for (const auto& [clear, family] : imageClears) clears[family->getIndex()].emplace_back(&clear);
+
         for (const auto& barrier : preImageBarriers)
         {
             const auto* srcFamily = barrier.srcFamily;
@@ -655,10 +1424,13 @@ namespace sol
             const auto* srcFamily = barrier.srcFamily;
             const auto* dstFamily = barrier.dstFamily ? barrier.dstFamily : srcFamily;
 
-            // Source and destination family are the same. Only an acquire on the destination queue is needed.
+            // Source and destination family are the same. Only an acquire on the destination queue is needed. On the
+            // transfer queue, it is recorded together with the releases, directly after the copies.
             if (srcFamily == dstFamily)
             {
-                postCopyAcquireImageBarriers[dstFamily->getIndex()].emplace_back(VkImageMemoryBarrier2{
+                auto& barriers = dstFamily->getIndex() == transferIndex ? postCopyReleaseImageBarriers :
+                                                                          postCopyAcquireImageBarriers;
+                barriers[dstFamily->getIndex()].emplace_back(VkImageMemoryBarrier2{
                   .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
                   .pNext               = nullptr,
                   .srcStageMask        = barrier.srcStage,
@@ -717,10 +1489,28 @@ namespace sol
             }
         }
 
+        // Merge barriers on the same resources.
+        for (uint32_t i = 0; i < familyCount; i++)
+        {
+            mergeBarriers(preCopyReleaseBufferBarriers[i]);
+            mergeBarriers(preCopyReleaseImageBarriers[i]);
+            mergeBarriers(preCopyAcquireBufferBarriers[i]);
+            mergeBarriers(preCopyAcquireImageBarriers[i]);
+            mergeBarriers(postCopyReleaseBufferBarriers[i]);
+            mergeBarriers(postCopyReleaseImageBarriers[i]);
+            mergeBarriers(postCopyAcquireBufferBarriers[i]);
+            mergeBarriers(postCopyAcquireImageBarriers[i]);
+            mergeBarriers(postUpdateBufferBarriers[i]);
+            mergeBarriers(postUpdateImageBarriers[i]);
+        }
+
         // Collect copies from staging buffers to buffers.
         for (const auto& [copy, buffer] : s2bCopies)
         {
-            bufferCopies.emplace_back(
+            addBufferCopy(
+              bufferCopies,
+              buffer->getBuffer().get(),
+              copy.dstBuffer.getBuffer().get(),
               VkBufferCopy2{.sType     = VK_STRUCTURE_TYPE_BUFFER_COPY_2,
                             .pNext     = nullptr,
                             .srcOffset = buffer->getBufferOffset(),
@@ -728,11 +1518,26 @@ namespace sol
                             .size      = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() : copy.size});
         }
 
+        // Collect copies from buffers to buffers.
+        for (const auto& copy : b2bCopies)
+        {
+            addBufferCopy(
+              bufferCopies,
+              copy.srcBuffer.getBuffer().get(),
+              copy.dstBuffer.getBuffer().get(),
+              VkBufferCopy2{.sType     = VK_STRUCTURE_TYPE_BUFFER_COPY_2,
+                            .pNext     = nullptr,
+                            .srcOffset = copy.srcOffset + copy.srcBuffer.getBufferOffset(),
+                            .dstOffset = copy.dstOffset + copy.dstBuffer.getBufferOffset(),
+                            .size      = copy.size == VK_WHOLE_SIZE ? copy.srcBuffer.getBufferSize() : copy.size});
+        }
+
         // Collect copies from staging buffers to images.
         for (const auto& [copy, buffer] : s2iCopies)
         {
+            auto& regions = bufferImageCopies.get({buffer->getBuffer().get(), copy.dstImage.getImage().get()});
             for (const auto& region : copy.regions)
-                bufferImageCopies.emplace_back(VkBufferImageCopy2{
+                regions.emplace_back(VkBufferImageCopy2{
                   .sType             = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2,
                   .pNext             = nullptr,
                   .bufferOffset      = buffer->getBufferOffset() + region.dataOffset,
@@ -746,31 +1551,52 @@ namespace sol
                   .imageExtent       = VkExtent3D{region.extent[0], region.extent[1], region.extent[2]}});
         }
 
-        // Collect copies from buffers to buffers.
-        for (const auto& copy : b2bCopies)
+        // Collect copies from buffers to images.
+        for (const auto& copy : b2iCopies)
         {
-            bufferCopies.emplace_back(
-              VkBufferCopy2{.sType     = VK_STRUCTURE_TYPE_BUFFER_COPY_2,
-                            .pNext     = nullptr,
-                            .srcOffset = copy.srcOffset + copy.srcBuffer.getBufferOffset(),
-                            .dstOffset = copy.dstOffset + copy.dstBuffer.getBufferOffset(),
-                            .size      = copy.size == VK_WHOLE_SIZE ? copy.srcBuffer.getBufferSize() : copy.size});
+            auto& regions = bufferImageCopies.get({copy.srcBuffer.getBuffer().get(), copy.dstImage.getImage().get()});
+            for (const auto& region : copy.regions)
+                regions.emplace_back(VkBufferImageCopy2{
+                  .sType             = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2,
+                  .pNext             = nullptr,
+                  .bufferOffset      = copy.srcBuffer.getBufferOffset() + region.dataOffset,
+                  .bufferRowLength   = 0,
+                  .bufferImageHeight = 0,
+                  .imageSubresource  = VkImageSubresourceLayers{.aspectMask     = region.aspectMask,
+                                                                .mipLevel       = region.mipLevel,
+                                                                .baseArrayLayer = region.baseArrayLayer,
+                                                                .layerCount     = region.layerCount},
+                  .imageOffset       = VkOffset3D{region.offset[0], region.offset[1], region.offset[2]},
+                  .imageExtent       = VkExtent3D{region.extent[0], region.extent[1], region.extent[2]}});
         }
 
-        // TODO: Implement  image to image and buffer to image copies.
-        // Don't forget second loop for the copy infos a bit below.
-
         // Collect copies from images to images.
-        for (const auto& copy : i2iCopies) { static_cast<void>(copy); }
-
-        // Collect copies from buffers to images.
-        for (const auto& copy : b2iCopies) { static_cast<void>(copy); }
+        for (const auto& copy : i2iCopies)
+        {
+            auto& regions = imageCopies.get({copy.srcImage.getImage().get(), copy.dstImage.getImage().get()});
+            for (const auto& region : copy.regions)
+                regions.emplace_back(VkImageCopy2{
+                  .sType          = VK_STRUCTURE_TYPE_IMAGE_COPY_2,
+                  .pNext          = nullptr,
+                  .srcSubresource = VkImageSubresourceLayers{.aspectMask     = region.aspectMask,
+                                                             .mipLevel       = region.srcMipLevel,
+                                                             .baseArrayLayer = region.srcBaseArrayLayer,
+                                                             .layerCount     = region.layerCount},
+                  .srcOffset      = VkOffset3D{region.srcOffset[0], region.srcOffset[1], region.srcOffset[2]},
+                  .dstSubresource = VkImageSubresourceLayers{.aspectMask     = region.aspectMask,
+                                                             .mipLevel       = region.dstMipLevel,
+                                                             .baseArrayLayer = region.dstBaseArrayLayer,
+                                                             .layerCount     = region.layerCount},
+                  .dstOffset      = VkOffset3D{region.dstOffset[0], region.dstOffset[1], region.dstOffset[2]},
+                  .extent         = VkExtent3D{region.extent[0], region.extent[1], region.extent[2]}});
+        }
 
         // Collect copies from images to buffers.
         for (const auto& [srcImage, dstBuffer, regions, dstOnDedicatedTransfer] : i2bCopies)
         {
+            auto& copies = imageBufferCopies.get({srcImage.getImage().get(), dstBuffer.getBuffer().get()});
             for (const auto& region : regions)
-                imageBufferCopies.emplace_back(VkBufferImageCopy2{
+                copies.emplace_back(VkBufferImageCopy2{
                   .sType             = VK_STRUCTURE_TYPE_BUFFER_IMAGE_COPY_2,
                   .pNext             = nullptr,
                   .bufferOffset      = dstBuffer.getBufferOffset() + region.dataOffset,
@@ -788,92 +1614,80 @@ namespace sol
          * Collect copy infos. Needs to happen after copies were fully collected for stable pointers.
          */
 
-        size_t copyIndex = 0;
-
-        // Collect copy infos from staging buffers to buffers.
-        for (const auto& [copy, buffer] : s2bCopies)
-        {
-            bufferInfos.emplace_back(VkCopyBufferInfo2{.sType       = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2,
-                                                       .pNext       = nullptr,
-                                                       .srcBuffer   = buffer->getBuffer().get(),
-                                                       .dstBuffer   = copy.dstBuffer.getBuffer().get(),
-                                                       .regionCount = 1,
-                                                       .pRegions    = &bufferCopies[copyIndex++]});
-        }
-        // Collect copy infos from buffers to buffers.
-        for (const auto& [srcBuffer,
-                          dstBuffer,
-                          size,
-                          srcOffset,
-                          dstOffset,
-                          srcOnDedicatedTransfer,
-                          dstOnDedicatedTransfer] : b2bCopies)
+        for (const auto& [key, regions] : bufferCopies.groups)
         {
             bufferInfos.emplace_back(VkCopyBufferInfo2{.sType       = VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2,
                                                        .pNext       = nullptr,
-                                                       .srcBuffer   = srcBuffer.getBuffer().get(),
-                                                       .dstBuffer   = dstBuffer.getBuffer().get(),
-                                                       .regionCount = 1,
-                                                       .pRegions    = &bufferCopies[copyIndex++]});
+                                                       .srcBuffer   = key.first,
+                                                       .dstBuffer   = key.second,
+                                                       .regionCount = static_cast<uint32_t>(regions.size()),
+                                                       .pRegions    = regions.data()});
         }
 
-        copyIndex = 0;
-
-        // Collect copy infos from staging buffers to images.
-        for (const auto& [copy, buffer] : s2iCopies)
+        for (const auto& [key, regions] : bufferImageCopies.groups)
         {
             bufferImageInfos.emplace_back(
               VkCopyBufferToImageInfo2{.sType          = VK_STRUCTURE_TYPE_COPY_BUFFER_TO_IMAGE_INFO_2,
                                        .pNext          = nullptr,
-                                       .srcBuffer      = buffer->getBuffer().get(),
-                                       .dstImage       = copy.dstImage.getImage().get(),
+                                       .srcBuffer      = key.first,
+                                       .dstImage       = key.second,
                                        .dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                       .regionCount    = static_cast<uint32_t>(copy.regions.size()),
-                                       .pRegions       = &bufferImageCopies[copyIndex]});
-            copyIndex += copy.regions.size();
-        }
-        // Collect copy infos from buffers to images
-        for (const auto& copy : b2iCopies)
-        {
-            // bufferImageInfos.emplace_back
-            static_cast<void>(copy);
+                                       .regionCount    = static_cast<uint32_t>(regions.size()),
+                                       .pRegions       = regions.data()});
         }
 
-        copyIndex = 0;
-
-        // Collect copy infos from images to images
-        for (const auto& copy : i2iCopies)
+        for (const auto& [key, regions] : imageCopies.groups)
         {
-            // imageInfos.emplace_back()
-            static_cast<void>(copy);
+            imageInfos.emplace_back(VkCopyImageInfo2{.sType          = VK_STRUCTURE_TYPE_COPY_IMAGE_INFO_2,
+                                                     .pNext          = nullptr,
+                                                     .srcImage       = key.first,
+                                                     .srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                                     .dstImage       = key.second,
+                                                     .dstImageLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                     .regionCount    = static_cast<uint32_t>(regions.size()),
+                                                     .pRegions       = regions.data()});
         }
 
-        copyIndex = 0;
-
-        // Collect copy infos from images to buffers.
-        for (const auto& [srcImage, dstBuffer, regions, dstOnDedicatedTransfer] : i2bCopies)
+        for (const auto& [key, regions] : imageBufferCopies.groups)
         {
             imageBufferInfos.emplace_back(
               VkCopyImageToBufferInfo2{.sType          = VK_STRUCTURE_TYPE_COPY_IMAGE_TO_BUFFER_INFO_2,
                                        .pNext          = nullptr,
-                                       .srcImage       = srcImage.getImage().get(),
+                                       .srcImage       = key.first,
                                        .srcImageLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                       .dstBuffer      = dstBuffer.getBuffer().get(),
+                                       .dstBuffer      = key.second,
                                        .regionCount    = static_cast<uint32_t>(regions.size()),
-                                       .pRegions       = &imageBufferCopies[copyIndex]});
-            copyIndex += regions.size();
+                                       .pRegions       = regions.data()});
+        }
+
+        stats.stagedCopies = s2bCopies.size() + s2iCopies.size() + b2bCopies.size() + i2iCopies.size() +
+                             b2iCopies.size() + i2bCopies.size();
+        stats.copyCommands =
+          bufferInfos.size() + imageInfos.size() + bufferImageInfos.size() + imageBufferInfos.size();
+        stats.copyRegions = bufferCopies.regionCount() + imageCopies.regionCount() +
+                            bufferImageCopies.regionCount() + imageBufferCopies.regionCount();
+        for (uint32_t i = 0; i < familyCount; i++)
+        {
+            stats.bufferBarriers += preCopyReleaseBufferBarriers[i].size() + preCopyAcquireBufferBarriers[i].size() +
+                                    postCopyReleaseBufferBarriers[i].size() + postCopyAcquireBufferBarriers[i].size() +
+                                    postUpdateBufferBarriers[i].size();
+            stats.imageBarriers += preCopyReleaseImageBarriers[i].size() + preCopyAcquireImageBarriers[i].size() +
+                                   postCopyReleaseImageBarriers[i].size() + postCopyAcquireImageBarriers[i].size() +
+                                   postUpdateImageBarriers[i].size();
         }
 
-        // Lock manager and wait on previous commits.
-        auto lock = manager->lockAndWait();
-        index     = ++manager->transactionIndex;
+        // Lock manager and get a free slot, waiting on the oldest in-flight transaction if there is none.
+        auto  lock   = manager->lock();
+        slot         = manager->acquireSlot();
+        index        = ++manager->transactionIndex;
+        auto& txSlot = manager->slots[slot];
 
         // Submit pre-copy release barriers.
         for (uint32_t i = 0; i < familyCount; i++)
         {
             if (preCopyReleaseBufferBarriers[i].empty() && preCopyReleaseImageBarriers[i].empty()) continue;
 
-            auto& cmdBuffer = *manager->preCopyReleaseCmdBuffers[i];
+            auto& cmdBuffer = *txSlot.preCopyReleaseCmdBuffers[i];
 
             const VkDependencyInfo dependency{
               .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
@@ -889,6 +1703,7 @@ namespace sol
             cmdBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
             cmdBuffer.beginOneTimeCommand();
             vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+            stats.barrierCommands++;
             cmdBuffer.endCommand();
 
             // TODO: All wait and signal semaphores that are recorded in the transaction use ALL_COMMANDS. Is that unavoidable?
@@ -914,16 +1729,17 @@ namespace sol
                                        .signalSemaphoreInfoCount = 1,
                                        .pSignalSemaphoreInfos    = &signalSemaphore};
 
+            stats.submits++;
             handleVulkanError(vkQueueSubmit2(memoryManager.getQueue(i).get(), 1, &submit, VK_NULL_HANDLE));
         }
 
-        // Submit pre-copy acquire barriers.
-        for (uint32_t i = 0; i < familyCount; i++)
-        {
-            if (preCopyAcquireBufferBarriers[i].empty() && preCopyAcquireImageBarriers[i].empty()) continue;
-
-            auto& cmdBuffer = *manager->preCopyAcquireCmdBuffers[i];
+        // Fills and copies are submitted on the transfer queue. Commands that would otherwise be submitted separately
+        // on the transfer queue directly before or after them are recorded into the same command buffer.
+        const bool hasCopies = !bufferFills.empty() || !bufferInfos.empty() || !imageInfos.empty() ||
+                               !bufferImageInfos.empty() || !imageBufferInfos.empty();
 
+        // Record pre-copy acquire barriers, together with the inline updates, image clears and the barriers after them.
+        const auto recordPreCopy = [&](VulkanCommandBuffer& cmdBuffer, const uint32_t i) {
             const VkDependencyInfo dependency{
               .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
               .pNext                    = VK_NULL_HANDLE,
@@ -935,9 +1751,81 @@ namespace sol
               .imageMemoryBarrierCount  = static_cast<uint32_t>(preCopyAcquireImageBarriers[i].size()),
               .pImageMemoryBarriers     = preCopyAcquireImageBarriers[i].data()};
 
+            const VkDependencyInfo updateDependency{
+              .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+              .pNext                    = VK_NULL_HANDLE,
+              .dependencyFlags          = 0,
+              .memoryBarrierCount       = 0,
+              .pMemoryBarriers          = VK_NULL_HANDLE,
+              .bufferMemoryBarrierCount = static_cast<uint32_t>(postUpdateBufferBarriers[i].size()),
+              .pBufferMemoryBarriers    = postUpdateBufferBarriers[i].data(),
+              .imageMemoryBarrierCount  = static_cast<uint32_t>(postUpdateImageBarriers[i].size()),
+              .pImageMemoryBarriers     = postUpdateImageBarriers[i].data()};
+
+            if (!preCopyAcquireBufferBarriers[i].empty() || !preCopyAcquireImageBarriers[i].empty())
+            {
+                vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+                stats.barrierCommands++;
+            }
+            for (const auto* update : updates[i])
+                vkCmdUpdateBuffer(cmdBuffer.get(),
+                                  update->buffer->getBuffer().get(),
+                                  update->offset,
+                                  update->size,
+                                  inlineData.data() + update->dataOffset);
+            for (const auto* clear : clears[i])
+            {
+                std::vector<VkImageSubresourceRange> colorRanges;
+                std::vector<VkImageSubresourceRange> depthStencilRanges;
+                for (const auto& range : clear->ranges)
+                {
+                    if (range.aspectMask == VK_IMAGE_ASPECT_COLOR_BIT)
+                        colorRanges.emplace_back(range);
+                    else
+                        depthStencilRanges.emplace_back(range);
+                }
+
+                if (!colorRanges.empty())
+                {
+                    vkCmdClearColorImage(cmdBuffer.get(),
+                                         clear->dstImage.getImage().get(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                         &clear->color,
+                                         static_cast<uint32_t>(colorRanges.size()),
+                                         colorRanges.data());
+                    stats.clears++;
+                }
+                if (!depthStencilRanges.empty())
+                {
+                    vkCmdClearDepthStencilImage(cmdBuffer.get(),
+                                                clear->dstImage.getImage().get(),
+                                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                &clear->depthStencil,
+                                                static_cast<uint32_t>(depthStencilRanges.size()),
+                                                depthStencilRanges.data());
+                    stats.clears++;
+                }
+            }
+            if (!postUpdateBufferBarriers[i].empty() || !postUpdateImageBarriers[i].empty())
+            {
+                vkCmdPipelineBarrier2(cmdBuffer.get(), &updateDependency);
+                stats.barrierCommands++;
+            }
+        };
+
+        // Submit pre-copy acquire barriers, together with the inline updates, image clears and the barriers after them.
+        for (uint32_t i = 0; i < familyCount; i++)
+        {
+            if (preCopyAcquireBufferBarriers[i].empty() && preCopyAcquireImageBarriers[i].empty() &&
+                updates[i].empty() && clears[i].empty())
+                continue;
+            if (hasCopies && i == transferIndex) continue;
+
+            auto& cmdBuffer = *txSlot.preCopyAcquireCmdBuffers[i];
+
             cmdBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
             cmdBuffer.beginOneTimeCommand();
-            vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+            recordPreCopy(cmdBuffer, i);
             cmdBuffer.endCommand();
 
             std::vector<VkSemaphoreSubmitInfo> waitSemaphores;
@@ -976,21 +1864,73 @@ namespace sol
                                        .signalSemaphoreInfoCount = 1,
                                        .pSignalSemaphoreInfos    = &signalSemaphore};
 
+            stats.submits++;
             handleVulkanError(vkQueueSubmit2(memoryManager.getQueue(i).get(), 1, &submit, VK_NULL_HANDLE));
         }
 
-        // Submit copies.
-        if (!bufferInfos.empty() || !imageInfos.empty() || !bufferImageInfos.empty() || !imageBufferInfos.empty())
+        // Submit fills and copies, together with the pre-copy acquire and post-copy release barriers of the transfer
+        // queue.
+        if (hasCopies)
         {
             auto& transferQueue = getMemoryManager().getTransferQueue();
-            auto& cmdBuffer     = *manager->copyCmdBuffer;
+            auto& cmdBuffer     = *txSlot.copyCmdBuffer;
 
             cmdBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
             cmdBuffer.beginOneTimeCommand();
+            recordPreCopy(cmdBuffer, transferIndex);
+            for (const auto& fill : bufferFills)
+                vkCmdFillBuffer(cmdBuffer.get(),
+                                fill.dstBuffer.getBuffer().get(),
+                                fill.dstBuffer.getBufferOffset() + fill.offset,
+                                fill.size,
+                                fill.data);
+            stats.fills = bufferFills.size();
+
+            // Copies are ordered after the fills, so that they can overwrite part of a filled range.
+            if (!bufferFills.empty() && stats.copyCommands > 0)
+            {
+                const VkMemoryBarrier2 fillBarrier{.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+                                                   .pNext         = nullptr,
+                                                   .srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                   .srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                                   .dstStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                   .dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT |
+                                                                    VK_ACCESS_2_TRANSFER_WRITE_BIT};
+                const VkDependencyInfo fillDependency{.sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                                                      .pNext                    = VK_NULL_HANDLE,
+                                                      .dependencyFlags          = 0,
+                                                      .memoryBarrierCount       = 1,
+                                                      .pMemoryBarriers          = &fillBarrier,
+                                                      .bufferMemoryBarrierCount = 0,
+                                                      .pBufferMemoryBarriers    = VK_NULL_HANDLE,
+                                                      .imageMemoryBarrierCount  = 0,
+                                                      .pImageMemoryBarriers     = VK_NULL_HANDLE};
+                vkCmdPipelineBarrier2(cmdBuffer.get(), &fillDependency);
+                stats.barrierCommands++;
+            }
+
             for (const auto& cp : bufferInfos) vkCmdCopyBuffer2(cmdBuffer.get(), &cp);
             for (const auto& cp : imageInfos) vkCmdCopyImage2(cmdBuffer.get(), &cp);
             for (const auto& cp : bufferImageInfos) vkCmdCopyBufferToImage2(cmdBuffer.get(), &cp);
             for (const auto& cp : imageBufferInfos) vkCmdCopyImageToBuffer2(cmdBuffer.get(), &cp);
+
+            const auto& releaseBufferBarriers = postCopyReleaseBufferBarriers[transferIndex];
+            const auto& releaseImageBarriers  = postCopyReleaseImageBarriers[transferIndex];
+            if (!releaseBufferBarriers.empty() || !releaseImageBarriers.empty())
+            {
+                const VkDependencyInfo dependency{
+                  .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+                  .pNext                    = VK_NULL_HANDLE,
+                  .dependencyFlags          = 0,
+                  .memoryBarrierCount       = 0,
+                  .pMemoryBarriers          = VK_NULL_HANDLE,
+                  .bufferMemoryBarrierCount = static_cast<uint32_t>(releaseBufferBarriers.size()),
+                  .pBufferMemoryBarriers    = releaseBufferBarriers.data(),
+                  .imageMemoryBarrierCount  = static_cast<uint32_t>(releaseImageBarriers.size()),
+                  .pImageMemoryBarriers     = releaseImageBarriers.data()};
+                vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+                stats.barrierCommands++;
+            }
             cmdBuffer.endCommand();
 
             std::vector<VkSemaphoreSubmitInfo> waitSemaphores;
@@ -1030,6 +1970,7 @@ namespace sol
                                        .signalSemaphoreInfoCount = 1,
                                        .pSignalSemaphoreInfos    = &signalSemaphore};
 
+            stats.submits++;
             handleVulkanError(vkQueueSubmit2(transferQueue.get(), 1, &submit, VK_NULL_HANDLE));
         }
 
@@ -1037,8 +1978,9 @@ namespace sol
         for (uint32_t i = 0; i < familyCount; i++)
         {
             if (postCopyReleaseBufferBarriers[i].empty() && postCopyReleaseImageBarriers[i].empty()) continue;
+            if (hasCopies && i == transferIndex) continue;
 
-            auto& cmdBuffer = *manager->postCopyReleaseCmdBuffers[i];
+            auto& cmdBuffer = *txSlot.postCopyReleaseCmdBuffers[i];
 
             const VkDependencyInfo dependency{
               .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
@@ -1054,6 +1996,7 @@ namespace sol
             cmdBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
             cmdBuffer.beginOneTimeCommand();
             vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+            stats.barrierCommands++;
             cmdBuffer.endCommand();
 
             const VkSemaphoreSubmitInfo signalSemaphore{.sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
@@ -1078,6 +2021,7 @@ namespace sol
                                        .signalSemaphoreInfoCount = 1,
                                        .pSignalSemaphoreInfos    = &signalSemaphore};
 
+            stats.submits++;
             handleVulkanError(vkQueueSubmit2(memoryManager.getQueue(i).get(), 1, &submit, VK_NULL_HANDLE));
         }
 
@@ -1086,7 +2030,7 @@ namespace sol
         {
             if (postCopyAcquireBufferBarriers[i].empty() && postCopyAcquireImageBarriers[i].empty()) continue;
 
-            auto& cmdBuffer = *manager->postCopyAcquireCmdBuffers[i];
+            auto& cmdBuffer = *txSlot.postCopyAcquireCmdBuffers[i];
 
             const VkDependencyInfo dependency{
               .sType                    = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
@@ -1102,6 +2046,7 @@ namespace sol
             cmdBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
             cmdBuffer.beginOneTimeCommand();
             vkCmdPipelineBarrier2(cmdBuffer.get(), &dependency);
+            stats.barrierCommands++;
             cmdBuffer.endCommand();
 
             std::vector<VkSemaphoreSubmitInfo> waitSemaphores;
@@ -1140,25 +2085,37 @@ namespace sol
                                        .signalSemaphoreInfoCount = 1,
                                        .pSignalSemaphoreInfos    = &signalSemaphore};
 
+            stats.submits++;
             handleVulkanError(vkQueueSubmit2(memoryManager.getQueue(i).get(), 1, &submit, VK_NULL_HANDLE));
         }
 
         // Copy final state of semaphore values.
-        semaphoreValues = manager->semaphoreValues;
+        semaphoreValues         = manager->semaphoreValues;
+        txSlot.semaphoreValues  = semaphoreValues;
+        txSlot.transactionIndex = index;
 
         committed = true;
     }
 
+    TransactionHandle Transaction::commitAsync()
+    {
+        commit();
+
+        auto lock  = manager->lock();
+        auto state = manager->addCompletion(semaphoreValues, takeStagingBuffers());
+        return TransactionHandle(*manager, std::move(state));
+    }
+
     void Transaction::wait()
     {
         if (done) return;
         requireCommitted();
 
-        auto lock = manager->lock();
+        // Only wait on the semaphore values of this transaction. Transactions that were committed later can
+        // still be in flight.
+        manager->wait(semaphoreValues);
 
-        // We only need to wait if this is still the active transaction.
-        // Otherwise, another transaction was already submitted, which had to perform the wait.
-        if (manager->transactionIndex == index) manager->wait();
+        invalidateDestinations();
 
         // Clear out all staging buffers.
         s2bCopies.clear();
@@ -1167,6 +2124,141 @@ namespace sol
         done = true;
     }
 
+    std::vector<IBufferPtr> Transaction::takeStagingBuffers()
+    {
+        // Only the buffers are moved out. The copies are kept, so that wait() can still invalidate their destinations.
+        std::vector<IBufferPtr> stagingBuffers;
+        stagingBuffers.reserve(s2bCopies.size() + s2iCopies.size());
+        for (auto& buffer : s2bCopies | std::views::values)
+            if (buffer) stagingBuffers.emplace_back(std::move(buffer));
+        for (auto& buffer : s2iCopies | std::views::values)
+            if (buffer) stagingBuffers.emplace_back(std::move(buffer));
+        return stagingBuffers;
+    }
+
+    void Transaction::writeDirect(const StagingBufferCopy& copy) const
+    {
+        auto&        buffer = copy.dstBuffer.getBuffer();
+        const size_t offset = copy.dstBuffer.getBufferOffset() + copy.offset;
+        const size_t size   = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() : copy.size;
+
+        // Memory that is not persistently mapped is only mapped for the duration of the write.
+        const bool mapped = buffer.isMapped();
+        if (!mapped) buffer.map();
+        manager->setData(buffer, copy.data, size, offset);
+        buffer.flush(offset, size);
+        if (!mapped) buffer.unmap();
+    }
+
+    bool Transaction::canWriteDirect(const StagingBufferCopy& copy, const std::optional<BufferBarrier>& barrier) const
+    {
+        if (!directWrite || !copy.dstBuffer.getBuffer().isHostVisible()) return false;
+        if (!barrier || copy.dstBuffer.isConcurrent()) return true;
+
+        // The barrier after a host write has the host stage as its source, which cannot be part of a queue family
+        // ownership transfer.
+        const auto* srcFamily = barrier->srcFamily ? barrier->srcFamily : &copy.dstBuffer.getQueueFamily();
+        const auto* dstFamily = barrier->dstFamily ? barrier->dstFamily : srcFamily;
+        return srcFamily == dstFamily;
+    }
+
+    bool Transaction::canUpdateInline(const StagingBufferCopy& copy) const
+    {
+        if (!inlineUpdates) return false;
+
+        const size_t size = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() : copy.size;
+        return size > 0 && size <= inlineUpdateSize && size % 4 == 0 &&
+               (copy.dstBuffer.getBufferOffset() + copy.offset) % 4 == 0;
+    }
+
+    void Transaction::stageInline(const StagingBufferCopy& copy, const std::optional<BufferBarrier>& barrier)
+    {
+        const size_t size = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() : copy.size;
+        const auto*  family =
+          barrier && barrier->srcFamily ? barrier->srcFamily : &copy.dstBuffer.getQueueFamily();
+
+        // Memory barrier that will get the destination buffer from its current state to the transfer state, without
+        // changing ownership.
+        if (barrier)
+        {
+            stage(BufferBarrier{.buffer    = copy.dstBuffer,
+                                .srcFamily = family,
+                                .dstFamily = family,
+                                .srcStage  = barrier->srcStage,
+                                .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .srcAccess = barrier->srcAccess,
+                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .offset    = narrowBarriers ? copy.offset : 0,
+                                .size      = narrowBarriers ? size : VK_WHOLE_SIZE},
+                  BarrierLocation::BeforeCopy);
+        }
+
+        const size_t dataOffset = inlineData.size();
+        inlineData.resize(dataOffset + size);
+        std::memcpy(inlineData.data() + dataOffset, copy.data, size);
+        inlineCopies.emplace_back(InlineUpdate{.buffer     = &copy.dstBuffer,
+                                               .family     = family,
+                                               .offset     = copy.dstBuffer.getBufferOffset() + copy.offset,
+                                               .dataOffset = dataOffset,
+                                               .size       = size});
+
+        // Memory barrier that will get the destination buffer from the transfer state to its final state. It is
+        // recorded directly after the update, instead of after the copies on the transfer queue.
+        if (barrier)
+        {
+            stage(BufferBarrier{.buffer    = copy.dstBuffer,
+                                .srcFamily = family,
+                                .dstFamily = barrier->dstFamily,
+                                .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstStage  = barrier->dstStage,
+                                .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .dstAccess = barrier->dstAccess,
+                                .offset    = narrowBarriers ? copy.offset : 0,
+                                .size      = narrowBarriers ? size : VK_WHOLE_SIZE},
+                  BarrierLocation::AfterUpdate);
+        }
+    }
+
+    void Transaction::invalidateDestinations() const
+    {
+        for (const auto& fill : bufferFills)
+        {
+            const auto& buffer = fill.dstBuffer.getBuffer();
+            if (!buffer.isHostVisible()) continue;
+            buffer.invalidate(fill.dstBuffer.getBufferOffset() + fill.offset, fill.size);
+        }
+
+        for (const auto& update : inlineCopies)
+        {
+            const auto& buffer = update.buffer->getBuffer();
+            if (!buffer.isHostVisible()) continue;
+            buffer.invalidate(update.offset, update.size);
+        }
+
+        for (const auto& copy : s2bCopies | std::views::keys)
+        {
+            const auto& buffer = copy.dstBuffer.getBuffer();
+            if (!buffer.isHostVisible()) continue;
+            const size_t size = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() : copy.size;
+            buffer.invalidate(copy.dstBuffer.getBufferOffset() + copy.offset, size);
+        }
+
+        for (const auto& copy : b2bCopies)
+        {
+            const auto& buffer = copy.dstBuffer.getBuffer();
+            if (!buffer.isHostVisible()) continue;
+            const size_t size = copy.size == VK_WHOLE_SIZE ? copy.srcBuffer.getBufferSize() : copy.size;
+            buffer.invalidate(copy.dstBuffer.getBufferOffset() + copy.dstOffset, size);
+        }
+
+        for (const auto& copy : i2bCopies)
+        {
+            const auto& buffer = copy.dstBuffer.getBuffer();
+            if (!buffer.isHostVisible()) continue;
+            buffer.invalidate(copy.dstBuffer.getBufferOffset(), copy.dstBuffer.getBufferSize());
+        }
+    }
+
     void Transaction::requireCommitted() const
     {
         if (!committed) throw SolError("Transaction was not yet committed.");
@@ -0,0 +1,67 @@
+#include "sol-memory/transaction_handle.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/transaction_manager.h"
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    TransactionHandle::TransactionHandle(TransactionManager& transactionManager, std::shared_ptr<State> handleState) :
+        manager(&transactionManager), state(std::move(handleState))
+    {
+    }
+
+    TransactionHandle::~TransactionHandle() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    TransactionManager& TransactionHandle::getTransferManager() noexcept { return *manager; }
+
+    const TransactionManager& TransactionHandle::getTransferManager() const noexcept { return *manager; }
+
+    const std::vector<uint64_t>& TransactionHandle::getSemaphoreValues() const noexcept
+    {
+        return state->semaphoreValues;
+    }
+
+    bool TransactionHandle::isComplete()
+    {
+        if (state->complete) return true;
+        static_cast<void>(manager->poll());
+        return state->complete;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Completion.
+    ////////////////////////////////////////////////////////////////
+
+    void TransactionHandle::onComplete(Callback callback)
+    {
+        {
+            auto lock = manager->lock();
+            if (!state->complete)
+            {
+                state->callbacks.emplace_back(std::move(callback));
+                return;
+            }
+        }
+
+        callback();
+    }
+
+    void TransactionHandle::wait()
+    {
+        if (state->complete) return;
+        manager->wait(state->semaphoreValues);
+        static_cast<void>(manager->poll());
+    }
+}  // namespace sol
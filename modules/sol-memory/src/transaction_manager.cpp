@@ -4,17 +4,23 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <format>
 #include <ranges>
 
 ////////////////////////////////////////////////////////////////
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
+#include "sol-core/vulkan_buffer.h"
 #include "sol-core/vulkan_command_buffer.h"
 #include "sol-core/vulkan_device.h"
 #include "sol-core/vulkan_physical_device.h"
 #include "sol-core/vulkan_queue.h"
 #include "sol-core/vulkan_timeline_semaphore.h"
+#include "sol-error/sol_error.h"
 #include "sol-error/vulkan_error_handler.h"
 
 ////////////////////////////////////////////////////////////////
@@ -22,18 +28,123 @@
 ////////////////////////////////////////////////////////////////
 
 #include "sol-memory/i_buffer.h"
+#include "sol-memory/i_image.h"
 #include "sol-memory/memory_manager.h"
 #include "sol-memory/transaction.h"
 
+namespace
+{
+    /**
+     * \brief Part of a region of a staging image copy that is uploaded in a single chunk.
+     */
+    struct ImagePiece
+    {
+        /**
+         * \brief Offset of the data of this piece in the source data.
+         */
+        size_t offset = 0;
+
+        size_t size = 0;
+
+        sol::ImageRegion region;
+    };
+
+    [[nodiscard]] size_t getChunkSize(const sol::RingBufferMemoryPool& pool, const size_t chunkSize)
+    {
+        // Keep chunks aligned, so that two of them fit in the ring buffer at the same time.
+        constexpr size_t alignment = 256;
+
+        if (chunkSize > pool.getBlockSize())
+            throw sol::SolError(std::format(
+              "Cannot upload in chunks of {} bytes. Staging pool block size is {}.", chunkSize, pool.getBlockSize()));
+        if (chunkSize > 0) return chunkSize;
+
+        const auto size = pool.getBlockSize() / 2 / alignment * alignment;
+        return size > 0 ? size : pool.getBlockSize();
+    }
+
+    /**
+     * \brief Recursively split a region over array layers, depth slices and rows until each piece fits in a chunk.
+     * Regions of block-compressed images are not split by rows, since a row of data holds a row of blocks.
+     */
+    void splitRegion(const sol::ImageRegion&  region,
+                     const size_t             offset,
+                     const size_t             size,
+                     const size_t             chunkSize,
+                     const bool               blockCompressed,
+                     std::vector<ImagePiece>& pieces)
+    {
+        if (size <= chunkSize)
+        {
+            pieces.emplace_back(ImagePiece{.offset = offset, .size = size, .region = region});
+            return;
+        }
+
+        // Split along the slowest varying dimension that has more than 1 element.
+        const auto split = [&](const uint32_t count, auto&& makeSub) {
+            const size_t   elementSize = size / count;
+            const uint32_t step        = static_cast<uint32_t>(std::max<size_t>(1, chunkSize / elementSize));
+            for (uint32_t i = 0; i < count; i += step)
+            {
+                const uint32_t n = std::min(step, count - i);
+                splitRegion(
+                  makeSub(i, n), offset + i * elementSize, n * elementSize, chunkSize, blockCompressed, pieces);
+            }
+        };
+
+        if (region.layerCount > 1)
+        {
+            split(region.layerCount, [&](const uint32_t i, const uint32_t n) {
+                auto sub = region;
+                sub.baseArrayLayer += i;
+                sub.layerCount = n;
+                return sub;
+            });
+        }
+        else if (region.extent[2] > 1)
+        {
+            split(region.extent[2], [&](const uint32_t i, const uint32_t n) {
+                auto sub = region;
+                sub.offset[2] += static_cast<int32_t>(i);
+                sub.extent[2] = n;
+                return sub;
+            });
+        }
+        else if (region.extent[1] > 1)
+        {
+            if (blockCompressed)
+                throw sol::SolError(std::format(
+                  "Cannot split image region of {} bytes into chunks of {} bytes: rows of a block-compressed image "
+                  "cannot be split.",
+                  size,
+                  chunkSize));
+
+            split(region.extent[1], [&](const uint32_t i, const uint32_t n) {
+                auto sub = region;
+                sub.offset[1] += static_cast<int32_t>(i);
+                sub.extent[1] = n;
+                return sub;
+            });
+        }
+        else
+            throw sol::SolError(
+              std::format("Cannot split image region of {} bytes into chunks of {} bytes.", size, chunkSize));
+    }
+}  // namespace
+
 namespace sol
 {
     ////////////////////////////////////////////////////////////////
     // Constructors.
     ////////////////////////////////////////////////////////////////
 
-    TransactionManager::TransactionManager(MemoryManager& memoryManager, RingBufferMemoryPool& memoryPool) :
+    TransactionManager::TransactionManager(MemoryManager&        memoryManager,
+                                           RingBufferMemoryPool& memoryPool,
+                                           const size_t          slotCount) :
         manager(&memoryManager), pool(&memoryPool)
     {
+        if (slotCount == 0) throw SolError("Cannot create a TransactionManager with 0 slots.");
+
         const auto familyCount = static_cast<uint32_t>(getDevice().getPhysicalDevice().getQueueFamilies().size());
 
         VulkanCommandBuffer::Settings cmdSettings;
@@ -41,17 +152,26 @@ namespace sol
         VulkanTimelineSemaphore::Settings semSettings;
         semSettings.device = manager->getDevice();
 
-        for (uint32_t i = 0; i < familyCount; i++)
+        slots.resize(slotCount);
+        for (auto& slot : slots)
         {
-            cmdSettings.commandPool = manager->getCommandPool(i);
-            preCopyReleaseCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
-            preCopyAcquireCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
-            postCopyReleaseCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
-            postCopyAcquireCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
+            for (uint32_t i = 0; i < familyCount; i++)
+            {
+                cmdSettings.commandPool = manager->getCommandPool(i);
+                slot.preCopyReleaseCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
+                slot.preCopyAcquireCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
+                slot.postCopyReleaseCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
+                slot.postCopyAcquireCmdBuffers.emplace_back(VulkanCommandBuffer::create(cmdSettings));
 
-            if (manager->getTransferQueue().getFamily().getIndex() == i)
-                copyCmdBuffer = VulkanCommandBuffer::create(cmdSettings);
+                if (manager->getTransferQueue().getFamily().getIndex() == i)
+                    slot.copyCmdBuffer = VulkanCommandBuffer::create(cmdSettings);
+            }
 
+            slot.semaphoreValues.resize(familyCount, 0);
+        }
+
+        for (uint32_t i = 0; i < familyCount; i++)
+        {
             semaphores.emplace_back(VulkanTimelineSemaphore::create(semSettings));
             semaphoreValues.emplace_back(0);
         }
@@ -67,7 +187,8 @@ namespace sol
     // Create.
     ////////////////////////////////////////////////////////////////
 
-    TransactionManagerPtr TransactionManager::create(MemoryManager& memoryManager, const size_t memoryPoolSize)
+    TransactionManagerPtr
+      TransactionManager::create(MemoryManager& memoryManager, const size_t memoryPoolSize, const size_t slotCount)
     {
         const IMemoryPool::CreateInfo info{
           .createFlags          = 0,
@@ -80,7 +201,7 @@ namespace sol
           .minBlocks       = 1,
           .maxBlocks       = 1};
         auto& pool = memoryManager.createRingBufferMemoryPool("transfer", info);
-        return std::make_unique<TransactionManager>(memoryManager, pool);
+        return std::make_unique<TransactionManager>(memoryManager, pool, slotCount);
     }
 
     ////////////////////////////////////////////////////////////////
@@ -102,11 +223,288 @@ namespace sol
         return semaphores;
     }
 
+    size_t TransactionManager::getSlotCount() const noexcept { return slots.size(); }
+
+    bool TransactionManager::getDirectWrite() const noexcept { return directWrite; }
+
+    bool TransactionManager::getInlineUpdates() const noexcept { return inlineUpdates; }
+
+    const TransactionManager::CopyExecutor& TransactionManager::getCopyExecutor() const noexcept
+    {
+        return copyExecutor;
+    }
+
+    size_t TransactionManager::getParallelCopyChunkSize() const noexcept { return parallelCopyChunkSize; }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void TransactionManager::setDirectWrite(const bool value) noexcept { directWrite = value; }
+
+    void TransactionManager::setInlineUpdates(const bool value) noexcept { inlineUpdates = value; }
+
+    void TransactionManager::setCopyExecutor(CopyExecutor executor, const size_t chunkSize)
+    {
+        if (chunkSize == 0) throw SolError("Cannot set copy executor. Chunk size cannot be 0.");
+        copyExecutor          = std::move(executor);
+        parallelCopyChunkSize = chunkSize;
+    }
+
     ////////////////////////////////////////////////////////////////
     // Transactions.
     ////////////////////////////////////////////////////////////////
 
-    BufferTransactionPtr TransactionManager::beginTransaction() { return std::make_unique<Transaction>(*this); }
+    BufferTransactionPtr TransactionManager::beginTransaction()
+    {
+        static_cast<void>(poll());
+        return std::make_unique<Transaction>(*this);
+    }
+
+    size_t TransactionManager::poll()
+    {
+        std::vector<IBufferPtr>                                stagingBuffers;
+        std::vector<TransactionHandle::Callback>               callbacks;
+        std::vector<std::shared_ptr<TransactionHandle::State>> completed;
+
+        {
+            auto l = lock();
+            if (completions.empty()) return 0;
+
+            // Semaphore values only increase, so query them once instead of for every transaction.
+            std::vector<uint64_t> values(semaphores.size());
+            for (size_t i = 0; i < semaphores.size(); i++)
+                handleVulkanError(vkGetSemaphoreCounterValue(getDevice().get(), semaphores[i]->get(), &values[i]));
+
+            const auto isDone = [&values](const TransactionHandle::State& state) {
+                for (size_t i = 0; i < values.size(); i++)
+                    if (values[i] < state.semaphoreValues[i]) return false;
+                return true;
+            };
+
+            for (auto& state : completions)
+            {
+                if (!isDone(*state)) continue;
+
+                for (auto& b : state->stagingBuffers) stagingBuffers.emplace_back(std::move(b));
+                for (auto& c : state->callbacks) callbacks.emplace_back(std::move(c));
+                state->stagingBuffers.clear();
+                state->callbacks.clear();
+                state->complete = true;
+                completed.emplace_back(state);
+            }
+
+            std::erase_if(completions, [](const auto& state) { return state->complete.load(); });
+        }
+
+        // Release staging buffers and invoke callbacks without holding the lock, so that callbacks can begin new
+        // transactions.
+        stagingBuffers.clear();
+        for (const auto& callback : callbacks) callback();
+
+        return completed.size();
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Streaming.
+    ////////////////////////////////////////////////////////////////
+
+    TransactionHandle TransactionManager::upload(const StagingBufferCopy&            copy,
+                                                 const std::optional<BufferBarrier>& barrier,
+                                                 size_t                              chunkSize)
+    {
+        chunkSize         = getChunkSize(*pool, chunkSize);
+        const size_t size = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() - copy.offset : copy.size;
+        const auto*  data = static_cast<const std::byte*>(copy.data);
+        const auto*  transferFamily = &getMemoryManager().getTransferQueue().getFamily();
+        if (size == 0) throw SolError("Cannot upload 0 bytes.");
+
+        std::deque<TransactionHandle> inFlight;
+        for (size_t offset = 0;; offset += chunkSize)
+        {
+            const size_t chunk = std::min(chunkSize, size - offset);
+            const bool   first = offset == 0;
+            const bool   last  = offset + chunk >= size;
+
+            // Drop chunks that have already completed, which releases their staging buffers.
+            while (!inFlight.empty() && inFlight.front().isComplete()) inFlight.pop_front();
+
+            auto transaction = beginTransaction();
+
+            // Memory barrier that will get the destination buffer from its current state to the transfer state.
+            if (first && barrier)
+            {
+                transaction->stage(
+                  BufferBarrier{.buffer    = copy.dstBuffer,
+                                .srcFamily = barrier->srcFamily,
+                                .dstFamily = copy.dstOnDedicatedTransfer ? transferFamily : barrier->srcFamily,
+                                .srcStage  = barrier->srcStage,
+                                .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .srcAccess = barrier->srcAccess,
+                                .dstAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT},
+                  BarrierLocation::BeforeCopy);
+            }
+
+            // Stage the chunk. If the staging pool is full, wait for the oldest chunk to complete.
+            const StagingBufferCopy chunkCopy{.dstBuffer              = copy.dstBuffer,
+                                              .data                   = data + offset,
+                                              .size                   = chunk,
+                                              .offset                 = copy.offset + offset,
+                                              .dstOnDedicatedTransfer = copy.dstOnDedicatedTransfer};
+            while (!transaction->stage(chunkCopy))
+            {
+                if (inFlight.empty())
+                    throw SolError(std::format("Failed to allocate a staging buffer of {} bytes.", chunk));
+                inFlight.front().wait();
+                inFlight.pop_front();
+            }
+
+            // Memory barrier that will get the destination buffer from the transfer state to its final state.
+            if (last && barrier)
+            {
+                transaction->stage(
+                  BufferBarrier{.buffer    = copy.dstBuffer,
+                                .srcFamily = copy.dstOnDedicatedTransfer ? transferFamily : barrier->srcFamily,
+                                .dstFamily = barrier->dstFamily,
+                                .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                .dstStage  = barrier->dstStage,
+                                .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                .dstAccess = barrier->dstAccess},
+                  BarrierLocation::AfterCopy);
+            }
+
+            inFlight.emplace_back(transaction->commitAsync());
+            if (last) return inFlight.back();
+        }
+    }
+
+    TransactionHandle TransactionManager::upload(const StagingImageCopy&            copy,
+                                                 const std::optional<ImageBarrier>& barrier,
+                                                 size_t                             chunkSize)
+    {
+        chunkSize        = getChunkSize(*pool, chunkSize);
+        const auto* data = static_cast<const std::byte*>(copy.data);
+
+        // Split all regions into pieces that fit in a chunk.
+        auto regions = copy.regions;
+        std::ranges::sort(regions, {}, &ImageRegion::dataOffset);
+        std::vector<ImagePiece> pieces;
+        for (size_t i = 0; i < regions.size(); i++)
+        {
+            const size_t end = i + 1 < regions.size() ? regions[i + 1].dataOffset : copy.dataSize;
+            splitRegion(regions[i],
+                        regions[i].dataOffset,
+                        end - regions[i].dataOffset,
+                        chunkSize,
+                        copy.dstImage.isBlockCompressed(),
+                        pieces);
+        }
+        if (pieces.empty()) throw SolError("Cannot upload an image copy without regions.");
+
+        std::deque<TransactionHandle> inFlight;
+        size_t                        index = 0;
+        for (bool first = true;; first = false)
+        {
+            // Pack as many consecutive pieces as fit in a single chunk.
+            const size_t             start = pieces[index].offset;
+            size_t                   end   = start;
+            std::vector<ImageRegion> chunkRegions;
+            for (; index < pieces.size() && pieces[index].offset + pieces[index].size - start <= chunkSize; index++)
+            {
+                auto region       = pieces[index].region;
+                region.dataOffset = pieces[index].offset - start;
+                chunkRegions.emplace_back(region);
+                end = pieces[index].offset + pieces[index].size;
+            }
+            const bool last = index >= pieces.size();
+
+            // Drop chunks that have already completed, which releases their staging buffers.
+            while (!inFlight.empty() && inFlight.front().isComplete()) inFlight.pop_front();
+
+            auto transaction = beginTransaction();
+
+            // Image barrier that will get the destination image from its current state to the transfer state.
+            if (first && barrier)
+            {
+                transaction->stage(ImageBarrier{.image          = copy.dstImage,
+                                                .srcFamily      = barrier->srcFamily,
+                                                .dstFamily      = barrier->dstFamily,
+                                                .srcStage       = barrier->srcStage,
+                                                .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                .srcAccess      = barrier->srcAccess,
+                                                .dstAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                                .srcLayout      = barrier->srcLayout,
+                                                .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                .aspectMask     = barrier->aspectMask,
+                                                .baseMipLevel   = barrier->baseMipLevel,
+                                                .levelCount     = barrier->levelCount,
+                                                .baseArrayLayer = barrier->baseArrayLayer,
+                                                .layerCount     = barrier->layerCount},
+                                   BarrierLocation::BeforeCopy);
+            }
+
+            // Stage the chunk. If the staging pool is full, wait for the oldest chunk to complete.
+            const StagingImageCopy chunkCopy{
+              .dstImage = copy.dstImage, .data = data + start, .dataSize = end - start, .regions = chunkRegions};
+            while (!transaction->stage(chunkCopy))
+            {
+                if (inFlight.empty())
+                    throw SolError(std::format("Failed to allocate a staging buffer of {} bytes.", end - start));
+                inFlight.front().wait();
+                inFlight.pop_front();
+            }
+
+            // Image barrier that will get the destination image from the transfer state to its final state.
+            if (last && barrier)
+            {
+                transaction->stage(ImageBarrier{.image          = copy.dstImage,
+                                                .srcFamily      = barrier->dstFamily,
+                                                .dstFamily      = barrier->dstFamily,
+                                                .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                .dstStage       = barrier->dstStage,
+                                                .srcAccess      = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                                .dstAccess      = barrier->dstAccess,
+                                                .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                                .dstLayout      = barrier->dstLayout,
+                                                .aspectMask     = barrier->aspectMask,
+                                                .baseMipLevel   = barrier->baseMipLevel,
+                                                .levelCount     = barrier->levelCount,
+                                                .baseArrayLayer = barrier->baseArrayLayer,
+                                                .layerCount     = barrier->layerCount},
+                                   BarrierLocation::AfterCopy);
+            }
+
+            inFlight.emplace_back(transaction->commitAsync());
+            if (last) return inFlight.back();
+        }
+    }
+
+    void TransactionManager::setData(const VulkanBuffer& buffer,
+                                     const void* const   data,
+                                     const size_t        size,
+                                     const size_t        offset) const
+    {
+        // Small copies are not worth the dispatch overhead.
+        if (!copyExecutor || size < 2 * parallelCopyChunkSize)
+        {
+            buffer.setData(data, size, offset);
+            return;
+        }
+
+        if (!buffer.isMapped()) throw SolError("Cannot set buffer data. Buffer is not mapped.");
+        if (size + offset > buffer.getSize())
+            throw SolError("Cannot set buffer data, size + offset exceeds total size of buffer.");
+
+        // Distribute the remainder over all pieces, keeping piece boundaries 64-byte aligned.
+        const size_t count = size / parallelCopyChunkSize;
+        auto*        dst   = buffer.getMappedData<std::byte>() + offset;
+        const auto*  src   = static_cast<const std::byte*>(data);
+        copyExecutor(count, [&](const size_t i) {
+            const size_t start = i == 0 ? 0 : (size * i / count) & ~size_t{63};
+            const size_t end   = i == count - 1 ? size : (size * (i + 1) / count) & ~size_t{63};
+            std::memcpy(dst + start, src + start, end - start);
+        });
+    }
 
     std::unique_ptr<std::scoped_lock<std::mutex>> TransactionManager::lockAndWait()
     {
@@ -116,6 +514,12 @@ namespace sol
     }
 
     void TransactionManager::wait()
+    {
+        wait(semaphoreValues);
+        for (const auto& state : completions) state->stagingBuffers.clear();
+    }
+
+    void TransactionManager::wait(const std::vector<uint64_t>& values) const
     {
         const auto handles =
           semaphores | std::views::transform([](const auto& s) { return s->get(); }) | std::ranges::to<std::vector>();
@@ -125,10 +529,47 @@ namespace sol
                                        .flags          = 0,
                                        .semaphoreCount = static_cast<uint32_t>(handles.size()),
                                        .pSemaphores    = handles.data(),
-                                       .pValues        = semaphoreValues.data()};
+                                       .pValues        = values.data()};
 
         handleVulkanError(vkWaitSemaphores(getDevice().get(), &info, UINT64_MAX));
-        pendingStagingBuffers.clear();
+    }
+
+    bool TransactionManager::isComplete(const std::vector<uint64_t>& values) const
+    {
+        for (size_t i = 0; i < semaphores.size(); i++)
+        {
+            uint64_t value = 0;
+            handleVulkanError(vkGetSemaphoreCounterValue(getDevice().get(), semaphores[i]->get(), &value));
+            if (value < values[i]) return false;
+        }
+
+        return true;
+    }
+
+    size_t TransactionManager::acquireSlot()
+    {
+        // Prefer a slot that was never used or whose work has already completed.
+        auto it = std::ranges::find_if(
+          slots, [this](const Slot& slot) { return slot.transactionIndex == 0 || isComplete(slot.semaphoreValues); });
+
+        // All slots are in flight. Wait for the oldest one.
+        if (it == slots.end())
+        {
+            it = std::ranges::min_element(slots, {}, &Slot::transactionIndex);
+            wait(it->semaphoreValues);
+        }
+
+        return static_cast<size_t>(std::distance(slots.begin(), it));
+    }
+
+    std::shared_ptr<TransactionHandle::State>
+      TransactionManager::addCompletion(std::vector<uint64_t> values, std::vector<IBufferPtr> stagingBuffers)
+    {
+        auto state             = std::make_shared<TransactionHandle::State>();
+        state->semaphoreValues = std::move(values);
+        state->stagingBuffers  = std::move(stagingBuffers);
+        completions.emplace_back(state);
+        return state;
     }
 
     std::unique_ptr<std::scoped_lock<std::mutex>> TransactionManager::lock()
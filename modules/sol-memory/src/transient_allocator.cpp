@@ -0,0 +1,278 @@
+#include "sol-memory/transient_allocator.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+#include <numeric>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_device.h"
+#include "sol-core/vulkan_device_memory.h"
+#include "sol-core/vulkan_physical_device.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/memory_manager.h"
+
+namespace
+{
+    [[nodiscard]] size_t alignUp(const size_t value, const size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}  // namespace
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    TransientAllocator::TransientAllocator(MemoryManager& memoryManager) : manager(&memoryManager) {}
+
+    TransientAllocator::~TransientAllocator() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    MemoryManager& TransientAllocator::getMemoryManager() noexcept { return *manager; }
+
+    const MemoryManager& TransientAllocator::getMemoryManager() const noexcept { return *manager; }
+
+    size_t TransientAllocator::getResourceCount() const noexcept { return resources.size(); }
+
+    bool TransientAllocator::isAllocated() const noexcept { return allocated; }
+
+    VulkanImage& TransientAllocator::getImage(const size_t index) const
+    {
+        const auto& resource = getResource(index);
+        if (!resource.image) throw SolError(std::format("Transient resource {} is not an image.", index));
+        return *resource.image;
+    }
+
+    VulkanBuffer& TransientAllocator::getBuffer(const size_t index) const
+    {
+        const auto& resource = getResource(index);
+        if (!resource.buffer) throw SolError(std::format("Transient resource {} is not a buffer.", index));
+        return *resource.buffer;
+    }
+
+    size_t TransientAllocator::getOffset(const size_t index) const
+    {
+        if (!allocated) throw SolError("Cannot get offset of transient resource. Resources were not allocated yet.");
+        return getResource(index).offset;
+    }
+
+    size_t TransientAllocator::getHeapIndex(const size_t index) const
+    {
+        if (!allocated) throw SolError("Cannot get heap of transient resource. Resources were not allocated yet.");
+        return getResource(index).heap;
+    }
+
+    const TransientAllocator::Statistics& TransientAllocator::getStatistics() const noexcept { return statistics; }
+
+    ////////////////////////////////////////////////////////////////
+    // Resources.
+    ////////////////////////////////////////////////////////////////
+
+    size_t TransientAllocator::addImage(const VulkanImage::Settings& settings,
+                                        const uint32_t               firstUse,
+                                        const uint32_t               lastUse)
+    {
+        validateResource(firstUse, lastUse, settings.allocator.valid());
+
+        auto imageSettings   = settings;
+        imageSettings.device = getMemoryManager().getDevice();
+
+        Resource resource;
+        resource.image        = VulkanImage::create(imageSettings);
+        resource.firstUse     = firstUse;
+        resource.lastUse      = lastUse;
+        resource.requirements = resource.image->getMemoryRequirements();
+        resource.lazy         = (settings.imageUsage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) &&
+                        findMemoryType(resource.requirements.memoryTypeBits,
+                                       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                         VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT) >= 0;
+        resources.emplace_back(std::move(resource));
+
+        return resources.size() - 1;
+    }
+
+    size_t TransientAllocator::addBuffer(const VulkanBuffer::Settings& settings,
+                                         const uint32_t                firstUse,
+                                         const uint32_t                lastUse)
+    {
+        validateResource(firstUse, lastUse, settings.allocator.valid());
+
+        auto bufferSettings   = settings;
+        bufferSettings.device = getMemoryManager().getDevice();
+
+        Resource resource;
+        resource.buffer       = VulkanBuffer::create(bufferSettings);
+        resource.firstUse     = firstUse;
+        resource.lastUse      = lastUse;
+        resource.requirements = resource.buffer->getMemoryRequirements();
+        resources.emplace_back(std::move(resource));
+
+        return resources.size() - 1;
+    }
+
+    void TransientAllocator::allocate()
+    {
+        if (allocated) throw SolError("Cannot allocate transient resources. Resources were already allocated.");
+
+        // Buffers and optimally tiled images in the same memory must be bufferImageGranularity apart. Instead of
+        // tracking the kind of each neighbour, simply align all resources to it.
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(getMemoryManager().getDevice().getPhysicalDevice().get(), &properties);
+        const size_t granularity = properties.limits.bufferImageGranularity;
+
+        // Place large resources first, they constrain the layout the most.
+        std::vector<size_t> order(resources.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::ranges::stable_sort(order, [this](const size_t lhs, const size_t rhs) {
+            return resources[lhs].requirements.size > resources[rhs].requirements.size;
+        });
+
+        std::vector<std::vector<size_t>> placed;
+        for (const auto index : order)
+        {
+            auto&        resource  = resources[index];
+            const size_t alignment = std::max<size_t>(resource.requirements.alignment, granularity);
+            const auto   flags     = resource.lazy ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                                   VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+                                                   : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+            // Find a heap of the same kind that still has a compatible memory type.
+            resource.heap = heaps.size();
+            for (size_t i = 0; i < heaps.size(); i++)
+            {
+                if (heaps[i].lazy != resource.lazy) continue;
+                if (findMemoryType(heaps[i].memoryTypeBits & resource.requirements.memoryTypeBits, flags) < 0)
+                    continue;
+                resource.heap = i;
+                break;
+            }
+            if (resource.heap == heaps.size())
+            {
+                if (findMemoryType(resource.requirements.memoryTypeBits, flags) < 0)
+                    throw SolError(
+                      std::format("Cannot allocate transient resource {}. No device local memory type found.", index));
+                heaps.emplace_back(Heap{.memory = nullptr, .size = 0, .memoryTypeBits = ~0u, .lazy = resource.lazy});
+                placed.emplace_back();
+            }
+            auto& heap = heaps[resource.heap];
+            heap.memoryTypeBits &= resource.requirements.memoryTypeBits;
+
+            // Collect resources in the same heap whose lifetime overlaps.
+            std::vector<const Resource*> conflicts;
+            for (const auto other : placed[resource.heap])
+            {
+                const auto& o = resources[other];
+                if (o.firstUse <= resource.lastUse && resource.firstUse <= o.lastUse) conflicts.push_back(&o);
+            }
+
+            // Candidate offsets are the start of the heap and the end of each conflicting resource.
+            std::vector<size_t> candidates{0};
+            for (const auto* o : conflicts) candidates.push_back(alignUp(o->offset + o->requirements.size, alignment));
+            std::ranges::sort(candidates);
+
+            const size_t size = resource.requirements.size;
+            for (const auto offset : candidates)
+            {
+                if (std::ranges::none_of(conflicts, [&](const Resource* o) {
+                        return offset < o->offset + o->requirements.size && o->offset < offset + size;
+                    }))
+                {
+                    resource.offset = offset;
+                    break;
+                }
+            }
+
+            heap.size = std::max(heap.size, resource.offset + size);
+            placed[resource.heap].push_back(index);
+        }
+
+        // Allocate device memory and bind resources.
+        statistics = {};
+        for (auto& heap : heaps)
+        {
+            VulkanDeviceMemory::Settings settings;
+            settings.device              = getMemoryManager().getDevice();
+            settings.size                = heap.size;
+            settings.memoryTypeBits      = heap.memoryTypeBits;
+            settings.memoryPropertyFlags = heap.lazy ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT |
+                                                         VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT
+                                                     : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+            heap.memory = VulkanDeviceMemory::create(settings);
+
+            statistics.heapBytes += heap.size;
+            statistics.heapCount++;
+            if (heap.lazy) statistics.lazyHeapCount++;
+        }
+
+        for (auto& resource : resources)
+        {
+            auto& memory = *heaps[resource.heap].memory;
+            if (resource.image)
+                resource.image->bindMemory(memory, resource.offset);
+            else
+                resource.buffer->bindMemory(memory, resource.offset);
+
+            statistics.dedicatedBytes += resource.requirements.size;
+        }
+
+        statistics.savedBytes = statistics.dedicatedBytes - std::min(statistics.dedicatedBytes, statistics.heapBytes);
+        allocated             = true;
+    }
+
+    void TransientAllocator::reset()
+    {
+        resources.clear();
+        heaps.clear();
+        allocated  = false;
+        statistics = {};
+    }
+
+    void TransientAllocator::validateResource(const uint32_t firstUse,
+                                              const uint32_t lastUse,
+                                              const bool     hasAllocator) const
+    {
+        if (allocated) throw SolError("Cannot add transient resource. Resources were already allocated.");
+        if (lastUse < firstUse)
+            throw SolError(std::format(
+              "Cannot add transient resource. Last use ({}) is before first use ({}).", lastUse, firstUse));
+        if (hasAllocator) throw SolError("Cannot add transient resource. Memory is bound by the TransientAllocator.");
+    }
+
+    const TransientAllocator::Resource& TransientAllocator::getResource(const size_t index) const
+    {
+        if (index >= resources.size())
+            throw SolError(std::format("Transient resource index {} is out of range.", index));
+        return resources[index];
+    }
+
+    int32_t TransientAllocator::findMemoryType(const uint32_t memoryTypeBits, const VkMemoryPropertyFlags flags) const
+    {
+        VkPhysicalDeviceMemoryProperties memProperties;
+        vkGetPhysicalDeviceMemoryProperties(getMemoryManager().getDevice().getPhysicalDevice().get(), &memProperties);
+
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++)
+        {
+            if (memoryTypeBits & 1u << i && (memProperties.memoryTypes[i].propertyFlags & flags) == flags)
+                return static_cast<int32_t>(i);
+        }
+
+        return -1;
+    }
+}  // namespace sol
@@ -0,0 +1,254 @@
+#include "sol-memory/upload_scheduler.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/pool/ring_buffer_memory_pool.h"
+#include "sol-memory/transaction_manager.h"
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    UploadScheduler::UploadScheduler(TransactionManager& transactionManager, const size_t budget) :
+        manager(&transactionManager)
+    {
+        setFrameBudget(budget);
+    }
+
+    UploadScheduler::~UploadScheduler() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    TransactionManager& UploadScheduler::getTransactionManager() noexcept { return *manager; }
+
+    const TransactionManager& UploadScheduler::getTransactionManager() const noexcept { return *manager; }
+
+    size_t UploadScheduler::getFrameBudget() const noexcept { return frameBudget; }
+
+    size_t UploadScheduler::getQueueDepth(const Priority priority) const
+    {
+        std::scoped_lock lock(mutex);
+        return metrics.queuedRequests[static_cast<size_t>(priority)];
+    }
+
+    size_t UploadScheduler::getQueuedBytes(const Priority priority) const
+    {
+        std::scoped_lock lock(mutex);
+        return metrics.queuedBytes[static_cast<size_t>(priority)];
+    }
+
+    UploadScheduler::Metrics UploadScheduler::getMetrics() const
+    {
+        std::scoped_lock lock(mutex);
+        return metrics;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void UploadScheduler::setFrameBudget(const size_t budget)
+    {
+        if (budget == 0) throw SolError("Cannot set upload frame budget to 0 bytes.");
+        frameBudget = budget;
+    }
+
+    bool UploadScheduler::setPriority(const RequestId id, const Priority priority)
+    {
+        std::scoped_lock lock(mutex);
+
+        const auto it = dequeue(id);
+        if (it == requests.end()) return false;
+
+        it->second.priority = priority;
+        queues[static_cast<size_t>(priority)].push_back(id);
+        metrics.queuedRequests[static_cast<size_t>(priority)]++;
+        metrics.queuedBytes[static_cast<size_t>(priority)] += it->second.size;
+        return true;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Requests.
+    ////////////////////////////////////////////////////////////////
+
+    UploadScheduler::RequestId UploadScheduler::enqueue(const StagingBufferCopy&     copy,
+                                                        std::optional<BufferBarrier> barrier,
+                                                        const Priority               priority,
+                                                        Callback                     onComplete)
+    {
+        const size_t size = copy.size == VK_WHOLE_SIZE ? copy.dstBuffer.getBufferSize() - copy.offset : copy.size;
+        return enqueue(
+          BufferUpload{.copy = copy, .barrier = std::move(barrier)}, size, priority, std::move(onComplete));
+    }
+
+    UploadScheduler::RequestId UploadScheduler::enqueue(const StagingImageCopy&     copy,
+                                                        std::optional<ImageBarrier> barrier,
+                                                        const Priority              priority,
+                                                        Callback                    onComplete)
+    {
+        return enqueue(
+          ImageUpload{.copy = copy, .barrier = std::move(barrier)}, copy.dataSize, priority, std::move(onComplete));
+    }
+
+    UploadScheduler::RequestId UploadScheduler::enqueue(std::variant<BufferUpload, ImageUpload> upload,
+                                                        const size_t                            size,
+                                                        const Priority                          priority,
+                                                        Callback                                onComplete)
+    {
+        if (size == 0) throw SolError("Cannot enqueue an upload of 0 bytes.");
+        // Anything larger would never fit in the staging pool and block its queue forever.
+        if (size > manager->getMemoryPool().getBlockSize())
+            throw SolError(std::format("Cannot enqueue an upload of {} bytes. Staging pool block size is {}.",
+                                       size,
+                                       manager->getMemoryPool().getBlockSize()));
+
+        std::scoped_lock lock(mutex);
+
+        const RequestId id = nextId++;
+        requests.emplace(id,
+                         Request{.upload     = std::move(upload),
+                                 .priority   = priority,
+                                 .size       = size,
+                                 .onComplete = std::move(onComplete)});
+        queues[static_cast<size_t>(priority)].push_back(id);
+        metrics.queuedRequests[static_cast<size_t>(priority)]++;
+        metrics.queuedBytes[static_cast<size_t>(priority)] += size;
+        return id;
+    }
+
+    bool UploadScheduler::cancel(const RequestId id)
+    {
+        std::scoped_lock lock(mutex);
+
+        const auto it = dequeue(id);
+        if (it == requests.end()) return false;
+
+        requests.erase(it);
+        return true;
+    }
+
+    std::optional<TransactionHandle> UploadScheduler::commitFrame()
+    {
+        // Take requests from the queues while holding the lock, but stage them without it, so that producers are not
+        // blocked by the copies into staging memory.
+        std::vector<std::pair<RequestId, Request>> batch;
+        {
+            std::scoped_lock lock(mutex);
+
+            metrics.frames++;
+            metrics.lastFrameBytes    = 0;
+            metrics.lastFrameRequests = 0;
+
+            size_t bytes = 0;
+            bool   full  = false;
+            for (size_t p = 0; p < priorityCount && !full; p++)
+            {
+                auto& queue = queues[p];
+                while (!queue.empty())
+                {
+                    const auto it = requests.find(queue.front());
+                    // Stop at the first request that does not fit, unless nothing was taken yet.
+                    if (!batch.empty() && bytes + it->second.size > frameBudget)
+                    {
+                        full = true;
+                        break;
+                    }
+
+                    bytes += it->second.size;
+                    metrics.queuedRequests[p]--;
+                    metrics.queuedBytes[p] -= it->second.size;
+                    batch.emplace_back(it->first, std::move(it->second));
+                    requests.erase(it);
+                    queue.pop_front();
+                }
+            }
+        }
+
+        if (batch.empty()) return std::nullopt;
+
+        const auto transaction = manager->beginTransaction();
+        size_t     staged      = 0;
+        for (; staged < batch.size(); staged++)
+        {
+            const bool success = std::visit(
+              [&transaction](const auto& upload) { return transaction->stage(upload.copy, upload.barrier); },
+              batch[staged].second.upload);
+            if (!success) break;
+        }
+
+        {
+            std::scoped_lock lock(mutex);
+
+            // Requests for which no staging memory was available go back to the front of their queues, in their
+            // original order. They are retried next frame, once earlier transactions have released their staging
+            // buffers.
+            for (size_t i = batch.size(); i > staged; i--)
+            {
+                auto& [id, request] = batch[i - 1];
+                const auto p        = static_cast<size_t>(request.priority);
+                queues[p].push_front(id);
+                metrics.queuedRequests[p]++;
+                metrics.queuedBytes[p] += request.size;
+                requests.emplace(id, std::move(request));
+            }
+
+            for (size_t i = 0; i < staged; i++)
+            {
+                const auto& request = batch[i].second;
+                const auto  p       = static_cast<size_t>(request.priority);
+                metrics.committedRequests[p]++;
+                metrics.committedBytes[p] += request.size;
+                metrics.lastFrameRequests++;
+                metrics.lastFrameBytes += request.size;
+            }
+        }
+
+        // If staging memory ran out before the first request, nothing was recorded and the transaction is abandoned.
+        // Anything that was recorded anyway is still committed, so that it is not silently dropped.
+        if (staged == 0 && transaction->isEmpty()) return std::nullopt;
+
+        // Callbacks are registered without holding the lock, since they are invoked right away if the transaction
+        // has already completed and may enqueue new requests.
+        auto handle = transaction->commitAsync();
+        for (size_t i = 0; i < staged; i++)
+            if (auto& request = batch[i].second; request.onComplete) handle.onComplete(std::move(request.onComplete));
+
+        return handle;
+    }
+
+    std::unordered_map<UploadScheduler::RequestId, UploadScheduler::Request>::iterator
+      UploadScheduler::dequeue(const RequestId id)
+    {
+        const auto it = requests.find(id);
+        if (it == requests.end()) return it;
+
+        const auto p     = static_cast<size_t>(it->second.priority);
+        auto&      queue = queues[p];
+        queue.erase(std::ranges::find(queue, id));
+        metrics.queuedRequests[p]--;
+        metrics.queuedBytes[p] -= it->second.size;
+        return it;
+    }
+}  // namespace sol
@@ -15,13 +15,16 @@ namespace sol
     class IMeshTransfer;
     class IndexBuffer;
     class IndexedMesh;
+    class LodGenerator;
     class Mesh;
     class MeshDescription;
     class MeshLayout;
     class MeshManager;
+    class MeshOptimizer;
     class MultiMesh;
     class SharedMesh;
     class VertexBuffer;
+    class VertexFormatConverter;
 
     using GeometryBufferAllocatorPtr       = std::unique_ptr<GeometryBufferAllocator>;
     using GeometryBufferAllocatorSharedPtr = std::shared_ptr<GeometryBufferAllocator>;
@@ -31,6 +34,8 @@ namespace sol
     using IMeshTransferSharedPtr           = std::shared_ptr<IMeshTransfer>;
     using IndexBufferPtr                   = std::unique_ptr<IndexBuffer>;
     using IndexBufferSharedPtr             = std::shared_ptr<IndexBuffer>;
+    using LodGeneratorPtr                  = std::unique_ptr<LodGenerator>;
+    using LodGeneratorSharedPtr            = std::shared_ptr<LodGenerator>;
     using MeshPtr                          = std::unique_ptr<Mesh>;
     using MeshSharedPtr                    = std::shared_ptr<Mesh>;
     using MeshDescriptionPtr               = std::unique_ptr<MeshDescription>;
@@ -39,6 +44,10 @@ namespace sol
     using MeshLayoutSharedPtr              = std::shared_ptr<MeshLayout>;
     using MeshManagerPtr                   = std::unique_ptr<MeshManager>;
     using MeshManagerSharedPtr             = std::shared_ptr<MeshManager>;
+    using MeshOptimizerPtr                 = std::unique_ptr<MeshOptimizer>;
+    using MeshOptimizerSharedPtr           = std::shared_ptr<MeshOptimizer>;
     using VertexBufferPtr                  = std::unique_ptr<VertexBuffer>;
     using VertexBufferSharedPtr            = std::shared_ptr<VertexBuffer>;
+    using VertexFormatConverterPtr         = std::unique_ptr<VertexFormatConverter>;
+    using VertexFormatConverterSharedPtr   = std::shared_ptr<VertexFormatConverter>;
 }  // namespace sol
@@ -1,5 +1,12 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <unordered_set>
+#include <vector>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -10,6 +17,7 @@
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
+#include "sol-memory/fwd.h"
 #include "sol-memory/i_buffer_allocator.h"
 
 ////////////////////////////////////////////////////////////////
@@ -23,6 +31,9 @@ namespace sol
     class GeometryBufferAllocator final : public IBufferAllocator
     {
     public:
+        friend class IndexBuffer;
+        friend class VertexBuffer;
+
         ////////////////////////////////////////////////////////////////
         // Types.
         ////////////////////////////////////////////////////////////////
@@ -38,8 +49,8 @@ namespace sol
             Separate = 0,
 
             /**
-             * \brief Preallocate a global vertex and index buffer with a fixed size
-             * and return suballocations from these global buffers.
+             * \brief Preallocate a global vertex and index buffer and return suballocations from these global buffers.
+             * The global buffers can be grown and compacted with beginGrowth and beginCompaction.
              */
             Global = 1
         };
@@ -74,6 +85,24 @@ namespace sol
             size_t indexSize = 0;
         };
 
+        struct RelocationStats
+        {
+            /**
+             * \brief Number of vertex and index buffers moved in the pass.
+             */
+            size_t allocationsMoved = 0;
+
+            /**
+             * \brief Number of vertices copied in the pass.
+             */
+            size_t verticesMoved = 0;
+
+            /**
+             * \brief Number of indices copied in the pass.
+             */
+            size_t indicesMoved = 0;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -109,10 +138,82 @@ namespace sol
 
         [[nodiscard]] VmaVirtualBlock getVirtualIndexBlock() const noexcept;
 
+        /**
+         * \brief Get the number of vertices the global vertex buffer can hold.
+         * \return Number of vertices, or 0 if strategy == Separate.
+         */
+        [[nodiscard]] size_t getVertexCapacity() const noexcept;
+
+        /**
+         * \brief Get the number of indices the global index buffer can hold.
+         * \return Number of indices, or 0 if strategy == Separate.
+         */
+        [[nodiscard]] size_t getIndexCapacity() const noexcept;
+
+        /**
+         * \brief Get the number of unallocated vertices in the global vertex buffer. Because of fragmentation, the
+         * largest possible allocation can be smaller.
+         * \return Number of vertices, or 0 if strategy == Separate.
+         */
+        [[nodiscard]] size_t getFreeVertexCount() const;
+
+        /**
+         * \brief Get the number of unallocated indices in the global index buffer. Because of fragmentation, the
+         * largest possible allocation can be smaller.
+         * \return Number of indices, or 0 if strategy == Separate.
+         */
+        [[nodiscard]] size_t getFreeIndexCount() const;
+
+        /**
+         * \brief Returns whether a growth or compaction pass was begun and not yet ended.
+         * \return True if relocating.
+         */
+        [[nodiscard]] bool isRelocating() const noexcept;
+
         ////////////////////////////////////////////////////////////////
         // Setters.
         ////////////////////////////////////////////////////////////////
 
+        ////////////////////////////////////////////////////////////////
+        // Relocation.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Begin growing the global buffers. Allocates larger buffers, packs all vertex and index buffers into
+         * them in their current order and stages a copy for each contiguous range in the transaction. Buffers keep
+         * referencing their old location until endRelocation is called. New vertex and index buffers allocated
+         * before then are placed in the new global buffers.
+         * \param transaction Transaction in which to stage copies.
+         * \param vertexCapacity New number of vertices. If not larger than the current capacity, the global vertex
+         * buffer is not grown.
+         * \param indexCapacity New number of indices. If not larger than the current capacity, the global index
+         * buffer is not grown.
+         * \throws SolError Thrown if strategy == Separate or a pass is already in progress.
+         * \return Stats.
+         */
+        RelocationStats beginGrowth(Transaction& transaction, size_t vertexCapacity, size_t indexCapacity);
+
+        /**
+         * \brief Begin an incremental compaction pass. Moves vertex and index buffers from the end of the global
+         * buffers into the lowest free range before them and stages a copy for each move in the transaction. Buffers
+         * keep referencing their old location until endRelocation is called.
+         * \param transaction Transaction in which to stage copies.
+         * \param maxMoves Maximum number of buffers to move in this pass. If 0, there is no limit.
+         * \throws SolError Thrown if strategy == Separate or a pass is already in progress.
+         * \return Stats.
+         */
+        RelocationStats beginCompaction(Transaction& transaction, size_t maxMoves = 0);
+
+        /**
+         * \brief End the current growth or compaction pass. Should only be called after the transaction passed to
+         * beginGrowth or beginCompaction has completed. Moves all buffers to their new location, invokes their
+         * relocation callbacks and releases the old ranges. After growth, the old global buffers are destroyed.
+         * After compaction, the old ranges are immediately available to new vertex and index buffers, which may
+         * overwrite them. In both cases, the old buffers and ranges must no longer be in use by any command buffers,
+         * e.g. by waiting on all frames that were recorded before the relocation callbacks were invoked. Destination
+         * ranges of buffers that were released during the pass are also only released here.
+         */
+        void endRelocation();
 
         ////////////////////////////////////////////////////////////////
         // Allocations.
@@ -140,37 +241,115 @@ namespace sol
 
     private:
         ////////////////////////////////////////////////////////////////
-        // Member variables.
+        // Types.
         ////////////////////////////////////////////////////////////////
 
-        /**
-        * \brief Optional global vertex buffer.
-        */
-        IBufferPtr vertexBuffer;
+        template<typename T>
+        struct Move
+        {
+            /**
+             * \brief Buffer that is moved. Null if the buffer was released during the pass.
+             */
+            T* owner = nullptr;
 
-        /**
-         * \brief Optional global index buffer.
-         */
-        IBufferPtr indexBuffer;
+            /**
+             * \brief Allocation at the destination.
+             */
+            VmaVirtualAllocation allocation = VK_NULL_HANDLE;
+
+            /**
+             * \brief Offset of the destination in number of elements.
+             */
+            size_t offset = 0;
+        };
+
+        template<typename T>
+        struct GlobalBuffer
+        {
+            IBufferPtr buffer;
+
+            /**
+             * \brief Size of each element in bytes.
+             */
+            size_t elementSize = 0;
+
+            /**
+             * \brief Virtual block for the buffer. Sized in number of elements instead of bytes, since all
+             * allocations consist of equally sized and aligned elements.
+             */
+            VmaVirtualBlock virtualBlock = VK_NULL_HANDLE;
+
+            /**
+             * \brief All buffers suballocated from this buffer.
+             */
+            std::unordered_set<T*> owners;
+
+            /**
+             * \brief Larger buffer while growing.
+             */
+            IBufferPtr newBuffer;
+
+            /**
+             * \brief Virtual block for the larger buffer while growing.
+             */
+            VmaVirtualBlock newVirtualBlock = VK_NULL_HANDLE;
+
+            /**
+             * \brief Moves of the current pass.
+             */
+            std::vector<Move<T>> moves;
+        };
+
+        template<typename T>
+        [[nodiscard]] std::unique_ptr<T> allocateGlobal(GlobalBuffer<T>& global, size_t count);
+
+        template<typename T>
+        void release(GlobalBuffer<T>& global, T& owner);
 
         /**
-         * \brief Size of each vertex in the global vertex buffer.
+         * \brief Release the range of a vertex buffer in the global vertex buffer. Called by its destructor.
+         * \param buffer Vertex buffer.
          */
-        size_t vertexSize = 0;
+        void release(VertexBuffer& buffer);
 
         /**
-         * \brief Size of each index in the global index buffer.
+         * \brief Release the range of an index buffer in the global index buffer. Called by its destructor.
+         * \param buffer Index buffer.
          */
-        size_t indexSize = 0;
+        void release(IndexBuffer& buffer);
+
+        template<typename T>
+        void grow(GlobalBuffer<T>&   global,
+                  Transaction&       transaction,
+                  size_t             capacity,
+                  VkBufferUsageFlags usage,
+                  size_t&            elementsMoved,
+                  RelocationStats&   stats);
+
+        template<typename T>
+        void compact(GlobalBuffer<T>& global,
+                     Transaction&     transaction,
+                     size_t           maxMoves,
+                     size_t&          elementsMoved,
+                     RelocationStats& stats);
+
+        template<typename T>
+        void finishRelocation(GlobalBuffer<T>& global);
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
 
         /**
-         * \brief Virtual block for the global vertex buffer.
+         * \brief Optional global vertex buffer.
          */
-        VmaVirtualBlock virtualVertexBlock = VK_NULL_HANDLE;
+        GlobalBuffer<VertexBuffer> vertices;
 
         /**
-         * \brief Virtual block for the global index buffer.
+         * \brief Optional global index buffer.
          */
-        VmaVirtualBlock virtualIndexBlock = VK_NULL_HANDLE;
+        GlobalBuffer<IndexBuffer> indices;
+
+        bool relocating = false;
     };
 }  // namespace sol
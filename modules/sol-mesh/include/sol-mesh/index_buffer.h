@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -24,6 +30,15 @@ namespace sol
     class IndexBuffer final : public IBuffer
     {
     public:
+        friend class GeometryBufferAllocator;
+
+        /**
+         * \brief Callback invoked after the buffer was moved to a different global buffer and/or offset by the
+         * GeometryBufferAllocator, e.g. when growing or compacting. Can be used to patch draw parameters and bindings
+         * that reference the old location.
+         */
+        using RelocationCallback = std::function<void(IndexBuffer&)>;
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -61,8 +76,16 @@ namespace sol
 
         [[nodiscard]] const GeometryBufferAllocator& getAllocator() const noexcept;
 
+        /**
+         * \brief Get the number of indices in this index buffer.
+         * \return Number of indices.
+         */
         [[nodiscard]] size_t getIndexCount() const noexcept;
 
+        /**
+         * \brief Get the size of each index.
+         * \return Size in bytes.
+         */
         [[nodiscard]] size_t getIndexSize() const noexcept;
 
         /**
@@ -95,6 +118,12 @@ namespace sol
         // Setters.
         ////////////////////////////////////////////////////////////////
 
+        /**
+         * \brief Set the callback that is invoked when this buffer is relocated.
+         * \param callback Callback.
+         */
+        void setRelocationCallback(RelocationCallback callback);
+
         ////////////////////////////////////////////////////////////////
         // Transactions.
         ////////////////////////////////////////////////////////////////
@@ -138,6 +167,14 @@ namespace sol
                           size_t         dstOffset);
 
     private:
+        /**
+         * \brief Move this buffer to a new location in a global buffer and invoke the relocation callback.
+         * \param buffer New global buffer.
+         * \param allocation New allocation into the global buffer.
+         * \param offset New offset into the global buffer in number of indices.
+         */
+        void relocate(IBuffer& buffer, VmaVirtualAllocation allocation, size_t offset);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -173,5 +210,7 @@ namespace sol
          * \brief Offset into global buffer in number of indices.
          */
         size_t indexOffset = 0;
+
+        RelocationCallback onRelocate;
     };
 }  // namespace sol
@@ -0,0 +1,136 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/fwd.h"
+#include "sol-mesh/mesh.h"
+
+namespace sol
+{
+    /**
+     * \brief Generates a chain of simplified levels of detail for a triangle list using edge collapses ordered by
+     * quadric error. Vertices are collapsed onto one of their neighbours, so that all levels index the same vertex
+     * buffers and only need extra index ranges. Vertices on open boundaries (which includes attribute seams, where
+     * vertices are duplicated) are never removed.
+     *
+     * Each level targets reductionFactor times the triangle count of the previous level. A collapse is rejected when
+     * its quadric error or the distance of any vertex it removes (including those removed by earlier collapses onto
+     * the same vertex) to the triangles around the remaining vertex would exceed maxError. The error of a level is the
+     * largest such distance, which is measured per collapse and not re-measured when later collapses change the
+     * surrounding triangles. The chain ends when a level cannot be reduced any further.
+     */
+    class LodGenerator
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Settings
+        {
+            /**
+             * \brief Maximum number of levels to generate, excluding level 0.
+             */
+            size_t maxLevels = 4;
+
+            /**
+             * \brief Target triangle count of each level relative to the previous level.
+             */
+            float reductionFactor = 0.5f;
+
+            /**
+             * \brief Maximum error of any level, relative to the diagonal of the bounding box of the mesh.
+             */
+            float maxError = 0.05f;
+
+            /**
+             * \brief Index of the vertex buffer that holds the positions.
+             */
+            size_t positionStream = 0;
+
+            /**
+             * \brief Byte offset of the position (3 floats) inside of a vertex of the position stream.
+             */
+            size_t positionOffset = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        LodGenerator();
+
+        explicit LodGenerator(Settings s);
+
+        LodGenerator(const LodGenerator&) = delete;
+
+        LodGenerator(LodGenerator&&) noexcept = default;
+
+        ~LodGenerator() noexcept;
+
+        LodGenerator& operator=(const LodGenerator&) = delete;
+
+        LodGenerator& operator=(LodGenerator&&) noexcept = default;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] const Settings& getSettings() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set the settings.
+         * \param s Settings.
+         * \throws SolError Thrown if the reduction factor is not in (0, 1) or the error is negative.
+         */
+        void setSettings(Settings s);
+
+        ////////////////////////////////////////////////////////////////
+        // Generation.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Generate levels of detail for a triangle list. The indices of each level are appended to the list.
+         * \param indices Indices. Must be a multiple of 3.
+         * \param positions Pointer to the position of the first vertex. Positions are 3 floats.
+         * \param stride Distance in bytes between consecutive positions.
+         * \param vertexCount Number of vertices.
+         * \throws SolError Thrown if the index count is not a multiple of 3 or an index is out of range.
+         * \return Generated levels, which can be passed to Mesh::setLods.
+         */
+        std::vector<Mesh::Lod>
+          generate(std::vector<uint32_t>& indices, const std::byte* positions, size_t stride, size_t vertexCount) const;
+
+        /**
+         * \brief Generate levels of detail for a MeshDescription into a new, empty MeshDescription. The vertex buffers
+         * are copied as is. The index buffer holds the original indices followed by those of each level.
+         * \param source Indexed source MeshDescription.
+         * \param target Target MeshDescription without buffers.
+         * \throws SolError Thrown if the source is not indexed, the position stream is missing or the target already
+         * has buffers.
+         * \return Generated levels, which can be passed to Mesh::setLods once the mesh has been uploaded.
+         */
+        std::vector<Mesh::Lod> generate(const MeshDescription& source, MeshDescription& target) const;
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        Settings settings;
+    };
+}  // namespace sol
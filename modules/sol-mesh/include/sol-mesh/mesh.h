@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <cstdint>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////
@@ -23,6 +24,64 @@ namespace sol
     class Mesh
     {
     public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Range of a mesh that is drawn with a single draw call. All values are relative to the start of the
+         * vertex and index buffers of the mesh, so that a submesh remains valid when the buffers are suballocated from
+         * a global buffer.
+         * -
+         *
+         * For meshes without an index buffer, firstIndex and indexCount are interpreted as the first vertex and the
+         * number of vertices, and vertexOffset is ignored.
+         */
+        struct SubMesh
+        {
+            /**
+             * \brief First index.
+             */
+            uint32_t firstIndex = 0;
+
+            /**
+             * \brief Number of indices.
+             */
+            uint32_t indexCount = 0;
+
+            /**
+             * \brief Value added to each index before indexing into the vertex buffers.
+             */
+            int32_t vertexOffset = 0;
+
+            auto operator<=>(const SubMesh&) const noexcept = default;
+        };
+
+        /**
+         * \brief Simplified level of detail of a mesh, stored as an extra range of the index (or vertex) buffer. Level
+         * 0 is the mesh itself, drawn using its submeshes. Levels 1 and up are the explicitly set LODs.
+         */
+        struct Lod
+        {
+            /**
+             * \brief First index.
+             */
+            uint32_t firstIndex = 0;
+
+            /**
+             * \brief Number of indices.
+             */
+            uint32_t indexCount = 0;
+
+            /**
+             * \brief Maximum distance of the removed vertices of the full detail mesh to the simplified surface, in
+             * object space units.
+             */
+            float error = 0;
+
+            auto operator<=>(const Lod&) const noexcept = default;
+        };
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -111,7 +170,93 @@ namespace sol
          */
         [[nodiscard]] const IndexBufferPtr& getIndexBuffer() const noexcept;
 
+        /**
+         * \brief Get the number of vertices, i.e. the vertex count of the first vertex buffer.
+         * \return Number of vertices, or 0 if there are no vertex buffers.
+         */
+        [[nodiscard]] size_t getVertexCount() const noexcept;
+
+        /**
+         * \brief Get the number of indices.
+         * \return Number of indices, or 0 if there is no index buffer.
+         */
+        [[nodiscard]] size_t getIndexCount() const noexcept;
+
+        /**
+         * \brief Get the number of elements that are drawn for the whole mesh, i.e. the number of indices if there is
+         * an index buffer and the number of vertices otherwise.
+         * \return Number of elements.
+         */
+        [[nodiscard]] size_t getElementCount() const noexcept;
+
+        /**
+         * \brief Get the explicitly set submeshes.
+         * \return List of submeshes. If empty, the whole mesh is drawn as a single range.
+         */
+        [[nodiscard]] const std::vector<SubMesh>& getSubMeshes() const noexcept;
+
+        /**
+         * \brief Get the ranges that should be drawn. This is either the list of submeshes, or a single range covering
+         * the whole mesh if no submeshes were set.
+         * \return List of draw ranges.
+         */
+        [[nodiscard]] std::vector<SubMesh> getDrawRanges() const;
+
+        /**
+         * \brief Get the ranges that should be drawn for a level of detail.
+         * \param lod Level of detail. Level 0 is the full detail mesh. Levels beyond the last LOD are clamped.
+         * \return List of draw ranges.
+         */
+        [[nodiscard]] std::vector<SubMesh> getDrawRanges(size_t lod) const;
+
+        /**
+         * \brief Get the simplified levels of detail, ordered from most to least detailed.
+         * \return List of LODs. Does not include level 0.
+         */
+        [[nodiscard]] const std::vector<Lod>& getLods() const noexcept;
+
+        /**
+         * \brief Get the number of levels of detail, including level 0.
+         * \return Number of levels.
+         */
+        [[nodiscard]] size_t getLodCount() const noexcept;
+
+        /**
+         * \brief Select the least detailed level whose error does not exceed the given error.
+         * \param maxError Maximum error in object space units.
+         * \return Level of detail, or 0 if no LOD is accurate enough.
+         */
+        [[nodiscard]] size_t selectLod(float maxError) const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Replace the list of submeshes.
+         * \param meshes List of submeshes. Pass an empty list to draw the whole mesh as a single range.
+         * \throws SolError Thrown if a submesh is out of the range of the index (or vertex) buffer.
+         */
+        void setSubMeshes(std::vector<SubMesh> meshes);
+
+        /**
+         * \brief Append a submesh.
+         * \param mesh Submesh.
+         * \throws SolError Thrown if the submesh is out of the range of the index (or vertex) buffer.
+         */
+        void addSubMesh(const SubMesh& mesh);
+
+        /**
+         * \brief Replace the list of simplified levels of detail.
+         * \param levels List of LODs, ordered from most to least detailed.
+         * \throws SolError Thrown if a LOD is out of the range of the index (or vertex) buffer or if errors are not
+         * increasing.
+         */
+        void setLods(std::vector<Lod> levels);
+
     private:
+        void validateSubMesh(const SubMesh& mesh) const;
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -130,5 +275,15 @@ namespace sol
          * \brief Optional index buffer.
          */
         IndexBufferPtr indexBuffer;
+
+        /**
+         * \brief Optional list of ranges drawn separately.
+         */
+        std::vector<SubMesh> subMeshes;
+
+        /**
+         * \brief Optional list of simplified levels of detail.
+         */
+        std::vector<Lod> lods;
     };
 }  // namespace sol
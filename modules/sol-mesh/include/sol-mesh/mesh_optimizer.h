@@ -0,0 +1,221 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief Optional stage that reorders mesh data before it is uploaded to the GPU. It runs three passes, which can
+     * be enabled separately:
+     * -
+     *
+     * 1. Vertex cache: triangles are reordered for post-transform cache locality using Tipsify (Sander et al. 2007).
+     * -
+     *
+     * 2. Overdraw: the clusters produced by the vertex cache pass are sorted so that outward facing clusters, which are
+     * most likely to occlude the rest of the mesh, are drawn first. The new order is only kept if it does not make the
+     * ACMR worse than overdrawThreshold times that of the vertex cache pass.
+     * -
+     *
+     * 3. Vertex fetch: vertices are renumbered in order of first use by the index buffer and all vertex streams are
+     * permuted accordingly, so that the vertex fetch hardware reads memory mostly sequentially.
+     * -
+     *
+     * Meshes are optimized independently, so a batch of meshes is processed in parallel using the executor.
+     */
+    class MeshOptimizer
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Function that invokes task(i) for all i in [0, count), possibly in parallel on a worker pool, and
+         * returns once all tasks have finished. Tasks do not throw.
+         */
+        using Executor = std::function<void(size_t count, const std::function<void(size_t)>& task)>;
+
+        struct Settings
+        {
+            /**
+             * \brief Number of entries of the simulated FIFO post-transform cache.
+             */
+            uint32_t cacheSize = 16;
+
+            bool optimizeVertexCache = true;
+
+            /**
+             * \brief Sort clusters for overdraw. Builds on the clusters of the vertex cache pass, so it is skipped if
+             * that pass is disabled.
+             */
+            bool optimizeOverdraw = true;
+
+            /**
+             * \brief Maximum allowed ratio between the ACMR after the overdraw pass and the ACMR after the vertex
+             * cache pass.
+             */
+            float overdrawThreshold = 1.05f;
+
+            bool optimizeVertexFetch = true;
+
+            /**
+             * \brief Index of the vertex stream that holds the positions used by the overdraw pass.
+             */
+            size_t positionStream = 0;
+
+            /**
+             * \brief Byte offset of the position (3 floats) inside of a vertex of the position stream.
+             */
+            size_t positionOffset = 0;
+
+            /**
+             * \brief Executor used to optimize multiple meshes in parallel. If empty, a thread per hardware thread is
+             * started for each batch.
+             */
+            Executor executor;
+        };
+
+        /**
+         * \brief Vertex stream that is permuted by the vertex fetch pass.
+         */
+        struct VertexStream
+        {
+            std::byte* data = nullptr;
+
+            /**
+             * \brief Distance in bytes between consecutive vertices.
+             */
+            size_t stride = 0;
+        };
+
+        struct Stats
+        {
+            /**
+             * \brief Average cache miss ratio, i.e. the number of transformed vertices per triangle, before
+             * optimization.
+             */
+            float acmrBefore = 0;
+
+            float acmrAfter = 0;
+
+            /**
+             * \brief Average transform to vertex ratio, i.e. the number of transformed vertices per referenced
+             * vertex, before optimization. 1 is optimal.
+             */
+            float atvrBefore = 0;
+
+            float atvrAfter = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        MeshOptimizer();
+
+        explicit MeshOptimizer(Settings s);
+
+        MeshOptimizer(const MeshOptimizer&) = delete;
+
+        MeshOptimizer(MeshOptimizer&&) noexcept = default;
+
+        ~MeshOptimizer() noexcept;
+
+        MeshOptimizer& operator=(const MeshOptimizer&) = delete;
+
+        MeshOptimizer& operator=(MeshOptimizer&&) noexcept = default;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        [[nodiscard]] const Settings& getSettings() const noexcept;
+
+        ////////////////////////////////////////////////////////////////
+        // Setters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Set the settings.
+         * \param s Settings.
+         * \throws SolError Thrown if the cache size is 0.
+         */
+        void setSettings(Settings s);
+
+        ////////////////////////////////////////////////////////////////
+        // Optimization.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Optimize a triangle list in place.
+         * \param indices Indices. Must be a multiple of 3.
+         * \param vertexCount Number of vertices in each stream.
+         * \param streams Vertex streams. The overdraw pass reads positions from the position stream. The vertex fetch
+         * pass permutes all streams.
+         * \throws SolError Thrown if the index count is not a multiple of 3, an index is out of range or the position
+         * stream is missing while the overdraw pass is enabled.
+         * \return Stats.
+         */
+        Stats optimize(std::span<uint32_t> indices, size_t vertexCount, std::span<const VertexStream> streams) const;
+
+        /**
+         * \brief Optimize the staging buffers of a MeshDescription in place. Must be called before the description is
+         * passed to the MeshManager.
+         * \param mesh Indexed MeshDescription. All vertex buffers must hold the same number of vertices.
+         * \throws SolError Thrown if the mesh is not indexed or its vertex buffers differ in size.
+         * \return Stats.
+         */
+        Stats optimize(MeshDescription& mesh) const;
+
+        /**
+         * \brief Optimize a batch of MeshDescriptions in parallel.
+         * \param meshes MeshDescriptions.
+         * \throws SolError Rethrows the first error that was thrown for any of the meshes. Other meshes are still
+         * optimized.
+         * \return Stats of each mesh.
+         */
+        std::vector<Stats> optimize(std::span<MeshDescription* const> meshes) const;
+
+        /**
+         * \brief Calculate the average cache miss ratio of a triangle list for a FIFO cache.
+         * \param indices Indices.
+         * \param vertexCount Number of vertices.
+         * \param cacheSize Number of cache entries.
+         * \return ACMR.
+         */
+        [[nodiscard]] static float
+          calculateAcmr(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize);
+
+        /**
+         * \brief Calculate the average transform to vertex ratio of a triangle list for a FIFO cache.
+         * \param indices Indices.
+         * \param vertexCount Number of vertices.
+         * \param cacheSize Number of cache entries.
+         * \return ATVR.
+         */
+        [[nodiscard]] static float
+          calculateAtvr(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize);
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        Settings settings;
+    };
+}  // namespace sol
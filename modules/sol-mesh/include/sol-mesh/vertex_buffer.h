@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
@@ -25,6 +31,15 @@ namespace sol
     class VertexBuffer final : public IBuffer
     {
     public:
+        friend class GeometryBufferAllocator;
+
+        /**
+         * \brief Callback invoked after the buffer was moved to a different global buffer and/or offset by the
+         * GeometryBufferAllocator, e.g. when growing or compacting. Can be used to patch draw parameters and bindings
+         * that reference the old location.
+         */
+        using RelocationCallback = std::function<void(VertexBuffer&)>;
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -102,6 +117,12 @@ namespace sol
         // Setters.
         ////////////////////////////////////////////////////////////////
 
+        /**
+         * \brief Set the callback that is invoked when this buffer is relocated.
+         * \param callback Callback.
+         */
+        void setRelocationCallback(RelocationCallback callback);
+
         ////////////////////////////////////////////////////////////////
         // Transactions.
         ////////////////////////////////////////////////////////////////
@@ -145,6 +166,14 @@ namespace sol
                            size_t         dstOffset);
 
     private:
+        /**
+         * \brief Move this buffer to a new location in a global buffer and invoke the relocation callback.
+         * \param buffer New global buffer.
+         * \param allocation New allocation into the global buffer.
+         * \param offset New offset into the global buffer in number of vertices.
+         */
+        void relocate(IBuffer& buffer, VmaVirtualAllocation allocation, size_t offset);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -180,5 +209,7 @@ namespace sol
          * \brief Offset into global buffer in number of vertices.
          */
         size_t vertexOffset = 0;
+
+        RelocationCallback onRelocate;
     };
 }  // namespace sol
@@ -0,0 +1,193 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// External includes.
+////////////////////////////////////////////////////////////////
+
+#include <vulkan/vulkan.hpp>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/fwd.h"
+
+namespace sol
+{
+    /**
+     * \brief Converts vertex data from a source MeshLayout to a more compact target MeshLayout, e.g. to store UVs as
+     * half floats, normals as snorm16 or colors as unorm8. Attributes are matched by location. Source attributes that
+     * are not in the target layout are dropped.
+     * -
+     *
+     * Supported conversions are from 32-bit float formats to float, half float, snorm and unorm formats of 8 or 16 bits
+     * with the same number of components. A 3-component source may also be converted to a 4-component target, in which
+     * case the 4th component is 1. A 3-component source converted to a 2-component float or snorm target is
+     * octahedral encoded, which is meant for unit vectors such as normals. Attributes with identical source and target
+     * formats are copied as is.
+     * -
+     *
+     * Vertex buffer i of a MeshDescription holds the data of binding i.
+     */
+    class VertexFormatConverter
+    {
+    public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        struct Stats
+        {
+            /**
+             * \brief Size of the source vertex data in bytes.
+             */
+            size_t sourceBytes = 0;
+
+            /**
+             * \brief Size of the converted vertex data in bytes. The memory saved is sourceBytes - targetBytes.
+             */
+            size_t targetBytes = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Constructors.
+        ////////////////////////////////////////////////////////////////
+
+        VertexFormatConverter() = delete;
+
+        /**
+         * \brief Construct a new VertexFormatConverter.
+         * \param source Finalized source layout.
+         * \param target Finalized target layout.
+         * \throws SolError Thrown if a layout was not finalized, a target attribute has no source attribute, a
+         * conversion is not supported or an attribute does not fit in the stride of its binding.
+         */
+        VertexFormatConverter(const MeshLayout& source, const MeshLayout& target);
+
+        VertexFormatConverter(const VertexFormatConverter&) = delete;
+
+        VertexFormatConverter(VertexFormatConverter&&) noexcept = default;
+
+        ~VertexFormatConverter() noexcept;
+
+        VertexFormatConverter& operator=(const VertexFormatConverter&) = delete;
+
+        VertexFormatConverter& operator=(VertexFormatConverter&&) noexcept = default;
+
+        ////////////////////////////////////////////////////////////////
+        // Getters.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Get the number of bindings of the source layout, i.e. the number of source vertex buffers.
+         * \return Number of bindings.
+         */
+        [[nodiscard]] size_t getSourceBindingCount() const noexcept;
+
+        /**
+         * \brief Get the number of bindings of the target layout, i.e. the number of target vertex buffers.
+         * \return Number of bindings.
+         */
+        [[nodiscard]] size_t getTargetBindingCount() const noexcept;
+
+        /**
+         * \brief Get the stride of a source binding.
+         * \param binding Binding index.
+         * \return Stride in bytes.
+         */
+        [[nodiscard]] uint32_t getSourceStride(size_t binding) const;
+
+        /**
+         * \brief Get the stride of a target binding.
+         * \param binding Binding index.
+         * \return Stride in bytes.
+         */
+        [[nodiscard]] uint32_t getTargetStride(size_t binding) const;
+
+        ////////////////////////////////////////////////////////////////
+        // Conversion.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Convert vertex data.
+         * \param source Source data of each source binding.
+         * \param target Target data of each target binding. Should point to at least vertexCount times the stride of
+         * the binding.
+         * \param vertexCount Number of vertices.
+         * \throws SolError Thrown if the number of source or target buffers does not match the layouts.
+         */
+        void convert(std::span<const std::byte* const> source,
+                     std::span<std::byte* const>       target,
+                     size_t                            vertexCount) const;
+
+        /**
+         * \brief Convert the vertex buffers of a MeshDescription into a new, empty MeshDescription. The index buffer is
+         * copied as is. Should be done right before the target is passed to the MeshManager for upload.
+         * \param source Source MeshDescription.
+         * \param target Target MeshDescription without buffers.
+         * \throws SolError Thrown if the vertex buffers of the source do not match the source layout, or if the target
+         * already has buffers.
+         * \return Stats.
+         */
+        Stats convert(const MeshDescription& source, MeshDescription& target) const;
+
+    private:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        enum class ComponentType : uint32_t
+        {
+            Float32,
+            Float16,
+            Snorm16,
+            Unorm16,
+            Snorm8,
+            Unorm8,
+            Raw
+        };
+
+        struct Conversion
+        {
+            uint32_t sourceBinding = 0;
+
+            uint32_t sourceOffset = 0;
+
+            uint32_t sourceComponents = 0;
+
+            uint32_t targetBinding = 0;
+
+            uint32_t targetOffset = 0;
+
+            uint32_t targetComponents = 0;
+
+            ComponentType targetType = ComponentType::Raw;
+
+            bool octahedral = false;
+
+            /**
+             * \brief Size of the attribute in bytes, if it is copied as is.
+             */
+            uint32_t rawSize = 0;
+        };
+
+        ////////////////////////////////////////////////////////////////
+        // Member variables.
+        ////////////////////////////////////////////////////////////////
+
+        std::vector<uint32_t> sourceStrides;
+
+        std::vector<uint32_t> targetStrides;
+
+        std::vector<Conversion> conversions;
+    };
+}  // namespace sol
@@ -1,14 +1,23 @@
 #include "sol-mesh/geometry_buffer_allocator.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <optional>
+
 ////////////////////////////////////////////////////////////////
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
 #include "sol-core/vulkan_buffer.h"
 #include "sol-core/vulkan_queue.h"
+#include "sol-error/sol_error.h"
 #include "sol-error/vulkan_error_handler.h"
 #include "sol-memory/buffer.h"
 #include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -17,6 +26,99 @@
 #include "sol-mesh/index_buffer.h"
 #include "sol-mesh/vertex_buffer.h"
 
+namespace
+{
+    constexpr VkBufferUsageFlags vertexBufferUsage =
+      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    constexpr VkBufferUsageFlags indexBufferUsage =
+      VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+    [[nodiscard]] sol::IBufferPtr
+      createGlobalBuffer(sol::MemoryManager& memoryManager, const size_t size, const VkBufferUsageFlags usage)
+    {
+        const sol::VulkanBuffer::Settings settings{.device      = memoryManager.getDevice(),
+                                                   .size        = size,
+                                                   .bufferUsage = usage,
+                                                   .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                                                   .allocator   = memoryManager.getAllocator(),
+                                                   .vma = {.pool           = nullptr,
+                                                           .memoryUsage    = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+                                                           .requiredFlags  = 0,
+                                                           .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                           .flags          = 0,
+                                                           .alignment      = 0}};
+
+        return std::make_unique<sol::Buffer>(
+          memoryManager, memoryManager.getTransferQueue().getFamily(), sol::VulkanBuffer::create(settings));
+    }
+
+    [[nodiscard]] VmaVirtualBlock createVirtualBlock(const size_t count)
+    {
+        VmaVirtualBlockCreateInfo blockCreateInfo = {};
+        // TODO: Look into making this optional.
+        // blockCreateInfo.flags = VMA_VIRTUAL_BLOCK_CREATE_LINEAR_ALGORITHM_BIT;
+        blockCreateInfo.size  = count;
+        VmaVirtualBlock block = VK_NULL_HANDLE;
+        sol::handleVulkanError(vmaCreateVirtualBlock(&blockCreateInfo, &block));
+        return block;
+    }
+
+    /**
+     * \brief Get the info for an allocation that is placed at the lowest possible offset, used to pack allocations at
+     * the start of a block.
+     */
+    [[nodiscard]] VmaVirtualAllocationCreateInfo minOffsetInfo(const size_t count)
+    {
+        return {.size      = count,
+                .alignment = 0,
+                .flags     = VMA_VIRTUAL_ALLOCATION_CREATE_STRATEGY_MIN_OFFSET_BIT,
+                .pUserData = nullptr};
+    }
+
+    void destroyVirtualBlock(const VmaVirtualBlock block)
+    {
+        if (!block) return;
+        vmaClearVirtualBlock(block);
+        vmaDestroyVirtualBlock(block);
+    }
+
+    /**
+     * \brief Stage a copy of a range of a global buffer. The global buffers remain owned by the queue family they
+     * were created on, so no ownership transfers are needed. Source and destination can be the same buffer, as long
+     * as the ranges do not overlap.
+     */
+    void stageMove(sol::Transaction& transaction,
+                   sol::IBuffer&     src,
+                   sol::IBuffer&     dst,
+                   const size_t      srcOffset,
+                   const size_t      dstOffset,
+                   const size_t      size)
+    {
+        transaction.stage(sol::BufferToBufferCopy{.srcBuffer              = src,
+                                                  .dstBuffer              = dst,
+                                                  .size                   = size,
+                                                  .srcOffset              = srcOffset,
+                                                  .dstOffset              = dstOffset,
+                                                  .srcOnDedicatedTransfer = false,
+                                                  .dstOnDedicatedTransfer = false},
+                          sol::BufferBarrier{.buffer    = src,
+                                             .srcFamily = nullptr,
+                                             .dstFamily = nullptr,
+                                             .srcStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .srcAccess = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                                             .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT},
+                          sol::BufferBarrier{.buffer    = dst,
+                                             .srcFamily = nullptr,
+                                             .dstFamily = nullptr,
+                                             .srcStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .srcAccess = VK_ACCESS_2_MEMORY_READ_BIT,
+                                             .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT});
+    }
+}  // namespace
+
 namespace sol
 {
     ////////////////////////////////////////////////////////////////
@@ -30,21 +132,14 @@ namespace sol
                                                      IBufferPtr     idxBuffer,
                                                      const size_t   vtxSize,
                                                      const size_t   idxSize) :
-        IBufferAllocator(memoryManager),
-        vertexBuffer(std::move(vtxBuffer)),
-
-        indexBuffer(std::move(idxBuffer)),
-        vertexSize(vtxSize),
-        indexSize(idxSize)
+        IBufferAllocator(memoryManager)
     {
-        // Create virtual blocks. Use count instead of size in bytes, since we always allocate equally sized and aligned vertices and indices.
-        VmaVirtualBlockCreateInfo blockCreateInfo = {};
-        // TODO: Look into making this optional.
-        // blockCreateInfo.flags = VMA_VIRTUAL_BLOCK_CREATE_LINEAR_ALGORITHM_BIT;
-        blockCreateInfo.size = vertexBuffer->getBufferSize() / vertexSize;
-        static_cast<void>(vmaCreateVirtualBlock(&blockCreateInfo, &virtualVertexBlock));
-        blockCreateInfo.size = indexBuffer->getBufferSize() / indexSize;
-        static_cast<void>(vmaCreateVirtualBlock(&blockCreateInfo, &virtualIndexBlock));
+        vertices.buffer       = std::move(vtxBuffer);
+        vertices.elementSize  = vtxSize;
+        vertices.virtualBlock = createVirtualBlock(vertices.buffer->getBufferSize() / vtxSize);
+        indices.buffer        = std::move(idxBuffer);
+        indices.elementSize   = idxSize;
+        indices.virtualBlock  = createVirtualBlock(indices.buffer->getBufferSize() / idxSize);
     }
 
     GeometryBufferAllocatorPtr GeometryBufferAllocator::create(Settings settings)
@@ -56,45 +151,20 @@ namespace sol
             settings.indexSize == 0)
             throw SolError("Cannot create GeometryBufferAllocator when vertex or index size or count is 0.");
 
-        VulkanBuffer::Settings bSettings{.device      = settings.memoryManager.getDevice(),
-                                         .size        = settings.vertexSize * settings.vertexCount,
-                                         .bufferUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                                                        VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                                                        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                                         .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-                                         .allocator   = settings.memoryManager.getAllocator(),
-                                         .vma         = {.pool           = nullptr,
-                                                         .memoryUsage    = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
-                                                         .requiredFlags  = 0,
-                                                         .preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                                         .flags          = 0,
-                                                         .alignment      = 0}};
-
-        auto vtxBuffer = VulkanBuffer::create(bSettings);
-        bSettings.size = settings.indexSize * settings.indexCount;
-        bSettings.bufferUsage =
-          VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-        auto idxBuffer = VulkanBuffer::create(bSettings);
-
         return std::make_unique<GeometryBufferAllocator>(
           settings.memoryManager,
-          std::make_unique<Buffer>(
-            settings.memoryManager, settings.memoryManager.getTransferQueue().getFamily(), std::move(vtxBuffer)),
-          std::make_unique<Buffer>(
-            settings.memoryManager, settings.memoryManager.getTransferQueue().getFamily(), std::move(idxBuffer)),
+          createGlobalBuffer(settings.memoryManager, settings.vertexSize * settings.vertexCount, vertexBufferUsage),
+          createGlobalBuffer(settings.memoryManager, settings.indexSize * settings.indexCount, indexBufferUsage),
           settings.vertexSize,
           settings.indexSize);
     }
 
     GeometryBufferAllocator::~GeometryBufferAllocator() noexcept
     {
-        if (virtualVertexBlock)
-        {
-            vmaClearVirtualBlock(virtualVertexBlock);
-            vmaClearVirtualBlock(virtualIndexBlock);
-            vmaDestroyVirtualBlock(virtualVertexBlock);
-            vmaDestroyVirtualBlock(virtualIndexBlock);
-        }
+        destroyVirtualBlock(vertices.virtualBlock);
+        destroyVirtualBlock(vertices.newVirtualBlock);
+        destroyVirtualBlock(indices.virtualBlock);
+        destroyVirtualBlock(indices.newVirtualBlock);
     }
 
     ////////////////////////////////////////////////////////////////
@@ -108,18 +178,222 @@ namespace sol
 
     GeometryBufferAllocator::Strategy GeometryBufferAllocator::getStrategy() const noexcept
     {
-        if (vertexBuffer) return Strategy::Global;
+        if (vertices.buffer) return Strategy::Global;
         return Strategy::Separate;
     }
 
-    VmaVirtualBlock GeometryBufferAllocator::getVirtualVertexBlock() const noexcept { return virtualVertexBlock; }
+    VmaVirtualBlock GeometryBufferAllocator::getVirtualVertexBlock() const noexcept { return vertices.virtualBlock; }
+
+    VmaVirtualBlock GeometryBufferAllocator::getVirtualIndexBlock() const noexcept { return indices.virtualBlock; }
+
+    size_t GeometryBufferAllocator::getVertexCapacity() const noexcept
+    {
+        return vertices.buffer ? vertices.buffer->getBufferSize() / vertices.elementSize : 0;
+    }
+
+    size_t GeometryBufferAllocator::getIndexCapacity() const noexcept
+    {
+        return indices.buffer ? indices.buffer->getBufferSize() / indices.elementSize : 0;
+    }
+
+    size_t GeometryBufferAllocator::getFreeVertexCount() const
+    {
+        if (!vertices.virtualBlock) return 0;
+        VmaStatistics stats;
+        vmaGetVirtualBlockStatistics(vertices.virtualBlock, &stats);
+        return stats.blockBytes - stats.allocationBytes;
+    }
+
+    size_t GeometryBufferAllocator::getFreeIndexCount() const
+    {
+        if (!indices.virtualBlock) return 0;
+        VmaStatistics stats;
+        vmaGetVirtualBlockStatistics(indices.virtualBlock, &stats);
+        return stats.blockBytes - stats.allocationBytes;
+    }
 
-    VmaVirtualBlock GeometryBufferAllocator::getVirtualIndexBlock() const noexcept { return virtualIndexBlock; }
+    bool GeometryBufferAllocator::isRelocating() const noexcept { return relocating; }
 
     ////////////////////////////////////////////////////////////////
     // Setters.
     ////////////////////////////////////////////////////////////////
 
+    ////////////////////////////////////////////////////////////////
+    // Relocation.
+    ////////////////////////////////////////////////////////////////
+
+    GeometryBufferAllocator::RelocationStats GeometryBufferAllocator::beginGrowth(Transaction& transaction,
+                                                                                  const size_t vertexCapacity,
+                                                                                  const size_t indexCapacity)
+    {
+        if (getStrategy() != Strategy::Global)
+            throw SolError("Cannot grow GeometryBufferAllocator without global buffers.");
+        if (relocating) throw SolError("Cannot begin a growth pass before the previous pass has ended.");
+        relocating = true;
+
+        RelocationStats stats;
+        grow(vertices, transaction, vertexCapacity, vertexBufferUsage, stats.verticesMoved, stats);
+        grow(indices, transaction, indexCapacity, indexBufferUsage, stats.indicesMoved, stats);
+        return stats;
+    }
+
+    GeometryBufferAllocator::RelocationStats GeometryBufferAllocator::beginCompaction(Transaction& transaction,
+                                                                                      const size_t maxMoves)
+    {
+        if (getStrategy() != Strategy::Global)
+            throw SolError("Cannot compact GeometryBufferAllocator without global buffers.");
+        if (relocating) throw SolError("Cannot begin a compaction pass before the previous pass has ended.");
+        relocating = true;
+
+        RelocationStats stats;
+        compact(vertices, transaction, maxMoves, stats.verticesMoved, stats);
+        compact(indices, transaction, maxMoves, stats.indicesMoved, stats);
+        return stats;
+    }
+
+    void GeometryBufferAllocator::endRelocation()
+    {
+        if (!relocating) throw SolError("Cannot end a relocation pass that was not begun.");
+        relocating = false;
+
+        finishRelocation(vertices);
+        finishRelocation(indices);
+    }
+
+    template<typename T>
+    void GeometryBufferAllocator::grow(GlobalBuffer<T>&         global,
+                                       Transaction&             transaction,
+                                       const size_t             capacity,
+                                       const VkBufferUsageFlags usage,
+                                       size_t&                  elementsMoved,
+                                       RelocationStats&         stats)
+    {
+        if (capacity * global.elementSize <= global.buffer->getBufferSize()) return;
+
+        global.newBuffer       = createGlobalBuffer(getMemoryManager(), capacity * global.elementSize, usage);
+        global.newVirtualBlock = createVirtualBlock(capacity);
+
+        // Pack all buffers at the start of the new buffer in their current order. Buffers that are adjacent in both
+        // the old and the new buffer are copied together.
+        auto owners = std::vector<T*>(global.owners.begin(), global.owners.end());
+        std::ranges::sort(owners, {}, [](const T* owner) { return owner->getBufferOffset(); });
+
+        struct Range
+        {
+            size_t src  = 0;
+            size_t dst  = 0;
+            size_t size = 0;
+        };
+        std::optional<Range> range;
+        const auto           flush = [&] {
+            if (range)
+                stageMove(transaction, *global.buffer, *global.newBuffer, range->src, range->dst, range->size);
+        };
+
+        for (auto* owner : owners)
+        {
+            const size_t         count = owner->getBufferSize() / global.elementSize;
+            const auto           info  = minOffsetInfo(count);
+            VmaVirtualAllocation allocation;
+            VkDeviceSize         offset;
+            handleVulkanError(vmaVirtualAllocate(global.newVirtualBlock, &info, &allocation, &offset));
+            global.moves.emplace_back(Move<T>{.owner = owner, .allocation = allocation, .offset = offset});
+
+            const size_t src = owner->getBufferOffset();
+            const size_t dst = offset * global.elementSize;
+            if (range && range->src + range->size == src && range->dst + range->size == dst)
+                range->size += owner->getBufferSize();
+            else
+            {
+                flush();
+                range = Range{.src = src, .dst = dst, .size = owner->getBufferSize()};
+            }
+
+            elementsMoved += count;
+            stats.allocationsMoved++;
+        }
+
+        flush();
+    }
+
+    template<typename T>
+    void GeometryBufferAllocator::compact(GlobalBuffer<T>& global,
+                                          Transaction&     transaction,
+                                          const size_t     maxMoves,
+                                          size_t&          elementsMoved,
+                                          RelocationStats& stats)
+    {
+        // Try to move buffers from the end of the global buffer first, so that a large free range remains at the end.
+        auto owners = std::vector<T*>(global.owners.begin(), global.owners.end());
+        std::ranges::sort(owners, std::ranges::greater{}, [](const T* owner) { return owner->getBufferOffset(); });
+
+        for (auto* owner : owners)
+        {
+            if (maxMoves > 0 && stats.allocationsMoved >= maxMoves) break;
+
+            const size_t         count     = owner->getBufferSize() / global.elementSize;
+            const size_t         srcOffset = owner->getBufferOffset() / global.elementSize;
+            const auto           info      = minOffsetInfo(count);
+            VmaVirtualAllocation allocation;
+            VkDeviceSize         offset;
+            if (vmaVirtualAllocate(global.virtualBlock, &info, &allocation, &offset) != VK_SUCCESS) continue;
+
+            // Only keep the new range if it lies entirely before the current one. Copies within a buffer must not
+            // overlap.
+            if (offset + count > srcOffset)
+            {
+                vmaVirtualFree(global.virtualBlock, allocation);
+                continue;
+            }
+
+            global.moves.emplace_back(Move<T>{.owner = owner, .allocation = allocation, .offset = offset});
+            stageMove(transaction,
+                      *global.buffer,
+                      *global.buffer,
+                      owner->getBufferOffset(),
+                      offset * global.elementSize,
+                      owner->getBufferSize());
+
+            elementsMoved += count;
+            stats.allocationsMoved++;
+        }
+    }
+
+    template<typename T>
+    void GeometryBufferAllocator::finishRelocation(GlobalBuffer<T>& global)
+    {
+        auto moves = std::move(global.moves);
+        global.moves.clear();
+
+        // After growth, the old block and buffer are released as a whole once all buffers point to the new ones.
+        // Otherwise, the old ranges of moved buffers are released individually.
+        IBufferPtr      oldBuffer;
+        VmaVirtualBlock oldBlock = VK_NULL_HANDLE;
+        if (global.newBuffer)
+        {
+            oldBuffer              = std::move(global.buffer);
+            oldBlock               = global.virtualBlock;
+            global.buffer          = std::move(global.newBuffer);
+            global.virtualBlock    = global.newVirtualBlock;
+            global.newVirtualBlock = VK_NULL_HANDLE;
+        }
+        else
+        {
+            for (const auto& move : moves)
+                if (move.owner) vmaVirtualFree(global.virtualBlock, move.owner->virtualAllocation);
+        }
+
+        // The copies of dropped moves have completed, so their destination ranges can be reused now.
+        for (const auto& [owner, allocation, offset] : moves)
+        {
+            if (owner)
+                owner->relocate(*global.buffer, allocation, offset);
+            else
+                vmaVirtualFree(global.virtualBlock, allocation);
+        }
+
+        destroyVirtualBlock(oldBlock);
+    }
 
     ////////////////////////////////////////////////////////////////
     // Allocations.
@@ -130,23 +404,14 @@ namespace sol
         if (count == 0) throw SolError("Cannot allocate vertex buffer with 0 vertices.");
 
         // Do a suballocation in the global vertex buffer.
-        if (getStrategy() == Strategy::Global)
-        {
-            const VmaVirtualAllocationCreateInfo info{.size = count, .alignment = 0, .flags = 0, .pUserData = nullptr};
-            VmaVirtualAllocation                 allocation;
-            VkDeviceSize                         offset;
-            handleVulkanError(vmaVirtualAllocate(virtualVertexBlock, &info, &allocation, &offset));
-            return std::make_unique<VertexBuffer>(*this, *vertexBuffer, count, vertexSize, allocation, offset);
-        }
+        if (getStrategy() == Strategy::Global) return allocateGlobal(vertices, count);
 
         if (size == 0) throw SolError("Cannot allocate vertex buffer with a size of 0 bytes");
 
         // Allocate a wholly separate vertex buffer.
         const VulkanBuffer::Settings settings{.device      = getDevice(),
                                               .size        = count * size,
-                                              .bufferUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
-                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                                                             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                              .bufferUsage = vertexBufferUsage,
                                               .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
                                               .allocator   = getMemoryManager().getAllocator(),
                                               .vma         = {.pool           = nullptr,
@@ -165,23 +430,14 @@ namespace sol
         if (count == 0) throw SolError("Cannot allocate index buffer with 0 indices.");
 
         // Do a suballocation in the global index buffer.
-        if (getStrategy() == Strategy::Global)
-        {
-            const VmaVirtualAllocationCreateInfo info{.size = count, .alignment = 0, .flags = 0, .pUserData = nullptr};
-            VmaVirtualAllocation                 allocation;
-            VkDeviceSize                         offset;
-            handleVulkanError(vmaVirtualAllocate(virtualIndexBlock, &info, &allocation, &offset));
-            return std::make_unique<IndexBuffer>(*this, *indexBuffer, count, indexSize, allocation, offset);
-        }
+        if (getStrategy() == Strategy::Global) return allocateGlobal(indices, count);
 
         if (size == 0) throw SolError("Cannot allocate index buffer with a size of 0 bytes");
 
         // Allocate a wholly separate index buffer.
         const VulkanBuffer::Settings settings{.device      = getDevice(),
                                               .size        = count * size,
-                                              .bufferUsage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
-                                                             VK_BUFFER_USAGE_TRANSFER_DST_BIT |
-                                                             VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                                              .bufferUsage = indexBufferUsage,
                                               .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
                                               .allocator   = getMemoryManager().getAllocator(),
                                               .vma         = {.pool           = nullptr,
@@ -203,4 +459,40 @@ namespace sol
         throw SolError("Not yet implemented.");
     }
 
+    template<typename T>
+    std::unique_ptr<T> GeometryBufferAllocator::allocateGlobal(GlobalBuffer<T>& global, const size_t count)
+    {
+        // While growing, new buffers are placed in the new global buffer right away, so that they do not have to be
+        // moved.
+        auto&      buffer = global.newBuffer ? *global.newBuffer : *global.buffer;
+        const auto block  = global.newBuffer ? global.newVirtualBlock : global.virtualBlock;
+
+        const VmaVirtualAllocationCreateInfo info{.size = count, .alignment = 0, .flags = 0, .pUserData = nullptr};
+        VmaVirtualAllocation                 allocation;
+        VkDeviceSize                         offset;
+        handleVulkanError(vmaVirtualAllocate(block, &info, &allocation, &offset));
+
+        auto owner = std::make_unique<T>(*this, buffer, count, global.elementSize, allocation, offset);
+        global.owners.insert(owner.get());
+        return owner;
+    }
+
+    template<typename T>
+    void GeometryBufferAllocator::release(GlobalBuffer<T>& global, T& owner)
+    {
+        global.owners.erase(&owner);
+
+        // Buffers allocated while growing already live in the new global buffer.
+        const bool inNewBuffer = global.newBuffer && owner.globalBuffer == global.newBuffer.get();
+        vmaVirtualFree(inNewBuffer ? global.newVirtualBlock : global.virtualBlock, owner.virtualAllocation);
+
+        // Drop a pending move of this buffer. Its copy may not have run yet, so the destination range stays reserved
+        // until the pass ends. Otherwise, the copy could overwrite a new buffer allocated in that range.
+        if (const auto it = std::ranges::find(global.moves, &owner, &Move<T>::owner); it != global.moves.end())
+            it->owner = nullptr;
+    }
+
+    void GeometryBufferAllocator::release(VertexBuffer& buffer) { release(vertices, buffer); }
+
+    void GeometryBufferAllocator::release(IndexBuffer& buffer) { release(indices, buffer); }
 }  // namespace sol
@@ -50,7 +50,7 @@ namespace sol
 
     IndexBuffer::~IndexBuffer() noexcept
     {
-        if (virtualAllocation) vmaVirtualFree(allocator->getVirtualIndexBlock(), virtualAllocation);
+        if (virtualAllocation) allocator->release(*this);
     }
 
     ////////////////////////////////////////////////////////////////
@@ -95,6 +95,16 @@ namespace sol
     // Setters.
     ////////////////////////////////////////////////////////////////
 
+    void IndexBuffer::setRelocationCallback(RelocationCallback callback) { onRelocate = std::move(callback); }
+
+    void IndexBuffer::relocate(IBuffer& buffer, const VmaVirtualAllocation allocation, const size_t offset)
+    {
+        globalBuffer      = &buffer;
+        virtualAllocation = allocation;
+        indexOffset       = offset;
+        if (onRelocate) onRelocate(*this);
+    }
+
     ////////////////////////////////////////////////////////////////
     // Transactions.
     ////////////////////////////////////////////////////////////////
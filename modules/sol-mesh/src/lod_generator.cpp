@@ -0,0 +1,476 @@
+#include "sol-mesh/lod_generator.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/mesh_description.h"
+
+namespace
+{
+    using double3 = std::array<double, 3>;
+
+    double3 operator-(const double3& lhs, const double3& rhs) noexcept
+    {
+        return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+    }
+
+    double dot(const double3& lhs, const double3& rhs) noexcept
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+    }
+
+    double3 cross(const double3& lhs, const double3& rhs) noexcept
+    {
+        return {lhs[1] * rhs[2] - lhs[2] * rhs[1],
+                lhs[2] * rhs[0] - lhs[0] * rhs[2],
+                lhs[0] * rhs[1] - lhs[1] * rhs[0]};
+    }
+
+    /**
+     * \brief Squared distance from a point to a triangle.
+     */
+    double distanceSq(const double3& p, const double3& a, const double3& b, const double3& c) noexcept
+    {
+        const auto lengthSq = [](const double3& v) { return dot(v, v); };
+        const auto lerp     = [](const double3& x, const double3& y, const double t) {
+            return double3{x[0] + (y[0] - x[0]) * t, x[1] + (y[1] - x[1]) * t, x[2] + (y[2] - x[2]) * t};
+        };
+
+        // Find the closest point by testing the Voronoi regions of the vertices, edges and face in turn.
+        const auto   ab = b - a, ac = c - a, ap = p - a;
+        const double d1 = dot(ab, ap), d2 = dot(ac, ap);
+        if (d1 <= 0 && d2 <= 0) return lengthSq(ap);
+
+        const auto   bp = p - b;
+        const double d3 = dot(ab, bp), d4 = dot(ac, bp);
+        if (d3 >= 0 && d4 <= d3) return lengthSq(bp);
+
+        const double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0 && d1 >= 0 && d3 <= 0) return lengthSq(p - lerp(a, b, d1 / (d1 - d3)));
+
+        const auto   cp = p - c;
+        const double d5 = dot(ab, cp), d6 = dot(ac, cp);
+        if (d6 >= 0 && d5 <= d6) return lengthSq(cp);
+
+        const double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0 && d2 >= 0 && d6 <= 0) return lengthSq(p - lerp(a, c, d2 / (d2 - d6)));
+
+        const double va = d3 * d6 - d5 * d4;
+        if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) return lengthSq(p - lerp(b, c, (d4 - d3) / (d4 - d3 + d5 - d6)));
+
+        // Degenerate triangles have no face region. The closest point lies on one of the edges tested above.
+        const double denom = va + vb + vc;
+        if (denom <= 0) return std::min({lengthSq(ap), lengthSq(bp), lengthSq(cp)});
+
+        const double v = vb / denom, w = vc / denom;
+        return lengthSq(p - lerp(a, b, v) - double3{ac[0] * w, ac[1] * w, ac[2] * w});
+    }
+
+    /**
+     * \brief Sum of squared distances to a set of area weighted planes.
+     */
+    struct Quadric
+    {
+        double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c      = 0;
+        double weight = 0;
+
+        Quadric& operator+=(const Quadric& rhs) noexcept
+        {
+            a00 += rhs.a00;
+            a01 += rhs.a01;
+            a02 += rhs.a02;
+            a11 += rhs.a11;
+            a12 += rhs.a12;
+            a22 += rhs.a22;
+            b0 += rhs.b0;
+            b1 += rhs.b1;
+            b2 += rhs.b2;
+            c += rhs.c;
+            weight += rhs.weight;
+            return *this;
+        }
+
+        void addPlane(const double3& n, const double d, const double w) noexcept
+        {
+            a00 += w * n[0] * n[0];
+            a01 += w * n[0] * n[1];
+            a02 += w * n[0] * n[2];
+            a11 += w * n[1] * n[1];
+            a12 += w * n[1] * n[2];
+            a22 += w * n[2] * n[2];
+            b0 += w * n[0] * d;
+            b1 += w * n[1] * d;
+            b2 += w * n[2] * d;
+            c += w * d * d;
+            weight += w;
+        }
+
+        [[nodiscard]] double evaluate(const double3& p) const noexcept
+        {
+            const double x = p[0], y = p[1], z = p[2];
+            return a00 * x * x + a11 * y * y + a22 * z * z + 2 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+                   2 * (b0 * x + b1 * y + b2 * z) + c;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t from = 0;
+
+        uint32_t to = 0;
+
+        /**
+         * \brief Mean squared distance to the original surface after the collapse.
+         */
+        double cost = 0;
+    };
+
+    void removeDegenerate(std::vector<uint32_t>& triangles)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < triangles.size(); i += 3)
+        {
+            const auto a = triangles[i], b = triangles[i + 1], c = triangles[i + 2];
+            if (a == b || b == c || c == a) continue;
+            triangles[count++] = a;
+            triangles[count++] = b;
+            triangles[count++] = c;
+        }
+        triangles.resize(count);
+    }
+
+    std::vector<sol::Mesh::Lod> simplify(std::vector<uint32_t>&             indices,
+                                         const std::vector<double3>&        positions,
+                                         const sol::LodGenerator::Settings& settings)
+    {
+        const size_t vertexCount = positions.size();
+
+        // Error limit relative to the bounds of the referenced vertices.
+        double3 lower{std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max()};
+        double3 upper{std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest()};
+        for (const auto index : indices)
+        {
+            for (size_t c = 0; c < 3; c++)
+            {
+                lower[c] = std::min(lower[c], positions[index][c]);
+                upper[c] = std::max(upper[c], positions[index][c]);
+            }
+        }
+        const auto   diagonal = upper - lower;
+        const double limit    = settings.maxError * std::sqrt(dot(diagonal, diagonal));
+        const double limitSq  = limit * limit;
+
+        std::vector<uint32_t> current(indices.begin(), indices.end());
+        removeDegenerate(current);
+
+        // Plane quadrics of all adjacent triangles, per vertex.
+        std::vector<Quadric> quadrics(vertexCount);
+        for (size_t i = 0; i < current.size(); i += 3)
+        {
+            const auto& p0     = positions[current[i]];
+            auto        n      = cross(positions[current[i + 1]] - p0, positions[current[i + 2]] - p0);
+            const auto  length = std::sqrt(dot(n, n));
+            if (length == 0) continue;
+
+            n = {n[0] / length, n[1] / length, n[2] / length};
+            for (size_t c = 0; c < 3; c++) quadrics[current[i + c]].addPlane(n, -dot(n, p0), length * 0.5);
+        }
+
+        // Lock vertices on edges that are not shared by exactly 2 triangles, i.e. open boundaries, seams and
+        // non-manifold edges. Collapsing those would visibly change the silhouette or tear the mesh apart.
+        std::vector<bool> locked(vertexCount, false);
+        {
+            std::unordered_map<uint64_t, uint32_t> edges;
+            const auto key = [](const uint32_t a, const uint32_t b) {
+                return static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+            };
+            for (size_t i = 0; i < current.size(); i += 3)
+                for (size_t c = 0; c < 3; c++) edges[key(current[i + c], current[i + (c + 1) % 3])]++;
+            for (const auto& [edge, count] : edges)
+            {
+                if (count == 2) continue;
+                locked[edge >> 32]        = true;
+                locked[edge & 0xffffffff] = true;
+            }
+        }
+
+        std::vector<sol::Mesh::Lod> lods;
+        std::vector<size_t>         offsets;
+        std::vector<uint32_t>       adjacency;
+        std::vector<Collapse>       collapses;
+        std::vector<bool>           touched;
+        std::vector<uint32_t>       remap(vertexCount);
+        std::iota(remap.begin(), remap.end(), 0);
+
+        // Original vertices that were collapsed into each vertex, including the vertex itself.
+        std::vector<std::vector<uint32_t>> members(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; v++) members[v].push_back(v);
+        double maxDistanceSq = 0;
+
+        for (size_t level = 0; level < settings.maxLevels; level++)
+        {
+            const size_t previousCount = current.size() / 3;
+            const auto   targetCount =
+              static_cast<size_t>(static_cast<double>(previousCount) * settings.reductionFactor);
+
+            while (current.size() / 3 > targetCount)
+            {
+                // Triangles adjacent to each vertex.
+                offsets.assign(vertexCount + 1, 0);
+                for (const auto index : current) offsets[index + 1]++;
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                adjacency.resize(current.size());
+                {
+                    auto fill = offsets;
+                    for (size_t i = 0; i < current.size(); i++)
+                        adjacency[fill[current[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+
+                // Collapse of each vertex onto each of its neighbours, cheapest first.
+                collapses.clear();
+                for (size_t i = 0; i < current.size(); i += 3)
+                {
+                    for (size_t c = 0; c < 3; c++)
+                    {
+                        const auto from = current[i + c];
+                        const auto to   = current[i + (c + 1) % 3];
+                        for (const auto& [f, t] : {std::pair{from, to}, std::pair{to, from}})
+                        {
+                            if (locked[f]) continue;
+
+                            auto q = quadrics[f];
+                            q += quadrics[t];
+                            const double cost = q.weight > 0 ? std::max(0.0, q.evaluate(positions[t]) / q.weight) : 0;
+                            if (cost <= limitSq) collapses.emplace_back(Collapse{.from = f, .to = t, .cost = cost});
+                        }
+                    }
+                }
+                std::ranges::sort(collapses, {}, &Collapse::cost);
+
+                // Apply collapses that do not touch the neighbourhood of an earlier collapse in this pass, so that the
+                // triangle list does not have to be updated in between.
+                touched.assign(vertexCount, false);
+                size_t remaining = current.size() / 3;
+                size_t applied   = 0;
+                for (const auto& [from, to, cost] : collapses)
+                {
+                    if (touched[from] || touched[to]) continue;
+
+                    // Reject collapses that flip any of the remaining triangles.
+                    bool   flips   = false;
+                    size_t removed = 0;
+                    for (size_t a = offsets[from]; a < offsets[from + 1] && !flips; a++)
+                    {
+                        const auto* t = &current[adjacency[a] * 3];
+                        if (t[0] == to || t[1] == to || t[2] == to)
+                        {
+                            removed++;
+                            continue;
+                        }
+
+                        std::array<double3, 3> p{positions[t[0]], positions[t[1]], positions[t[2]]};
+                        const auto             before = cross(p[1] - p[0], p[2] - p[0]);
+                        for (size_t c = 0; c < 3; c++)
+                            if (t[c] == from) p[c] = positions[to];
+                        const auto after = cross(p[1] - p[0], p[2] - p[0]);
+                        flips            = dot(before, before) > 0 && dot(before, after) <= 0;
+                    }
+                    if (flips) continue;
+
+                    // Measure the distance of all vertices that end up at the destination to the triangles around it
+                    // after the collapse. Triangles around the destination that are not shared with the source are
+                    // unchanged, since no earlier collapse of this pass touched them.
+                    double distance = 0;
+                    for (const auto v : members[from])
+                    {
+                        double nearest = std::numeric_limits<double>::max();
+                        for (const auto vertex : {from, to})
+                        {
+                            for (size_t a = offsets[vertex]; a < offsets[vertex + 1]; a++)
+                            {
+                                const auto* t = &current[adjacency[a] * 3];
+                                if (std::ranges::count(t, t + 3, from) + std::ranges::count(t, t + 3, to) > 1) continue;
+
+                                std::array<double3, 3> p{positions[t[0]], positions[t[1]], positions[t[2]]};
+                                for (size_t c = 0; c < 3; c++)
+                                    if (t[c] == from) p[c] = positions[to];
+                                nearest = std::min(nearest, distanceSq(positions[v], p[0], p[1], p[2]));
+                            }
+                        }
+                        distance = std::max(distance, nearest);
+                    }
+                    if (distance > limitSq) continue;
+
+                    for (size_t a = offsets[from]; a < offsets[from + 1]; a++)
+                    {
+                        const auto* t = &current[adjacency[a] * 3];
+                        touched[t[0]] = touched[t[1]] = touched[t[2]] = true;
+                    }
+
+                    remap[from] = to;
+                    quadrics[to] += quadrics[from];
+                    members[to].insert(members[to].end(), members[from].begin(), members[from].end());
+                    members[from].clear();
+                    maxDistanceSq = std::max(maxDistanceSq, distance);
+                    remaining -= std::min(remaining, removed);
+                    applied++;
+
+                    if (remaining <= targetCount) break;
+                }
+
+                if (applied == 0) break;
+
+                for (auto& index : current) index = remap[index];
+                removeDegenerate(current);
+            }
+
+            if (current.empty() || current.size() / 3 >= previousCount) break;
+
+            lods.emplace_back(sol::Mesh::Lod{.firstIndex = static_cast<uint32_t>(indices.size()),
+                                             .indexCount = static_cast<uint32_t>(current.size()),
+                                             .error      = static_cast<float>(std::sqrt(maxDistanceSq))});
+            indices.insert(indices.end(), current.begin(), current.end());
+        }
+
+        return lods;
+    }
+}  // namespace
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    LodGenerator::LodGenerator() = default;
+
+    LodGenerator::LodGenerator(Settings s) { setSettings(s); }
+
+    LodGenerator::~LodGenerator() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    const LodGenerator::Settings& LodGenerator::getSettings() const noexcept { return settings; }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void LodGenerator::setSettings(const Settings s)
+    {
+        if (s.reductionFactor <= 0 || s.reductionFactor >= 1)
+            throw SolError(std::format("Cannot set LOD reduction factor to {}. Must be in (0, 1).", s.reductionFactor));
+        if (s.maxError < 0) throw SolError("Cannot set a negative maximum LOD error.");
+        settings = s;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Generation.
+    ////////////////////////////////////////////////////////////////
+
+    std::vector<Mesh::Lod> LodGenerator::generate(std::vector<uint32_t>& indices,
+                                                  const std::byte*       positions,
+                                                  const size_t           stride,
+                                                  const size_t           vertexCount) const
+    {
+        if (indices.size() % 3 != 0)
+            throw SolError(
+              std::format("Cannot generate LODs. Index count {} is not a multiple of 3.", indices.size()));
+        if (const auto it = std::ranges::find_if(indices, [&](const uint32_t i) { return i >= vertexCount; });
+            it != indices.end())
+            throw SolError(
+              std::format("Cannot generate LODs. Index {} is out of range for {} vertices.", *it, vertexCount));
+
+        std::vector<double3> points(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++)
+        {
+            std::array<float, 3> p;
+            std::memcpy(p.data(), positions + v * stride, sizeof(p));
+            points[v] = {p[0], p[1], p[2]};
+        }
+
+        return simplify(indices, points, settings);
+    }
+
+    std::vector<Mesh::Lod> LodGenerator::generate(const MeshDescription& source, MeshDescription& target) const
+    {
+        if (!source.isIndexed()) throw SolError("Cannot generate LODs for a MeshDescription without an index buffer.");
+        if (settings.positionStream >= source.getVertexBufferCount() ||
+            settings.positionOffset + 3 * sizeof(float) > source.getVertexSize(settings.positionStream))
+            throw SolError("Cannot generate LODs. Position stream is missing or too small.");
+        if (target.getVertexBufferCount() > 0 || target.isIndexed())
+            throw SolError("Cannot generate LODs. Target MeshDescription already has buffers.");
+
+        // Widen indices to 32 bits.
+        const size_t          indexSize  = source.getIndexSize();
+        const size_t          indexCount = source.getIndexCount();
+        const auto*           data       = source.getIndexBuffer().getMappedData<std::byte>();
+        std::vector<uint32_t> indices(indexCount);
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            uint32_t index = 0;
+            std::memcpy(&index, data + i * indexSize, indexSize);
+            indices[i] = index;
+        }
+
+        const auto lods = generate(indices,
+                                   source.getVertexBuffer(settings.positionStream).getMappedData<std::byte>() +
+                                     settings.positionOffset,
+                                   source.getVertexSize(settings.positionStream),
+                                   source.getVertexCount(settings.positionStream));
+
+        if (indices.size() > std::numeric_limits<uint32_t>::max())
+            throw SolError("Cannot generate LODs. Too many indices.");
+
+        for (size_t i = 0; i < source.getVertexBufferCount(); i++)
+        {
+            target.addVertexBuffer(
+              source.getVertexSize(i), source.getVertexCount(i), source.getVertexOffset(i), source.getVertexFlags(i));
+            if (source.getVertexCount(i) > 0)
+                target.setVertexData(
+                  i, 0, source.getVertexCount(i), source.getVertexBuffer(i).getMappedData<std::byte>());
+        }
+
+        // Narrow indices again. Collapses never introduce new vertices, so all indices still fit.
+        std::vector<std::byte> narrowed(indices.size() * indexSize);
+        for (size_t i = 0; i < indices.size(); i++)
+            std::memcpy(narrowed.data() + i * indexSize, &indices[i], indexSize);
+
+        target.addIndexBuffer(indexSize,
+                              static_cast<uint32_t>(indices.size()),
+                              source.getIndexOffset(),
+                              source.getIndexFlags());
+        if (!indices.empty()) target.setIndexData(0, indices.size(), narrowed.data());
+
+        return lods;
+    }
+}  // namespace sol
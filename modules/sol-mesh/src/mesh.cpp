@@ -1,11 +1,24 @@
 #include "sol-mesh/mesh.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <format>
+
 ////////////////////////////////////////////////////////////////
 // External includes.
 ////////////////////////////////////////////////////////////////
 
 #include "uuid_system_generator.h"
 
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-error/sol_error.h"
+
 ////////////////////////////////////////////////////////////////
 // Current target includes.
 ////////////////////////////////////////////////////////////////
@@ -119,4 +132,82 @@ namespace sol
     IndexBufferPtr& Mesh::getIndexBuffer() noexcept { return indexBuffer; }
 
     const IndexBufferPtr& Mesh::getIndexBuffer() const noexcept { return indexBuffer; }
+
+    size_t Mesh::getVertexCount() const noexcept
+    {
+        return vertexBuffers.empty() ? 0 : vertexBuffers.front()->getVertexCount();
+    }
+
+    size_t Mesh::getIndexCount() const noexcept { return indexBuffer ? indexBuffer->getIndexCount() : 0; }
+
+    size_t Mesh::getElementCount() const noexcept { return hasIndexBuffer() ? getIndexCount() : getVertexCount(); }
+
+    const std::vector<Mesh::SubMesh>& Mesh::getSubMeshes() const noexcept { return subMeshes; }
+
+    std::vector<Mesh::SubMesh> Mesh::getDrawRanges() const
+    {
+        if (!subMeshes.empty()) return subMeshes;
+        return {SubMesh{.firstIndex = 0, .indexCount = static_cast<uint32_t>(getElementCount()), .vertexOffset = 0}};
+    }
+
+    std::vector<Mesh::SubMesh> Mesh::getDrawRanges(const size_t lod) const
+    {
+        if (lod == 0 || lods.empty()) return getDrawRanges();
+        const auto& level = lods[std::min(lod, lods.size()) - 1];
+        return {SubMesh{.firstIndex = level.firstIndex, .indexCount = level.indexCount, .vertexOffset = 0}};
+    }
+
+    const std::vector<Mesh::Lod>& Mesh::getLods() const noexcept { return lods; }
+
+    size_t Mesh::getLodCount() const noexcept { return lods.size() + 1; }
+
+    size_t Mesh::selectLod(const float maxError) const noexcept
+    {
+        // Errors are increasing, so the last accurate enough level is the least detailed one.
+        size_t lod = 0;
+        while (lod < lods.size() && lods[lod].error <= maxError) lod++;
+        return lod;
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void Mesh::setSubMeshes(std::vector<SubMesh> meshes)
+    {
+        for (const auto& mesh : meshes) validateSubMesh(mesh);
+        subMeshes = std::move(meshes);
+    }
+
+    void Mesh::addSubMesh(const SubMesh& mesh)
+    {
+        validateSubMesh(mesh);
+        subMeshes.emplace_back(mesh);
+    }
+
+    void Mesh::setLods(std::vector<Lod> levels)
+    {
+        for (size_t i = 0; i < levels.size(); i++)
+        {
+            validateSubMesh(
+              SubMesh{.firstIndex = levels[i].firstIndex, .indexCount = levels[i].indexCount, .vertexOffset = 0});
+            if (i > 0 && levels[i].error < levels[i - 1].error)
+                throw SolError(std::format("Cannot set LODs. Error of level {} is smaller than that of level {}.",
+                                           i + 1,
+                                           i));
+        }
+        lods = std::move(levels);
+    }
+
+    void Mesh::validateSubMesh(const SubMesh& mesh) const
+    {
+        if (mesh.indexCount == 0) throw SolError("Cannot add submesh with 0 elements.");
+
+        const size_t end = static_cast<size_t>(mesh.firstIndex) + mesh.indexCount;
+        if (end > getElementCount())
+            throw SolError(std::format("Cannot add submesh with range [{}, {}). Mesh only has {} elements.",
+                                       mesh.firstIndex,
+                                       end,
+                                       getElementCount()));
+    }
 }  // namespace sol
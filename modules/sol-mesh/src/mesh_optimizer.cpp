@@ -0,0 +1,481 @@
+#include "sol-mesh/mesh_optimizer.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <limits>
+#include <numeric>
+#include <thread>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/mesh_description.h"
+
+namespace
+{
+    using float3 = std::array<float, 3>;
+
+    float3 operator+(const float3& lhs, const float3& rhs) noexcept
+    {
+        return {lhs[0] + rhs[0], lhs[1] + rhs[1], lhs[2] + rhs[2]};
+    }
+
+    float3 operator-(const float3& lhs, const float3& rhs) noexcept
+    {
+        return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+    }
+
+    float3 operator*(const float3& lhs, const float rhs) noexcept { return {lhs[0] * rhs, lhs[1] * rhs, lhs[2] * rhs}; }
+
+    float dot(const float3& lhs, const float3& rhs) noexcept
+    {
+        return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+    }
+
+    float3 cross(const float3& lhs, const float3& rhs) noexcept
+    {
+        return {lhs[1] * rhs[2] - lhs[2] * rhs[1],
+                lhs[2] * rhs[0] - lhs[0] * rhs[2],
+                lhs[0] * rhs[1] - lhs[1] * rhs[0]};
+    }
+
+    struct CacheCounts
+    {
+        size_t transforms = 0;
+
+        size_t referenced = 0;
+    };
+
+    /**
+     * \brief Run a triangle list through a simulated FIFO post-transform cache.
+     */
+    CacheCounts
+      simulateFifo(const std::span<const uint32_t> indices, const size_t vertexCount, const uint32_t cacheSize)
+    {
+        // Number of misses at the moment each vertex last entered the cache, or 0 if it never did. A vertex is still
+        // cached if fewer than cacheSize misses happened since.
+        std::vector<size_t> entered(vertexCount, 0);
+        CacheCounts         counts;
+
+        for (const auto index : indices)
+        {
+            if (entered[index] != 0 && counts.transforms - entered[index] < cacheSize) continue;
+            if (entered[index] == 0) counts.referenced++;
+            entered[index] = ++counts.transforms;
+        }
+
+        return counts;
+    }
+
+    /**
+     * \brief Reorder triangles for vertex cache locality using Tipsify. Also returns the first triangle of each
+     * cluster, i.e. each run of triangles that starts after the algorithm hit a dead end and the cache is cold.
+     */
+    std::vector<uint32_t> tipsify(const std::span<const uint32_t> indices,
+                                  const size_t                    vertexCount,
+                                  const uint32_t                  cacheSize,
+                                  std::vector<size_t>&            clusters)
+    {
+        const size_t triangleCount = indices.size() / 3;
+
+        // Triangles adjacent to each vertex.
+        std::vector<size_t> offsets(vertexCount + 1, 0);
+        for (const auto index : indices) offsets[index + 1]++;
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<size_t> adjacency(indices.size());
+        {
+            auto fill = offsets;
+            for (size_t i = 0; i < indices.size(); i++) adjacency[fill[indices[i]]++] = i / 3;
+        }
+
+        // Number of triangles that still have to be emitted, per vertex.
+        std::vector<int64_t> live(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++) live[v] = static_cast<int64_t>(offsets[v + 1] - offsets[v]);
+
+        // Starting the timestamp past the cache size makes all vertices initially uncached.
+        std::vector<int64_t>  cacheTime(vertexCount, 0);
+        int64_t               timestamp = static_cast<int64_t>(cacheSize) + 1;
+        std::vector<bool>     emitted(triangleCount, false);
+        std::vector<uint32_t> deadEnd;
+        std::vector<uint32_t> candidates;
+        size_t                cursor = 0;
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+
+        const auto skipDeadEnd = [&]() -> int64_t {
+            while (!deadEnd.empty())
+            {
+                const auto v = deadEnd.back();
+                deadEnd.pop_back();
+                if (live[v] > 0) return v;
+            }
+
+            for (; cursor < vertexCount; cursor++)
+                if (live[cursor] > 0) return static_cast<int64_t>(cursor);
+
+            return -1;
+        };
+
+        int64_t fanning = skipDeadEnd();
+        while (fanning >= 0)
+        {
+            candidates.clear();
+            for (size_t a = offsets[fanning]; a < offsets[fanning + 1]; a++)
+            {
+                const auto t = adjacency[a];
+                if (emitted[t]) continue;
+                emitted[t] = true;
+
+                for (size_t c = 0; c < 3; c++)
+                {
+                    const auto v = indices[t * 3 + c];
+                    result.push_back(v);
+                    deadEnd.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if (timestamp - cacheTime[v] > static_cast<int64_t>(cacheSize)) cacheTime[v] = timestamp++;
+                }
+            }
+
+            // Prefer the candidate that is in the cache longest and whose remaining triangles still fit in the cache
+            // when fanning around it.
+            int64_t best         = -1;
+            int64_t bestPriority = -1;
+            for (const auto v : candidates)
+            {
+                if (live[v] <= 0) continue;
+
+                int64_t priority = 0;
+                if (timestamp - cacheTime[v] + 2 * live[v] <= static_cast<int64_t>(cacheSize))
+                    priority = timestamp - cacheTime[v];
+                if (priority > bestPriority)
+                {
+                    best         = v;
+                    bestPriority = priority;
+                }
+            }
+
+            if (best < 0)
+            {
+                best = skipDeadEnd();
+                if (best >= 0 && (clusters.empty() || clusters.back() != result.size() / 3))
+                    clusters.push_back(result.size() / 3);
+            }
+
+            fanning = best;
+        }
+
+        if (clusters.empty() || clusters.front() != 0) clusters.insert(clusters.begin(), 0);
+
+        return result;
+    }
+
+    /**
+     * \brief Sort clusters of triangles so that clusters facing away from the center of the mesh are drawn first.
+     */
+    std::vector<uint32_t> sortClusters(const std::span<const uint32_t>         indices,
+                                       const std::vector<size_t>&              clusters,
+                                       const sol::MeshOptimizer::VertexStream& positions,
+                                       const size_t                            positionOffset)
+    {
+        const auto position = [&](const uint32_t v) {
+            float3 p;
+            std::memcpy(p.data(), positions.data + v * positions.stride + positionOffset, sizeof(float3));
+            return p;
+        };
+
+        const size_t        triangleCount = indices.size() / 3;
+        std::vector<float3> centroids(clusters.size(), float3{});
+        std::vector<float3> normals(clusters.size(), float3{});
+        float3              meshCentroid{};
+        float               meshArea = 0;
+
+        for (size_t c = 0; c < clusters.size(); c++)
+        {
+            const size_t end  = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+            float        area = 0;
+            for (size_t t = clusters[c]; t < end; t++)
+            {
+                const auto p0 = position(indices[t * 3 + 0]);
+                const auto p1 = position(indices[t * 3 + 1]);
+                const auto p2 = position(indices[t * 3 + 2]);
+                const auto n  = cross(p1 - p0, p2 - p0);
+                const auto a  = std::sqrt(dot(n, n));
+
+                // Weigh by area, so that long thin triangles do not dominate the cluster.
+                centroids[c] = centroids[c] + (p0 + p1 + p2) * (a / 3.0f);
+                normals[c]   = normals[c] + n;
+                area += a;
+            }
+
+            meshCentroid = meshCentroid + centroids[c];
+            meshArea += area;
+            if (area > 0) centroids[c] = centroids[c] * (1.0f / area);
+
+            if (const auto length = std::sqrt(dot(normals[c], normals[c])); length > 0)
+                normals[c] = normals[c] * (1.0f / length);
+        }
+
+        if (meshArea > 0) meshCentroid = meshCentroid * (1.0f / meshArea);
+
+        std::vector<float> keys(clusters.size());
+        for (size_t c = 0; c < clusters.size(); c++) keys[c] = dot(centroids[c] - meshCentroid, normals[c]);
+
+        std::vector<size_t> order(clusters.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [&keys](const size_t lhs, const size_t rhs) { return keys[lhs] > keys[rhs]; });
+
+        std::vector<uint32_t> result;
+        result.reserve(indices.size());
+        for (const auto c : order)
+        {
+            const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+            result.insert(result.end(), indices.begin() + clusters[c] * 3, indices.begin() + end * 3);
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Renumber vertices in order of first use and permute all streams accordingly. Unreferenced vertices are
+     * moved to the end.
+     */
+    void remapVertices(const std::span<uint32_t>                               indices,
+                       const size_t                                            vertexCount,
+                       const std::span<const sol::MeshOptimizer::VertexStream> streams)
+    {
+        constexpr auto        unused = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> remap(vertexCount, unused);
+        uint32_t              next = 0;
+
+        for (auto& index : indices)
+        {
+            if (remap[index] == unused) remap[index] = next++;
+            index = remap[index];
+        }
+
+        for (auto& r : remap)
+            if (r == unused) r = next++;
+
+        std::vector<std::byte> tmp;
+        for (const auto& stream : streams)
+        {
+            tmp.resize(vertexCount * stream.stride);
+            for (size_t v = 0; v < vertexCount; v++)
+                std::memcpy(tmp.data() + remap[v] * stream.stride, stream.data + v * stream.stride, stream.stride);
+            std::memcpy(stream.data, tmp.data(), tmp.size());
+        }
+    }
+
+    void runParallel(const size_t count, const std::function<void(size_t)>& task)
+    {
+        const size_t threadCount = std::min<size_t>(count, std::max<size_t>(1, std::thread::hardware_concurrency()));
+        std::atomic<size_t> next = 0;
+
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < threadCount; i++)
+            threads.emplace_back([&] {
+                for (size_t j = next++; j < count; j = next++) task(j);
+            });
+    }
+}  // namespace
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    MeshOptimizer::MeshOptimizer() = default;
+
+    MeshOptimizer::MeshOptimizer(Settings s) { setSettings(std::move(s)); }
+
+    MeshOptimizer::~MeshOptimizer() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    const MeshOptimizer::Settings& MeshOptimizer::getSettings() const noexcept { return settings; }
+
+    ////////////////////////////////////////////////////////////////
+    // Setters.
+    ////////////////////////////////////////////////////////////////
+
+    void MeshOptimizer::setSettings(Settings s)
+    {
+        if (s.cacheSize == 0) throw SolError("Cannot set MeshOptimizer cache size to 0.");
+        settings = std::move(s);
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Optimization.
+    ////////////////////////////////////////////////////////////////
+
+    MeshOptimizer::Stats MeshOptimizer::optimize(const std::span<uint32_t>           indices,
+                                                 const size_t                        vertexCount,
+                                                 const std::span<const VertexStream> streams) const
+    {
+        if (indices.size() % 3 != 0)
+            throw SolError(std::format("Cannot optimize mesh. Index count {} is not a multiple of 3.", indices.size()));
+        if (const auto it = std::ranges::find_if(indices, [&](const uint32_t i) { return i >= vertexCount; });
+            it != indices.end())
+            throw SolError(
+              std::format("Cannot optimize mesh. Index {} is out of range for {} vertices.", *it, vertexCount));
+
+        const bool overdraw = settings.optimizeVertexCache && settings.optimizeOverdraw;
+        if (overdraw && (settings.positionStream >= streams.size() ||
+                         settings.positionOffset + 3 * sizeof(float) > streams[settings.positionStream].stride))
+            throw SolError("Cannot optimize mesh for overdraw. Position stream is missing or too small.");
+
+        Stats stats;
+        stats.acmrBefore = calculateAcmr(indices, vertexCount, settings.cacheSize);
+        stats.atvrBefore = calculateAtvr(indices, vertexCount, settings.cacheSize);
+
+        if (settings.optimizeVertexCache)
+        {
+            std::vector<size_t> clusters;
+            auto                result = tipsify(indices, vertexCount, settings.cacheSize, clusters);
+
+            if (overdraw && clusters.size() > 1)
+            {
+                // Sorting clusters breaks up the cache locality at cluster boundaries. Only keep the new order if the
+                // cost is within the threshold.
+                auto sorted =
+                  sortClusters(result, clusters, streams[settings.positionStream], settings.positionOffset);
+                const auto acmr       = calculateAcmr(result, vertexCount, settings.cacheSize);
+                const auto sortedAcmr = calculateAcmr(sorted, vertexCount, settings.cacheSize);
+                if (sortedAcmr <= acmr * settings.overdrawThreshold) result = std::move(sorted);
+            }
+
+            std::ranges::copy(result, indices.begin());
+        }
+
+        if (settings.optimizeVertexFetch) remapVertices(indices, vertexCount, streams);
+
+        stats.acmrAfter = calculateAcmr(indices, vertexCount, settings.cacheSize);
+        stats.atvrAfter = calculateAtvr(indices, vertexCount, settings.cacheSize);
+        return stats;
+    }
+
+    MeshOptimizer::Stats MeshOptimizer::optimize(MeshDescription& mesh) const
+    {
+        if (!mesh.isIndexed()) throw SolError("Cannot optimize a MeshDescription without an index buffer.");
+
+        const size_t              vertexCount = mesh.getVertexBufferCount() > 0 ? mesh.getVertexCount(0) : 0;
+        std::vector<VertexStream> streams;
+        for (size_t i = 0; i < mesh.getVertexBufferCount(); i++)
+        {
+            if (mesh.getVertexCount(i) != vertexCount)
+                throw SolError(
+                  std::format("Cannot optimize MeshDescription. Vertex buffer {} holds {} vertices instead of {}.",
+                              i,
+                              mesh.getVertexCount(i),
+                              vertexCount));
+            streams.emplace_back(VertexStream{.data   = mesh.getVertexBuffer(i).getMappedData<std::byte>(),
+                                              .stride = mesh.getVertexSize(i)});
+        }
+
+        // Widen indices to 32 bits, optimize, and narrow them again.
+        const size_t          indexSize  = mesh.getIndexSize();
+        const size_t          indexCount = mesh.getIndexCount();
+        auto*                 data       = mesh.getIndexBuffer().getMappedData<std::byte>();
+        std::vector<uint32_t> indices(indexCount);
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            if (indexSize == 1)
+                indices[i] = static_cast<uint32_t>(data[i]);
+            else if (indexSize == 2)
+            {
+                uint16_t index;
+                std::memcpy(&index, data + i * 2, 2);
+                indices[i] = index;
+            }
+            else
+                std::memcpy(&indices[i], data + i * 4, 4);
+        }
+
+        const auto stats = optimize(indices, vertexCount, streams);
+
+        for (size_t i = 0; i < indexCount; i++)
+        {
+            if (indexSize == 1)
+                data[i] = static_cast<std::byte>(indices[i]);
+            else if (indexSize == 2)
+            {
+                const auto index = static_cast<uint16_t>(indices[i]);
+                std::memcpy(data + i * 2, &index, 2);
+            }
+            else
+                std::memcpy(data + i * 4, &indices[i], 4);
+        }
+
+        mesh.getIndexBuffer().flush();
+        for (size_t i = 0; i < mesh.getVertexBufferCount(); i++) mesh.getVertexBuffer(i).flush();
+
+        return stats;
+    }
+
+    std::vector<MeshOptimizer::Stats> MeshOptimizer::optimize(const std::span<MeshDescription* const> meshes) const
+    {
+        std::vector<Stats>              stats(meshes.size());
+        std::vector<std::exception_ptr> errors(meshes.size());
+
+        const auto task = [&](const size_t i) {
+            try
+            {
+                stats[i] = optimize(*meshes[i]);
+            }
+            catch (...)
+            {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        if (settings.executor)
+            settings.executor(meshes.size(), task);
+        else
+            runParallel(meshes.size(), task);
+
+        for (const auto& error : errors)
+            if (error) std::rethrow_exception(error);
+
+        return stats;
+    }
+
+    float MeshOptimizer::calculateAcmr(const std::span<const uint32_t> indices,
+                                       const size_t                    vertexCount,
+                                       const uint32_t                  cacheSize)
+    {
+        if (indices.size() < 3) return 0;
+        const auto counts = simulateFifo(indices, vertexCount, cacheSize);
+        return static_cast<float>(counts.transforms) / static_cast<float>(indices.size() / 3);
+    }
+
+    float MeshOptimizer::calculateAtvr(const std::span<const uint32_t> indices,
+                                       const size_t                    vertexCount,
+                                       const uint32_t                  cacheSize)
+    {
+        const auto counts = simulateFifo(indices, vertexCount, cacheSize);
+        if (counts.referenced == 0) return 0;
+        return static_cast<float>(counts.transforms) / static_cast<float>(counts.referenced);
+    }
+}  // namespace sol
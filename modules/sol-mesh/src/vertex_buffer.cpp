@@ -50,7 +50,7 @@ namespace sol
 
     VertexBuffer::~VertexBuffer() noexcept
     {
-        if (virtualAllocation) vmaVirtualFree(allocator->getVirtualVertexBlock(), virtualAllocation);
+        if (virtualAllocation) allocator->release(*this);
     }
 
     ////////////////////////////////////////////////////////////////
@@ -84,6 +84,16 @@ namespace sol
     // Setters.
     ////////////////////////////////////////////////////////////////
 
+    void VertexBuffer::setRelocationCallback(RelocationCallback callback) { onRelocate = std::move(callback); }
+
+    void VertexBuffer::relocate(IBuffer& buffer, const VmaVirtualAllocation allocation, const size_t offset)
+    {
+        globalBuffer      = &buffer;
+        virtualAllocation = allocation;
+        vertexOffset      = offset;
+        if (onRelocate) onRelocate(*this);
+    }
+
     ////////////////////////////////////////////////////////////////
     // Transactions.
     ////////////////////////////////////////////////////////////////
@@ -0,0 +1,405 @@
+#include "sol-mesh/vertex_format_converter.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <limits>
+#include <optional>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-error/sol_error.h"
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-mesh/mesh_description.h"
+#include "sol-mesh/mesh_layout.h"
+
+namespace
+{
+    /**
+     * \brief Number of vertices that are converted per batch. Each batch is gathered into a contiguous float buffer,
+     * converted into a contiguous buffer of the target type and then scattered to the target. The conversion itself is
+     * scalar code without SIMD intrinsics. Its loops select between values instead of branching, which leaves the
+     * compiler free to vectorize them.
+     */
+    constexpr size_t batchSize = 256;
+
+    /**
+     * \brief Convert a float to a half float, rounding to nearest even. The results of all cases are computed and
+     * the correct one is selected afterwards.
+     */
+    uint16_t toHalf(const float value) noexcept
+    {
+        constexpr uint32_t f32Infinity = 255u << 23;
+        constexpr uint32_t f16Max      = (127u + 16u) << 23;
+        constexpr uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        uint32_t       bits = std::bit_cast<uint32_t>(value);
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        bits &= 0x7fffffffu;
+
+        // Infinity, NaN and values that are too large for a half float.
+        const uint32_t special = bits > f32Infinity ? 0x7e00u : 0x7c00u;
+
+        // Values that become denormals or zero. Adding the magic number lets the float unit do the rounding.
+        const float    denormFloat = std::bit_cast<float>(bits) + std::bit_cast<float>(denormMagic);
+        const uint32_t denorm      = std::bit_cast<uint32_t>(denormFloat) - denormMagic;
+
+        // Normal values. Rebias the exponent and round the mantissa.
+        const uint32_t mantissaOdd = (bits >> 13) & 1u;
+        const uint32_t normal      = (bits + ((15u - 127u) << 23) + 0xfffu + mantissaOdd) >> 13;
+
+        return static_cast<uint16_t>(sign | (bits >= f16Max ? special : bits < (113u << 23) ? denorm : normal));
+    }
+
+    template<typename T>
+    T toSnorm(const float value) noexcept
+    {
+        constexpr auto max = static_cast<float>(std::numeric_limits<T>::max());
+        const float scaled = std::clamp(value, -1.0f, 1.0f) * max;
+        return static_cast<T>(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+    }
+
+    template<typename T>
+    T toUnorm(const float value) noexcept
+    {
+        constexpr auto max = static_cast<float>(std::numeric_limits<T>::max());
+        return static_cast<T>(std::clamp(value, 0.0f, 1.0f) * max + 0.5f);
+    }
+
+    /**
+     * \brief Convert all values of a batch into a contiguous scratch buffer and scatter the components of each vertex
+     * to the strided target.
+     */
+    template<typename T, typename F>
+    void convertBatch(const std::array<float, batchSize * 4>& values,
+                      const size_t                            count,
+                      const size_t                            components,
+                      std::byte*                              dst,
+                      const size_t                            dstStride,
+                      F                                       f) noexcept
+    {
+        std::array<T, batchSize * 4> scratch;
+        for (size_t i = 0; i < count * 4; i++) scratch[i] = f(values[i]);
+        for (size_t v = 0; v < count; v++) std::memcpy(dst + v * dstStride, &scratch[v * 4], components * sizeof(T));
+    }
+}  // namespace
+
+namespace sol
+{
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    VertexFormatConverter::VertexFormatConverter(const MeshLayout& source, const MeshLayout& target)
+    {
+        const auto getFormat = [](const VkFormat format) -> std::optional<std::pair<ComponentType, uint32_t>> {
+            switch (format)
+            {
+            case VK_FORMAT_R32_SFLOAT: return std::pair{ComponentType::Float32, 1u};
+            case VK_FORMAT_R32G32_SFLOAT: return std::pair{ComponentType::Float32, 2u};
+            case VK_FORMAT_R32G32B32_SFLOAT: return std::pair{ComponentType::Float32, 3u};
+            case VK_FORMAT_R32G32B32A32_SFLOAT: return std::pair{ComponentType::Float32, 4u};
+            case VK_FORMAT_R16_SFLOAT: return std::pair{ComponentType::Float16, 1u};
+            case VK_FORMAT_R16G16_SFLOAT: return std::pair{ComponentType::Float16, 2u};
+            case VK_FORMAT_R16G16B16_SFLOAT: return std::pair{ComponentType::Float16, 3u};
+            case VK_FORMAT_R16G16B16A16_SFLOAT: return std::pair{ComponentType::Float16, 4u};
+            case VK_FORMAT_R16_SNORM: return std::pair{ComponentType::Snorm16, 1u};
+            case VK_FORMAT_R16G16_SNORM: return std::pair{ComponentType::Snorm16, 2u};
+            case VK_FORMAT_R16G16B16_SNORM: return std::pair{ComponentType::Snorm16, 3u};
+            case VK_FORMAT_R16G16B16A16_SNORM: return std::pair{ComponentType::Snorm16, 4u};
+            case VK_FORMAT_R16_UNORM: return std::pair{ComponentType::Unorm16, 1u};
+            case VK_FORMAT_R16G16_UNORM: return std::pair{ComponentType::Unorm16, 2u};
+            case VK_FORMAT_R16G16B16_UNORM: return std::pair{ComponentType::Unorm16, 3u};
+            case VK_FORMAT_R16G16B16A16_UNORM: return std::pair{ComponentType::Unorm16, 4u};
+            case VK_FORMAT_R8_SNORM: return std::pair{ComponentType::Snorm8, 1u};
+            case VK_FORMAT_R8G8_SNORM: return std::pair{ComponentType::Snorm8, 2u};
+            case VK_FORMAT_R8G8B8_SNORM: return std::pair{ComponentType::Snorm8, 3u};
+            case VK_FORMAT_R8G8B8A8_SNORM: return std::pair{ComponentType::Snorm8, 4u};
+            case VK_FORMAT_R8_UNORM: return std::pair{ComponentType::Unorm8, 1u};
+            case VK_FORMAT_R8G8_UNORM: return std::pair{ComponentType::Unorm8, 2u};
+            case VK_FORMAT_R8G8B8_UNORM: return std::pair{ComponentType::Unorm8, 3u};
+            case VK_FORMAT_R8G8B8A8_UNORM: return std::pair{ComponentType::Unorm8, 4u};
+            default: return std::nullopt;
+            }
+        };
+
+        const auto getComponentSize = [](const ComponentType type) -> uint32_t {
+            switch (type)
+            {
+            case ComponentType::Float32: return 4;
+            case ComponentType::Float16:
+            case ComponentType::Snorm16:
+            case ComponentType::Unorm16: return 2;
+            case ComponentType::Snorm8:
+            case ComponentType::Unorm8: return 1;
+            case ComponentType::Raw: break;
+            }
+            return 0;
+        };
+
+        const auto getStrides = [](const MeshLayout& layout, const char* name) {
+            const auto& bindings = layout.getBindingDescriptions();
+            uint32_t    count    = 0;
+            for (const auto& b : bindings) count = std::max(count, b.binding + 1);
+
+            std::vector<uint32_t> strides(count, 0);
+            for (const auto& b : bindings) strides[b.binding] = b.stride;
+            for (uint32_t i = 0; i < count; i++)
+                if (strides[i] == 0)
+                    throw SolError(std::format("Cannot convert vertex formats. Binding {} of {} layout is missing or "
+                                               "has a stride of 0.",
+                                               i,
+                                               name));
+            return strides;
+        };
+
+        sourceStrides = getStrides(source, "source");
+        targetStrides = getStrides(target, "target");
+
+        const auto& sourceAttributes = source.getAttributeDescriptions();
+        for (const auto& dst : target.getAttributeDescriptions())
+        {
+            const auto src =
+              std::ranges::find(sourceAttributes, dst.location, &VkVertexInputAttributeDescription::location);
+            if (src == sourceAttributes.end())
+                throw SolError(
+                  std::format("Cannot convert vertex formats. Target attribute at location {} has no source attribute.",
+                              dst.location));
+
+            const auto srcFormat = getFormat(src->format);
+            const auto dstFormat = getFormat(dst.format);
+            if (!srcFormat || !dstFormat)
+                throw SolError(std::format(
+                  "Cannot convert vertex formats. Format of attribute at location {} is not supported.", dst.location));
+
+            const auto [srcType, srcComponents] = *srcFormat;
+            const auto [dstType, dstComponents] = *dstFormat;
+            const uint32_t srcSize              = srcComponents * getComponentSize(srcType);
+            const uint32_t dstSize              = dstComponents * getComponentSize(dstType);
+
+            Conversion conversion{.sourceBinding    = src->binding,
+                                  .sourceOffset     = src->offset,
+                                  .sourceComponents = srcComponents,
+                                  .targetBinding    = dst.binding,
+                                  .targetOffset     = dst.offset,
+                                  .targetComponents = dstComponents,
+                                  .targetType       = dstType,
+                                  .octahedral       = false,
+                                  .rawSize          = 0};
+
+            if (src->format == dst.format)
+            {
+                conversion.targetType = ComponentType::Raw;
+                conversion.rawSize    = srcSize;
+            }
+            else if (srcType != ComponentType::Float32)
+                throw SolError(std::format(
+                  "Cannot convert vertex formats. Source attribute at location {} is not a 32-bit float format.",
+                  dst.location));
+            else if (srcComponents == 3 && dstComponents == 2)
+            {
+                // Octahedral coordinates are in [-1, 1] and would be clamped by unorm formats.
+                if (dstType == ComponentType::Unorm16 || dstType == ComponentType::Unorm8)
+                    throw SolError(std::format("Cannot convert vertex formats. Octahedral encoding of attribute at "
+                                               "location {} requires a float or snorm target format.",
+                                               dst.location));
+                conversion.octahedral = true;
+            }
+            else if (srcComponents != dstComponents && !(srcComponents == 3 && dstComponents == 4))
+                throw SolError(std::format(
+                  "Cannot convert vertex formats. Cannot convert {} components to {} for attribute at location {}.",
+                  srcComponents,
+                  dstComponents,
+                  dst.location));
+
+            if (src->binding >= sourceStrides.size() || dst.binding >= targetStrides.size())
+                throw SolError(std::format(
+                  "Cannot convert vertex formats. Binding of attribute at location {} is missing.", dst.location));
+
+            if (src->offset + srcSize > sourceStrides[src->binding] ||
+                dst.offset + dstSize > targetStrides[dst.binding])
+                throw SolError(std::format(
+                  "Cannot convert vertex formats. Attribute at location {} does not fit in the stride of its binding.",
+                  dst.location));
+
+            conversions.emplace_back(conversion);
+        }
+    }
+
+    VertexFormatConverter::~VertexFormatConverter() noexcept = default;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    size_t VertexFormatConverter::getSourceBindingCount() const noexcept { return sourceStrides.size(); }
+
+    size_t VertexFormatConverter::getTargetBindingCount() const noexcept { return targetStrides.size(); }
+
+    uint32_t VertexFormatConverter::getSourceStride(const size_t binding) const
+    {
+        if (binding >= sourceStrides.size()) throw SolError("Binding index out of range.");
+        return sourceStrides[binding];
+    }
+
+    uint32_t VertexFormatConverter::getTargetStride(const size_t binding) const
+    {
+        if (binding >= targetStrides.size()) throw SolError("Binding index out of range.");
+        return targetStrides[binding];
+    }
+
+    ////////////////////////////////////////////////////////////////
+    // Conversion.
+    ////////////////////////////////////////////////////////////////
+
+    void VertexFormatConverter::convert(const std::span<const std::byte* const> source,
+                                        const std::span<std::byte* const>       target,
+                                        const size_t                            vertexCount) const
+    {
+        if (source.size() != sourceStrides.size())
+            throw SolError(std::format("Cannot convert vertices. Expected {} source buffers, got {}.",
+                                       sourceStrides.size(),
+                                       source.size()));
+        if (target.size() != targetStrides.size())
+            throw SolError(std::format("Cannot convert vertices. Expected {} target buffers, got {}.",
+                                       targetStrides.size(),
+                                       target.size()));
+
+        std::array<float, batchSize * 4> values;
+
+        for (const auto& conversion : conversions)
+        {
+            const size_t     srcStride = sourceStrides[conversion.sourceBinding];
+            const size_t     dstStride = targetStrides[conversion.targetBinding];
+            const std::byte* src       = source[conversion.sourceBinding] + conversion.sourceOffset;
+            std::byte*       dst       = target[conversion.targetBinding] + conversion.targetOffset;
+
+            if (conversion.targetType == ComponentType::Raw)
+            {
+                for (size_t v = 0; v < vertexCount; v++)
+                    std::memcpy(dst + v * dstStride, src + v * srcStride, conversion.rawSize);
+                continue;
+            }
+
+            // Missing components are 0, except for the 4th component which is 1. Gathering only overwrites the source
+            // components, so this is done once per attribute.
+            for (size_t i = 0; i < values.size(); i++) values[i] = i % 4 == 3 ? 1.0f : 0.0f;
+
+            for (size_t first = 0; first < vertexCount; first += batchSize)
+            {
+                const size_t count = std::min(batchSize, vertexCount - first);
+
+                // Gather the batch into 4 floats per vertex.
+                for (size_t v = 0; v < count; v++)
+                    std::memcpy(&values[v * 4], src + (first + v) * srcStride, conversion.sourceComponents * 4);
+
+                if (conversion.octahedral)
+                {
+                    for (size_t v = 0; v < count; v++)
+                    {
+                        float*      n = &values[v * 4];
+                        const float l = std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]);
+                        const float s = l > 0 ? 1.0f / l : 0.0f;
+                        const float x = n[0] * s;
+                        const float y = n[1] * s;
+
+                        // Fold the lower hemisphere over the diagonals.
+                        const float foldX = (1.0f - std::abs(y)) * (x >= 0 ? 1.0f : -1.0f);
+                        const float foldY = (1.0f - std::abs(x)) * (y >= 0 ? 1.0f : -1.0f);
+                        n[0]              = n[2] < 0 ? foldX : x;
+                        n[1]              = n[2] < 0 ? foldY : y;
+                    }
+                }
+
+                const size_t components = conversion.targetComponents;
+                std::byte*   out        = dst + first * dstStride;
+                switch (conversion.targetType)
+                {
+                case ComponentType::Float32:
+                    convertBatch<float>(values, count, components, out, dstStride, std::identity{});
+                    break;
+                case ComponentType::Float16:
+                    convertBatch<uint16_t>(values, count, components, out, dstStride, toHalf);
+                    break;
+                case ComponentType::Snorm16:
+                    convertBatch<int16_t>(values, count, components, out, dstStride, toSnorm<int16_t>);
+                    break;
+                case ComponentType::Unorm16:
+                    convertBatch<uint16_t>(values, count, components, out, dstStride, toUnorm<uint16_t>);
+                    break;
+                case ComponentType::Snorm8:
+                    convertBatch<int8_t>(values, count, components, out, dstStride, toSnorm<int8_t>);
+                    break;
+                case ComponentType::Unorm8:
+                    convertBatch<uint8_t>(values, count, components, out, dstStride, toUnorm<uint8_t>);
+                    break;
+                case ComponentType::Raw: break;
+                }
+            }
+        }
+    }
+
+    VertexFormatConverter::Stats VertexFormatConverter::convert(const MeshDescription& source,
+                                                                MeshDescription&       target) const
+    {
+        if (target.getVertexBufferCount() > 0 || target.isIndexed())
+            throw SolError("Cannot convert MeshDescription. Target already has buffers.");
+        if (source.getVertexBufferCount() != sourceStrides.size())
+            throw SolError(std::format("Cannot convert MeshDescription. Expected {} vertex buffers, got {}.",
+                                       sourceStrides.size(),
+                                       source.getVertexBufferCount()));
+
+        Stats                         stats;
+        const uint32_t                vertexCount = sourceStrides.empty() ? 0 : source.getVertexCount(0);
+        std::vector<const std::byte*> src;
+        for (size_t i = 0; i < sourceStrides.size(); i++)
+        {
+            if (source.getVertexSize(i) != sourceStrides[i] || source.getVertexCount(i) != vertexCount)
+                throw SolError(std::format(
+                  "Cannot convert MeshDescription. Vertex buffer {} does not match the source layout.", i));
+            src.emplace_back(source.getVertexBuffer(i).getMappedData<std::byte>());
+            stats.sourceBytes += static_cast<size_t>(sourceStrides[i]) * vertexCount;
+        }
+
+        std::vector<std::byte*> dst;
+        for (size_t i = 0; i < targetStrides.size(); i++)
+        {
+            // Keep the target offset and flags of the source buffer of the same binding, if there is one.
+            const bool hasSource = i < source.getVertexBufferCount();
+            target.addVertexBuffer(targetStrides[i],
+                                   vertexCount,
+                                   hasSource ? source.getVertexOffset(i) : 0,
+                                   hasSource ? source.getVertexFlags(i) : 0);
+            dst.emplace_back(target.getVertexBuffer(i).getMappedData<std::byte>());
+            stats.targetBytes += static_cast<size_t>(targetStrides[i]) * vertexCount;
+        }
+
+        convert(src, dst, vertexCount);
+        for (size_t i = 0; i < targetStrides.size(); i++) target.getVertexBuffer(i).flush();
+
+        if (source.isIndexed())
+        {
+            target.addIndexBuffer(
+              source.getIndexSize(), source.getIndexCount(), source.getIndexOffset(), source.getIndexFlags());
+            if (source.getIndexCount() > 0)
+                target.setIndexData(0, source.getIndexCount(), source.getIndexBuffer().getMappedData<std::byte>());
+        }
+
+        return stats;
+    }
+}  // namespace sol
@@ -36,6 +36,11 @@ namespace sol
              */
             const Mesh* mesh = nullptr;
 
+            /**
+             * \brief Level of detail of the mesh to draw.
+             */
+            size_t lod = 0;
+
             /**
              * \brief Active material.
              */
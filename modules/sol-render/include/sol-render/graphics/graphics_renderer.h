@@ -90,7 +90,7 @@ namespace sol
 
         [[nodiscard]] uint32_t bindIndexBuffer(VkCommandBuffer cb, const Mesh& mesh);
 
-        void bindVertexBuffers(VkCommandBuffer cb, const Mesh& mesh);
+        [[nodiscard]] uint32_t bindVertexBuffers(VkCommandBuffer cb, const Mesh& mesh);
 
         std::vector<const DescriptorBuffer*>                                             activeDescriptorBuffers = {};
         const VulkanGraphicsPipeline2*                                                   activePipeline      = nullptr;
@@ -1,5 +1,11 @@
 #pragma once
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <functional>
+
 ////////////////////////////////////////////////////////////////
 // Module includes.
 ////////////////////////////////////////////////////////////////
@@ -25,6 +31,16 @@ namespace sol
                                                Node::Type::Mesh>
     {
     public:
+        ////////////////////////////////////////////////////////////////
+        // Types.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Function that returns the distance from the camera to a mesh node, in the object space units of its
+         * mesh. A distance of 0 or less selects the full detail mesh.
+         */
+        using DistanceFunction = std::function<float(const MeshNode&)>;
+
         ////////////////////////////////////////////////////////////////
         // Constructors.
         ////////////////////////////////////////////////////////////////
@@ -47,12 +63,33 @@ namespace sol
 
         [[nodiscard]] GraphicsRenderData* getRenderData() const noexcept;
 
+        [[nodiscard]] const DistanceFunction& getDistanceFunction() const noexcept;
+
+        [[nodiscard]] float getProjectionScale() const noexcept;
+
+        [[nodiscard]] float getMaxPixelError() const noexcept;
+
         ////////////////////////////////////////////////////////////////
         // Setters.
         ////////////////////////////////////////////////////////////////
 
         void setRenderData(GraphicsRenderData* data) noexcept;
 
+        /**
+         * \brief Enable level of detail selection. For each mesh, the least detailed level whose error, projected onto
+         * the screen, does not exceed the maximum pixel error is drawn.
+         * \param func Distance function.
+         * \param scale Projection scale, i.e. viewportHeight / (2 * tan(fovY / 2)) for a perspective projection.
+         * \param pixelError Maximum error in pixels.
+         * \throws SolError Thrown if the scale is not positive or the pixel error is negative.
+         */
+        void setLodSelection(DistanceFunction func, float scale, float pixelError = 1.0f);
+
+        /**
+         * \brief Disable level of detail selection. All meshes are drawn at full detail.
+         */
+        void clearLodSelection() noexcept;
+
     protected:
         ////////////////////////////////////////////////////////////////
         // Traversal.
@@ -84,6 +121,9 @@ namespace sol
         TraversalStack<GraphicsDynamicStateNode, size_t> dynamicStateStack{};
         TraversalStack<GraphicsMaterialNode>             materialStack{};
         TraversalStack<GraphicsPushConstantNode, size_t> pushConstantStack{};
-        GraphicsRenderData*                              renderData = nullptr;
+        GraphicsRenderData*                              renderData      = nullptr;
+        DistanceFunction                                 distanceFunction;
+        float                                            projectionScale = 0;
+        float                                            maxPixelError   = 1.0f;
     };
 }  // namespace sol
@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <ranges>
 #include <set>
 #include <vector>
@@ -53,19 +54,28 @@ namespace sol
 
         bindDescriptorBuffers(params);
 
-        for (const auto& [mesh, material, descriptorOffset, pushConstantOffset, dynamicStateOffset] :
+        for (const auto& [mesh, lod, material, descriptorOffset, pushConstantOffset, dynamicStateOffset] :
              params.renderData.drawables)
         {
             bindMaterial(params.commandBuffer, *material);
             bindDynamicStates(params.commandBuffer, params, *material, dynamicStateOffset);
             bindPushConstants(params.commandBuffer, params, *material, pushConstantOffset);
             bindDescriptors(params.commandBuffer, params, *material, descriptorOffset);
-            const auto firstIndex = bindIndexBuffer(params.commandBuffer, *mesh);
-            bindVertexBuffers(params.commandBuffer, *mesh);
-            if (mesh->hasIndexBuffer())
-                vkCmdDrawIndexed(params.commandBuffer, 0, 1, firstIndex, 0, 0);
-            else
-                vkCmdDraw(params.commandBuffer, 0, 1, 0, 0);
+            const auto firstIndex  = bindIndexBuffer(params.commandBuffer, *mesh);
+            const auto firstVertex = bindVertexBuffers(params.commandBuffer, *mesh);
+
+            for (const auto& [subIndex, subCount, subVertexOffset] : mesh->getDrawRanges(lod))
+            {
+                if (mesh->hasIndexBuffer())
+                    vkCmdDrawIndexed(params.commandBuffer,
+                                     subCount,
+                                     1,
+                                     firstIndex + subIndex,
+                                     static_cast<int32_t>(firstVertex) + subVertexOffset,
+                                     0);
+                else
+                    vkCmdDraw(params.commandBuffer, subCount, 1, firstVertex + subIndex, 0);
+            }
         }
     }
 
@@ -73,7 +83,7 @@ namespace sol
     {
         std::set<const DescriptorBuffer*> uniqueBuffers;
 
-        for (const auto& [mesh, material, descriptorOffset, pushConstantOffset, dynamicStateOffset] :
+        for (const auto& [mesh, lod, material, descriptorOffset, pushConstantOffset, dynamicStateOffset] :
              params.renderData.drawables)
         {
             for (size_t i = 0; i < material->getDescriptorLayouts().size(); i++)
@@ -244,15 +254,23 @@ namespace sol
         return 0;
     }
 
-    void GraphicsRenderer::bindVertexBuffers(const VkCommandBuffer cb, const Mesh& mesh)
+    uint32_t GraphicsRenderer::bindVertexBuffers(const VkCommandBuffer cb, const Mesh& mesh)
     {
         if (activeVertexBuffers.size() < mesh.getVertexBufferCount())
             activeVertexBuffers.resize(mesh.getVertexBufferCount());
 
+        // If all vertex buffers start at the same vertex, they are bound with an offset of 0 and the vertex offset is
+        // applied during the draw call instead. Consecutive meshes suballocated from the same global buffers then do
+        // not require a rebind.
+        const auto& vertexBuffers = mesh.getVertexBuffers();
+        const bool  sharedOffset  = std::ranges::all_of(vertexBuffers, [&](const VertexBufferPtr& vb) {
+            return vb->getVertexOffset() == vertexBuffers.front()->getVertexOffset();
+        });
+
         for (size_t i = 0; i < mesh.getVertexBufferCount(); i++)
         {
-            const std::pair vertexBuffer = {&mesh.getVertexBuffers()[i]->getBuffer(),
-                                            mesh.getVertexBuffers()[i]->getBufferOffset()};
+            const std::pair vertexBuffer = {&vertexBuffers[i]->getBuffer(),
+                                            sharedOffset ? 0 : vertexBuffers[i]->getBufferOffset()};
 
             if (activeVertexBuffers[i] != vertexBuffer)
             {
@@ -263,5 +281,8 @@ namespace sol
                 activeVertexBuffers[i] = vertexBuffer;
             }
         }
+
+        if (!sharedOffset || vertexBuffers.empty()) return 0;
+        return static_cast<uint32_t>(vertexBuffers.front()->getVertexOffset());
     }
 }  // namespace sol
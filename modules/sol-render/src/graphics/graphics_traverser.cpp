@@ -7,6 +7,7 @@
 #include "sol-error/sol_error.h"
 #include "sol-material/graphics/graphics_dynamic_state.h"
 #include "sol-material/graphics/graphics_material2.h"
+#include "sol-mesh/mesh.h"
 #include "sol-scenegraph/drawable/mesh_node.h"
 #include "sol-scenegraph/graphics/graphics_dynamic_state_node.h"
 
@@ -32,12 +33,32 @@ namespace sol
 
     GraphicsRenderData* GraphicsTraverser::getRenderData() const noexcept { return renderData; }
 
+    const GraphicsTraverser::DistanceFunction& GraphicsTraverser::getDistanceFunction() const noexcept
+    {
+        return distanceFunction;
+    }
+
+    float GraphicsTraverser::getProjectionScale() const noexcept { return projectionScale; }
+
+    float GraphicsTraverser::getMaxPixelError() const noexcept { return maxPixelError; }
+
     ////////////////////////////////////////////////////////////////
     // Setters.
     ////////////////////////////////////////////////////////////////
 
     void GraphicsTraverser::setRenderData(GraphicsRenderData* data) noexcept { renderData = data; }
 
+    void GraphicsTraverser::setLodSelection(DistanceFunction func, const float scale, const float pixelError)
+    {
+        if (scale <= 0) throw SolError("Cannot set LOD selection. Projection scale must be larger than 0.");
+        if (pixelError < 0) throw SolError("Cannot set LOD selection. Maximum pixel error cannot be negative.");
+        distanceFunction = std::move(func);
+        projectionScale  = scale;
+        maxPixelError    = pixelError;
+    }
+
+    void GraphicsTraverser::clearLodSelection() noexcept { distanceFunction = {}; }
+
     ////////////////////////////////////////////////////////////////
     // Traversal.
     ////////////////////////////////////////////////////////////////
@@ -235,7 +256,16 @@ namespace sol
             return;
         }
 
+        // Select level of detail by projecting the error of each level onto the screen.
+        size_t lod = 0;
+        if (distanceFunction && projectionScale > 0)
+        {
+            const auto distance = distanceFunction(node);
+            if (distance > 0) lod = node.getMesh()->selectLod(maxPixelError * distance / projectionScale);
+        }
+
         renderData->drawables.emplace_back(GraphicsRenderData::Drawable{.mesh               = node.getMesh(),
+                                                                        .lod                = lod,
                                                                         .material           = &material,
                                                                         .descriptorOffset   = descriptorOffset,
                                                                         .pushConstantOffset = pcOffset,
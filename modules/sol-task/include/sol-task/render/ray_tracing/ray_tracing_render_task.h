@@ -5,6 +5,7 @@
 ////////////////////////////////////////////////////////////////
 
 #include "sol-core/fwd.h"
+#include "sol-memory/fwd.h"
 #include "sol-render/ray_tracing/fwd.h"
 
 ////////////////////////////////////////////////////////////////
@@ -71,5 +72,10 @@ namespace sol
          * \brief Index passed to the renderer for selecting the descriptor sets that are bound.
          */
         ITaskResource<uint32_t>* frameIndex = nullptr;
+
+        /**
+         * \brief Optional list of buffer updates that is flushed at the start of the command buffer.
+         */
+        ITaskResource<BufferUpdateList>* updateList = nullptr;
     };
 }  // namespace sol
@@ -6,6 +6,7 @@
 
 #include "sol-core/vulkan_command_buffer.h"
 #include "sol-error/sol_error.h"
+#include "sol-memory/buffer_update_list.h"
 #include "sol-render/graphics/graphics_renderer.h"
 #include "sol-render/graphics/graphics_rendering_info.h"
 
@@ -72,6 +73,7 @@ namespace sol
 
         rCommandBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
         rCommandBuffer.beginOneTimeCommand();
+        if (updateList) (*updateList)->flush(rCommandBuffer);
         rRenderer.createPipelines(params);
         rRenderingInfo.preTransition(rCommandBuffer);
         rRenderingInfo.beginRendering(rCommandBuffer);
@@ -7,6 +7,7 @@
 #include "sol-core/vulkan_command_buffer_list.h"
 #include "sol-core/vulkan_frame_buffer.h"
 #include "sol-error/sol_error.h"
+#include "sol-memory/buffer_update_list.h"
 #include "sol-render/ray_tracing/ray_tracing_renderer.h"
 
 
@@ -61,6 +62,7 @@ namespace sol
 
         rCommandBuffer.resetCommand(VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
         rCommandBuffer.beginOneTimeCommand();
+        if (updateList) (*updateList)->flush(rCommandBuffer);
         const RayTracingRenderer::Parameters params = {
           .renderData = rRenderData, .commandBuffer = rCommandBuffer.get(), .index = rFrameIndex};
         rRenderer.createPipelines(params);
@@ -4,6 +4,7 @@
 // Standard includes.
 ////////////////////////////////////////////////////////////////
 
+#include <functional>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////
@@ -20,6 +21,7 @@
 #include "sol-core/fwd.h"
 #include "sol-core/object_ref_setting.h"
 #include "sol-memory/i_image.h"
+#include "sol-memory/residency_manager.h"
 #include "sol-memory/transaction.h"
 
 ////////////////////////////////////////////////////////////////
@@ -82,6 +84,12 @@ namespace sol
              * \brief Image tiling.
              */
             VkImageTiling tiling;
+
+            /**
+             * \brief Sharing mode. A concurrent image is never transferred between queue families, which avoids the
+             * release and acquire barriers around each transfer. See MemoryManager::setSharingMode.
+             */
+            VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
         };
 
         struct Barrier
@@ -305,7 +313,33 @@ namespace sol
                      const Barrier&                 dstBarrier,
                      const std::vector<CopyRegion>& regions);
 
+        ////////////////////////////////////////////////////////////////
+        // Residency.
+        ////////////////////////////////////////////////////////////////
+
+        /**
+         * \brief Register this image with a ResidencyManager. On eviction, all mip levels are downloaded and the
+         * VulkanImage is destroyed. The image must not be used until it is touched again. On restore, a new
+         * VulkanImage is created and all mip levels are uploaded and transitioned back to the layout they had. Image
+         * views of the old VulkanImage are invalid after a restore.
+         * \param manager ResidencyManager.
+         * \param priority Priority.
+         * \param onRestore Optional callback that is invoked after the image was recreated, e.g. to recreate views.
+         * \throws SolError Thrown if the size of a texel of the image format is not known, e.g. for compressed
+         * formats.
+         * \return Handle.
+         */
+        [[nodiscard]] ResidencyManager::Handle registerResidency(ResidencyManager&              manager,
+                                                                 uint32_t                       priority  = 0,
+                                                                 std::function<void(Image2D2&)> onRestore = {});
+
     private:
+        /**
+         * \brief Create the VulkanImage from the current format, size, level count, usage, tiling and sharing mode.
+         * \param initialLayout Initial layout of all levels.
+         */
+        void createImage(VkImageLayout initialLayout);
+
         ////////////////////////////////////////////////////////////////
         // Member variables.
         ////////////////////////////////////////////////////////////////
@@ -349,5 +383,10 @@ namespace sol
          * \brief Image tiling.
          */
         VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
+
+        /**
+         * \brief Requested sharing mode.
+         */
+        VkSharingMode sharingMode = VK_SHARING_MODE_EXCLUSIVE;
     };
 }  // namespace sol
@@ -24,6 +24,71 @@
 #include "sol-memory/i_buffer.h"
 #include "sol-memory/memory_manager.h"
 
+namespace
+{
+    /**
+     * \brief Get the size of a texel of an uncompressed format.
+     * \param format Format.
+     * \return Size in bytes, or 0 if not known.
+     */
+    [[nodiscard]] size_t getTexelSize(const VkFormat format) noexcept
+    {
+        switch (format)
+        {
+        case VK_FORMAT_R8_UNORM:
+        case VK_FORMAT_R8_SNORM:
+        case VK_FORMAT_R8_UINT:
+        case VK_FORMAT_R8_SINT:
+        case VK_FORMAT_R8_SRGB:
+        case VK_FORMAT_S8_UINT: return 1;
+        case VK_FORMAT_R8G8_UNORM:
+        case VK_FORMAT_R8G8_SNORM:
+        case VK_FORMAT_R8G8_UINT:
+        case VK_FORMAT_R8G8_SINT:
+        case VK_FORMAT_R8G8_SRGB:
+        case VK_FORMAT_R16_UNORM:
+        case VK_FORMAT_R16_SNORM:
+        case VK_FORMAT_R16_UINT:
+        case VK_FORMAT_R16_SINT:
+        case VK_FORMAT_R16_SFLOAT:
+        case VK_FORMAT_D16_UNORM: return 2;
+        case VK_FORMAT_R8G8B8A8_UNORM:
+        case VK_FORMAT_R8G8B8A8_SNORM:
+        case VK_FORMAT_R8G8B8A8_UINT:
+        case VK_FORMAT_R8G8B8A8_SINT:
+        case VK_FORMAT_R8G8B8A8_SRGB:
+        case VK_FORMAT_B8G8R8A8_UNORM:
+        case VK_FORMAT_B8G8R8A8_SRGB:
+        case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+        case VK_FORMAT_B10G11R11_UFLOAT_PACK32:
+        case VK_FORMAT_R16G16_UNORM:
+        case VK_FORMAT_R16G16_SNORM:
+        case VK_FORMAT_R16G16_UINT:
+        case VK_FORMAT_R16G16_SINT:
+        case VK_FORMAT_R16G16_SFLOAT:
+        case VK_FORMAT_R32_UINT:
+        case VK_FORMAT_R32_SINT:
+        case VK_FORMAT_R32_SFLOAT:
+        case VK_FORMAT_D32_SFLOAT: return 4;
+        case VK_FORMAT_R16G16B16A16_UNORM:
+        case VK_FORMAT_R16G16B16A16_SNORM:
+        case VK_FORMAT_R16G16B16A16_UINT:
+        case VK_FORMAT_R16G16B16A16_SINT:
+        case VK_FORMAT_R16G16B16A16_SFLOAT:
+        case VK_FORMAT_R32G32_UINT:
+        case VK_FORMAT_R32G32_SINT:
+        case VK_FORMAT_R32G32_SFLOAT: return 8;
+        case VK_FORMAT_R32G32B32_UINT:
+        case VK_FORMAT_R32G32B32_SINT:
+        case VK_FORMAT_R32G32B32_SFLOAT: return 12;
+        case VK_FORMAT_R32G32B32A32_UINT:
+        case VK_FORMAT_R32G32B32A32_SINT:
+        case VK_FORMAT_R32G32B32A32_SFLOAT: return 16;
+        default: return 0;
+        }
+    }
+}  // namespace
+
 namespace sol
 {
     ////////////////////////////////////////////////////////////////
@@ -121,39 +186,44 @@ namespace sol
         if (settings.levels == 0)
             levels = static_cast<uint32_t>(std::floor(std::log2(std::max(settings.size[0], settings.size[1])))) + 1;
 
-        VulkanImage::Settings imageSettings;
-        imageSettings.device             = settings.memoryManager().getDevice();
-        imageSettings.format             = settings.format;
-        imageSettings.width              = settings.size[0];
-        imageSettings.height             = settings.size[1];
-        imageSettings.depth              = 1;
-        imageSettings.mipLevels          = levels;
-        imageSettings.arrayLayers        = 1;
-        imageSettings.tiling             = settings.tiling;
-        imageSettings.imageUsage         = settings.usage;
-        imageSettings.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
-        imageSettings.initialLayout      = settings.initialLayout;
-        imageSettings.allocator          = settings.memoryManager().getAllocator();
-        imageSettings.vma.memoryUsage    = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
-        imageSettings.vma.requiredFlags  = 0;
-        imageSettings.vma.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-        imageSettings.vma.flags          = 0;
-        auto vulkanImage                 = VulkanImage::create(imageSettings);
-
         auto image = id.is_nil() ? std::make_unique<Image2D2>(settings.memoryManager()) :
                                    std::make_unique<Image2D2>(settings.memoryManager(), id);
         image->queueFamily.resize(levels, &settings.initialOwner());
         image->imageLayout.resize(levels, settings.initialLayout);
-        image->image       = std::move(vulkanImage);
         image->format      = settings.format;
         image->size        = settings.size;
         image->usageFlags  = settings.usage;
         image->aspectFlags = settings.aspect;
         image->tiling      = settings.tiling;
+        image->sharingMode = settings.sharingMode;
+        image->createImage(settings.initialLayout);
 
         return image;
     }
 
+    void Image2D2::createImage(const VkImageLayout initialLayout)
+    {
+        VulkanImage::Settings imageSettings;
+        imageSettings.device             = getMemoryManager().getDevice();
+        imageSettings.format             = format;
+        imageSettings.width              = size[0];
+        imageSettings.height             = size[1];
+        imageSettings.depth              = 1;
+        imageSettings.mipLevels          = getLevelCount();
+        imageSettings.arrayLayers        = 1;
+        imageSettings.tiling             = tiling;
+        imageSettings.imageUsage         = usageFlags;
+        imageSettings.initialLayout      = initialLayout;
+        imageSettings.allocator          = getMemoryManager().getAllocator();
+        imageSettings.vma.memoryUsage    = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        imageSettings.vma.requiredFlags  = 0;
+        imageSettings.vma.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        imageSettings.vma.flags          = 0;
+        getMemoryManager().setSharingMode(imageSettings, sharingMode);
+        image = VulkanImage::create(imageSettings);
+        std::ranges::fill(imageLayout, initialLayout);
+    }
+
     ////////////////////////////////////////////////////////////////
     // Transactions.
     ////////////////////////////////////////////////////////////////
@@ -273,4 +343,90 @@ namespace sol
         transaction.stage(copy, imgBarrier, bufferBarrier);
     }
 
+    ////////////////////////////////////////////////////////////////
+    // Residency.
+    ////////////////////////////////////////////////////////////////
+
+    ResidencyManager::Handle Image2D2::registerResidency(ResidencyManager&              manager,
+                                                         const uint32_t                 priority,
+                                                         std::function<void(Image2D2&)> onRestore)
+    {
+        const size_t texelSize = getTexelSize(format);
+        if (texelSize == 0)
+            throw SolError(std::format("Cannot register image with ResidencyManager. Texel size of format {} is not "
+                                       "known.",
+                                       static_cast<int32_t>(format)));
+
+        // All levels are stored tightly packed after each other.
+        std::vector<CopyRegion> regions;
+        size_t                  dataSize = 0;
+        for (uint32_t level = 0; level < getLevelCount(); level++)
+        {
+            const uint32_t w = std::max(size[0] >> level, 1u);
+            const uint32_t h = std::max(size[1] >> level, 1u);
+            regions.emplace_back(
+              CopyRegion{.dataOffset = dataSize, .level = level, .regionOffset = {0, 0}, .regionSize = {w, h}});
+            dataSize += texelSize * w * h;
+        }
+
+        // Layout and owner of the image before it was evicted, to restore it to.
+        struct State
+        {
+            VkImageLayout            layout = VK_IMAGE_LAYOUT_UNDEFINED;
+            const VulkanQueueFamily* family = nullptr;
+        };
+        auto state = std::make_shared<State>();
+
+        ResidencyManager::Resource resource;
+        resource.size     = dataSize;
+        resource.priority = priority;
+        resource.download = [this, regions](Transaction& transaction, IBuffer& dstBuffer) {
+            getData(transaction,
+                    dstBuffer,
+                    Barrier{.dstFamily = nullptr,
+                            .srcStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                            .dstStage  = VK_PIPELINE_STAGE_2_NONE,
+                            .srcAccess = VK_ACCESS_2_MEMORY_WRITE_BIT,
+                            .dstAccess = VK_ACCESS_2_NONE,
+                            .dstLayout = imageLayout[0]},
+                    Barrier{.dstFamily = nullptr,
+                            .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                            .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                            .srcAccess = VK_ACCESS_2_NONE,
+                            .dstAccess = VK_ACCESS_2_HOST_READ_BIT,
+                            .dstLayout = VK_IMAGE_LAYOUT_UNDEFINED},
+                    regions);
+        };
+        resource.release = [this, state] {
+            // Only remember the state of a resident image. Release is also called after a failed restore.
+            if (image)
+            {
+                state->layout = imageLayout[0];
+                state->family = queueFamily[0];
+            }
+            image.reset();
+        };
+        resource.restore = [this, regions, dataSize, state, onRestore = std::move(onRestore)](
+                             Transaction& transaction, const void* data) {
+            createImage(VK_IMAGE_LAYOUT_UNDEFINED);
+            if (state->family) std::ranges::fill(queueFamily, state->family);
+            if (!setData(transaction,
+                         data,
+                         dataSize,
+                         Barrier{.dstFamily = nullptr,
+                                 .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                 .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                 .srcAccess = VK_ACCESS_2_NONE,
+                                 .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT,
+                                 .dstLayout = state->layout},
+                         false,
+                         regions))
+                return false;
+
+            if (onRestore) onRestore(*this);
+            return true;
+        };
+
+        return manager.add(std::move(resource));
+    }
 }  // namespace sol
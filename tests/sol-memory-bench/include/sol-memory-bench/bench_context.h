@@ -0,0 +1,101 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <string>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/fwd.h"
+#include "sol-core/vulkan_physical_device_features.h"
+#include "sol-memory/fwd.h"
+
+/**
+ * \brief Headless Vulkan device, memory manager and transaction manager for running benchmarks. Unlike the test
+ * fixture, this accepts any device type and does not require a dedicated transfer queue, so that it can run on
+ * software implementations such as lavapipe. If the device has no dedicated transfer queue, copies are done on the
+ * graphics queue.
+ */
+class BenchContext
+{
+public:
+    ////////////////////////////////////////////////////////////////
+    // Types.
+    ////////////////////////////////////////////////////////////////
+
+    struct Settings
+    {
+        /**
+         * \brief If not empty, only devices whose name contains this string are considered.
+         */
+        std::string deviceFilter;
+
+        /**
+         * \brief Block size of the ring buffer pool used for staging buffers. Must fit the largest copy.
+         */
+        size_t stagingPoolSize = 512ull * 1024ull * 1024ull;
+    };
+
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    BenchContext() = delete;
+
+    explicit BenchContext(const Settings& settings);
+
+    BenchContext(const BenchContext&) = delete;
+
+    BenchContext(BenchContext&&) noexcept = delete;
+
+    ~BenchContext() noexcept;
+
+    BenchContext& operator=(const BenchContext&) = delete;
+
+    BenchContext& operator=(BenchContext&&) noexcept = delete;
+
+    ////////////////////////////////////////////////////////////////
+    // Getters.
+    ////////////////////////////////////////////////////////////////
+
+    [[nodiscard]] sol::VulkanDevice& getDevice() const noexcept;
+
+    [[nodiscard]] sol::MemoryManager& getMemoryManager() const noexcept;
+
+    [[nodiscard]] sol::TransactionManager& getTransactionManager() const noexcept;
+
+    [[nodiscard]] const std::string& getDeviceName() const noexcept;
+
+    [[nodiscard]] const std::string& getDeviceType() const noexcept;
+
+    [[nodiscard]] bool hasDedicatedTransfer() const noexcept;
+
+private:
+    ////////////////////////////////////////////////////////////////
+    // Member variables.
+    ////////////////////////////////////////////////////////////////
+
+    sol::VulkanInstancePtr instance;
+
+    sol::VulkanPhysicalDeviceFeatures2Ptr supportedFeatures;
+
+    sol::VulkanPhysicalDeviceFeatures2Ptr enabledFeatures;
+
+    sol::VulkanPhysicalDevicePtr physicalDevice;
+
+    sol::VulkanDevicePtr device;
+
+    sol::MemoryManagerPtr memoryManager;
+
+    sol::TransactionManagerPtr transactionManager;
+
+    std::string deviceName;
+
+    std::string deviceType;
+
+    bool dedicatedTransfer = false;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * \brief Minimal streaming JSON writer for benchmark results. Keeps track of separators and indentation, but does not
+ * validate that keys and values are interleaved correctly.
+ */
+class JsonWriter
+{
+public:
+    ////////////////////////////////////////////////////////////////
+    // Constructors.
+    ////////////////////////////////////////////////////////////////
+
+    JsonWriter() = delete;
+
+    explicit JsonWriter(std::ostream& stream);
+
+    JsonWriter(const JsonWriter&) = delete;
+
+    JsonWriter(JsonWriter&&) noexcept = delete;
+
+    ~JsonWriter() noexcept;
+
+    JsonWriter& operator=(const JsonWriter&) = delete;
+
+    JsonWriter& operator=(JsonWriter&&) noexcept = delete;
+
+    ////////////////////////////////////////////////////////////////
+    // Structure.
+    ////////////////////////////////////////////////////////////////
+
+    JsonWriter& beginObject();
+
+    JsonWriter& endObject();
+
+    JsonWriter& beginArray();
+
+    JsonWriter& endArray();
+
+    /**
+     * \brief Write the key of the next object member.
+     * \param name Key.
+     * \return *this.
+     */
+    JsonWriter& key(std::string_view name);
+
+    ////////////////////////////////////////////////////////////////
+    // Values.
+    ////////////////////////////////////////////////////////////////
+
+    JsonWriter& value(std::string_view v);
+
+    JsonWriter& value(const char* v);
+
+    JsonWriter& value(bool v);
+
+    JsonWriter& value(size_t v);
+
+    /**
+     * \brief Write a number. Non-finite values are written as null.
+     * \param v Value.
+     * \return *this.
+     */
+    JsonWriter& value(double v);
+
+    /**
+     * \brief Write an object member.
+     * \tparam T Value type.
+     * \param name Key.
+     * \param v Value.
+     * \return *this.
+     */
+    template<typename T>
+    JsonWriter& field(const std::string_view name, const T& v)
+    {
+        key(name);
+        return value(v);
+    }
+
+private:
+    ////////////////////////////////////////////////////////////////
+    // Formatting.
+    ////////////////////////////////////////////////////////////////
+
+    /**
+     * \brief Write the separator and indentation that go before a new key or value.
+     */
+    void prefix();
+
+    void newline();
+
+    void writeString(std::string_view v);
+
+    ////////////////////////////////////////////////////////////////
+    // Member variables.
+    ////////////////////////////////////////////////////////////////
+
+    std::ostream* out = nullptr;
+
+    /**
+     * \brief For each open object or array, whether it is still empty.
+     */
+    std::vector<bool> empty;
+
+    /**
+     * \brief Whether a key was just written, in which case the next value goes on the same line.
+     */
+    bool afterKey = false;
+};
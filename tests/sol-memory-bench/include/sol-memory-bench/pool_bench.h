@@ -0,0 +1,26 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory-bench/bench_context.h"
+#include "sol-memory-bench/json_writer.h"
+
+/**
+ * \brief Measure allocation and release throughput of each pool type for a range of size classes. Buffers are
+ * allocated in batches and released in the order each pool type requires. Writes a "pool_allocation" array.
+ * \param context Context.
+ * \param json Writer, positioned inside an object.
+ * \param quick Run fewer iterations.
+ */
+void runPoolAllocationBench(BenchContext& context, JsonWriter& json, bool quick);
+
+/**
+ * \brief Measure allocation throughput of a NonLinearMemoryPool with and without thread cache, while multiple threads
+ * allocate and release buffers at the same time. Writes a "pool_contention" array.
+ * \param context Context.
+ * \param json Writer, positioned inside an object.
+ * \param quick Run fewer iterations.
+ */
+void runPoolContentionBench(BenchContext& context, JsonWriter& json, bool quick);
@@ -0,0 +1,17 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory-bench/bench_context.h"
+#include "sol-memory-bench/json_writer.h"
+
+/**
+ * \brief Measure throughput of single copy transactions through the staging pool for copy sizes from 64 bytes to
+ * 256 MiB, and the latency of committing and waiting on each of them. Writes a "transaction" array.
+ * \param context Context.
+ * \param json Writer, positioned inside an object.
+ * \param quick Run fewer iterations.
+ */
+void runTransactionBench(BenchContext& context, JsonWriter& json, bool quick);
@@ -0,0 +1,156 @@
+#include "sol-memory-bench/bench_context.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_device.h"
+#include "sol-core/vulkan_instance.h"
+#include "sol-core/vulkan_memory_allocator.h"
+#include "sol-core/vulkan_physical_device.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-core/vulkan_queue_family.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/ring_buffer_memory_pool.h"
+#include "sol-memory/transaction_manager.h"
+
+namespace
+{
+    using Features = sol::VulkanPhysicalDeviceFeatures2<sol::VulkanPhysicalDeviceVulkan12Features,
+                                                        sol::VulkanPhysicalDeviceVulkan13Features>;
+
+    std::string deviceTypeToString(const VkPhysicalDeviceType type)
+    {
+        switch (type)
+        {
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated";
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+        default: return "other";
+        }
+    }
+}  // namespace
+
+////////////////////////////////////////////////////////////////
+// Constructors.
+////////////////////////////////////////////////////////////////
+
+BenchContext::BenchContext(const Settings& settings)
+{
+    {
+        sol::VulkanInstance::Settings instanceSettings;
+        instanceSettings.applicationName    = "SolMemoryBench";
+        instanceSettings.applicationVersion = sol::Version(1, 0, 0);
+        instance                            = sol::VulkanInstance::create(instanceSettings);
+    }
+
+    // Only request what sol-memory needs, so that software implementations qualify as well.
+    supportedFeatures = std::make_unique<Features>();
+    enabledFeatures   = std::make_unique<Features>();
+    enabledFeatures->getAs<sol::VulkanPhysicalDeviceVulkan12Features>()->bufferDeviceAddress = VK_TRUE;
+    enabledFeatures->getAs<sol::VulkanPhysicalDeviceVulkan12Features>()->timelineSemaphore   = VK_TRUE;
+    enabledFeatures->getAs<sol::VulkanPhysicalDeviceVulkan13Features>()->synchronization2    = VK_TRUE;
+
+    {
+        sol::VulkanPhysicalDevice::Settings deviceSettings;
+        deviceSettings.instance       = instance;
+        deviceSettings.propertyFilter = [filter = settings.deviceFilter](const VkPhysicalDeviceProperties& props) {
+            return filter.empty() || std::string_view(props.deviceName).find(filter) != std::string_view::npos;
+        };
+        deviceSettings.features      = supportedFeatures.get();
+        deviceSettings.featureFilter = [](sol::RootVulkanPhysicalDeviceFeatures2& features) {
+            if (!features.getAs<sol::VulkanPhysicalDeviceVulkan12Features>()->bufferDeviceAddress) return false;
+            if (!features.getAs<sol::VulkanPhysicalDeviceVulkan12Features>()->timelineSemaphore) return false;
+            if (!features.getAs<sol::VulkanPhysicalDeviceVulkan13Features>()->synchronization2) return false;
+            return true;
+        };
+        deviceSettings.queueFamilyFilter = [](const std::vector<sol::VulkanQueueFamily>& queues) {
+            return std::ranges::any_of(queues, [](const auto& q) { return q.supportsGraphics(); });
+        };
+        physicalDevice = sol::VulkanPhysicalDevice::create(deviceSettings);
+
+        VkPhysicalDeviceProperties props;
+        vkGetPhysicalDeviceProperties(physicalDevice->get(), &props);
+        deviceName = props.deviceName;
+        deviceType = deviceTypeToString(props.deviceType);
+    }
+
+    {
+        sol::VulkanDevice::Settings deviceSettings;
+        deviceSettings.physicalDevice = physicalDevice;
+        deviceSettings.features       = enabledFeatures.get();
+        deviceSettings.queues.resize(physicalDevice->getQueueFamilies().size(), 1);
+        deviceSettings.threadSafeQueues = true;
+        device                          = sol::VulkanDevice::create(deviceSettings);
+    }
+
+    {
+        sol::VulkanMemoryAllocator::Settings allocatorSettings;
+        allocatorSettings.device = *device;
+        allocatorSettings.flags  = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+        memoryManager = std::make_unique<sol::MemoryManager>(sol::VulkanMemoryAllocator::create(allocatorSettings));
+
+        for (auto& queue : device->getQueues())
+        {
+            if (queue->getFamily().supportsCompute()) memoryManager->setComputeQueue(*queue);
+            if (queue->getFamily().supportsGraphics()) memoryManager->setGraphicsQueue(*queue);
+            if (queue->getFamily().supportsDedicatedTransfer())
+            {
+                memoryManager->setTransferQueue(*queue);
+                dedicatedTransfer = true;
+            }
+        }
+        if (!dedicatedTransfer) memoryManager->setTransferQueue(memoryManager->getGraphicsQueue());
+    }
+
+    {
+        const sol::IMemoryPool::CreateInfo info{
+          .createFlags          = 0,
+          .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+          .blockSize       = settings.stagingPoolSize,
+          .minBlocks       = 1,
+          .maxBlocks       = 1};
+        auto& pool         = memoryManager->createRingBufferMemoryPool("bench-staging", info);
+        transactionManager = std::make_unique<sol::TransactionManager>(*memoryManager, pool);
+    }
+}
+
+BenchContext::~BenchContext() noexcept
+{
+    vkDeviceWaitIdle(device->get());
+    transactionManager.reset();
+    memoryManager.reset();
+    device.reset();
+    physicalDevice.reset();
+    enabledFeatures.reset();
+    supportedFeatures.reset();
+    instance.reset();
+}
+
+////////////////////////////////////////////////////////////////
+// Getters.
+////////////////////////////////////////////////////////////////
+
+sol::VulkanDevice& BenchContext::getDevice() const noexcept { return *device; }
+
+sol::MemoryManager& BenchContext::getMemoryManager() const noexcept { return *memoryManager; }
+
+sol::TransactionManager& BenchContext::getTransactionManager() const noexcept { return *transactionManager; }
+
+const std::string& BenchContext::getDeviceName() const noexcept { return deviceName; }
+
+const std::string& BenchContext::getDeviceType() const noexcept { return deviceType; }
+
+bool BenchContext::hasDedicatedTransfer() const noexcept { return dedicatedTransfer; }
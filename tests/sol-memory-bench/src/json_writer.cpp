@@ -0,0 +1,148 @@
+#include "sol-memory-bench/json_writer.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <format>
+
+////////////////////////////////////////////////////////////////
+// Constructors.
+////////////////////////////////////////////////////////////////
+
+JsonWriter::JsonWriter(std::ostream& stream) : out(&stream) {}
+
+JsonWriter::~JsonWriter() noexcept = default;
+
+////////////////////////////////////////////////////////////////
+// Structure.
+////////////////////////////////////////////////////////////////
+
+JsonWriter& JsonWriter::beginObject()
+{
+    prefix();
+    *out << '{';
+    empty.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject()
+{
+    const bool wasEmpty = empty.back();
+    empty.pop_back();
+    if (!wasEmpty) newline();
+    *out << '}';
+    if (empty.empty()) *out << '\n';
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray()
+{
+    prefix();
+    *out << '[';
+    empty.push_back(true);
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray()
+{
+    const bool wasEmpty = empty.back();
+    empty.pop_back();
+    if (!wasEmpty) newline();
+    *out << ']';
+    if (empty.empty()) *out << '\n';
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(const std::string_view name)
+{
+    prefix();
+    writeString(name);
+    *out << ": ";
+    afterKey = true;
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////
+// Values.
+////////////////////////////////////////////////////////////////
+
+JsonWriter& JsonWriter::value(const std::string_view v)
+{
+    prefix();
+    writeString(v);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const char* v) { return value(std::string_view(v)); }
+
+JsonWriter& JsonWriter::value(const bool v)
+{
+    prefix();
+    *out << (v ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const size_t v)
+{
+    prefix();
+    *out << v;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(const double v)
+{
+    prefix();
+    if (std::isfinite(v))
+        *out << std::format("{}", v);
+    else
+        *out << "null";
+    return *this;
+}
+
+////////////////////////////////////////////////////////////////
+// Formatting.
+////////////////////////////////////////////////////////////////
+
+void JsonWriter::prefix()
+{
+    if (afterKey)
+    {
+        afterKey = false;
+        return;
+    }
+
+    if (empty.empty()) return;
+    if (!empty.back()) *out << ',';
+    empty.back() = false;
+    newline();
+}
+
+void JsonWriter::newline()
+{
+    *out << '\n';
+    for (size_t i = 0; i < empty.size(); i++) *out << "    ";
+}
+
+void JsonWriter::writeString(const std::string_view v)
+{
+    *out << '"';
+    for (const char c : v)
+    {
+        switch (c)
+        {
+        case '"': *out << "\\\""; break;
+        case '\\': *out << "\\\\"; break;
+        case '\n': *out << "\\n"; break;
+        case '\r': *out << "\\r"; break;
+        case '\t': *out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                *out << std::format("\\u{:04x}", static_cast<unsigned int>(c));
+            else
+                *out << c;
+        }
+    }
+    *out << '"';
+}
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <chrono>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+////////////////////////////////////////////////////////////////
+// Current target includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory-bench/bench_context.h"
+#include "sol-memory-bench/json_writer.h"
+#include "sol-memory-bench/pool_bench.h"
+#include "sol-memory-bench/transaction_bench.h"
+
+namespace
+{
+    void printUsage()
+    {
+        std::cerr << "Usage: sol-memory-bench [--output <file>] [--device <name>] [--quick]\n"
+                     "  --output <file>  Write results to file instead of stdout.\n"
+                     "  --device <name>  Only use a device whose name contains this string, e.g. llvmpipe.\n"
+                     "  --quick          Run fewer iterations, e.g. for smoke testing.\n";
+    }
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    std::string            output;
+    BenchContext::Settings settings;
+    bool                   quick = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--output" && i + 1 < argc)
+            output = argv[++i];
+        else if (arg == "--device" && i + 1 < argc)
+            settings.deviceFilter = argv[++i];
+        else if (arg == "--quick")
+            quick = true;
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Results are gathered in memory first, so that a failing run does not leave a truncated file behind.
+    std::ostringstream results;
+    try
+    {
+        BenchContext context(settings);
+        JsonWriter   json(results);
+
+        const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+        json.beginObject()
+          .field("version", SOL_VERSION_STRING)
+          .field("timestamp", std::format("{:%FT%TZ}", now))
+          .field("quick", quick);
+        json.key("device")
+          .beginObject()
+          .field("name", context.getDeviceName())
+          .field("type", context.getDeviceType())
+          .field("dedicated_transfer", context.hasDedicatedTransfer())
+          .endObject();
+
+        runPoolAllocationBench(context, json, quick);
+        runPoolContentionBench(context, json, quick);
+        runTransactionBench(context, json, quick);
+
+        json.endObject();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << std::format("Benchmark failed: {}\n", e.what());
+        return 1;
+    }
+
+    if (output.empty())
+        std::cout << results.str();
+    else
+    {
+        std::ofstream file(output);
+        if (!file)
+        {
+            std::cerr << std::format("Cannot open {} for writing.\n", output);
+            return 1;
+        }
+        file << results.str();
+    }
+
+    return 0;
+}
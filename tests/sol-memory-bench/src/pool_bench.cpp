@@ -0,0 +1,195 @@
+#include "sol-memory-bench/pool_bench.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <format>
+#include <iostream>
+#include <latch>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/free_at_once_memory_pool.h"
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/non_linear_memory_pool.h"
+#include "sol-memory/pool/ring_buffer_memory_pool.h"
+#include "sol-memory/pool/stack_memory_pool.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::array<size_t, 4> sizeClasses = {256, 4ull * 1024ull, 64ull * 1024ull, 1024ull * 1024ull};
+
+    constexpr std::array<size_t, 4> threadCounts = {1, 2, 4, 8};
+
+    constexpr sol::IMemoryPool::CreateInfo poolInfo{.createFlags          = 0,
+                                                    .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                    .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                    .requiredMemoryFlags  = 0,
+                                                    .preferredMemoryFlags = 0,
+                                                    .allocationFlags      = 0,
+                                                    .blockSize            = 64ull * 1024ull * 1024ull,
+                                                    .minBlocks            = 1,
+                                                    .maxBlocks            = 1};
+
+    /**
+     * \brief Pool under test and the order in which it requires buffers to be released.
+     */
+    struct PoolCase
+    {
+        const char* name = nullptr;
+
+        sol::IMemoryPool* pool = nullptr;
+
+        /**
+         * \brief If true, buffers are released in reverse order of allocation. Otherwise in order of allocation.
+         */
+        bool releaseReversed = false;
+    };
+
+    double seconds(const Clock::duration d) { return std::chrono::duration<double>(d).count(); }
+
+    void benchPool(const PoolCase& poolCase, const size_t size, const size_t targetAllocations, JsonWriter& json)
+    {
+        // Keep batches well within a single block, so that allocations never fail or wait.
+        const size_t batchSize = std::min<size_t>(256, poolInfo.blockSize / (size * 2));
+        const size_t rounds    = std::max<size_t>(1, targetAllocations / batchSize);
+
+        std::vector<sol::MemoryPoolBufferPtr> batch(batchSize);
+        Clock::duration                       allocTime{};
+        Clock::duration                       freeTime{};
+        for (size_t r = 0; r < rounds; r++)
+        {
+            const auto allocStart = Clock::now();
+            for (auto& buffer : batch)
+                buffer = poolCase.pool->allocateBuffer(size, sol::IBufferAllocator::OnAllocationFailure::Throw);
+            const auto freeStart = Clock::now();
+            if (poolCase.releaseReversed)
+                for (auto& buffer : batch | std::views::reverse) buffer.reset();
+            else
+                for (auto& buffer : batch) buffer.reset();
+            const auto end = Clock::now();
+
+            allocTime += freeStart - allocStart;
+            freeTime += end - freeStart;
+        }
+
+        const size_t count = rounds * batchSize;
+        json.beginObject()
+          .field("pool", poolCase.name)
+          .field("size", size)
+          .field("allocations", count)
+          .field("alloc_per_second", static_cast<double>(count) / seconds(allocTime))
+          .field("free_per_second", static_cast<double>(count) / seconds(freeTime))
+          .field("alloc_ns", seconds(allocTime) * 1e9 / static_cast<double>(count))
+          .field("free_ns", seconds(freeTime) * 1e9 / static_cast<double>(count))
+          .endObject();
+    }
+
+    void benchContention(const char*               name,
+                         sol::NonLinearMemoryPool& pool,
+                         const size_t              threadCount,
+                         const size_t              iterations,
+                         JsonWriter&               json)
+    {
+        std::vector<Clock::time_point> starts(threadCount);
+        std::vector<Clock::time_point> ends(threadCount);
+        std::latch                     ready(static_cast<std::ptrdiff_t>(threadCount));
+        {
+            std::vector<std::jthread> threads;
+            for (size_t t = 0; t < threadCount; t++)
+            {
+                threads.emplace_back([&, t] {
+                    // Keep a small window of live buffers, so that releases happen in a different order than
+                    // allocations.
+                    std::vector<sol::MemoryPoolBufferPtr> live(8);
+                    ready.arrive_and_wait();
+                    starts[t] = Clock::now();
+                    for (size_t i = 0; i < iterations; i++)
+                    {
+                        const size_t size     = size_t{64} << ((i + t) % 5);
+                        live[i % live.size()] =
+                          pool.allocateBuffer(size, sol::IBufferAllocator::OnAllocationFailure::Throw);
+                    }
+                    live.clear();
+                    ends[t] = Clock::now();
+                });
+            }
+        }
+
+        const auto   elapsed = seconds(std::ranges::max(ends) - std::ranges::min(starts));
+        const size_t count   = threadCount * iterations;
+        json.beginObject()
+          .field("pool", name)
+          .field("threads", threadCount)
+          .field("allocations", count)
+          .field("alloc_per_second", static_cast<double>(count) / elapsed)
+          .field("alloc_per_second_per_thread", static_cast<double>(count) / elapsed / static_cast<double>(threadCount))
+          .endObject();
+    }
+}  // namespace
+
+void runPoolAllocationBench(BenchContext& context, JsonWriter& json, const bool quick)
+{
+    auto& manager = context.getMemoryManager();
+
+    auto& cachedPool = manager.createNonLinearMemoryPool("bench-non-linear-cached", poolInfo);
+    cachedPool.setThreadCache(64ull * 1024ull);
+
+    const std::array cases = {
+      PoolCase{.name = "non_linear", .pool = &manager.createNonLinearMemoryPool("bench-non-linear", poolInfo)},
+      PoolCase{.name = "non_linear_thread_cache", .pool = &cachedPool},
+      PoolCase{.name = "free_at_once", .pool = &manager.createFreeAtOnceMemoryPool("bench-free-at-once", poolInfo)},
+      PoolCase{.name            = "stack",
+               .pool            = &manager.createStackMemoryPool("bench-stack", poolInfo),
+               .releaseReversed = true},
+      PoolCase{.name = "ring_buffer", .pool = &manager.createRingBufferMemoryPool("bench-ring-buffer", poolInfo)}};
+
+    const size_t targetAllocations = quick ? 4096 : 65536;
+
+    json.key("pool_allocation").beginArray();
+    for (const auto& poolCase : cases)
+    {
+        for (const auto size : sizeClasses)
+        {
+            std::cerr << std::format("pool_allocation: {} {} bytes\n", poolCase.name, size);
+            benchPool(poolCase, size, targetAllocations, json);
+        }
+    }
+    json.endArray();
+}
+
+void runPoolContentionBench(BenchContext& context, JsonWriter& json, const bool quick)
+{
+    auto& manager = context.getMemoryManager();
+
+    sol::IMemoryPool::CreateInfo info = poolInfo;
+    info.blockSize                    = 16ull * 1024ull * 1024ull;
+    info.maxBlocks                    = 4;
+
+    auto& uncachedPool = manager.createNonLinearMemoryPool("bench-contention", info);
+    auto& cachedPool   = manager.createNonLinearMemoryPool("bench-contention-cached", info);
+    cachedPool.setThreadCache(4096);
+
+    const size_t iterations = quick ? 2000 : 20000;
+
+    json.key("pool_contention").beginArray();
+    for (const auto threadCount : threadCounts)
+    {
+        std::cerr << std::format("pool_contention: {} threads\n", threadCount);
+        benchContention("non_linear", uncachedPool, threadCount, iterations, json);
+        benchContention("non_linear_thread_cache", cachedPool, threadCount, iterations, json);
+    }
+    json.endArray();
+}
@@ -0,0 +1,142 @@
+#include "sol-memory-bench/transaction_bench.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <format>
+#include <iostream>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-error/sol_error.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr size_t minCopySize = 64;
+
+    constexpr size_t maxCopySize = 256ull * 1024ull * 1024ull;
+
+    double microseconds(const Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); }
+
+    /**
+     * \brief Get a percentile of a sorted list of samples, using the nearest rank.
+     * \param sorted Sorted samples. Must not be empty.
+     * \param p Percentile in [0, 1].
+     * \return Sample.
+     */
+    double percentile(const std::vector<double>& sorted, const double p)
+    {
+        const auto rank = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+
+    void writeLatency(JsonWriter& json, std::vector<double> samples)
+    {
+        std::ranges::sort(samples);
+        json.beginObject()
+          .field("min", samples.front())
+          .field("mean", std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size()))
+          .field("p50", percentile(samples, 0.5))
+          .field("p95", percentile(samples, 0.95))
+          .field("p99", percentile(samples, 0.99))
+          .field("max", samples.back())
+          .endObject();
+    }
+
+    void benchCopy(BenchContext& context, const size_t size, const size_t iterations, JsonWriter& json)
+    {
+        auto& transactionManager = context.getTransactionManager();
+
+        const auto dstBuffer = context.getMemoryManager().allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{.size        = size,
+                                                .bufferUsage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                                .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                                                .memoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE},
+          sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+        std::vector<std::byte> data(size);
+        for (size_t i = 0; i < size; i++) data[i] = static_cast<std::byte>(i);
+
+        const sol::StagingBufferCopy copy{.dstBuffer = *dstBuffer, .data = data.data(), .size = size, .offset = 0};
+        const sol::BufferBarrier     barrier{.buffer    = *dstBuffer,
+                                             .srcFamily = nullptr,
+                                             .dstFamily = nullptr,
+                                             .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+                                             .srcAccess = VK_ACCESS_2_NONE,
+                                             .dstAccess = VK_ACCESS_2_MEMORY_READ_BIT};
+
+        std::vector<double> stageTimes;
+        std::vector<double> commitTimes;
+        stageTimes.reserve(iterations);
+        commitTimes.reserve(iterations);
+        Clock::duration total{};
+        size_t          submits = 0;
+
+        // The first iteration is a warm-up and is not measured.
+        for (size_t i = 0; i <= iterations; i++)
+        {
+            const auto start       = Clock::now();
+            const auto transaction = transactionManager.beginTransaction();
+            if (!transaction->stage(copy, barrier, true))
+                throw sol::SolError(std::format("Failed to allocate staging buffer of {} bytes.", size));
+            const auto staged = Clock::now();
+            transaction->commit();
+            transaction->wait();
+            const auto end = Clock::now();
+
+            if (i == 0) continue;
+            stageTimes.push_back(microseconds(staged - start));
+            commitTimes.push_back(microseconds(end - staged));
+            total += end - start;
+            submits = transaction->getStats().submits;
+        }
+
+        const double elapsed = std::chrono::duration<double>(total).count();
+        const double stageTime =
+          std::accumulate(stageTimes.begin(), stageTimes.end(), 0.0) / static_cast<double>(iterations);
+        json.beginObject()
+          .field("size", size)
+          .field("iterations", iterations)
+          .field("submits", submits)
+          .field("mb_per_second", static_cast<double>(size * iterations) / elapsed / 1e6)
+          .field("ops_per_second", static_cast<double>(iterations) / elapsed)
+          .field("stage_us", stageTime);
+        json.key("commit_wait_us");
+        writeLatency(json, std::move(commitTimes));
+        json.endObject();
+    }
+}  // namespace
+
+void runTransactionBench(BenchContext& context, JsonWriter& json, const bool quick)
+{
+    // Aim for a fixed number of bytes per copy size, within limits, so that small copies get enough samples for
+    // stable percentiles and large copies do not take forever.
+    const size_t targetBytes   = quick ? 64ull * 1024ull * 1024ull : 1024ull * 1024ull * 1024ull;
+    const size_t minIterations = quick ? 2 : 4;
+    const size_t maxIterations = quick ? 200 : 2000;
+
+    json.key("transaction").beginArray();
+    for (size_t size = minCopySize; size <= maxCopySize; size *= 4)
+    {
+        const size_t iterations = std::clamp(targetBytes / size, minIterations, maxIterations);
+        std::cerr << std::format("transaction: {} bytes x {}\n", size, iterations);
+        benchCopy(context, size, iterations, json);
+    }
+    json.endArray();
+}
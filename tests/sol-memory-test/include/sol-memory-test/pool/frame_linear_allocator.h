@@ -0,0 +1,23 @@
+#pragma once
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "bettertest/mixins/compare_mixin.h"
+#include "bettertest/mixins/exception_mixin.h"
+#include "bettertest/tests/unit_test.h"
+
+////////////////////////////////////////////////////////////////
+// Test includes.
+////////////////////////////////////////////////////////////////
+
+#include "testutils/utils.h"
+
+class FrameLinearAllocator final
+    : public bt::UnitTest<FrameLinearAllocator, bt::CompareMixin, bt::ExceptionMixin>,
+      BasicFixture
+{
+public:
+    void operator()() override;
+};
@@ -10,16 +10,32 @@
 // Current target includes.
 ////////////////////////////////////////////////////////////////
 
+#include "sol-memory-test/pool/frame_linear_allocator.h"
 #include "sol-memory-test/pool/free_at_once_memory_pool.h"
 #include "sol-memory-test/pool/i_memory_pool.h"
 #include "sol-memory-test/pool/non_linear_memory_pool.h"
+#include "sol-memory-test/pool/pool_statistics.h"
 #include "sol-memory-test/pool/ring_buffer_memory_pool.h"
 #include "sol-memory-test/pool/stack_memory_pool.h"
+#include "sol-memory-test/pool/thread_cache.h"
+#include "sol-memory-test/pool/transient_allocator.h"
+#include "sol-memory-test/transfer_manager/async_commit.h"
+#include "sol-memory-test/transfer_manager/buffer_fill.h"
 #include "sol-memory-test/transfer_manager/concurrent_buffer_transactions.h"
+#include "sol-memory-test/transfer_manager/concurrent_sharing.h"
+#include "sol-memory-test/transfer_manager/copy_coalescing.h"
+#include "sol-memory-test/transfer_manager/defragmentation.h"
+#include "sol-memory-test/transfer_manager/direct_write.h"
+#include "sol-memory-test/transfer_manager/in_flight_transactions.h"
+#include "sol-memory-test/transfer_manager/inline_update.h"
 #include "sol-memory-test/transfer_manager/large_copy.h"
 #include "sol-memory-test/transfer_manager/manual_copy_barrier.h"
 #include "sol-memory-test/transfer_manager/multiple_copies.h"
+#include "sol-memory-test/transfer_manager/parallel_staging_copy.h"
 #include "sol-memory-test/transfer_manager/partial_copy.h"
+#include "sol-memory-test/transfer_manager/residency.h"
+#include "sol-memory-test/transfer_manager/streaming_upload.h"
+#include "sol-memory-test/transfer_manager/upload_scheduler.h"
 
 #ifdef WIN32
 #include "Windows.h"
@@ -38,15 +54,31 @@ int main(int argc, char** argv)
     }
 #endif
     // TODO: Parallel tests are not supported. BetterTest needs an option to always disable them and perhaps even give an error when trying run in parallel.
-    return bt::run<FreeAtOnceMemoryPool,
+    return bt::run<FrameLinearAllocator,
+                   FreeAtOnceMemoryPool,
                    IMemoryPool,
                    NonLinearMemoryPool,
+                   PoolStatistics,
                    RingBufferMemoryPool,
                    StackMemoryPool,
+                   ThreadCache,
+                   TransientAllocator,
 
+                   AsyncCommit,
+                   BufferFill,
                    ConcurrentBufferTransactions,
+                   ConcurrentSharing,
+                   CopyCoalescing,
+                   Defragmentation,
+                   DirectWrite,
+                   InFlightTransactions,
+                   InlineUpdate,
                    LargeCopy,
                    ManualCopyBarrier,
                    MultipleCopies,
-                   PartialCopy>(argc, argv, "sol-memory");
+                   ParallelStagingCopy,
+                   PartialCopy,
+                   Residency,
+                   StreamingUpload,
+                   UploadScheduler>(argc, argv, "sol-memory");
 }
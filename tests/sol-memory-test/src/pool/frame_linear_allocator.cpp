@@ -0,0 +1,102 @@
+#include "sol-memory-test/pool/frame_linear_allocator.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_device.h"
+#include "sol-core/vulkan_timeline_semaphore.h"
+#include "sol-memory/frame_linear_allocator.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/stack_memory_pool.h"
+
+void FrameLinearAllocator::operator()()
+{
+    constexpr size_t frameSize = 64ull * 1024ull;
+
+    sol::StackMemoryPool* pool = nullptr;
+    expectNoThrow([&] {
+        constexpr sol::IMemoryPool::CreateInfo info{
+          .createFlags          = 0,
+          .bufferUsage          = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+          .blockSize       = 1024ull * 1024ull,
+          .minBlocks       = 0,
+          .maxBlocks       = 1};
+        pool = &getMemoryManager().createStackMemoryPool("frameLinear", info);
+    });
+
+    // Invalid parameters.
+    expectThrow([&] { static_cast<void>(sol::FrameLinearAllocator(*pool, frameSize, 0)); });
+
+    const auto allocator = std::make_unique<sol::FrameLinearAllocator>(*pool, frameSize, 2, 256);
+    compareEQ(allocator->getFrameCount(), static_cast<size_t>(2));
+    compareEQ(pool->getStatistics().liveAllocations, static_cast<size_t>(2));
+
+    sol::VulkanTimelineSemaphore::Settings semSettings;
+    semSettings.device   = getDevice();
+    const auto semaphore = sol::VulkanTimelineSemaphore::create(semSettings);
+
+    const auto signal = [&](const uint64_t value) {
+        const VkSemaphoreSignalInfo info{.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SIGNAL_INFO,
+                                         .pNext     = nullptr,
+                                         .semaphore = semaphore->get(),
+                                         .value     = value};
+        vkSignalSemaphore(getDevice().get(), &info);
+    };
+
+    // First frame. Allocations are aligned and bump the head.
+    allocator->beginFrame();
+    compareEQ(allocator->getFrameIndex(), static_cast<size_t>(0));
+    const auto a0 = allocator->allocate(100);
+    const auto a1 = allocator->allocate(4, 16);
+    const auto a2 = allocator->allocate(4, 1024);
+    compareEQ(a0.offset, static_cast<size_t>(0));
+    compareEQ(a1.offset, static_cast<size_t>(256));
+    compareEQ(a2.offset, static_cast<size_t>(1024));
+    compareEQ(allocator->getUsedBytes(), static_cast<size_t>(1028));
+    compareTrue(a0.buffer == &allocator->getBuffer(0));
+
+    constexpr uint32_t value = 0xdeadbeef;
+    std::memcpy(a1.data, &value, sizeof(value));
+    compareEQ(*(allocator->getBuffer(0).getMappedData<uint32_t>() + 64), value);
+
+    // Out of memory.
+    compareFalse(allocator->tryAllocate(frameSize).has_value());
+    expectThrow([&] { static_cast<void>(allocator->allocate(frameSize)); });
+    allocator->endFrame(*semaphore, 1);
+
+    // Second frame uses the other buffer.
+    allocator->beginFrame();
+    compareEQ(allocator->getFrameIndex(), static_cast<size_t>(1));
+    compareEQ(allocator->getUsedBytes(), static_cast<size_t>(0));
+    compareTrue(allocator->allocate(frameSize).buffer == &allocator->getBuffer(1));
+    allocator->endFrame(*semaphore, 2);
+
+    // Back to the first frame, which is reset once its value was signalled.
+    signal(1);
+    allocator->beginFrame();
+    compareEQ(allocator->getFrameIndex(), static_cast<size_t>(0));
+    compareEQ(allocator->getUsedBytes(), static_cast<size_t>(0));
+    compareEQ(allocator->allocate(16).offset, static_cast<size_t>(0));
+    allocator->endFrame(*semaphore, 3);
+
+    signal(3);
+    expectNoThrow([&] { allocator->beginFrame(); });
+
+    // The alignment is raised to the required alignment of the pool.
+    const auto unaligned = std::make_unique<sol::FrameLinearAllocator>(*pool, frameSize, 1, 1);
+    unaligned->beginFrame();
+    static_cast<void>(unaligned->allocate(1));
+    compareEQ(unaligned->allocate(1).offset % pool->getRequiredAlignment(), static_cast<size_t>(0));
+}
@@ -55,6 +55,10 @@ void FreeAtOnceMemoryPool::operator()()
     compareEQ(1024ull * 512, buffers[0]->getBufferSize());
     compareEQ(1024ull * 512, buffers[1]->getBufferSize());
 
+    // Both allocations are suballocated from the same block.
+    compareTrue(&buffers[0]->getBuffer() == &buffers[1]->getBuffer());
+    compareNE(buffers[0]->getBufferOffset(), buffers[1]->getBufferOffset());
+
     // Allocation larger than block size.
     expectThrow([&] {
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 2048ull, .bufferUsage = 0, .alignment = 0};
@@ -92,4 +96,39 @@ void FreeAtOnceMemoryPool::operator()()
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 512ull, .bufferUsage = 0, .alignment = 0};
         static_cast<void>(pool->allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
     });
+
+    // A pool without a block limit keeps creating blocks. Offsets satisfy the alignment required by the block usage.
+    expectNoThrow([&] {
+        constexpr VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+        constexpr sol::IMemoryPool::CreateInfo info{.createFlags          = 0,
+                                                    .bufferUsage          = usage,
+                                                    .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                    .requiredMemoryFlags  = 0,
+                                                    .preferredMemoryFlags = 0,
+                                                    .allocationFlags      = 0,
+                                                    .blockSize            = 1024ull * 1024ull,
+                                                    .minBlocks            = 0,
+                                                    .maxBlocks            = 0};
+        auto& unlimited = memoryManager->createFreeAtOnceMemoryPool("unlimited", info);
+        compareTrue(unlimited.getRequiredAlignment() >= 4);
+
+        // Odd sizes, so that unaligned offsets would follow.
+        constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 262147, .bufferUsage = 0, .alignment = 0};
+        std::vector<sol::MemoryPoolBufferPtr>      unlimitedBuffers;
+        for (size_t i = 0; i < 24; i++)
+        {
+            unlimitedBuffers.emplace_back(
+              unlimited.allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+            compareEQ(0, unlimitedBuffers.back()->getBufferOffset() % unlimited.getRequiredAlignment());
+        }
+
+        // Usage flags that the blocks do not support are rejected.
+        expectThrow([&] {
+            constexpr sol::IMemoryPool::AllocationInfo uniformAlloc{
+              .size = 1024, .bufferUsage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, .alignment = 0};
+            static_cast<void>(
+              unlimited.allocateBuffer(uniformAlloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        });
+    });
 }
@@ -40,7 +40,7 @@ void NonLinearMemoryPool::operator()()
         pool = &memoryManager->createNonLinearMemoryPool("pool", info);
     });
 
-    compareEQ(sol::IMemoryPool::Capabilities::None, pool->getCapabilities());
+    compareEQ(sol::IMemoryPool::Capabilities::Defragmentation, pool->getCapabilities());
 
     // Two allocations of half block size.
     std::vector<sol::MemoryPoolBufferPtr> buffers;
@@ -55,6 +55,10 @@ void NonLinearMemoryPool::operator()()
     compareEQ(1024ull * 512, buffers[0]->getBufferSize());
     compareEQ(1024ull * 512, buffers[1]->getBufferSize());
 
+    // Both allocations are suballocated from the same block.
+    compareTrue(&buffers[0]->getBuffer() == &buffers[1]->getBuffer());
+    compareNE(buffers[0]->getBufferOffset(), buffers[1]->getBufferOffset());
+
     // Allocation larger than block size.
     expectThrow([&] {
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 2048ull, .bufferUsage = 0, .alignment = 0};
@@ -100,4 +104,39 @@ void NonLinearMemoryPool::operator()()
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 32ull, .bufferUsage = 0, .alignment = 0};
         for (size_t i = 0; i < 320; i++) buffers.emplace_back(pool->allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
     });
+
+    // A pool without a block limit keeps creating blocks. Offsets satisfy the alignment required by the block usage.
+    expectNoThrow([&] {
+        constexpr VkBufferUsageFlags usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+        constexpr sol::IMemoryPool::CreateInfo info{.createFlags          = 0,
+                                                    .bufferUsage          = usage,
+                                                    .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                    .requiredMemoryFlags  = 0,
+                                                    .preferredMemoryFlags = 0,
+                                                    .allocationFlags      = 0,
+                                                    .blockSize            = 1024ull * 1024ull,
+                                                    .minBlocks            = 0,
+                                                    .maxBlocks            = 0};
+        auto& unlimited = memoryManager->createNonLinearMemoryPool("unlimited", info);
+        compareTrue(unlimited.getRequiredAlignment() >= 4);
+
+        // Odd sizes, so that unaligned offsets would follow.
+        constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 262147, .bufferUsage = 0, .alignment = 0};
+        std::vector<sol::MemoryPoolBufferPtr>      unlimitedBuffers;
+        for (size_t i = 0; i < 24; i++)
+        {
+            unlimitedBuffers.emplace_back(
+              unlimited.allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+            compareEQ(0, unlimitedBuffers.back()->getBufferOffset() % unlimited.getRequiredAlignment());
+        }
+
+        // Usage flags that the blocks do not support are rejected.
+        expectThrow([&] {
+            constexpr sol::IMemoryPool::AllocationInfo uniformAlloc{
+              .size = 1024, .bufferUsage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, .alignment = 0};
+            static_cast<void>(
+              unlimited.allocateBuffer(uniformAlloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        });
+    });
 }
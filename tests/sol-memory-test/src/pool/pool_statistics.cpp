@@ -0,0 +1,105 @@
+#include "sol-memory-test/pool/pool_statistics.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <bit>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/non_linear_memory_pool.h"
+#include "sol-memory/pool/ring_buffer_memory_pool.h"
+
+void PoolStatistics::operator()()
+{
+    constexpr size_t blockSize = 1024ull * 1024ull;
+
+    constexpr sol::IMemoryPool::CreateInfo info{.createFlags          = 0,
+                                                .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                .requiredMemoryFlags  = 0,
+                                                .preferredMemoryFlags = 0,
+                                                .allocationFlags      = 0,
+                                                .blockSize            = blockSize,
+                                                .minBlocks            = 0,
+                                                .maxBlocks            = 1};
+
+    // Ring buffer pool.
+    {
+        sol::RingBufferMemoryPool* pool = nullptr;
+        expectNoThrow([&] { pool = &getMemoryManager().createRingBufferMemoryPool("statisticsRing", info); });
+
+        auto stats = pool->getStatistics();
+        compareEQ(stats.liveBytes, static_cast<size_t>(0));
+        compareEQ(stats.liveAllocations, static_cast<size_t>(0));
+        compareEQ(pool->getFreeBlockHistogram().largest, blockSize);
+
+        std::vector<sol::MemoryPoolBufferPtr> buffers;
+        for (size_t i = 0; i < 3; i++)
+            buffers.emplace_back(
+              pool->allocateBuffer(blockSize / 4, sol::IBufferAllocator::OnAllocationFailure::Throw));
+
+        stats = pool->getStatistics();
+        compareEQ(stats.liveBytes, 3 * blockSize / 4);
+        compareEQ(stats.liveAllocations, static_cast<size_t>(3));
+        compareEQ(stats.highWatermark, 3 * blockSize / 4);
+        compareEQ(stats.totalAllocations, static_cast<size_t>(3));
+        compareEQ(stats.failedAllocations, static_cast<size_t>(0));
+        compareEQ(stats.blockCount, static_cast<size_t>(1));
+
+        // Does not fit.
+        compareTrue(pool->allocateBuffer(blockSize / 2, sol::IBufferAllocator::OnAllocationFailure::Empty) == nullptr);
+        expectThrow([&] {
+            static_cast<void>(pool->allocateBuffer(blockSize / 2, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        });
+        compareEQ(pool->getStatistics().failedAllocations, static_cast<size_t>(2));
+
+        // Releasing the oldest buffer frees up a second range before the tail.
+        buffers.erase(buffers.begin());
+        stats = pool->getStatistics();
+        compareEQ(stats.liveBytes, blockSize / 2);
+        compareEQ(stats.liveAllocations, static_cast<size_t>(2));
+        compareEQ(stats.highWatermark, 3 * blockSize / 4);
+
+        const auto histogram = pool->getFreeBlockHistogram();
+        compareEQ(histogram.count, static_cast<size_t>(2));
+        compareEQ(histogram.freeBytes, blockSize / 2);
+        compareEQ(histogram.largest, blockSize / 4);
+        compareEQ(histogram.buckets[std::bit_width(blockSize / 4) - 1], static_cast<size_t>(2));
+
+        pool->resetHighWatermark();
+        compareEQ(pool->getStatistics().highWatermark, blockSize / 2);
+
+        buffers.clear();
+        compareEQ(pool->getStatistics().liveBytes, static_cast<size_t>(0));
+    }
+
+    // Non-linear pool.
+    {
+        sol::NonLinearMemoryPool* pool = nullptr;
+        expectNoThrow([&] { pool = &getMemoryManager().createNonLinearMemoryPool("statisticsNonLinear", info); });
+
+        std::vector<sol::MemoryPoolBufferPtr> buffers;
+        for (size_t i = 0; i < 4; i++)
+            buffers.emplace_back(
+              pool->allocateBuffer(blockSize / 8, sol::IBufferAllocator::OnAllocationFailure::Throw));
+
+        // Leave a hole in the middle.
+        buffers.erase(buffers.begin() + 1);
+
+        const auto histogram = pool->getFreeBlockHistogram();
+        compareEQ(histogram.count, static_cast<size_t>(2));
+        compareEQ(histogram.freeBytes, blockSize - 3 * blockSize / 8);
+        compareEQ(histogram.largest, blockSize / 2);
+    }
+
+    // Heap budgets.
+    const auto budgets = getMemoryManager().getHeapBudgets();
+    compareFalse(budgets.empty());
+    for (const auto& budget : budgets) compareTrue(budget.blockBytes <= budget.size);
+}
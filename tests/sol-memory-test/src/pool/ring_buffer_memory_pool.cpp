@@ -61,6 +61,13 @@ void RingBufferMemoryPool::operator()()
     compareEQ(1024ull * 256, buffers[0]->getBufferSize());
     compareEQ(1024ull * 256, buffers[1]->getBufferSize());
 
+    // All allocations are views into the same buffer.
+    compareTrue(&pool->getBuffer() == &buffers[0]->getBuffer());
+    compareTrue(&pool->getBuffer() == &buffers[1]->getBuffer());
+    compareEQ(0ull, buffers[0]->getBufferOffset());
+    compareEQ(1024ull * 256, buffers[1]->getBufferOffset());
+    compareTrue(buffers[0]->isSubAllocation());
+
     // Allocation larger than block size.
     expectThrow([&] {
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 2048ull, .bufferUsage = 0, .alignment = 0};
@@ -83,6 +90,7 @@ void RingBufferMemoryPool::operator()()
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 256ull, .bufferUsage = 0, .alignment = 0};
         buffers[0] = pool->allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw);
     });
+    compareEQ(0ull, buffers[0]->getBufferOffset());
 
     // Clearing the third buffer opens up space, but in the wrong place.
     expectNoThrow([&] { buffers[2].reset(); });
@@ -105,6 +113,17 @@ void RingBufferMemoryPool::operator()()
     // Clear all memory.
     expectNoThrow([&] { buffers.clear(); });
 
+    // Alignments that are not a power of 2 are combined with the required alignment of the pool.
+    expectNoThrow([&] {
+        constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 100, .bufferUsage = 0, .alignment = 12};
+        buffers.emplace_back(pool->allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        buffers.emplace_back(pool->allocateBuffer(alloc, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        compareEQ(0ull, buffers[1]->getBufferOffset() % 12);
+        compareEQ(0ull, buffers[1]->getBufferOffset() % pool->getRequiredAlignment());
+        compareTrue(buffers[1]->getBufferOffset() >= 100);
+        buffers.clear();
+    });
+
     // Fill up memory.
     expectNoThrow([&] {
         constexpr sol::IMemoryPool::AllocationInfo alloc{.size = 1024ull * 128ull, .bufferUsage = 0, .alignment = 0};
@@ -0,0 +1,157 @@
+#include "sol-memory-test/pool/thread_cache.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/non_linear_memory_pool.h"
+
+namespace
+{
+    /**
+     * \brief Check whether the ranges of a list of buffers overlap.
+     * \param buffers Buffers.
+     * \return True if no two buffers share any bytes of the same VkBuffer.
+     */
+    bool disjoint(const std::vector<sol::MemoryPoolBufferPtr>& buffers)
+    {
+        std::vector<std::tuple<const sol::VulkanBuffer*, size_t, size_t>> ranges;
+        for (const auto& buffer : buffers)
+            ranges.emplace_back(&buffer->getBuffer(), buffer->getBufferOffset(), buffer->getBufferSize());
+        std::ranges::sort(ranges);
+        for (size_t i = 1; i < ranges.size(); i++)
+            if (std::get<0>(ranges[i - 1]) == std::get<0>(ranges[i]) &&
+                std::get<1>(ranges[i - 1]) + std::get<2>(ranges[i - 1]) > std::get<1>(ranges[i]))
+                return false;
+        return true;
+    }
+}  // namespace
+
+void ThreadCache::operator()()
+{
+    constexpr sol::IMemoryPool::CreateInfo info{.createFlags          = 0,
+                                                .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                .requiredMemoryFlags  = 0,
+                                                .preferredMemoryFlags = 0,
+                                                .allocationFlags      = 0,
+                                                .blockSize            = 16ull * 1024ull * 1024ull,
+                                                .minBlocks            = 1,
+                                                .maxBlocks            = 4};
+
+    sol::NonLinearMemoryPool* cachedPool = nullptr;
+    expectNoThrow([&] { cachedPool = &getMemoryManager().createNonLinearMemoryPool("threadCache", info); });
+
+    // Invalid parameters.
+    expectThrow([&] { cachedPool->setThreadCache(info.blockSize * 2); });
+    expectThrow([&] { cachedPool->setThreadCache(4096, 0); });
+
+    expectNoThrow([&] { cachedPool->setThreadCache(3000, 16); });
+    compareEQ(cachedPool->getThreadCacheMaxSize(), static_cast<size_t>(4096));
+    compareEQ(cachedPool->getThreadCacheBatchSize(), static_cast<size_t>(16));
+
+    // Cached allocations are rounded up to their size class and aligned to it. Ranges must not overlap.
+    {
+        std::vector<sol::MemoryPoolBufferPtr> buffers;
+        for (size_t i = 0; i < 64; i++)
+            buffers.emplace_back(
+              cachedPool->allocateBuffer(100 + i * 50, sol::IBufferAllocator::OnAllocationFailure::Throw));
+
+        for (const auto& buffer : buffers) compareEQ(buffer->getBufferOffset() % 256, static_cast<size_t>(0));
+        compareTrue(disjoint(buffers));
+        compareEQ(cachedPool->getStatistics().liveAllocations, static_cast<size_t>(64));
+
+        // Thread caches cannot be changed while there are live allocations.
+        expectThrow([&] { cachedPool->setThreadCache(4096, 16); });
+
+        // Allocations larger than the cached size still go through the pool and never overlap cached slots.
+        for (size_t i = 0; i < 16; i++)
+            buffers.emplace_back(
+              cachedPool->allocateBuffer(5000 + i * 300, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        compareEQ(buffers.back()->getBufferSize(), static_cast<size_t>(9500));
+        compareTrue(disjoint(buffers));
+    }
+    compareEQ(cachedPool->getStatistics().liveBytes, static_cast<size_t>(0));
+
+    // Released slots are reused by the same thread.
+    {
+        auto         buffer = cachedPool->allocateBuffer(512, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        const size_t offset = buffer->getBufferOffset();
+        buffer.reset();
+        buffer = cachedPool->allocateBuffer(512, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        compareEQ(buffer->getBufferOffset(), offset);
+    }
+
+    // Growing the thread caches releases the old slots and lets this thread use the new size classes.
+    {
+        const size_t blocks = cachedPool->getBlockCount();
+        expectNoThrow([&] { cachedPool->setThreadCache(16384, 16); });
+        compareEQ(cachedPool->getThreadCacheMaxSize(), static_cast<size_t>(16384));
+
+        std::vector<sol::MemoryPoolBufferPtr> buffers;
+        for (size_t i = 0; i < 64; i++)
+            buffers.emplace_back(
+              cachedPool->allocateBuffer(256 + i * 250, sol::IBufferAllocator::OnAllocationFailure::Throw));
+        compareEQ(buffers.back()->getBufferOffset() % 16384, static_cast<size_t>(0));
+        compareTrue(disjoint(buffers));
+        compareEQ(cachedPool->getBlockCount(), blocks);
+        buffers.clear();
+
+        // Changing the thread caches repeatedly does not leak slots.
+        for (size_t i = 0; i < 64; i++)
+        {
+            expectNoThrow([&] { cachedPool->setThreadCache(16384, 16); });
+            buffers.emplace_back(cachedPool->allocateBuffer(16384, sol::IBufferAllocator::OnAllocationFailure::Throw));
+            buffers.clear();
+        }
+        compareEQ(cachedPool->getBlockCount(), blocks);
+        compareEQ(cachedPool->getFreeBlockHistogram().freeBytes, info.blockSize * blocks - 16ull * 16384ull);
+    }
+
+    // Allocate and release cached and uncached buffers from many threads at once.
+    {
+        constexpr size_t                      threadCount = 8;
+        std::mutex                            mutex;
+        std::vector<sol::MemoryPoolBufferPtr> remaining;
+        {
+            std::vector<std::jthread> threads;
+            for (size_t t = 0; t < threadCount; t++)
+            {
+                threads.emplace_back([&, t] {
+                    // Keep a small window of live buffers, so that releases happen in a different order than
+                    // allocations.
+                    std::vector<sol::MemoryPoolBufferPtr> live(8);
+                    for (size_t i = 0; i < 2000; i++)
+                    {
+                        const size_t size     = size_t{64} << ((i + t) % 8);
+                        live[i % live.size()] =
+                          cachedPool->allocateBuffer(size, sol::IBufferAllocator::OnAllocationFailure::Throw);
+                    }
+
+                    std::scoped_lock lock(mutex);
+                    for (auto& buffer : live) remaining.emplace_back(std::move(buffer));
+                });
+            }
+        }
+
+        // Buffers that were live at the same time on different threads do not overlap.
+        compareEQ(remaining.size(), threadCount * 8);
+        compareTrue(disjoint(remaining));
+        compareEQ(cachedPool->getStatistics().liveAllocations, threadCount * 8);
+
+        remaining.clear();
+        compareEQ(cachedPool->getStatistics().liveAllocations, static_cast<size_t>(0));
+        compareEQ(cachedPool->getStatistics().liveBytes, static_cast<size_t>(0));
+    }
+}
@@ -0,0 +1,84 @@
+#include "sol-memory-test/pool/transient_allocator.h"
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_image.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transient_allocator.h"
+
+void TransientAllocator::operator()()
+{
+    sol::TransientAllocator allocator(getMemoryManager());
+
+    sol::VulkanImage::Settings imageSettings;
+    imageSettings.format     = VK_FORMAT_R8G8B8A8_UNORM;
+    imageSettings.width      = 512;
+    imageSettings.height     = 512;
+    imageSettings.depth      = 1;
+    imageSettings.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+
+    sol::VulkanBuffer::Settings bufferSettings;
+    bufferSettings.size        = 1024ull * 1024ull;
+    bufferSettings.bufferUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+
+    // Invalid lifetime.
+    expectThrow([&] { static_cast<void>(allocator.addImage(imageSettings, 2, 1)); });
+
+    // Resources that are used as a chain of passes. a and c can share memory, as can b and d.
+    size_t a = 0, b = 0, c = 0, d = 0, e = 0;
+    expectNoThrow([&] {
+        a = allocator.addImage(imageSettings, 0, 1);
+        b = allocator.addImage(imageSettings, 1, 2);
+        c = allocator.addImage(imageSettings, 2, 3);
+        d = allocator.addImage(imageSettings, 3, 4);
+        e = allocator.addBuffer(bufferSettings, 0, 4);
+    });
+    compareEQ(allocator.getResourceCount(), static_cast<size_t>(5));
+
+    // Resources are not placed yet.
+    expectThrow([&] { static_cast<void>(allocator.getOffset(a)); });
+    expectThrow([&] { static_cast<void>(allocator.getBuffer(a)); });
+    expectThrow([&] { static_cast<void>(allocator.getImage(e)); });
+
+    expectNoThrow([&] { allocator.allocate(); });
+    compareTrue(allocator.isAllocated());
+    expectThrow([&] { allocator.allocate(); });
+    expectThrow([&] { static_cast<void>(allocator.addBuffer(bufferSettings, 0, 0)); });
+
+    // Resources with overlapping lifetimes in the same heap must not overlap in memory.
+    const auto overlaps = [&](const size_t lhs, const size_t rhs) {
+        if (allocator.getHeapIndex(lhs) != allocator.getHeapIndex(rhs)) return false;
+        const size_t lhsEnd = allocator.getOffset(lhs) + allocator.getImage(lhs).getMemoryRequirements().size;
+        const size_t rhsEnd = allocator.getOffset(rhs) + allocator.getImage(rhs).getMemoryRequirements().size;
+        return allocator.getOffset(lhs) < rhsEnd && allocator.getOffset(rhs) < lhsEnd;
+    };
+    compareFalse(overlaps(a, b));
+    compareFalse(overlaps(b, c));
+    compareFalse(overlaps(c, d));
+
+    // Two images worth of memory is enough for all four images.
+    const auto& stats      = allocator.getStatistics();
+    const auto  imageSize  = allocator.getImage(a).getMemoryRequirements().size;
+    const auto  bufferSize = allocator.getBuffer(e).getMemoryRequirements().size;
+    compareEQ(stats.dedicatedBytes, static_cast<size_t>(4 * imageSize + bufferSize));
+    compareTrue(stats.savedBytes >= 2 * imageSize - bufferSize);
+    compareEQ(stats.savedBytes, stats.dedicatedBytes - stats.heapBytes);
+    compareEQ(stats.lazyHeapCount, static_cast<size_t>(0));
+
+    allocator.reset();
+    compareFalse(allocator.isAllocated());
+    compareEQ(allocator.getResourceCount(), static_cast<size_t>(0));
+
+    // Transient attachments.
+    imageSettings.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+    expectNoThrow([&] {
+        static_cast<void>(allocator.addImage(imageSettings, 0, 0));
+        static_cast<void>(allocator.addImage(imageSettings, 1, 1));
+        allocator.allocate();
+    });
+    compareEQ(allocator.getOffset(0), allocator.getOffset(1));
+    compareEQ(allocator.getStatistics().savedBytes, allocator.getImage(0).getMemoryRequirements().size);
+}
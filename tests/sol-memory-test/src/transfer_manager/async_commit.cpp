@@ -0,0 +1,118 @@
+#include "sol-memory-test/transfer_manager/async_commit.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_handle.h"
+#include "sol-memory/transaction_manager.h"
+
+void AsyncCommit::operator()()
+{
+    constexpr uint32_t elementCount = 4096;
+    constexpr size_t   bufferCount  = 4;
+
+    std::vector<std::vector<uint32_t>> data;
+    for (size_t i = 0; i < bufferCount; i++)
+        data.emplace_back(std::views::iota(static_cast<uint32_t>(i * elementCount)) | std::views::take(elementCount) |
+                          std::ranges::to<std::vector<uint32_t>>());
+
+    // Allocate a number of buffers.
+    std::vector<sol::IBufferPtr> buffers;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        for (size_t i = 0; i < bufferCount; i++)
+            buffers.emplace_back(
+              getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw));
+    });
+
+    // Commit a transaction per buffer without waiting. Transactions are destroyed right away.
+    size_t                              completed = 0;
+    std::vector<sol::TransactionHandle> handles;
+    expectNoThrow([&] {
+        for (size_t i = 0; i < bufferCount; i++)
+        {
+            const auto                   transaction = getTransferManager().beginTransaction();
+            const sol::StagingBufferCopy copy{
+              .dstBuffer = *buffers[i], .data = data[i].data(), .size = VK_WHOLE_SIZE, .offset = 0};
+            const sol::BufferBarrier barrier{.buffer    = *buffers[i],
+                                             .srcFamily = nullptr,
+                                             .dstFamily = nullptr,
+                                             .srcStage  = 0,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                             .srcAccess = 0,
+                                             .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+            compareTrue(transaction->stage(copy, barrier));
+            auto handle = transaction->commitAsync();
+            handle.onComplete([&completed] { completed++; });
+            handles.emplace_back(std::move(handle));
+        }
+    });
+
+    // Poll until all transactions have completed.
+    expectNoThrow([&] {
+        while (!std::ranges::all_of(handles, [](auto& handle) { return handle.isComplete(); }))
+        {
+        }
+    });
+    compareEQ(completed, bufferCount);
+
+    // Registering a callback on a completed transaction invokes it immediately.
+    handles.front().onComplete([&completed] { completed++; });
+    compareEQ(completed, bufferCount + 1);
+
+    // Nothing is left to poll.
+    compareEQ(getTransferManager().poll(), static_cast<size_t>(0));
+
+    // Compare.
+    std::vector<uint32_t> dstData(elementCount);
+    for (size_t i = 0; i < bufferCount; i++)
+    {
+        memcpy(dstData.data(), buffers[i]->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+        compareEQ(data[i], dstData);
+    }
+
+    // Waiting on a transaction that was committed asynchronously still invalidates host visible destinations.
+    expectNoThrow([&] {
+        const std::vector<uint32_t> reversed(data[0].rbegin(), data[0].rend());
+
+        const auto                   transaction = getTransferManager().beginTransaction();
+        const sol::StagingBufferCopy copy{
+          .dstBuffer = *buffers[0], .data = reversed.data(), .size = VK_WHOLE_SIZE, .offset = 0};
+        const sol::BufferBarrier barrier{.buffer    = *buffers[0],
+                                         .srcFamily = nullptr,
+                                         .dstFamily = nullptr,
+                                         .srcStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                         .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                         .srcAccess = VK_ACCESS_2_HOST_READ_BIT,
+                                         .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+        compareTrue(transaction->stage(copy, barrier));
+        auto handle = transaction->commitAsync();
+        transaction->wait();
+        compareTrue(handle.isComplete());
+
+        memcpy(dstData.data(), buffers[0]->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+        compareEQ(reversed, dstData);
+    });
+}
@@ -0,0 +1,111 @@
+#include "sol-memory-test/transfer_manager/buffer_fill.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void BufferFill::operator()()
+{
+    constexpr uint32_t elementCount = 1024;
+    constexpr uint32_t fillValue    = 0xDEADBEEF;
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Create a host visible buffer, so that results can be checked without a download.
+    sol::IBufferPtr buffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+
+    const auto readBack = [&] {
+        buffer->getBuffer().invalidate(buffer->getBufferOffset(), sizeof(uint32_t) * elementCount);
+        std::vector<uint32_t> dstData(elementCount);
+        std::memcpy(dstData.data(),
+                    buffer->getBuffer().getMappedData<std::byte>() + buffer->getBufferOffset(),
+                    sizeof(uint32_t) * elementCount);
+        return dstData;
+    };
+
+    const sol::BufferBarrier barrier{.buffer    = *buffer,
+                                     .srcFamily = nullptr,
+                                     .dstFamily = nullptr,
+                                     .srcStage  = 0,
+                                     .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                     .srcAccess = 0,
+                                     .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+
+    // Fill the whole buffer and overwrite the second half with a copy. Fills are recorded before copies.
+    expectNoThrow([&] {
+        std::memset(buffer->getBuffer().getMappedData<std::byte>() + buffer->getBufferOffset(),
+                    0,
+                    sizeof(uint32_t) * elementCount);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->stage(sol::BufferFill{.dstBuffer = *buffer, .data = fillValue}, barrier);
+        const sol::StagingBufferCopy copy{.dstBuffer = *buffer,
+                                          .data      = data.data(),
+                                          .size      = sizeof(uint32_t) * elementCount / 2,
+                                          .offset    = sizeof(uint32_t) * elementCount / 2};
+        compareTrue(transaction->stage(copy, barrier));
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.fills, static_cast<size_t>(1));
+        compareEQ(stats.stagedCopies, static_cast<size_t>(1));
+
+        std::vector<uint32_t> expected(elementCount, fillValue);
+        std::ranges::copy(data | std::views::take(elementCount / 2), expected.begin() + elementCount / 2);
+        compareEQ(expected, readBack());
+    });
+
+    // Fill a range in the middle of the buffer.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->stage(sol::BufferFill{.dstBuffer = *buffer,
+                                           .data      = 0,
+                                           .size      = sizeof(uint32_t) * 16,
+                                           .offset    = sizeof(uint32_t) * 8},
+                           barrier);
+        transaction->commit();
+        transaction->wait();
+
+        std::vector<uint32_t> expected(elementCount, fillValue);
+        std::ranges::copy(data | std::views::take(elementCount / 2), expected.begin() + elementCount / 2);
+        std::fill_n(expected.begin() + 8, 16, 0u);
+        compareEQ(expected, readBack());
+    });
+
+    // Size and offset must be multiples of 4.
+    expectThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->stage(sol::BufferFill{.dstBuffer = *buffer, .data = 0, .size = 6, .offset = 0});
+    });
+    expectThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->stage(sol::BufferFill{.dstBuffer = *buffer, .data = 0, .size = 8, .offset = 2});
+    });
+}
@@ -0,0 +1,145 @@
+#include "sol-memory-test/transfer_manager/concurrent_sharing.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/non_linear_memory_pool.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void ConcurrentSharing::operator()()
+{
+    constexpr uint32_t elementCount = 1024 * 64;
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Resources are only concurrent if there is more than one queue family to share them with.
+    const bool concurrent = getMemoryManager().getQueueFamilyIndices().size() > 1;
+
+    sol::IBufferPtr buffer;
+    sol::IBufferPtr hostBuffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_CONCURRENT,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = 0,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+        constexpr sol::IBufferAllocator::AllocationInfo hostInfo{
+          .size                 = sizeof(uint32_t) * elementCount,
+          .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        hostBuffer = getMemoryManager().allocateBuffer(hostInfo, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+    compareEQ(concurrent, buffer->isConcurrent());
+    compareFalse(hostBuffer->isConcurrent());
+
+    // Upload to the buffer. Without ownership transfers, all barriers are recorded in the copy command buffer.
+    expectNoThrow([&] {
+        const auto&                 family = buffer->getQueueFamily();
+        const sol::IBuffer::Barrier barrier{.dstFamily = &getMemoryManager().getGraphicsQueue().getFamily(),
+                                            .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                            .dstStage  = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                                            .srcAccess = VK_ACCESS_2_NONE,
+                                            .dstAccess = VK_ACCESS_2_SHADER_STORAGE_READ_BIT};
+
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(buffer->setData(*transaction, data.data(), sizeof(uint32_t) * elementCount, 0, barrier, false));
+        transaction->commit();
+        transaction->wait();
+
+        if (concurrent)
+        {
+            compareEQ(transaction->getStats().submits, static_cast<size_t>(1));
+            compareEQ(&family, &buffer->getQueueFamily());
+        }
+    });
+
+    // Download again and compare.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        buffer->getData(*transaction,
+                        *hostBuffer,
+                        sol::IBuffer::Barrier{.dstFamily = nullptr,
+                                              .srcStage  = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                                              .dstStage  = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+                                              .srcAccess = VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+                                              .dstAccess = VK_ACCESS_2_SHADER_STORAGE_READ_BIT},
+                        sol::IBuffer::Barrier{.dstFamily = nullptr,
+                                              .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                              .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                              .srcAccess = VK_ACCESS_2_NONE,
+                                              .dstAccess = VK_ACCESS_2_HOST_READ_BIT},
+                        sizeof(uint32_t) * elementCount,
+                        0,
+                        0);
+        transaction->commit();
+        transaction->wait();
+
+        hostBuffer->getBuffer().invalidate(hostBuffer->getBufferOffset(), sizeof(uint32_t) * elementCount);
+        std::vector<uint32_t> dstData(elementCount);
+        std::memcpy(dstData.data(),
+                    hostBuffer->getBuffer().getMappedData<std::byte>() + hostBuffer->getBufferOffset(),
+                    sizeof(uint32_t) * elementCount);
+        compareEQ(data, dstData);
+    });
+
+    // Memory pools create all their buffers with the same sharing mode.
+    expectNoThrow([&] {
+        constexpr sol::IMemoryPool::CreateInfo info{.createFlags          = 0,
+                                                    .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                    .sharingMode          = VK_SHARING_MODE_CONCURRENT,
+                                                    .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+                                                    .requiredMemoryFlags  = 0,
+                                                    .preferredMemoryFlags = 0,
+                                                    .allocationFlags      = 0,
+                                                    .blockSize            = 1024ull * 1024ull,
+                                                    .minBlocks            = 0,
+                                                    .maxBlocks            = 1};
+        auto& pool = getMemoryManager().createNonLinearMemoryPool("concurrent-sharing", info);
+        compareEQ(VK_SHARING_MODE_CONCURRENT, pool.getSharingMode());
+
+        const auto poolBuffer = pool.allocateBuffer(1024, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        compareEQ(concurrent, poolBuffer->isConcurrent());
+    });
+
+    // An exclusive pool cannot hand out concurrent buffers.
+    expectThrow([&] {
+        auto& pool = getMemoryManager().createNonLinearMemoryPool(
+          "exclusive-sharing",
+          sol::IMemoryPool::CreateInfo{.bufferUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                       .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+                                       .memoryUsage = VMA_MEMORY_USAGE_AUTO,
+                                       .blockSize   = 1024ull * 1024ull,
+                                       .maxBlocks   = 1});
+        static_cast<void>(pool.allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{.size        = 1024,
+                                                .bufferUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                                .sharingMode = VK_SHARING_MODE_CONCURRENT,
+                                                .memoryUsage = VMA_MEMORY_USAGE_AUTO},
+          sol::IBufferAllocator::OnAllocationFailure::Throw));
+    });
+}
@@ -0,0 +1,123 @@
+#include "sol-memory-test/transfer_manager/copy_coalescing.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void CopyCoalescing::operator()()
+{
+    constexpr uint32_t elementCount = 1024;
+    constexpr uint32_t chunkCount   = 64;
+    constexpr uint32_t chunkSize    = elementCount / chunkCount;
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Create equally sized buffers.
+    sol::IBufferPtr srcBuffer, dstBuffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        srcBuffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        dstBuffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+
+    // Transfer data to srcBuffer in many small chunks. All staging buffers come from the same ring buffer, so all
+    // copies should end up in a single command, and all barriers should be merged into one before and one after.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->setNarrowBarriers(true);
+        const sol::BufferBarrier barrier{.buffer    = *srcBuffer,
+                                         .srcFamily = nullptr,
+                                         .dstFamily = nullptr,
+                                         .srcStage  = 0,
+                                         .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                         .srcAccess = 0,
+                                         .dstAccess = VK_ACCESS_2_TRANSFER_READ_BIT};
+        for (uint32_t i = 0; i < chunkCount; i++)
+        {
+            const sol::StagingBufferCopy copy{.dstBuffer = *srcBuffer,
+                                              .data      = data.data() + i * chunkSize,
+                                              .size      = sizeof(uint32_t) * chunkSize,
+                                              .offset    = sizeof(uint32_t) * i * chunkSize};
+            compareTrue(transaction->stage(copy, barrier));
+        }
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.stagedCopies, static_cast<size_t>(chunkCount));
+        compareEQ(stats.copyCommands, static_cast<size_t>(1));
+        compareEQ(stats.copyRegions, static_cast<size_t>(chunkCount));
+        compareEQ(stats.bufferBarriers, static_cast<size_t>(2));
+        compareEQ(stats.barrierCommands, static_cast<size_t>(2));
+    });
+
+    // Copy the chunks in reverse order from srcBuffer to dstBuffer. Should again be a single command.
+    expectNoThrow([&] {
+        const auto               transaction = getTransferManager().beginTransaction();
+        const sol::BufferBarrier srcBarrier{.buffer    = *srcBuffer,
+                                            .srcFamily = nullptr,
+                                            .dstFamily = nullptr,
+                                            .srcStage  = 0,
+                                            .dstStage  = 0,
+                                            .srcAccess = 0,
+                                            .dstAccess = 0};
+        const sol::BufferBarrier dstBarrier{.buffer    = *dstBuffer,
+                                            .srcFamily = nullptr,
+                                            .dstFamily = nullptr,
+                                            .srcStage  = 0,
+                                            .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                            .srcAccess = 0,
+                                            .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+        for (uint32_t i = 0; i < chunkCount; i++)
+        {
+            const sol::BufferToBufferCopy copy{.srcBuffer              = *srcBuffer,
+                                               .dstBuffer              = *dstBuffer,
+                                               .size                   = sizeof(uint32_t) * chunkSize,
+                                               .srcOffset              = sizeof(uint32_t) * i * chunkSize,
+                                               .dstOffset              = sizeof(uint32_t) * (chunkCount - i - 1) * chunkSize,
+                                               .srcOnDedicatedTransfer = false,
+                                               .dstOnDedicatedTransfer = false};
+            transaction->stage(copy, srcBarrier, dstBarrier);
+        }
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.copyCommands, static_cast<size_t>(1));
+        compareEQ(stats.copyRegions, static_cast<size_t>(chunkCount));
+    });
+
+    // Compare.
+    std::vector<uint32_t> dstData(elementCount);
+    memcpy(dstData.data(), srcBuffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+    compareEQ(data, dstData);
+    memcpy(dstData.data(), dstBuffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+    for (uint32_t i = 0; i < chunkCount; i++)
+    {
+        const auto expected = std::vector(data.begin() + i * chunkSize, data.begin() + (i + 1) * chunkSize);
+        const auto actual   = std::vector(dstData.begin() + (chunkCount - i - 1) * chunkSize,
+                                        dstData.begin() + (chunkCount - i) * chunkSize);
+        compareEQ(expected, actual);
+    }
+}
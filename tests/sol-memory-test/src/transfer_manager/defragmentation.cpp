@@ -0,0 +1,108 @@
+#include "sol-memory-test/transfer_manager/defragmentation.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/pool/memory_pool_buffer.h"
+#include "sol-memory/pool/non_linear_memory_pool.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void Defragmentation::operator()()
+{
+    // 256KiB.
+    constexpr uint32_t count       = 1024 * 64;
+    constexpr size_t   bufferCount = 8;
+
+    // Create a memory pool with 4 blocks of 1MiB.
+    sol::NonLinearMemoryPool* pool = nullptr;
+    expectNoThrow([&] {
+        constexpr sol::IMemoryPool::CreateInfo info{
+          .createFlags = 0,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .blockSize       = 1024ull * 1024ull,
+          .minBlocks       = 0,
+          .maxBlocks       = 4};
+        pool = &getMemoryManager().createNonLinearMemoryPool("defragmentation", info);
+    });
+
+    // Fill 2 blocks with buffers.
+    std::vector<std::vector<uint32_t>>    data;
+    std::vector<sol::MemoryPoolBufferPtr> buffers;
+    size_t                                relocations = 0;
+    expectNoThrow([&] {
+        for (size_t i = 0; i < bufferCount; i++)
+        {
+            auto& d = data.emplace_back(std::views::iota(static_cast<uint32_t>(i * count)) | std::views::take(count) |
+                                        std::ranges::to<std::vector<uint32_t>>());
+            auto& b = buffers.emplace_back(
+              pool->allocateBuffer(sizeof(uint32_t) * count, sol::IBufferAllocator::OnAllocationFailure::Throw));
+            b->getBuffer().setData(d.data(), sizeof(uint32_t) * count, b->getBufferOffset());
+            b->setRelocationCallback([&](sol::MemoryPoolBuffer&) { relocations++; });
+        }
+    });
+    compareEQ(static_cast<size_t>(2), pool->getBlockCount());
+
+    // Create holes in both blocks.
+    for (size_t i = 0; i < bufferCount; i += 2) buffers[i].reset();
+    const auto statsBefore = pool->getStatistics();
+
+    // Defragment with a limit of a single buffer.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        const auto stats       = pool->beginDefragmentation(*transaction, sizeof(uint32_t) * count);
+        compareEQ(static_cast<size_t>(1), stats.allocationsMoved);
+        compareEQ(sizeof(uint32_t) * count, stats.bytesMoved);
+        compareTrue(pool->isDefragmenting());
+        transaction->commit();
+        transaction->wait();
+        pool->endDefragmentation();
+    });
+    compareEQ(static_cast<size_t>(1), relocations);
+    compareFalse(pool->isDefragmenting());
+
+    // Defragment without limit. Should empty the second block completely.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        static_cast<void>(pool->beginDefragmentation(*transaction));
+        transaction->commit();
+        transaction->wait();
+        pool->endDefragmentation();
+    });
+    compareEQ(static_cast<size_t>(2), relocations);
+    compareEQ(static_cast<size_t>(1), pool->getBlockCount());
+
+    // Temporary buffers of the moves are not counted.
+    const auto statsAfter = pool->getStatistics();
+    compareEQ(statsBefore.liveBytes, statsAfter.liveBytes);
+    compareEQ(statsBefore.liveAllocations, statsAfter.liveAllocations);
+    compareEQ(statsBefore.totalAllocations, statsAfter.totalAllocations);
+    compareEQ(statsBefore.highWatermark, statsAfter.highWatermark);
+
+    // Compare.
+    std::vector<uint32_t> dstData(count);
+    for (size_t i = 1; i < bufferCount; i += 2)
+    {
+        std::memcpy(dstData.data(),
+                    buffers[i]->getBuffer().getMappedData<uint8_t>() + buffers[i]->getBufferOffset(),
+                    sizeof(uint32_t) * count);
+        compareEQ(data[i], dstData);
+    }
+
+    buffers.clear();
+}
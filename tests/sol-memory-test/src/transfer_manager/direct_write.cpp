@@ -0,0 +1,141 @@
+#include "sol-memory-test/transfer_manager/direct_write.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void DirectWrite::operator()()
+{
+    constexpr uint32_t elementCount = 1024;
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Create a host visible buffer.
+    sol::IBufferPtr buffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+    compareTrue(buffer->getBuffer().isHostVisible());
+
+    const sol::BufferBarrier barrier{.buffer    = *buffer,
+                                     .srcFamily = nullptr,
+                                     .dstFamily = nullptr,
+                                     .srcStage  = 0,
+                                     .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                     .srcAccess = 0,
+                                     .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+
+    // Write the whole buffer, followed by a partial write of the second half, in reverse.
+    expectNoThrow([&] {
+        std::memset(buffer->getBuffer().getMappedData<uint32_t>(), 0, sizeof(uint32_t) * elementCount);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->setDirectWrite(true);
+
+        const sol::StagingBufferCopy copy0{.dstBuffer = *buffer, .data = data.data(), .size = VK_WHOLE_SIZE};
+        compareTrue(transaction->stage(copy0, barrier));
+
+        const auto                   reversed = data | std::views::reverse | std::ranges::to<std::vector<uint32_t>>();
+        const sol::StagingBufferCopy copy1{.dstBuffer = *buffer,
+                                           .data      = reversed.data(),
+                                           .size      = sizeof(uint32_t) * elementCount / 2,
+                                           .offset    = sizeof(uint32_t) * elementCount / 2};
+        compareTrue(transaction->stage(copy1, barrier));
+
+        // Data is written during staging.
+        compareEQ(0, std::memcmp(buffer->getBuffer().getMappedData<uint32_t>(), data.data(), copy1.offset));
+        compareEQ(0,
+                  std::memcmp(buffer->getBuffer().getMappedData<uint32_t>() + elementCount / 2,
+                              reversed.data(),
+                              copy1.size));
+
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.directWrites, static_cast<size_t>(2));
+        compareEQ(stats.stagedCopies, static_cast<size_t>(0));
+        compareEQ(stats.copyCommands, static_cast<size_t>(0));
+    });
+
+    // Direct writes are disabled by default, so the same copy goes through a staging buffer.
+    expectNoThrow([&] {
+        std::memset(buffer->getBuffer().getMappedData<uint32_t>(), 0, sizeof(uint32_t) * elementCount);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        compareFalse(transaction->getDirectWrite());
+        compareTrue(transaction->isEmpty());
+
+        const sol::StagingBufferCopy copy{.dstBuffer = *buffer, .data = data.data(), .size = VK_WHOLE_SIZE};
+        compareTrue(transaction->stage(copy, barrier));
+        compareFalse(transaction->isEmpty());
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.directWrites, static_cast<size_t>(0));
+        compareEQ(stats.stagedCopies, static_cast<size_t>(1));
+        compareEQ(stats.copyCommands, static_cast<size_t>(1));
+
+        std::vector<uint32_t> dstData(elementCount);
+        std::memcpy(dstData.data(), buffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+        compareEQ(data, dstData);
+    });
+
+    // A copy whose barrier transfers ownership cannot be released after a host write and goes through a staging
+    // buffer, even with direct writes enabled.
+    if (const auto& compute = getMemoryManager().getComputeQueue().getFamily(); &compute != &buffer->getQueueFamily())
+    {
+        expectNoThrow([&] {
+            std::memset(buffer->getBuffer().getMappedData<uint32_t>(), 0, sizeof(uint32_t) * elementCount);
+
+            const auto transaction = getTransferManager().beginTransaction();
+            transaction->setDirectWrite(true);
+
+            const sol::StagingBufferCopy copy{.dstBuffer = *buffer, .data = data.data(), .size = VK_WHOLE_SIZE};
+            const sol::BufferBarrier     release{.buffer    = *buffer,
+                                                 .srcFamily = nullptr,
+                                                 .dstFamily = &compute,
+                                                 .srcStage  = 0,
+                                                 .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                                 .srcAccess = 0,
+                                                 .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+            compareTrue(transaction->stage(copy, release));
+            transaction->commit();
+            transaction->wait();
+
+            const auto& stats = transaction->getStats();
+            compareEQ(stats.directWrites, static_cast<size_t>(0));
+            compareEQ(stats.stagedCopies, static_cast<size_t>(1));
+            compareEQ(&compute, &buffer->getQueueFamily());
+
+            std::vector<uint32_t> dstData(elementCount);
+            std::memcpy(
+              dstData.data(), buffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+            compareEQ(data, dstData);
+        });
+    }
+}
@@ -0,0 +1,84 @@
+#include "sol-memory-test/transfer_manager/in_flight_transactions.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void InFlightTransactions::operator()()
+{
+    constexpr uint32_t count       = 4096;
+    constexpr size_t   bufferCount = 8;
+
+    compareEQ(static_cast<size_t>(2), getTransferManager().getSlotCount());
+
+    std::vector<std::vector<uint32_t>> data;
+    for (size_t i = 0; i < bufferCount; i++)
+        data.emplace_back(std::views::iota(static_cast<uint32_t>(i * count)) | std::views::take(count) |
+                          std::ranges::to<std::vector<uint32_t>>());
+
+    // Allocate a number of buffers.
+    std::vector<sol::IBufferPtr> buffers;
+    expectNoThrow([&] {
+        const sol::IBufferAllocator::AllocationInfo info{
+          .size        = sizeof(uint32_t) * count,
+          .bufferUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+          .alignment       = 0};
+        for (size_t i = 0; i < bufferCount; i++)
+            buffers.emplace_back(
+              getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw));
+    });
+
+    // Commit a transaction per buffer without waiting in between. Commits after the first slotCount
+    // transactions will reuse the slot of the oldest transaction.
+    std::vector<sol::BufferTransactionPtr> transactions;
+    expectNoThrow([&] {
+        for (size_t i = 0; i < bufferCount; i++)
+        {
+            auto                         transaction = getTransferManager().beginTransaction();
+            const sol::StagingBufferCopy copy{
+              .dstBuffer = *buffers[i], .data = data[i].data(), .size = VK_WHOLE_SIZE, .offset = 0};
+            const sol::BufferBarrier barrier{.buffer    = *buffers[i],
+                                             .srcFamily = nullptr,
+                                             .dstFamily = nullptr,
+                                             .srcStage  = 0,
+                                             .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                             .srcAccess = 0,
+                                             .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+            compareTrue(transaction->stage(copy, barrier));
+            transaction->commit();
+            transactions.emplace_back(std::move(transaction));
+        }
+    });
+
+    // Wait in reverse order of submission. Destroy some transactions without waiting on them.
+    expectNoThrow([&] {
+        for (auto& transaction : transactions | std::views::reverse | std::views::take(bufferCount / 2))
+            transaction->wait();
+        transactions.clear();
+    });
+
+    // Compare. All transactions before the last one must also be done once the last one completes.
+    std::vector<uint32_t> dstData(count);
+    for (size_t i = 0; i < bufferCount; i++)
+    {
+        memcpy(dstData.data(), buffers[i]->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * count);
+        compareEQ(data[i], dstData);
+    }
+}
@@ -0,0 +1,146 @@
+#include "sol-memory-test/transfer_manager/inline_update.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_command_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/buffer_update_list.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void InlineUpdate::operator()()
+{
+    constexpr uint32_t elementCount = 1024;
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Create a host visible buffer, so that results can be checked without a download.
+    sol::IBufferPtr buffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+
+    const auto readBack = [&] {
+        buffer->getBuffer().invalidate(buffer->getBufferOffset(), sizeof(uint32_t) * elementCount);
+        std::vector<uint32_t> dstData(elementCount);
+        std::memcpy(dstData.data(),
+                    buffer->getBuffer().getMappedData<std::byte>() + buffer->getBufferOffset(),
+                    sizeof(uint32_t) * elementCount);
+        return dstData;
+    };
+
+    const sol::BufferBarrier barrier{.buffer    = *buffer,
+                                     .srcFamily = nullptr,
+                                     .dstFamily = nullptr,
+                                     .srcStage  = 0,
+                                     .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                     .srcAccess = 0,
+                                     .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+
+    // Small copies are recorded inline on the queue that owns the buffer, in a single submit.
+    expectNoThrow([&] {
+        std::memset(buffer->getBuffer().getMappedData<std::byte>() + buffer->getBufferOffset(),
+                    0,
+                    sizeof(uint32_t) * elementCount);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->setInlineUpdates(true);
+
+        const sol::StagingBufferCopy copy0{
+          .dstBuffer = *buffer, .data = data.data(), .size = sizeof(uint32_t) * elementCount / 2, .offset = 0};
+        const sol::StagingBufferCopy copy1{.dstBuffer = *buffer,
+                                           .data      = data.data() + elementCount / 2,
+                                           .size      = sizeof(uint32_t) * elementCount / 2,
+                                           .offset    = sizeof(uint32_t) * elementCount / 2};
+        compareTrue(transaction->stage(copy0, barrier));
+        compareTrue(transaction->stage(copy1, barrier));
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.inlineUpdates, static_cast<size_t>(2));
+        compareEQ(stats.stagedCopies, static_cast<size_t>(0));
+        compareEQ(stats.copyCommands, static_cast<size_t>(0));
+        compareEQ(stats.submits, static_cast<size_t>(1));
+        compareEQ(data, readBack());
+    });
+
+    // Copies that are too large or misaligned for vkCmdUpdateBuffer still go through a staging buffer.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->setInlineUpdates(true);
+
+        const sol::StagingBufferCopy copy{
+          .dstBuffer = *buffer, .data = data.data(), .size = sizeof(uint32_t) * elementCount - 2, .offset = 0};
+        compareTrue(transaction->stage(copy, barrier));
+        transaction->commit();
+        transaction->wait();
+
+        const auto& stats = transaction->getStats();
+        compareEQ(stats.inlineUpdates, static_cast<size_t>(0));
+        compareEQ(stats.stagedCopies, static_cast<size_t>(1));
+    });
+
+    // Update list validation.
+    sol::BufferUpdateList list;
+    expectThrow([&] { list.add(*buffer, data.data(), 6); });
+    expectThrow([&] { list.add(*buffer, data.data(), 4, 2); });
+    expectThrow([&] { list.add(*buffer, data.data(), sol::BufferUpdateList::maxUpdateSize + 4); });
+    expectThrow([&] { list.add(*buffer, data.data(), 8, sizeof(uint32_t) * elementCount - 4); });
+    compareTrue(list.empty());
+
+    // Update list recorded into a command buffer of the queue family that owns the buffer.
+    expectNoThrow([&] {
+        std::memset(buffer->getBuffer().getMappedData<std::byte>() + buffer->getBufferOffset(),
+                    0,
+                    sizeof(uint32_t) * elementCount);
+
+        const auto reversed = data | std::views::reverse | std::ranges::to<std::vector<uint32_t>>();
+        list.add(*buffer, data.data(), sizeof(uint32_t) * elementCount);
+        list.add(*buffer, reversed.data(), sizeof(uint32_t) * elementCount / 2, sizeof(uint32_t) * elementCount / 2);
+        compareEQ(list.getUpdateCount(), static_cast<size_t>(2));
+        compareEQ(list.getDataSize(), static_cast<size_t>(sizeof(uint32_t) * elementCount * 3 / 2));
+
+        list.setBarrier(sol::BufferUpdateList::Barrier{.srcStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                                       .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                                       .srcAccess = VK_ACCESS_2_HOST_WRITE_BIT,
+                                                       .dstAccess = VK_ACCESS_2_HOST_READ_BIT});
+
+        auto&                              queue = getMemoryManager().getQueue(buffer->getQueueFamily());
+        sol::VulkanCommandBuffer::Settings settings;
+        settings.commandPool = getMemoryManager().getCommandPool(buffer->getQueueFamily());
+        const auto commandBuffer = sol::VulkanCommandBuffer::create(settings);
+        commandBuffer->beginOneTimeCommand();
+        list.flush(*commandBuffer);
+        commandBuffer->endCommand();
+        queue.submit(*commandBuffer);
+        vkQueueWaitIdle(queue.get());
+        compareTrue(list.empty());
+
+        auto expected = data;
+        std::ranges::copy(reversed | std::views::take(elementCount / 2), expected.begin() + elementCount / 2);
+        compareEQ(expected, readBack());
+    });
+}
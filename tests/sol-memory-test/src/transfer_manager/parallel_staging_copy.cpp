@@ -0,0 +1,94 @@
+#include "sol-memory-test/transfer_manager/parallel_staging_copy.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <cstring>
+#include <ranges>
+#include <thread>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void ParallelStagingCopy::operator()()
+{
+    constexpr size_t   chunkSize    = 1024ull * 1024ull;
+    constexpr uint32_t elementCount = 32 * chunkSize / sizeof(uint32_t);
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Executor that runs each task on a separate thread.
+    std::atomic_size_t taskCount = 0;
+    expectThrow([&] { getTransferManager().setCopyExecutor({}, 0); });
+    expectNoThrow([&] {
+        getTransferManager().setCopyExecutor(
+          [&](const size_t count, const std::function<void(size_t)>& task) {
+              std::vector<std::jthread> threads;
+              for (size_t i = 0; i < count; i++)
+                  threads.emplace_back([&, i] {
+                      task(i);
+                      ++taskCount;
+                  });
+          },
+          chunkSize);
+    });
+
+    sol::IBufferPtr buffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+
+    const sol::BufferBarrier barrier{.buffer    = *buffer,
+                                     .srcFamily = nullptr,
+                                     .dstFamily = nullptr,
+                                     .srcStage  = 0,
+                                     .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                     .srcAccess = 0,
+                                     .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+
+    // Large copy is split over the executor.
+    expectNoThrow([&] {
+        const auto                   transaction = getTransferManager().beginTransaction();
+        const sol::StagingBufferCopy copy{.dstBuffer = *buffer, .data = data.data(), .size = VK_WHOLE_SIZE};
+        compareTrue(transaction->stage(copy, barrier));
+        transaction->commit();
+        transaction->wait();
+    });
+    compareEQ(taskCount.load(), static_cast<size_t>(32));
+
+    std::vector<uint32_t> dstData(elementCount);
+    std::memcpy(dstData.data(), buffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+    compareEQ(data, dstData);
+
+    // Small copy stays inline.
+    taskCount = 0;
+    expectNoThrow([&] {
+        const auto                   transaction = getTransferManager().beginTransaction();
+        const sol::StagingBufferCopy copy{.dstBuffer = *buffer, .data = data.data(), .size = chunkSize};
+        compareTrue(transaction->stage(copy, barrier));
+        transaction->commit();
+        transaction->wait();
+    });
+    compareEQ(taskCount.load(), static_cast<size_t>(0));
+
+    expectNoThrow([&] { getTransferManager().setCopyExecutor({}); });
+}
@@ -0,0 +1,116 @@
+#include "sol-memory-test/transfer_manager/residency.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/residency_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+
+void Residency::operator()()
+{
+    constexpr size_t elementCount = 1024;
+    constexpr size_t size         = sizeof(uint32_t) * elementCount;
+
+    // Host visible buffers, so that contents can be checked directly.
+    constexpr sol::IBufferAllocator::AllocationInfo info{
+      .size                 = size,
+      .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+      .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+      .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+      .requiredMemoryFlags  = 0,
+      .preferredMemoryFlags = 0,
+      .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+      .alignment            = 0};
+
+    std::array<sol::IBufferPtr, 3>       buffers;
+    std::array<std::vector<uint32_t>, 3> data;
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        data[i] = std::views::iota(static_cast<uint32_t>(i * elementCount)) | std::views::take(elementCount) |
+                  std::ranges::to<std::vector<uint32_t>>();
+        buffers[i] = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        buffers[i]->getBuffer().setData(data[i].data(), size);
+    }
+
+    sol::ResidencyManager manager(getMemoryManager(), getTransferManager());
+    expectThrow([&] { manager.setBudgetFraction(0.0f); });
+    expectThrow([&] { static_cast<void>(manager.add(sol::ResidencyManager::Resource{})); });
+
+    std::array<sol::ResidencyManager::Handle, 3> handles{};
+    for (size_t i = 0; i < buffers.size(); i++)
+        handles[i] = manager.addBuffer(buffers[i], getMemoryManager(), info, i == 2 ? 1 : 0);
+    compareEQ(manager.getStatistics().residentBytes, 3 * size);
+
+    // Use all buffers in frame 1 and buffer 0 again in frame 2.
+    {
+        const auto transaction = getTransferManager().beginTransaction();
+        for (const auto handle : handles) compareTrue(manager.touch(*transaction, handle, 1));
+        compareTrue(manager.touch(*transaction, handles[0], 2));
+    }
+
+    // Within budget.
+    manager.setBudget(3 * size);
+    compareEQ(manager.enforceBudget(3), static_cast<size_t>(0));
+
+    // Buffer 1 has the lowest priority and was least recently used, so it is evicted first. Buffer 2 has a higher
+    // priority than buffer 0, so buffer 0 is evicted next, even though it was used more recently.
+    manager.setBudget(size);
+    compareEQ(manager.enforceBudget(3), 2 * size);
+    compareFalse(manager.isResident(handles[0]));
+    compareFalse(manager.isResident(handles[1]));
+    compareTrue(manager.isResident(handles[2]));
+    compareTrue(buffers[0] == nullptr);
+    compareTrue(buffers[1] == nullptr);
+
+    auto stats = manager.getStatistics();
+    compareEQ(stats.residentBytes, size);
+    compareEQ(stats.evictedBytes, 2 * size);
+    compareEQ(stats.evictions, static_cast<size_t>(2));
+
+    // Resources used in the current frame are never evicted.
+    manager.setBudget(1);
+    {
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(manager.touch(*transaction, handles[2], 4));
+    }
+    compareEQ(manager.enforceBudget(4), static_cast<size_t>(0));
+
+    // Touching restores the contents.
+    manager.setBudget(0);
+    {
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(manager.touch(*transaction, handles[0], 5));
+        compareTrue(manager.touch(*transaction, handles[1], 5));
+        transaction->commit();
+        transaction->wait();
+    }
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        compareTrue(manager.isResident(handles[i]));
+        std::vector<uint32_t> contents(elementCount);
+        std::memcpy(contents.data(), buffers[i]->getBuffer().getMappedData<uint32_t>(), size);
+        compareEQ(data[i], contents);
+    }
+
+    stats = manager.getStatistics();
+    compareEQ(stats.residentBytes, 3 * size);
+    compareEQ(stats.evictedBytes, static_cast<size_t>(0));
+    compareEQ(stats.restores, static_cast<size_t>(2));
+
+    manager.remove(handles[1]);
+    compareEQ(manager.getStatistics().residentCount, static_cast<size_t>(2));
+    expectThrow([&] { static_cast<void>(manager.isResident(handles[1])); });
+}
@@ -0,0 +1,96 @@
+#include "sol-memory-test/transfer_manager/streaming_upload.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ranges>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_handle.h"
+#include "sol-memory/transaction_manager.h"
+
+void StreamingUpload::operator()()
+{
+    // Upload 16 times as much data as fits in the staging pool.
+    constexpr size_t   poolSize     = 64ull * 1024ull;
+    constexpr uint32_t elementCount = 16 * poolSize / sizeof(uint32_t);
+    const auto data = std::views::iota(0) | std::views::take(elementCount) | std::ranges::to<std::vector<uint32_t>>();
+
+    // Create a transaction manager with a small staging pool.
+    sol::TransactionManagerPtr manager;
+    expectNoThrow([&] {
+        constexpr sol::IMemoryPool::CreateInfo info{
+          .createFlags          = 0,
+          .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+          .blockSize       = poolSize,
+          .minBlocks       = 1,
+          .maxBlocks       = 1};
+        auto& pool = getMemoryManager().createRingBufferMemoryPool("streaming", info);
+        manager    = std::make_unique<sol::TransactionManager>(getMemoryManager(), pool);
+    });
+
+    sol::IBufferPtr buffer;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size = sizeof(uint32_t) * elementCount,
+          .bufferUsage =
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = 0,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        buffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+    });
+
+    const sol::StagingBufferCopy copy{.dstBuffer = *buffer, .data = data.data(), .size = VK_WHOLE_SIZE, .offset = 0};
+    const sol::BufferBarrier     barrier{.buffer    = *buffer,
+                                         .srcFamily = nullptr,
+                                         .dstFamily = nullptr,
+                                         .srcStage  = 0,
+                                         .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                         .srcAccess = 0,
+                                         .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+
+    // A regular staging copy does not fit.
+    expectNoThrow([&] {
+        const auto transaction = manager->beginTransaction();
+        compareFalse(transaction->stage(copy, barrier));
+    });
+
+    // Chunks cannot be larger than the pool.
+    expectThrow([&] { static_cast<void>(manager->upload(copy, barrier, 2 * poolSize)); });
+
+    // Streaming upload with default and explicit chunk sizes.
+    for (const size_t chunkSize : {size_t{0}, poolSize / 4, size_t{1000}})
+    {
+        std::memset(buffer->getBuffer().getMappedData<uint32_t>(), 0, sizeof(uint32_t) * elementCount);
+
+        expectNoThrow([&] {
+            auto handle = manager->upload(copy, barrier, chunkSize);
+            handle.wait();
+            compareTrue(handle.isComplete());
+        });
+
+        std::vector<uint32_t> dstData(elementCount);
+        memcpy(dstData.data(), buffer->getBuffer().getMappedData<uint32_t>(), sizeof(uint32_t) * elementCount);
+        compareEQ(data, dstData);
+    }
+
+    expectNoThrow([&] { manager.reset(); });
+}
@@ -0,0 +1,153 @@
+#include "sol-memory-test/transfer_manager/upload_scheduler.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstring>
+#include <ranges>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+#include "sol-memory/upload_scheduler.h"
+
+void UploadScheduler::operator()()
+{
+    using Priority = sol::UploadScheduler::Priority;
+
+    constexpr uint32_t elementCount = 512;
+    constexpr size_t   bufferSize   = sizeof(uint32_t) * elementCount;
+    constexpr size_t   bufferCount  = 5;
+
+    std::vector<std::vector<uint32_t>> data;
+    for (size_t i = 0; i < bufferCount; i++)
+        data.emplace_back(std::views::iota(static_cast<uint32_t>(i * elementCount)) | std::views::take(elementCount) |
+                          std::ranges::to<std::vector<uint32_t>>());
+
+    // Create host visible buffers, so that results can be checked without a download.
+    std::vector<sol::IBufferPtr> buffers;
+    expectNoThrow([&] {
+        constexpr sol::IBufferAllocator::AllocationInfo info{
+          .size                 = bufferSize,
+          .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+          .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+          .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+          .requiredMemoryFlags  = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+          .preferredMemoryFlags = 0,
+          .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+          .alignment            = 0};
+        for (size_t i = 0; i < bufferCount; i++)
+            buffers.emplace_back(
+              getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw));
+    });
+
+    const auto readBack = [&](const size_t i) {
+        buffers[i]->getBuffer().invalidate(buffers[i]->getBufferOffset(), bufferSize);
+        std::vector<uint32_t> dstData(elementCount);
+        std::memcpy(dstData.data(),
+                    buffers[i]->getBuffer().getMappedData<std::byte>() + buffers[i]->getBufferOffset(),
+                    bufferSize);
+        return dstData;
+    };
+
+    const auto enqueue = [&](sol::UploadScheduler& scheduler, const size_t i, const Priority priority, bool* done) {
+        const sol::StagingBufferCopy copy{
+          .dstBuffer = *buffers[i], .data = data[i].data(), .size = VK_WHOLE_SIZE, .offset = 0};
+        const sol::BufferBarrier barrier{.buffer    = *buffers[i],
+                                         .srcFamily = nullptr,
+                                         .dstFamily = nullptr,
+                                         .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                         .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                         .srcAccess = VK_ACCESS_2_NONE,
+                                         .dstAccess = VK_ACCESS_2_HOST_READ_BIT};
+        return scheduler.enqueue(copy, barrier, priority, [done] { *done = true; });
+    };
+
+    // Invalid budget.
+    expectThrow([&] { sol::UploadScheduler scheduler(getTransferManager(), 0); });
+
+    // Requests are committed highest priority first, up to the frame budget.
+    expectNoThrow([&] {
+        sol::UploadScheduler          scheduler(getTransferManager(), bufferSize * 2);
+        std::array<bool, bufferCount> done{};
+
+        enqueue(scheduler, 0, Priority::Background, &done[0]);
+        enqueue(scheduler, 1, Priority::Background, &done[1]);
+        const auto cancelled = enqueue(scheduler, 2, Priority::Background, &done[2]);
+        const auto promoted  = enqueue(scheduler, 3, Priority::Background, &done[3]);
+        enqueue(scheduler, 4, Priority::VisibleNow, &done[4]);
+
+        compareEQ(scheduler.getQueueDepth(Priority::Background), static_cast<size_t>(4));
+        compareEQ(scheduler.getQueuedBytes(Priority::Background), bufferSize * 4);
+        compareEQ(scheduler.getQueueDepth(Priority::VisibleNow), static_cast<size_t>(1));
+        compareTrue(scheduler.cancel(cancelled));
+        compareFalse(scheduler.cancel(cancelled));
+        compareTrue(scheduler.setPriority(promoted, Priority::Prefetch));
+        compareEQ(scheduler.getQueueDepth(Priority::Background), static_cast<size_t>(2));
+        compareEQ(scheduler.getQueueDepth(Priority::Prefetch), static_cast<size_t>(1));
+
+        // First frame: the visible upload and the promoted prefetch.
+        auto handle = scheduler.commitFrame();
+        compareTrue(handle.has_value());
+        handle->wait();
+        static_cast<void>(getTransferManager().poll());
+        compareTrue(done[4]);
+        compareTrue(done[3]);
+        compareFalse(done[0]);
+        compareEQ(data[4], readBack(4));
+        compareEQ(data[3], readBack(3));
+        compareEQ(scheduler.getMetrics().lastFrameBytes, bufferSize * 2);
+        compareEQ(scheduler.getMetrics().committedBytes[static_cast<size_t>(Priority::VisibleNow)], bufferSize);
+        compareEQ(scheduler.getMetrics().committedBytes[static_cast<size_t>(Priority::Prefetch)], bufferSize);
+        compareFalse(scheduler.setPriority(promoted, Priority::VisibleNow));
+
+        // Second frame: the remaining background uploads.
+        handle = scheduler.commitFrame();
+        compareTrue(handle.has_value());
+        handle->wait();
+        static_cast<void>(getTransferManager().poll());
+        compareTrue(done[0]);
+        compareTrue(done[1]);
+        compareFalse(done[2]);
+        compareEQ(data[0], readBack(0));
+        compareEQ(data[1], readBack(1));
+        compareEQ(scheduler.getMetrics().lastFrameRequests, static_cast<size_t>(2));
+        compareEQ(scheduler.getQueueDepth(Priority::Background), static_cast<size_t>(0));
+        compareEQ(scheduler.getQueuedBytes(Priority::Background), static_cast<size_t>(0));
+
+        // Nothing left.
+        compareFalse(scheduler.commitFrame().has_value());
+        compareEQ(scheduler.getMetrics().frames, static_cast<size_t>(3));
+    });
+
+    // A request larger than the budget is committed on its own.
+    expectNoThrow([&] {
+        sol::UploadScheduler          scheduler(getTransferManager(), bufferSize / 2);
+        std::array<bool, bufferCount> done{};
+
+        enqueue(scheduler, 0, Priority::VisibleNow, &done[0]);
+        enqueue(scheduler, 1, Priority::VisibleNow, &done[1]);
+
+        auto handle = scheduler.commitFrame();
+        compareTrue(handle.has_value());
+        handle->wait();
+        compareEQ(scheduler.getMetrics().lastFrameRequests, static_cast<size_t>(1));
+        compareEQ(scheduler.getQueueDepth(Priority::VisibleNow), static_cast<size_t>(1));
+
+        handle = scheduler.commitFrame();
+        compareTrue(handle.has_value());
+        handle->wait();
+        static_cast<void>(getTransferManager().poll());
+        compareTrue(done[0]);
+        compareTrue(done[1]);
+    });
+}
@@ -1,10 +1,19 @@
 #include "sol-mesh-test/geometry_buffer_allocator.h"
 
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <ranges>
+
 ////////////////////////////////////////////////////////////////
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
 #include "sol-core/vulkan_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction_manager.h"
 #include "sol-mesh/geometry_buffer_allocator.h"
 #include "sol-mesh/index_buffer.h"
 #include "sol-mesh/vertex_buffer.h"
@@ -134,6 +143,170 @@ void GeometryBufferAllocator::operator()()
         expectNoThrow([&] { static_cast<void>(allocator->allocateIndexBuffer(512)); });
     }
 
+    // Test growing and compacting the global buffers.
+    {
+        const sol::GeometryBufferAllocator::Settings settings{.memoryManager = getMemoryManager(),
+                                                              .strategy =
+                                                                sol::GeometryBufferAllocator::Strategy::Global,
+                                                              .vertexCount = 1024,
+                                                              .vertexSize  = 16,
+                                                              .indexCount  = 2048,
+                                                              .indexSize   = 4};
+
+        const auto allocator = sol::GeometryBufferAllocator::create(settings);
+        const auto data =
+          std::views::iota(0u) | std::views::take(4096) | std::ranges::to<std::vector<uint32_t>>();
+
+        sol::IBufferPtr hostBuffer;
+        expectNoThrow([&] {
+            const sol::IBufferAllocator::AllocationInfo info{
+              .size                 = data.size() * sizeof(uint32_t),
+              .bufferUsage          = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+              .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+              .memoryUsage          = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+              .requiredMemoryFlags  = 0,
+              .preferredMemoryFlags = 0,
+              .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+              .alignment            = 0};
+            hostBuffer = getMemoryManager().allocateBuffer(info, sol::IBufferAllocator::OnAllocationFailure::Throw);
+        });
+
+        const auto upload = [&](sol::VertexBuffer& vbuffer) {
+            const auto transaction = getTransferManager().beginTransaction();
+            compareTrue(vbuffer.setVertexData(*transaction,
+                                              data.data(),
+                                              vbuffer.getVertexCount(),
+                                              0,
+                                              sol::IBuffer::Barrier{.dstFamily = nullptr,
+                                                                    .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                                                    .dstStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                                    .srcAccess = VK_ACCESS_2_NONE,
+                                                                    .dstAccess = VK_ACCESS_2_TRANSFER_READ_BIT},
+                                              false));
+            transaction->commit();
+            transaction->wait();
+        };
+
+        const auto readBack = [&](sol::VertexBuffer& vbuffer) {
+            const auto transaction = getTransferManager().beginTransaction();
+            vbuffer.getData(*transaction,
+                            *hostBuffer,
+                            sol::IBuffer::Barrier{.dstFamily = nullptr,
+                                                  .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                                  .dstStage  = VK_PIPELINE_STAGE_2_NONE,
+                                                  .srcAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+                                                  .dstAccess = VK_ACCESS_2_NONE},
+                            sol::IBuffer::Barrier{.dstFamily = nullptr,
+                                                  .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                                  .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                                                  .srcAccess = VK_ACCESS_2_NONE,
+                                                  .dstAccess = VK_ACCESS_2_HOST_READ_BIT},
+                            vbuffer.getBufferSize(),
+                            0,
+                            0);
+            transaction->commit();
+            transaction->wait();
+
+            std::vector<uint32_t> dstData(vbuffer.getBufferSize() / sizeof(uint32_t));
+            std::memcpy(dstData.data(), hostBuffer->getBuffer().getMappedData<uint32_t>(), vbuffer.getBufferSize());
+            return dstData;
+        };
+
+        const auto expected = [&](const sol::VertexBuffer& vbuffer) {
+            return data | std::views::take(vbuffer.getBufferSize() / sizeof(uint32_t)) |
+                   std::ranges::to<std::vector<uint32_t>>();
+        };
+
+        // Fill the global vertex buffer.
+        sol::VertexBufferPtr vbuffer0, vbuffer1, vbuffer2, vbuffer3;
+        expectNoThrow([&] { vbuffer0 = allocator->allocateVertexBuffer(256); });
+        expectNoThrow([&] { vbuffer1 = allocator->allocateVertexBuffer(256); });
+        expectNoThrow([&] { vbuffer2 = allocator->allocateVertexBuffer(512); });
+        upload(*vbuffer2);
+        compareEQ(1024, allocator->getVertexCapacity());
+        compareEQ(0, allocator->getFreeVertexCount());
+        expectThrow([&] { static_cast<void>(allocator->allocateVertexBuffer(128)); });
+
+        size_t relocations = 0;
+        for (auto* vbuffer : {vbuffer0.get(), vbuffer1.get(), vbuffer2.get()})
+            vbuffer->setRelocationCallback([&](sol::VertexBuffer&) { relocations++; });
+
+        // Compacting and growing a separate allocator is not possible, and only one pass can run at a time.
+        expectNoThrow([&] {
+            const auto transaction = getTransferManager().beginTransaction();
+            const auto separate    = sol::GeometryBufferAllocator::create(
+              {.memoryManager = getMemoryManager(), .strategy = sol::GeometryBufferAllocator::Strategy::Separate});
+            expectThrow([&] { static_cast<void>(separate->beginCompaction(*transaction)); });
+            expectThrow([&] { static_cast<void>(separate->beginGrowth(*transaction, 2048, 0)); });
+        });
+
+        // Grow the vertex buffer. New buffers are placed in the new global buffer right away.
+        expectNoThrow([&] {
+            const auto transaction = getTransferManager().beginTransaction();
+            const auto stats       = allocator->beginGrowth(*transaction, 2048, 0);
+            compareEQ(3, stats.allocationsMoved);
+            compareEQ(1024, stats.verticesMoved);
+            compareEQ(0, stats.indicesMoved);
+            compareTrue(allocator->isRelocating());
+            expectThrow([&] { static_cast<void>(allocator->beginCompaction(*transaction)); });
+
+            vbuffer3 = allocator->allocateVertexBuffer(512);
+            compareNE(&vbuffer2->getBuffer(), &vbuffer3->getBuffer());
+
+            transaction->commit();
+            transaction->wait();
+            allocator->endRelocation();
+        });
+        compareFalse(allocator->isRelocating());
+        compareEQ(3, relocations);
+        compareEQ(2048, allocator->getVertexCapacity());
+        compareEQ(512, allocator->getFreeVertexCount());
+        compareEQ(2048 * 16, vbuffer2->getBuffer().getSize());
+        compareEQ(&vbuffer2->getBuffer(), &vbuffer3->getBuffer());
+        compareEQ(512, vbuffer2->getVertexOffset());
+        compareEQ(expected(*vbuffer2), readBack(*vbuffer2));
+        upload(*vbuffer3);
+
+        // Free the start of the buffer and compact. Only the last buffer fits in the freed range.
+        vbuffer0.reset();
+        vbuffer1.reset();
+        relocations = 0;
+        vbuffer3->setRelocationCallback([&](sol::VertexBuffer&) { relocations++; });
+        const auto oldOffset = vbuffer3->getVertexOffset();
+        expectNoThrow([&] {
+            const auto transaction = getTransferManager().beginTransaction();
+            const auto stats       = allocator->beginCompaction(*transaction);
+            compareEQ(1, stats.allocationsMoved);
+            compareEQ(512, stats.verticesMoved);
+            transaction->commit();
+            transaction->wait();
+            allocator->endRelocation();
+        });
+        compareEQ(1, relocations);
+        compareTrue(vbuffer3->getVertexOffset() < oldOffset);
+        compareEQ(expected(*vbuffer3), readBack(*vbuffer3));
+        compareEQ(expected(*vbuffer2), readBack(*vbuffer2));
+        expectThrow([&] { allocator->endRelocation(); });
+
+        // Release a buffer while its move is pending. Its destination range stays reserved until the pass ends, so
+        // that the copy cannot overwrite a buffer allocated in the meantime.
+        sol::VertexBufferPtr vbuffer4;
+        expectNoThrow([&] { vbuffer4 = allocator->allocateVertexBuffer(512); });
+        vbuffer3.reset();
+        expectNoThrow([&] {
+            const auto transaction = getTransferManager().beginTransaction();
+            const auto stats       = allocator->beginCompaction(*transaction);
+            compareEQ(1, stats.allocationsMoved);
+            vbuffer4.reset();
+            vbuffer3 = allocator->allocateVertexBuffer(512);
+            compareNE(0, vbuffer3->getVertexOffset());
+            transaction->commit();
+            transaction->wait();
+            allocator->endRelocation();
+        });
+        compareEQ(1024, allocator->getFreeVertexCount());
+    }
+
     // Create allocator with invalid global settings.
     {
         sol::GeometryBufferAllocator::Settings settings{.memoryManager = getMemoryManager(),
@@ -0,0 +1,131 @@
+#include "sol-mesh-test/lod_generator.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <ranges>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-mesh/lod_generator.h"
+#include "sol-mesh/mesh_description.h"
+#include "sol-mesh/mesh_manager.h"
+
+void LodGenerator::operator()()
+{
+    using Position = std::array<float, 3>;
+
+    // Bumpy grid of quads.
+    constexpr uint32_t    size        = 32;
+    constexpr size_t      vertexCount = (size + 1) * (size + 1);
+    std::vector<Position> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y <= size; y++)
+        for (uint32_t x = 0; x <= size; x++)
+            positions.push_back({static_cast<float>(x),
+                                 static_cast<float>(y),
+                                 2 * std::sin(static_cast<float>(x) * 0.4f) * std::cos(static_cast<float>(y) * 0.3f)});
+    for (uint32_t y = 0; y < size; y++)
+    {
+        for (uint32_t x = 0; x < size; x++)
+        {
+            const uint32_t i = y * (size + 1) + x;
+            indices.insert(indices.end(), {i, i + 1, i + size + 1, i + 1, i + size + 2, i + size + 1});
+        }
+    }
+    const auto diagonal = std::sqrt(2.0f * size * size + 4.0f * 4.0f);
+
+    const auto checkLods = [&](const std::vector<sol::Mesh::Lod>& lods,
+                               const std::vector<uint32_t>&       idx,
+                               const float                        maxError) {
+        compareFalse(lods.empty());
+        uint32_t first = static_cast<uint32_t>(size * size * 6);
+        uint32_t count = first;
+        float    error = 0;
+        for (const auto& lod : lods)
+        {
+            // Levels are stored back to back, shrink and have increasing errors within the limit.
+            compareEQ(first, lod.firstIndex);
+            compareTrue(lod.indexCount < count);
+            compareEQ(0, lod.indexCount % 3);
+            compareTrue(lod.error >= error);
+            compareTrue(lod.error <= maxError * diagonal);
+            first += lod.indexCount;
+            count = lod.indexCount;
+            error = lod.error;
+        }
+        compareEQ(first, idx.size());
+        compareTrue(std::ranges::all_of(idx, [](const uint32_t i) { return i < vertexCount; }));
+    };
+
+    // Generate LODs for raw data.
+    expectNoThrow([&] {
+        const sol::LodGenerator generator;
+        auto                    idx  = indices;
+        const auto              lods = generator.generate(
+          idx, reinterpret_cast<const std::byte*>(positions.data()), sizeof(Position), vertexCount);
+        checkLods(lods, idx, generator.getSettings().maxError);
+        compareTrue(std::ranges::equal(indices, idx | std::views::take(indices.size())));
+        compareTrue(lods.size() > 1);
+    });
+
+    // Levels stay within a smaller error limit.
+    expectNoThrow([&] {
+        const sol::LodGenerator generator(sol::LodGenerator::Settings{.maxError = 0.005f});
+        auto                    idx  = indices;
+        const auto              lods = generator.generate(
+          idx, reinterpret_cast<const std::byte*>(positions.data()), sizeof(Position), vertexCount);
+        checkLods(lods, idx, 0.005f);
+    });
+
+    // Generate LODs for a MeshDescription.
+    expectNoThrow([&] {
+        sol::MeshManager manager(getMemoryManager());
+
+        const auto source = manager.createMeshDescription();
+        source->addVertexBuffer(sizeof(Position), static_cast<uint32_t>(vertexCount));
+        source->addIndexBuffer(sizeof(uint16_t), static_cast<uint32_t>(indices.size()));
+        source->setVertexData(0, 0, vertexCount, positions.data());
+        std::vector<uint16_t> idx16(indices.begin(), indices.end());
+        source->setIndexData(0, idx16.size(), idx16.data());
+
+        const auto target = manager.createMeshDescription();
+        const auto lods   = sol::LodGenerator().generate(*source, *target);
+        compareEQ(vertexCount, target->getVertexCount(0));
+        compareEQ(0, std::memcmp(positions.data(), target->getVertexBuffer(0).getMappedData<Position>(), 12));
+        compareEQ(sizeof(uint16_t), target->getIndexSize());
+        compareEQ(lods.back().firstIndex + lods.back().indexCount, target->getIndexCount());
+        compareEQ(0, std::memcmp(idx16.data(), target->getIndexBuffer().getMappedData<uint16_t>(), idx16.size() * 2));
+
+        // Target must be empty.
+        expectThrow([&] { static_cast<void>(sol::LodGenerator().generate(*source, *target)); });
+
+        // Source must be indexed.
+        const auto unindexed = manager.createMeshDescription();
+        unindexed->addVertexBuffer(sizeof(Position), 3);
+        expectThrow([&] { static_cast<void>(sol::LodGenerator().generate(*unindexed, *target)); });
+    });
+
+    // Invalid input.
+    expectThrow([&] {
+        std::vector<uint32_t> idx{0, 1};
+        static_cast<void>(sol::LodGenerator().generate(
+          idx, reinterpret_cast<const std::byte*>(positions.data()), sizeof(Position), vertexCount));
+    });
+    expectThrow([&] {
+        std::vector<uint32_t> idx{0, 1, static_cast<uint32_t>(vertexCount)};
+        static_cast<void>(sol::LodGenerator().generate(
+          idx, reinterpret_cast<const std::byte*>(positions.data()), sizeof(Position), vertexCount));
+    });
+    expectThrow([&] { sol::LodGenerator generator(sol::LodGenerator::Settings{.reductionFactor = 1.0f}); });
+    expectThrow([&] { sol::LodGenerator generator(sol::LodGenerator::Settings{.maxError = -1.0f}); });
+}
@@ -12,8 +12,11 @@
 
 #include "sol-mesh-test/geometry_buffer_allocator.h"
 #include "sol-mesh-test/index_buffer.h"
+#include "sol-mesh-test/lod_generator.h"
 #include "sol-mesh-test/mesh.h"
+#include "sol-mesh-test/mesh_optimizer.h"
 #include "sol-mesh-test/vertex_buffer.h"
+#include "sol-mesh-test/vertex_format_converter.h"
 
 #ifdef WIN32
 #include "Windows.h"
@@ -32,5 +35,11 @@ int main(int argc, char** argv)
     }
 #endif
 
-    return bt::run<GeometryBufferAllocator, IndexBuffer, Mesh, VertexBuffer>(argc, argv, "sol-mesh");
+    return bt::run<GeometryBufferAllocator,
+                   IndexBuffer,
+                   LodGenerator,
+                   Mesh,
+                   MeshOptimizer,
+                   VertexBuffer,
+                   VertexFormatConverter>(argc, argv, "sol-mesh");
 }
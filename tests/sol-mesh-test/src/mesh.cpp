@@ -64,4 +64,61 @@ void Mesh::operator()()
     compareNE(uuids::uuid{}, mesh3->getUuid());
     compareEQ(3, mesh3->getVertexBufferCount());
     compareTrue(mesh3->hasIndexBuffer());
+
+    // Element counts.
+    compareEQ(1024, mesh0->getVertexCount());
+    compareEQ(0, mesh0->getIndexCount());
+    compareEQ(1024, mesh0->getElementCount());
+    compareEQ(1024, mesh1->getIndexCount());
+    compareEQ(1024, mesh1->getElementCount());
+
+    // Without submeshes, the whole mesh is drawn as a single range.
+    compareTrue(mesh1->getSubMeshes().empty());
+    compareEQ(1, mesh1->getDrawRanges().size());
+    compareTrue(sol::Mesh::SubMesh{.firstIndex = 0, .indexCount = 1024, .vertexOffset = 0} ==
+                mesh1->getDrawRanges().front());
+
+    // Add submeshes.
+    expectNoThrow([&] {
+        mesh1->setSubMeshes({{.firstIndex = 0, .indexCount = 512, .vertexOffset = 0},
+                             {.firstIndex = 512, .indexCount = 256, .vertexOffset = 100}});
+        mesh1->addSubMesh({.firstIndex = 768, .indexCount = 256, .vertexOffset = 200});
+    });
+    compareEQ(3, mesh1->getSubMeshes().size());
+    compareTrue(mesh1->getSubMeshes() == mesh1->getDrawRanges());
+
+    // Submeshes must be non-empty and inside of the index (or vertex) buffer.
+    expectThrow([&] { mesh1->addSubMesh({.firstIndex = 0, .indexCount = 0, .vertexOffset = 0}); });
+    expectThrow([&] { mesh1->addSubMesh({.firstIndex = 1000, .indexCount = 25, .vertexOffset = 0}); });
+    expectThrow([&] { mesh0->setSubMeshes({{.firstIndex = 0, .indexCount = 1025, .vertexOffset = 0}}); });
+    compareEQ(3, mesh1->getSubMeshes().size());
+    compareTrue(mesh0->getSubMeshes().empty());
+
+    // Without LODs, every level draws the full detail mesh.
+    compareEQ(1, mesh1->getLodCount());
+    compareEQ(0, mesh1->selectLod(100.0f));
+    compareTrue(mesh1->getDrawRanges() == mesh1->getDrawRanges(2));
+
+    // Add LODs.
+    expectNoThrow([&] {
+        mesh1->setLods({{.firstIndex = 0, .indexCount = 384, .error = 0.5f},
+                        {.firstIndex = 384, .indexCount = 96, .error = 2.0f}});
+    });
+    compareEQ(3, mesh1->getLodCount());
+    compareEQ(0, mesh1->selectLod(0.25f));
+    compareEQ(1, mesh1->selectLod(0.5f));
+    compareEQ(2, mesh1->selectLod(100.0f));
+    compareTrue(mesh1->getSubMeshes() == mesh1->getDrawRanges(0));
+    compareEQ(1, mesh1->getDrawRanges(1).size());
+    compareTrue(sol::Mesh::SubMesh{.firstIndex = 0, .indexCount = 384, .vertexOffset = 0} ==
+                mesh1->getDrawRanges(1).front());
+    compareTrue(mesh1->getDrawRanges(2) == mesh1->getDrawRanges(5));
+
+    // LODs must be inside of the index (or vertex) buffer and errors must not decrease.
+    expectThrow([&] { mesh1->setLods({{.firstIndex = 1000, .indexCount = 48, .error = 1.0f}}); });
+    expectThrow([&] {
+        mesh1->setLods({{.firstIndex = 0, .indexCount = 48, .error = 1.0f},
+                        {.firstIndex = 48, .indexCount = 12, .error = 0.5f}});
+    });
+    compareEQ(3, mesh1->getLodCount());
 }
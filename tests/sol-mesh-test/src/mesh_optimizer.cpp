@@ -0,0 +1,159 @@
+#include "sol-mesh-test/mesh_optimizer.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-mesh/mesh_description.h"
+#include "sol-mesh/mesh_manager.h"
+#include "sol-mesh/mesh_optimizer.h"
+
+void MeshOptimizer::operator()()
+{
+    using Position = std::array<float, 3>;
+    using Triangle = std::array<Position, 3>;
+
+    // Grid of quads with its triangles in random order, like a badly exported mesh.
+    constexpr uint32_t    size        = 32;
+    constexpr size_t      vertexCount = (size + 1) * (size + 1);
+    std::vector<Position> positions;
+    std::vector<uint32_t> indices;
+    for (uint32_t y = 0; y <= size; y++)
+        for (uint32_t x = 0; x <= size; x++) positions.push_back({static_cast<float>(x), static_cast<float>(y), 0});
+    {
+        std::vector<std::array<uint32_t, 3>> triangles;
+        for (uint32_t y = 0; y < size; y++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                const uint32_t i = y * (size + 1) + x;
+                triangles.push_back({i, i + 1, i + size + 1});
+                triangles.push_back({i + 1, i + size + 2, i + size + 1});
+            }
+        }
+        std::ranges::shuffle(triangles, std::mt19937(7));
+        for (const auto& t : triangles) indices.insert(indices.end(), t.begin(), t.end());
+    }
+
+    // Triangles as sets of positions, which must survive optimization, including their winding.
+    const auto getTriangles = [](const std::vector<uint32_t>& idx, const std::vector<Position>& pos) {
+        std::vector<Triangle> triangles;
+        for (size_t i = 0; i < idx.size(); i += 3)
+        {
+            Triangle t{pos[idx[i]], pos[idx[i + 1]], pos[idx[i + 2]]};
+            std::ranges::rotate(t, std::ranges::min_element(t));
+            triangles.push_back(t);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    };
+
+    // Metrics.
+    compareEQ(3.0f, sol::MeshOptimizer::calculateAcmr(std::vector<uint32_t>{0, 1, 2}, 3, 16));
+    compareEQ(2.0f, sol::MeshOptimizer::calculateAcmr(std::vector<uint32_t>{0, 1, 2, 2, 1, 3}, 4, 16));
+    compareEQ(1.0f, sol::MeshOptimizer::calculateAtvr(std::vector<uint32_t>{0, 1, 2, 2, 1, 3}, 4, 16));
+    compareEQ(2.0f, sol::MeshOptimizer::calculateAtvr(std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 0, 1, 2}, 6, 3));
+
+    // Invalid input.
+    expectThrow([] { sol::MeshOptimizer optimizer(sol::MeshOptimizer::Settings{.cacheSize = 0}); });
+    expectThrow([&] {
+        std::vector<uint32_t> idx{0, 1};
+        static_cast<void>(sol::MeshOptimizer().optimize(idx, 3, {}));
+    });
+    expectThrow([&] {
+        std::vector<uint32_t> idx{0, 1, 3};
+        static_cast<void>(sol::MeshOptimizer().optimize(idx, 3, {}));
+    });
+    expectThrow([&] {
+        // Overdraw pass requires positions.
+        std::vector<uint32_t> idx{0, 1, 2};
+        static_cast<void>(sol::MeshOptimizer().optimize(idx, 3, {}));
+    });
+
+    // Optimize raw data. Cache locality improves and the geometry is unchanged.
+    expectNoThrow([&] {
+        auto                                   idx = indices;
+        auto                                   pos = positions;
+        const sol::MeshOptimizer::VertexStream stream{.data   = reinterpret_cast<std::byte*>(pos.data()),
+                                                      .stride = sizeof(Position)};
+        const auto stats = sol::MeshOptimizer().optimize(idx, vertexCount, {&stream, 1});
+
+        compareEQ(stats.acmrBefore, sol::MeshOptimizer::calculateAcmr(indices, vertexCount, 16));
+        compareEQ(stats.acmrAfter, sol::MeshOptimizer::calculateAcmr(idx, vertexCount, 16));
+        compareTrue(stats.acmrAfter < stats.acmrBefore);
+        compareTrue(stats.atvrAfter < stats.atvrBefore);
+        compareTrue(getTriangles(indices, positions) == getTriangles(idx, pos));
+
+        // Vertices are in order of first use.
+        uint32_t next = 0;
+        for (const auto i : idx)
+        {
+            compareTrue(i <= next);
+            if (i == next) next++;
+        }
+    });
+
+    // Only remap vertices. Triangle order, and therefore the ACMR, is unchanged.
+    expectNoThrow([&] {
+        auto                                   idx = indices;
+        auto                                   pos = positions;
+        const sol::MeshOptimizer::VertexStream stream{.data   = reinterpret_cast<std::byte*>(pos.data()),
+                                                      .stride = sizeof(Position)};
+        const sol::MeshOptimizer optimizer(
+          sol::MeshOptimizer::Settings{.optimizeVertexCache = false, .optimizeOverdraw = false});
+        const auto stats = optimizer.optimize(idx, vertexCount, {&stream, 1});
+
+        compareEQ(stats.acmrBefore, stats.acmrAfter);
+        compareEQ(0u, idx[0]);
+        compareTrue(getTriangles(indices, positions) == getTriangles(idx, pos));
+    });
+
+    // Optimize a batch of MeshDescriptions.
+    expectNoThrow([&] {
+        sol::MeshManager                     manager(getMemoryManager());
+        std::vector<sol::MeshDescriptionPtr> descriptions;
+        std::vector<sol::MeshDescription*>   ptrs;
+        for (size_t i = 0; i < 4; i++)
+        {
+            auto& desc = descriptions.emplace_back(manager.createMeshDescription());
+            desc->addVertexBuffer(sizeof(Position), static_cast<uint32_t>(vertexCount));
+            desc->addIndexBuffer(sizeof(uint16_t), static_cast<uint32_t>(indices.size()));
+            desc->setVertexData(0, 0, vertexCount, positions.data());
+            std::vector<uint16_t> idx(indices.begin(), indices.end());
+            desc->setIndexData(0, idx.size(), idx.data());
+            ptrs.push_back(desc.get());
+        }
+
+        const auto stats = sol::MeshOptimizer().optimize(ptrs);
+        compareEQ(ptrs.size(), stats.size());
+        for (size_t i = 0; i < ptrs.size(); i++)
+        {
+            compareTrue(stats[i].acmrAfter < stats[i].acmrBefore);
+
+            const auto*           idxData = ptrs[i]->getIndexBuffer().getMappedData<uint16_t>();
+            const auto*           posData = ptrs[i]->getVertexBuffer(0).getMappedData<Position>();
+            std::vector<uint32_t> idx(idxData, idxData + indices.size());
+            std::vector<Position> pos(posData, posData + vertexCount);
+            compareTrue(getTriangles(indices, positions) == getTriangles(idx, pos));
+        }
+    });
+
+    // Errors of individual meshes are rethrown after the batch has finished.
+    expectThrow([&] {
+        sol::MeshManager manager(getMemoryManager());
+        auto             desc = manager.createMeshDescription();
+        desc->addVertexBuffer(sizeof(Position), 3);
+        std::vector<sol::MeshDescription*> ptrs{desc.get()};
+        static_cast<void>(sol::MeshOptimizer().optimize(ptrs));
+    });
+}
@@ -0,0 +1,189 @@
+#include "sol-mesh-test/vertex_format_converter.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <vector>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-mesh/mesh_description.h"
+#include "sol-mesh/mesh_layout.h"
+#include "sol-mesh/mesh_manager.h"
+#include "sol-mesh/vertex_format_converter.h"
+
+namespace
+{
+    struct SourceVertex
+    {
+        std::array<float, 3> position;
+        std::array<float, 3> normal;
+        std::array<float, 2> uv;
+    };
+
+    struct TargetVertex
+    {
+        std::array<float, 3>    position;
+        std::array<int16_t, 2>  normal;
+        std::array<uint16_t, 2> uv;
+    };
+}  // namespace
+
+void VertexFormatConverter::operator()()
+{
+    // Source: float positions, normals and uvs in binding 0 and float colors in binding 1.
+    sol::MeshLayout source;
+    source.addBinding("vertex", 0, sizeof(SourceVertex), VK_VERTEX_INPUT_RATE_VERTEX);
+    source.addBinding("color", 1, sizeof(float) * 4, VK_VERTEX_INPUT_RATE_VERTEX);
+    source.addAttribute("position", 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0);
+    source.addAttribute("normal", 1, 0, VK_FORMAT_R32G32B32_SFLOAT, 12);
+    source.addAttribute("uv", 2, 0, VK_FORMAT_R32G32_SFLOAT, 24);
+    source.addAttribute("color", 3, 1, VK_FORMAT_R32G32B32A32_SFLOAT, 0);
+    source.finalize();
+
+    // Target: octahedral snorm16 normals, half float uvs and unorm8 colors.
+    sol::MeshLayout target;
+    target.addBinding("vertex", 0, sizeof(TargetVertex), VK_VERTEX_INPUT_RATE_VERTEX);
+    target.addBinding("color", 1, 4, VK_VERTEX_INPUT_RATE_VERTEX);
+    target.addAttribute("position", 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0);
+    target.addAttribute("normal", 1, 0, VK_FORMAT_R16G16_SNORM, 12);
+    target.addAttribute("uv", 2, 0, VK_FORMAT_R16G16_SFLOAT, 16);
+    target.addAttribute("color", 3, 1, VK_FORMAT_R8G8B8A8_UNORM, 0);
+    target.finalize();
+
+    const std::vector<SourceVertex> vertices{
+      {.position = {1, 2, 3}, .normal = {0, 0, 1}, .uv = {0.0f, 1.0f}},
+      {.position = {4, 5, 6}, .normal = {1, 0, 0}, .uv = {0.5f, 0.25f}},
+      {.position = {7, 8, 9}, .normal = {0, 0, -1}, .uv = {2.0f, -1.0f}},
+    };
+    const std::vector<std::array<float, 4>> colors{{1, 0, 0, 1}, {0, 1, 0, 0.5f}, {0, 0, 2, -1}};
+
+    const auto checkVertices = [&](const TargetVertex* dstVertices, const std::array<uint8_t, 4>* dstColors) {
+        compareTrue(vertices[0].position == dstVertices[0].position);
+        compareTrue(vertices[2].position == dstVertices[2].position);
+        compareTrue((std::array<int16_t, 2>{0, 0}) == dstVertices[0].normal);
+        compareTrue((std::array<int16_t, 2>{32767, 0}) == dstVertices[1].normal);
+        // The lower hemisphere is folded onto the corners.
+        compareTrue((std::array<int16_t, 2>{32767, 32767}) == dstVertices[2].normal);
+        compareTrue((std::array<uint16_t, 2>{0x0000, 0x3c00}) == dstVertices[0].uv);
+        compareTrue((std::array<uint16_t, 2>{0x3800, 0x3400}) == dstVertices[1].uv);
+        compareTrue((std::array<uint16_t, 2>{0x4000, 0xbc00}) == dstVertices[2].uv);
+        compareTrue((std::array<uint8_t, 4>{255, 0, 0, 255}) == dstColors[0]);
+        compareTrue((std::array<uint8_t, 4>{0, 255, 0, 128}) == dstColors[1]);
+        compareTrue((std::array<uint8_t, 4>{0, 0, 255, 0}) == dstColors[2]);
+    };
+
+    // Convert raw data.
+    expectNoThrow([&] {
+        const sol::VertexFormatConverter converter(source, target);
+        compareEQ(2, converter.getSourceBindingCount());
+        compareEQ(2, converter.getTargetBindingCount());
+        compareEQ(sizeof(SourceVertex), converter.getSourceStride(0));
+        compareEQ(sizeof(TargetVertex), converter.getTargetStride(0));
+
+        std::vector<TargetVertex>             dstVertices(vertices.size());
+        std::vector<std::array<uint8_t, 4>>   dstColors(vertices.size());
+        const std::array<const std::byte*, 2> src{reinterpret_cast<const std::byte*>(vertices.data()),
+                                                  reinterpret_cast<const std::byte*>(colors.data())};
+        const std::array<std::byte*, 2>       dst{reinterpret_cast<std::byte*>(dstVertices.data()),
+                                                  reinterpret_cast<std::byte*>(dstColors.data())};
+        converter.convert(src, dst, vertices.size());
+        checkVertices(dstVertices.data(), dstColors.data());
+
+        // Wrong number of buffers.
+        expectThrow([&] { converter.convert(std::span(src).first(1), dst, vertices.size()); });
+    });
+
+    // Convert 3 components to 4. The 4th component is 1.
+    expectNoThrow([&] {
+        sol::MeshLayout layout;
+        layout.addBinding("vertex", 0, 8, VK_VERTEX_INPUT_RATE_VERTEX);
+        layout.addAttribute("position", 0, 0, VK_FORMAT_R16G16B16A16_SFLOAT, 0);
+        layout.finalize();
+        const sol::VertexFormatConverter converter(source, layout);
+
+        std::vector<std::array<uint16_t, 4>>  dstPositions(vertices.size());
+        const std::array<const std::byte*, 2> src{reinterpret_cast<const std::byte*>(vertices.data()),
+                                                  reinterpret_cast<const std::byte*>(colors.data())};
+        const std::array<std::byte*, 1>       dst{reinterpret_cast<std::byte*>(dstPositions.data())};
+        converter.convert(src, dst, vertices.size());
+        compareTrue((std::array<uint16_t, 4>{0x3c00, 0x4000, 0x4200, 0x3c00}) == dstPositions[0]);
+        compareTrue((std::array<uint16_t, 4>{0x4400, 0x4500, 0x4600, 0x3c00}) == dstPositions[1]);
+    });
+
+    // Convert a MeshDescription.
+    expectNoThrow([&] {
+        const sol::VertexFormatConverter converter(source, target);
+        sol::MeshManager                 manager(getMemoryManager());
+
+        const auto srcDesc = manager.createMeshDescription();
+        srcDesc->addVertexBuffer(sizeof(SourceVertex), static_cast<uint32_t>(vertices.size()));
+        srcDesc->addVertexBuffer(sizeof(float) * 4, static_cast<uint32_t>(vertices.size()));
+        srcDesc->addIndexBuffer(sizeof(uint16_t), 3);
+        srcDesc->setVertexData(0, 0, vertices.size(), vertices.data());
+        srcDesc->setVertexData(1, 0, colors.size(), colors.data());
+        const std::array<uint16_t, 3> indices{2, 1, 0};
+        srcDesc->setIndexData(0, indices.size(), indices.data());
+
+        const auto dstDesc = manager.createMeshDescription();
+        const auto stats   = converter.convert(*srcDesc, *dstDesc);
+        compareEQ(vertices.size() * (sizeof(SourceVertex) + sizeof(float) * 4), stats.sourceBytes);
+        compareEQ(vertices.size() * (sizeof(TargetVertex) + 4), stats.targetBytes);
+        compareEQ(2, dstDesc->getVertexBufferCount());
+        compareEQ(sizeof(TargetVertex), dstDesc->getVertexSize(0));
+        compareEQ(3, dstDesc->getVertexCount(1));
+        compareTrue(dstDesc->isIndexed());
+        compareEQ(0, std::memcmp(indices.data(), dstDesc->getIndexBuffer().getMappedData<uint16_t>(), 6));
+        checkVertices(dstDesc->getVertexBuffer(0).getMappedData<TargetVertex>(),
+                      dstDesc->getVertexBuffer(1).getMappedData<std::array<uint8_t, 4>>());
+
+        // Target must be empty.
+        expectThrow([&] { static_cast<void>(converter.convert(*srcDesc, *dstDesc)); });
+    });
+
+    // Unsupported conversions.
+    expectThrow([&] {
+        // Target attribute without source.
+        sol::MeshLayout layout;
+        layout.addBinding("vertex", 0, 4, VK_VERTEX_INPUT_RATE_VERTEX);
+        layout.addAttribute("tangent", 4, 0, VK_FORMAT_R8G8B8A8_SNORM, 0);
+        layout.finalize();
+        sol::VertexFormatConverter converter(source, layout);
+    });
+    expectThrow([&] {
+        // 2 components to 1.
+        sol::MeshLayout layout;
+        layout.addBinding("vertex", 0, 2, VK_VERTEX_INPUT_RATE_VERTEX);
+        layout.addAttribute("uv", 2, 0, VK_FORMAT_R16_SFLOAT, 0);
+        layout.finalize();
+        sol::VertexFormatConverter converter(source, layout);
+    });
+    expectThrow([&] {
+        // Octahedral encoding into a unorm format.
+        sol::MeshLayout layout;
+        layout.addBinding("vertex", 0, 4, VK_VERTEX_INPUT_RATE_VERTEX);
+        layout.addAttribute("normal", 1, 0, VK_FORMAT_R16G16_UNORM, 0);
+        layout.finalize();
+        sol::VertexFormatConverter converter(source, layout);
+    });
+    expectThrow([&] {
+        // Attribute does not fit in stride.
+        sol::MeshLayout layout;
+        layout.addBinding("vertex", 0, 4, VK_VERTEX_INPUT_RATE_VERTEX);
+        layout.addAttribute("uv", 2, 0, VK_FORMAT_R16G16_SFLOAT, 2);
+        layout.finalize();
+        sol::VertexFormatConverter converter(source, layout);
+    });
+    expectThrow([&] {
+        // Layouts must be finalized.
+        sol::MeshLayout            layout;
+        sol::VertexFormatConverter converter(source, layout);
+    });
+}
@@ -4,8 +4,10 @@
 // Module includes.
 ////////////////////////////////////////////////////////////////
 
+#include "sol-mesh/mesh.h"
 #include "sol-render/graphics/graphics_render_data.h"
 #include "sol-render/graphics/graphics_traverser.h"
+#include "sol-scenegraph/drawable/mesh_node.h"
 
 ////////////////////////////////////////////////////////////////
 // Current target includes.
@@ -36,6 +38,7 @@ void GraphicsTraverser::operator()()
     compareEQ(scenegraph.meshes[0].get(), renderData.drawables[0].mesh);
     compareEQ(scenegraph.meshes[1].get(), renderData.drawables[1].mesh);
     compareEQ(scenegraph.meshes[1].get(), renderData.drawables[2].mesh);
+    compareEQ(0, renderData.drawables[0].lod);
 
     compareEQ(&scenegraph.materialInstances[0]->operator[](0), renderData.descriptors[0]);
     compareEQ(&scenegraph.materialInstances[1]->operator[](1), renderData.descriptors[1]);
@@ -47,4 +50,28 @@ void GraphicsTraverser::operator()()
     // Traversing again should be possible and append to the render data.
     traverser.traverse(scenegraph.scenegraph->getRootNode());
     compareEQ(6, renderData.drawables.size());
+
+    // Select levels of detail. The first mesh is far away and is drawn at the least detailed level that is accurate
+    // to 1 pixel. The second mesh is at distance 0 and is drawn at full detail.
+    scenegraph.meshes[0]->setLods({{.firstIndex = 0, .indexCount = 120, .error = 1.0f},
+                                   {.firstIndex = 120, .indexCount = 60, .error = 4.0f}});
+    scenegraph.meshes[1]->setLods({{.firstIndex = 0, .indexCount = 120, .error = 1.0f}});
+    expectThrow([&] { traverser.setLodSelection([](const sol::MeshNode&) { return 1.0f; }, 0.0f); });
+    expectNoThrow([&] {
+        traverser.setLodSelection(
+          [&](const sol::MeshNode& node) { return node.getMesh() == scenegraph.meshes[0].get() ? 200.0f : 0.0f; },
+          100.0f);
+    });
+    renderData.clear();
+    traverser.traverse(scenegraph.scenegraph->getRootNode());
+    compareEQ(3, renderData.drawables.size()).fatal("Incorrect number of drawables.");
+    compareEQ(1, renderData.drawables[0].lod);
+    compareEQ(0, renderData.drawables[1].lod);
+    compareEQ(0, renderData.drawables[2].lod);
+
+    // Without LOD selection, everything is drawn at full detail again.
+    traverser.clearLodSelection();
+    renderData.clear();
+    traverser.traverse(scenegraph.scenegraph->getRootNode());
+    compareEQ(0, renderData.drawables[0].lod);
 }
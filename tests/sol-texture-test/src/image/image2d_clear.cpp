@@ -0,0 +1,169 @@
+#include "sol-texture-test/image/image2d_clear.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <span>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-core/vulkan_queue_family.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+#include "sol-texture/image2d2.h"
+
+void Image2DClear::operator()()
+{
+    constexpr size_t texelCount = 64ull * 64ull;
+
+    const auto createImage = [&](const VkFormat                format,
+                                 const VkImageUsageFlags       usage,
+                                 const VkImageAspectFlags      aspect,
+                                 const sol::VulkanQueueFamily& owner) {
+        return sol::Image2D2::create(sol::Image2D2::Settings{.memoryManager = getMemoryManager(),
+                                                             .size          = {64u, 64u},
+                                                             .format        = format,
+                                                             .levels        = 1,
+                                                             .usage         = usage,
+                                                             .aspect        = aspect,
+                                                             .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+                                                             .initialOwner  = owner,
+                                                             .tiling        = VK_IMAGE_TILING_OPTIMAL});
+    };
+
+    // Stage a clear of the whole image, transitioning it from undefined to the transfer source layout.
+    const auto clear = [&](sol::Image2D2& image, const sol::ImageClear& imageClear) {
+        const auto transaction = getTransferManager().beginTransaction();
+        transaction->stage(imageClear,
+                           sol::ImageBarrier{.image          = image,
+                                             .srcFamily      = nullptr,
+                                             .dstFamily      = nullptr,
+                                             .srcStage       = VK_PIPELINE_STAGE_2_NONE,
+                                             .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                             .srcAccess      = VK_ACCESS_2_NONE,
+                                             .dstAccess      = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                             .srcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                                             .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                             .aspectMask     = image.getImageAspectFlags(),
+                                             .baseMipLevel   = 0,
+                                             .levelCount     = 1,
+                                             .baseArrayLayer = 0,
+                                             .layerCount     = 1});
+        transaction->commit();
+        transaction->wait();
+    };
+
+    // Copy the image back to a new host-side buffer.
+    const auto readBack = [&](sol::Image2D2& image) {
+        auto buffer = getMemoryManager().allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{
+            .size                 = texelCount * 4,
+            .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+            .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+            .requiredMemoryFlags  = 0,
+            .preferredMemoryFlags = 0,
+            .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+            .alignment            = 0},
+          sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        image.getData(*transaction,
+                      *buffer,
+                      {.dstFamily = nullptr,
+                       .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                       .dstStage  = VK_PIPELINE_STAGE_2_NONE,
+                       .srcAccess = VK_ACCESS_2_NONE,
+                       .dstAccess = VK_ACCESS_2_NONE,
+                       .dstLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL},
+                      {.dstFamily = nullptr,
+                       .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                       .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                       .srcAccess = VK_ACCESS_2_NONE,
+                       .dstAccess = VK_ACCESS_2_HOST_READ_BIT,
+                       .dstLayout = VK_IMAGE_LAYOUT_UNDEFINED},
+                      {sol::Image2D2::CopyRegion{}});
+        transaction->commit();
+        transaction->wait();
+        return buffer;
+    };
+
+    const auto& graphics = getMemoryManager().getGraphicsQueue().getFamily();
+
+    // Clear a color image.
+    expectNoThrow([&] {
+        const auto image = createImage(VK_FORMAT_R8G8B8A8_UINT,
+                                       VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                       VK_IMAGE_ASPECT_COLOR_BIT,
+                                       graphics);
+        clear(*image,
+              sol::ImageClear{.dstImage     = *image,
+                              .color        = {.uint32 = {1, 2, 3, 4}},
+                              .depthStencil = {},
+                              .ranges       = {VkImageSubresourceRange{.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                                                       .baseMipLevel   = 0,
+                                                                       .levelCount     = 1,
+                                                                       .baseArrayLayer = 0,
+                                                                       .layerCount     = 1}}});
+        compareEQ(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image->getImageLayout(0, 0));
+        compareEQ(&graphics, &image->getQueueFamily(0, 0));
+
+        const auto                      buffer = readBack(*image);
+        const std::span<const uint32_t> texels(buffer->getBuffer().getMappedData<uint32_t>(), texelCount);
+        compareTrue(std::ranges::all_of(texels, [](const uint32_t texel) { return texel == 0x04030201u; }));
+    });
+
+    // Clear a depth image.
+    expectNoThrow([&] {
+        const auto image = createImage(VK_FORMAT_D32_SFLOAT,
+                                       VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT |
+                                         VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                       VK_IMAGE_ASPECT_DEPTH_BIT,
+                                       graphics);
+        clear(*image,
+              sol::ImageClear{.dstImage     = *image,
+                              .color        = {},
+                              .depthStencil = {.depth = 0.25f, .stencil = 0},
+                              .ranges       = {VkImageSubresourceRange{.aspectMask     = VK_IMAGE_ASPECT_DEPTH_BIT,
+                                                                       .baseMipLevel   = 0,
+                                                                       .levelCount     = 1,
+                                                                       .baseArrayLayer = 0,
+                                                                       .layerCount     = 1}}});
+        compareEQ(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image->getImageLayout(0, 0));
+
+        const auto                   buffer = readBack(*image);
+        const std::span<const float> texels(buffer->getBuffer().getMappedData<float>(), texelCount);
+        compareTrue(std::ranges::all_of(texels, [](const float texel) { return texel == 0.25f; }));
+    });
+
+    // Clears cannot be recorded on a queue family without graphics or compute support.
+    if (const auto& transfer = getMemoryManager().getTransferQueue().getFamily();
+        !transfer.supportsGraphics() && !transfer.supportsCompute())
+    {
+        const auto image = createImage(VK_FORMAT_R8G8B8A8_UINT,
+                                       VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                       VK_IMAGE_ASPECT_COLOR_BIT,
+                                       transfer);
+        expectThrow([&] {
+            const auto transaction = getTransferManager().beginTransaction();
+            transaction->stage(
+              sol::ImageClear{.dstImage     = *image,
+                              .color        = {},
+                              .depthStencil = {},
+                              .ranges       = {VkImageSubresourceRange{.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                                                       .baseMipLevel   = 0,
+                                                                       .levelCount     = 1,
+                                                                       .baseArrayLayer = 0,
+                                                                       .layerCount     = 1}}},
+              std::nullopt);
+        });
+    }
+}
@@ -0,0 +1,114 @@
+#include "sol-texture-test/image/image2d_concurrent.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+#include "sol-texture/image2d2.h"
+
+void Image2DConcurrent::operator()()
+{
+    // Generate some test data.
+    const auto data = genR8G8B8A8W256H256Gradient();
+
+    // Resources are only concurrent if there is more than one queue family to share them with.
+    const bool  concurrent = getMemoryManager().getQueueFamilyIndices().size() > 1;
+    const auto& graphics   = getMemoryManager().getGraphicsQueue().getFamily();
+    const auto& compute    = getMemoryManager().getComputeQueue().getFamily();
+
+    sol::Image2D2Ptr image;
+    expectNoThrow([&] {
+        image = sol::Image2D2::create(sol::Image2D2::Settings{
+          .memoryManager = getMemoryManager(),
+          .size          = {256u, 256u},
+          .format        = VK_FORMAT_R8G8B8A8_UINT,
+          .levels        = 1,
+          .usage  = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+          .aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+          .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+          .initialOwner  = graphics,
+          .tiling        = VK_IMAGE_TILING_OPTIMAL,
+          .sharingMode   = VK_SHARING_MODE_CONCURRENT});
+    });
+    compareEQ(concurrent, image->isConcurrent());
+
+    // Upload on the transfer queue for use on the compute queue. Without ownership transfers, all barriers are
+    // recorded in the copy command buffer.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(image->setData(*transaction,
+                                   data.data(),
+                                   data.size() * 4,
+                                   {.dstFamily = &compute,
+                                    .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                    .dstStage  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                                    .srcAccess = VK_ACCESS_2_NONE,
+                                    .dstAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                                    .dstLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL},
+                                   false,
+                                   {sol::Image2D2::CopyRegion{}}));
+        transaction->commit();
+        transaction->wait();
+
+        compareEQ(VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, image->getImageLayout(0, 0));
+        if (concurrent)
+        {
+            compareEQ(transaction->getStats().submits, static_cast<size_t>(1));
+            compareEQ(&graphics, &image->getQueueFamily(0, 0));
+        }
+        else
+            compareEQ(&compute, &image->getQueueFamily(0, 0));
+    });
+
+    // Copy the image back from the transfer queue without a release and acquire pair and compare.
+    expectNoThrow([&] {
+        const auto buffer = getMemoryManager().allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{
+            .size                 = data.size() * 4,
+            .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+            .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+            .requiredMemoryFlags  = 0,
+            .preferredMemoryFlags = 0,
+            .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+            .alignment            = 0},
+          sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+        const auto transaction = getTransferManager().beginTransaction();
+        image->getData(*transaction,
+                       *buffer,
+                       {.dstFamily = nullptr,
+                        .srcStage  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .dstStage  = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+                        .srcAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                        .dstAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                        .dstLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL},
+                       {.dstFamily = nullptr,
+                        .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                        .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                        .srcAccess = VK_ACCESS_2_NONE,
+                        .dstAccess = VK_ACCESS_2_HOST_READ_BIT,
+                        .dstLayout = VK_IMAGE_LAYOUT_UNDEFINED},
+                       {sol::Image2D2::CopyRegion{}});
+        transaction->commit();
+        transaction->wait();
+
+        if (concurrent) compareEQ(&graphics, &image->getQueueFamily(0, 0));
+
+        std::vector<uint32_t> dataCopy(data.size(), 0);
+        std::memcpy(dataCopy.data(), buffer->getBuffer().getMappedData<uint32_t>(), data.size() * 4);
+        compareEQ(data, dataCopy);
+    });
+}
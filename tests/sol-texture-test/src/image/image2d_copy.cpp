@@ -0,0 +1,239 @@
+#include "sol-texture-test/image/image2d_copy.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+#include "sol-texture/image2d2.h"
+
+void Image2DCopy::operator()()
+{
+    // Generate some test data.
+    const auto  data     = genR8G8B8A8W256H256Gradient();
+    const auto& graphics = getMemoryManager().getGraphicsQueue().getFamily();
+
+    // Create a host-side buffer holding the test data.
+    sol::IBufferPtr srcBuffer;
+    expectNoThrow([&] {
+        srcBuffer = getMemoryManager().allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{
+            .size                 = data.size() * 4,
+            .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+            .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+            .requiredMemoryFlags  = 0,
+            .preferredMemoryFlags = 0,
+            .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT |
+                               VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT,
+            .alignment            = 0},
+          sol::IBufferAllocator::OnAllocationFailure::Throw);
+        std::memcpy(srcBuffer->getBuffer().getMappedData<uint32_t>(), data.data(), data.size() * 4);
+        srcBuffer->getBuffer().flush();
+    });
+
+    // Create a 256x256 image without mips and a 256x256 image with 2 mip levels.
+    sol::Image2D2Ptr image0;
+    sol::Image2D2Ptr image1;
+    expectNoThrow([&] {
+        image0 = sol::Image2D2::create(sol::Image2D2::Settings{
+          .memoryManager = getMemoryManager(),
+          .size          = {256u, 256u},
+          .format        = VK_FORMAT_R8G8B8A8_UINT,
+          .levels        = 1,
+          .usage  = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+          .aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+          .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+          .initialOwner  = graphics,
+          .tiling        = VK_IMAGE_TILING_OPTIMAL});
+
+        image1 = sol::Image2D2::create(sol::Image2D2::Settings{
+          .memoryManager = getMemoryManager(),
+          .size          = {256u, 256u},
+          .format        = VK_FORMAT_R8G8B8A8_UINT,
+          .levels        = 2,
+          .usage  = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+          .aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+          .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+          .initialOwner  = graphics,
+          .tiling        = VK_IMAGE_TILING_OPTIMAL});
+    });
+
+    // Copy buffer into image0, transitioning it from undefined to the transfer source layout.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+
+        const sol::BufferToImageCopy copy{
+          .srcBuffer              = *srcBuffer,
+          .dstImage               = *image0,
+          .regions                = {sol::ImageRegion{.dataOffset     = 0,
+                                                      .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                                      .mipLevel       = 0,
+                                                      .baseArrayLayer = 0,
+                                                      .layerCount     = 1,
+                                                      .offset         = {0, 0, 0},
+                                                      .extent         = {256, 256, 1}}},
+          .srcOnDedicatedTransfer = false,
+          .dstOnDedicatedTransfer = true};
+        const sol::ImageBarrier barrier{.image          = *image0,
+                                        .srcFamily      = &graphics,
+                                        .dstFamily      = &graphics,
+                                        .srcStage       = VK_PIPELINE_STAGE_2_NONE,
+                                        .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                        .srcAccess      = VK_ACCESS_2_NONE,
+                                        .dstAccess      = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                        .srcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                                        .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                        .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                        .baseMipLevel   = 0,
+                                        .levelCount     = 1,
+                                        .baseArrayLayer = 0,
+                                        .layerCount     = 1};
+        transaction->stage(copy, std::nullopt, barrier);
+
+        transaction->commit();
+        transaction->wait();
+    });
+
+    // Verify layout and queue family.
+    compareEQ(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image0->getImageLayout(0, 0));
+    compareEQ(&graphics, &image0->getQueueFamily(0, 0));
+
+    // Copy all of image0 into level 0 of image1 and a subregion of image0 into an offset region of level 1.
+    expectNoThrow([&] {
+        const auto transaction = getTransferManager().beginTransaction();
+
+        constexpr sol::ImageCopyRegion level0{.aspectMask        = VK_IMAGE_ASPECT_COLOR_BIT,
+                                              .srcMipLevel       = 0,
+                                              .srcBaseArrayLayer = 0,
+                                              .dstMipLevel       = 0,
+                                              .dstBaseArrayLayer = 0,
+                                              .layerCount        = 1,
+                                              .srcOffset         = {0, 0, 0},
+                                              .dstOffset         = {0, 0, 0},
+                                              .extent            = {256, 256, 1}};
+        constexpr sol::ImageCopyRegion level1{.aspectMask        = VK_IMAGE_ASPECT_COLOR_BIT,
+                                              .srcMipLevel       = 0,
+                                              .srcBaseArrayLayer = 0,
+                                              .dstMipLevel       = 1,
+                                              .dstBaseArrayLayer = 0,
+                                              .layerCount        = 1,
+                                              .srcOffset         = {64, 32, 0},
+                                              .dstOffset         = {16, 8, 0},
+                                              .extent            = {64, 96, 1}};
+        const sol::ImageToImageCopy    copy{.srcImage               = *image0,
+                                            .dstImage               = *image1,
+                                            .regions                = {level0, level1},
+                                            .srcOnDedicatedTransfer = true,
+                                            .dstOnDedicatedTransfer = true};
+        const sol::ImageBarrier srcBarrier{.image          = *image0,
+                                           .srcFamily      = &graphics,
+                                           .dstFamily      = &graphics,
+                                           .srcStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                           .dstStage       = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                                           .srcAccess      = VK_ACCESS_2_NONE,
+                                           .dstAccess      = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                                           .srcLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                           .dstLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                           .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                           .baseMipLevel   = 0,
+                                           .levelCount     = 1,
+                                           .baseArrayLayer = 0,
+                                           .layerCount     = 1};
+        const sol::ImageBarrier dstBarrier{.image          = *image1,
+                                           .srcFamily      = &graphics,
+                                           .dstFamily      = &graphics,
+                                           .srcStage       = VK_PIPELINE_STAGE_2_NONE,
+                                           .dstStage       = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                                           .srcAccess      = VK_ACCESS_2_NONE,
+                                           .dstAccess      = VK_ACCESS_2_TRANSFER_READ_BIT,
+                                           .srcLayout      = VK_IMAGE_LAYOUT_UNDEFINED,
+                                           .dstLayout      = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                           .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
+                                           .baseMipLevel   = 0,
+                                           .levelCount     = 2,
+                                           .baseArrayLayer = 0,
+                                           .layerCount     = 1};
+        transaction->stage(copy, srcBarrier, dstBarrier);
+
+        transaction->commit();
+        transaction->wait();
+    });
+
+    // Verify layouts and queue families.
+    compareEQ(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, image0->getImageLayout(0, 0));
+    compareEQ(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image1->getImageLayout(0, 0));
+    compareEQ(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image1->getImageLayout(1, 0));
+    compareEQ(&graphics, &image0->getQueueFamily(0, 0));
+    compareEQ(&graphics, &image1->getQueueFamily(0, 0));
+    compareEQ(&graphics, &image1->getQueueFamily(1, 0));
+
+    // Create a host-side buffer to copy level 0 and the level 1 subregion of image1 back to.
+    constexpr size_t level0Size = 256ull * 256ull * 4;
+    constexpr size_t regionSize = 64ull * 96ull * 4;
+    const auto       dstBuffer  = getMemoryManager().allocateBuffer(
+      sol::IBufferAllocator::AllocationInfo{
+        .size                 = level0Size + regionSize,
+        .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+        .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+        .requiredMemoryFlags  = 0,
+        .preferredMemoryFlags = 0,
+        .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+        .alignment            = 0},
+      sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+    // Copy data back.
+    {
+        const auto                          transaction = getTransferManager().beginTransaction();
+        constexpr sol::Image2D2::CopyRegion region0{
+          .dataOffset = 0, .level = 0, .regionOffset = {0, 0}, .regionSize = {256, 256}};
+        constexpr sol::Image2D2::CopyRegion region1{
+          .dataOffset = level0Size, .level = 1, .regionOffset = {16, 8}, .regionSize = {64, 96}};
+        image1->getData(*transaction,
+                        *dstBuffer,
+                        {.dstFamily = nullptr,
+                         .srcStage  = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+                         .dstStage  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                         .srcAccess = VK_ACCESS_2_NONE,
+                         .dstAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                         .dstLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
+                        {.dstFamily = nullptr,
+                         .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                         .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                         .srcAccess = VK_ACCESS_2_NONE,
+                         .dstAccess = VK_ACCESS_2_HOST_READ_BIT,
+                         .dstLayout = VK_IMAGE_LAYOUT_UNDEFINED},
+                        {region0, region1});
+        transaction->commit();
+        transaction->wait();
+    }
+
+    compareEQ(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, image1->getImageLayout(0, 0));
+    compareEQ(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, image1->getImageLayout(1, 0));
+
+    // Level 0 must match the test data.
+    const auto*           texels = dstBuffer->getBuffer().getMappedData<uint32_t>();
+    std::vector<uint32_t> dataCopy(256ull * 256ull, 0);
+    std::memcpy(dataCopy.data(), texels, level0Size);
+    compareEQ(data, dataCopy);
+
+    // Level 1 subregion must match the source subregion.
+    std::vector<uint32_t> expected;
+    for (size_t y = 0; y < 96; y++)
+        for (size_t x = 0; x < 64; x++) expected.push_back(data[(y + 32) * 256 + x + 64]);
+    dataCopy.resize(64ull * 96ull);
+    std::memcpy(dataCopy.data(), texels + level0Size / 4, regionSize);
+    compareEQ(expected, dataCopy);
+}
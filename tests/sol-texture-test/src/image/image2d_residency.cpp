@@ -0,0 +1,143 @@
+#include "sol-texture-test/image/image2d_residency.h"
+
+////////////////////////////////////////////////////////////////
+// Standard includes.
+////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+////////////////////////////////////////////////////////////////
+// Module includes.
+////////////////////////////////////////////////////////////////
+
+#include "sol-core/vulkan_buffer.h"
+#include "sol-core/vulkan_queue.h"
+#include "sol-memory/i_buffer.h"
+#include "sol-memory/memory_manager.h"
+#include "sol-memory/residency_manager.h"
+#include "sol-memory/transaction.h"
+#include "sol-memory/transaction_manager.h"
+#include "sol-texture/image2d2.h"
+
+void Image2DResidency::operator()()
+{
+    // Generate test data for 2 levels.
+    constexpr size_t level0Size = 256ull * 256ull * 4;
+    constexpr size_t level1Size = 128ull * 128ull * 4;
+    auto             data       = genR8G8B8A8W256H256Gradient();
+    for (uint32_t i = 0; i < 128 * 128; i++) data.push_back(i);
+
+    // Create a 256x256 image with 2 levels.
+    sol::Image2D2Ptr image;
+    expectNoThrow([&] {
+        image = sol::Image2D2::create(sol::Image2D2::Settings{
+          .memoryManager = getMemoryManager(),
+          .size          = {256u, 256u},
+          .format        = VK_FORMAT_R8G8B8A8_UINT,
+          .levels        = 2,
+          .usage  = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+          .aspect = VK_IMAGE_ASPECT_COLOR_BIT,
+          .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+          .initialOwner  = getMemoryManager().getGraphicsQueue().getFamily(),
+          .tiling        = VK_IMAGE_TILING_OPTIMAL});
+    });
+
+    // Copy test data into both levels.
+    {
+        const auto                          transaction = getTransferManager().beginTransaction();
+        constexpr sol::Image2D2::CopyRegion region0{
+          .dataOffset = 0, .level = 0, .regionOffset = {0, 0}, .regionSize = {256, 256}};
+        constexpr sol::Image2D2::CopyRegion region1{
+          .dataOffset = level0Size, .level = 1, .regionOffset = {0, 0}, .regionSize = {128, 128}};
+        compareTrue(image->setData(*transaction,
+                                   data.data(),
+                                   data.size() * 4,
+                                   {.dstFamily = nullptr,
+                                    .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                                    .dstStage  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                                    .srcAccess = VK_ACCESS_2_NONE,
+                                    .dstAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                                    .dstLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL},
+                                   false,
+                                   {region0, region1}));
+        transaction->commit();
+        transaction->wait();
+    }
+
+    sol::ResidencyManager         manager(getMemoryManager(), getTransferManager());
+    size_t                        restored = 0;
+    sol::ResidencyManager::Handle handle   = 0;
+    expectNoThrow([&] { handle = image->registerResidency(manager, 0, [&](sol::Image2D2&) { restored++; }); });
+    compareEQ(manager.getStatistics().residentBytes, level0Size + level1Size);
+
+    // Use the image in frame 1 and evict it under budget pressure in frame 2.
+    {
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(manager.touch(*transaction, handle, 1));
+    }
+    manager.setBudget(level0Size);
+    compareEQ(manager.enforceBudget(2), level0Size + level1Size);
+    compareFalse(manager.isResident(handle));
+    compareEQ(manager.getStatistics().evictedBytes, level0Size + level1Size);
+
+    // Touching restores the contents, layout and owner of all levels.
+    manager.setBudget(0);
+    {
+        const auto transaction = getTransferManager().beginTransaction();
+        compareTrue(manager.touch(*transaction, handle, 3));
+        transaction->commit();
+        transaction->wait();
+    }
+    compareTrue(manager.isResident(handle));
+    compareEQ(restored, static_cast<size_t>(1));
+    compareEQ(manager.getStatistics().restores, static_cast<size_t>(1));
+    for (uint32_t level = 0; level < 2; level++)
+    {
+        compareEQ(VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, image->getImageLayout(level, 0));
+        compareEQ(&getMemoryManager().getGraphicsQueue().getFamily(), &image->getQueueFamily(level, 0));
+    }
+
+    // Copy data back and compare.
+    {
+        const auto buffer = getMemoryManager().allocateBuffer(
+          sol::IBufferAllocator::AllocationInfo{
+            .size                 = level0Size + level1Size,
+            .bufferUsage          = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .sharingMode          = VK_SHARING_MODE_EXCLUSIVE,
+            .memoryUsage          = VMA_MEMORY_USAGE_AUTO,
+            .requiredMemoryFlags  = 0,
+            .preferredMemoryFlags = 0,
+            .allocationFlags      = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT,
+            .alignment            = 0},
+          sol::IBufferAllocator::OnAllocationFailure::Throw);
+
+        const auto                          transaction = getTransferManager().beginTransaction();
+        constexpr sol::Image2D2::CopyRegion region0{
+          .dataOffset = 0, .level = 0, .regionOffset = {0, 0}, .regionSize = {256, 256}};
+        constexpr sol::Image2D2::CopyRegion region1{
+          .dataOffset = level0Size, .level = 1, .regionOffset = {0, 0}, .regionSize = {128, 128}};
+        image->getData(*transaction,
+                       *buffer,
+                       {.dstFamily = nullptr,
+                        .srcStage  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                        .dstStage  = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT,
+                        .srcAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                        .dstAccess = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+                        .dstLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL},
+                       {.dstFamily = nullptr,
+                        .srcStage  = VK_PIPELINE_STAGE_2_NONE,
+                        .dstStage  = VK_PIPELINE_STAGE_2_HOST_BIT,
+                        .srcAccess = VK_ACCESS_2_NONE,
+                        .dstAccess = VK_ACCESS_2_HOST_READ_BIT,
+                        .dstLayout = VK_IMAGE_LAYOUT_UNDEFINED},
+                       {region0, region1});
+        transaction->commit();
+        transaction->wait();
+
+        std::vector<uint32_t> contents(data.size(), 0);
+        std::memcpy(contents.data(), buffer->getBuffer().getMappedData<uint32_t>(), level0Size + level1Size);
+        compareEQ(data, contents);
+    }
+
+    manager.remove(handle);
+}
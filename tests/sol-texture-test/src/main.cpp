@@ -10,7 +10,11 @@
 
 #include "sol-texture-test/image/image2d.h"
 #include "sol-texture-test/image/image2d_barriers.h"
+#include "sol-texture-test/image/image2d_clear.h"
+#include "sol-texture-test/image/image2d_concurrent.h"
+#include "sol-texture-test/image/image2d_copy.h"
 #include "sol-texture-test/image/image2d_data.h"
+#include "sol-texture-test/image/image2d_residency.h"
 #include "sol-texture-test/sampler/sampler2d.h"
 #include "sol-texture-test/texture/texture2d.h"
 
@@ -32,5 +36,13 @@ int main(int argc, char** argv)
 #endif
 
     // TODO: Parallel tests are not supported. BetterTest needs an option to always disable them and perhaps even give an error when trying run in parallel.
-    return bt::run<Image2D, Image2DBarriers, Image2DData, Sampler2D, Texture2D>(argc, argv, "sol-texture");
+    return bt::run<Image2D,
+                   Image2DBarriers,
+                   Image2DClear,
+                   Image2DConcurrent,
+                   Image2DCopy,
+                   Image2DData,
+                   Image2DResidency,
+                   Sampler2D,
+                   Texture2D>(argc, argv, "sol-texture");
 }